@@ -113,6 +113,7 @@ enum
 	APPPACKETTYPE_CSANNOUNCEMENT,
 	APPPACKETTYPE_DONATEEVENT,
 	APPPACKETTYPE_GAMESPYCSCHALLENGERESPONSEEVENT,
+	APPPACKETTYPE_CLIENTDELTAACK,
 
 	//
 	// Summation
@@ -42,12 +42,14 @@
 #include "ffactory.h"
 #include "saveloadstatus.h"
 #include "wwprofile.h"
+#include "hashtemplate.h"
 
 ///////////////////////////////////////////////////////////////////////
 //	Local prototypes
 ///////////////////////////////////////////////////////////////////////
 static void Asset_Name_From_Filename (StringClass& new_name, const char *filename);
 static void Get_Filename_From_Path (StringClass& new_name, const char *filename);
+static void Asset_Loaded (const char *filename);
 
 
 ///////////////////////////////////////////////////////////////////////
@@ -258,8 +260,12 @@ AssetDependencyManager::Load_Assets (ChunkLoadClass &cload)
 
 		//
 		//	Read the filename of each asset from the chunk and
-		// load its assets into the asset manager.
+		// load its assets into the asset manager.  The files are
+		// collected first so the asset manager can load them together,
+		// each render object only once.
 		//
+		DynamicVectorClass<StringClass> filename_list;
+		HashTemplateClass<StringClass, bool> queued_names;
 		while (cload.Open_Micro_Chunk ()) {
 			switch (cload.Cur_Micro_Chunk_ID ())
 			{
@@ -278,13 +284,17 @@ AssetDependencyManager::Load_Assets (ChunkLoadClass &cload)
 					//
 					StringClass render_obj_name(0,true);
 					::Asset_Name_From_Filename (render_obj_name,filename);
-					INIT_SUB_STATUS(filename);
+					render_obj_name.To_Lower ();
 
 					//
-					//	Load the assets from this file into the asset manager
+					//	Queue this file up to be loaded into the asset manager,
+					// unless an earlier file already provides the render object
 					//
-					if (WW3DAssetManager::Get_Instance ()->Render_Obj_Exists (render_obj_name) == false) {
-						WW3DAssetManager::Get_Instance ()->Load_3D_Assets (filename);
+					if (	WW3DAssetManager::Get_Instance ()->Render_Obj_Exists (render_obj_name) == false &&
+							queued_names.Exists (render_obj_name) == false)
+					{
+						queued_names.Insert (render_obj_name, true);
+						filename_list.Add (filename);
 					}
 //	WWLOG_INTERMEDIATE(filename);
 				}
@@ -297,6 +307,12 @@ AssetDependencyManager::Load_Assets (ChunkLoadClass &cload)
 
 			cload.Close_Micro_Chunk ();
 		}
+
+		//
+		//	Load the assets from these files into the asset manager,
+		// the status shows each file as it finishes loading.
+		//
+		WW3DAssetManager::Get_Instance ()->Load_3D_Assets (filename_list, Asset_Loaded);
 	}
 
 	cload.Close_Chunk ();
@@ -331,3 +347,14 @@ void Asset_Name_From_Filename (StringClass& asset_name, const char *filename)
 		extension[0] = 0;
 	}
 }
+
+
+////////////////////////////////////////////////////////////////////////////
+//
+//  Asset_Loaded
+//
+////////////////////////////////////////////////////////////////////////////
+void Asset_Loaded (const char *filename)
+{
+	INIT_SUB_STATUS(filename);
+}
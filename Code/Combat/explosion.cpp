@@ -286,6 +286,9 @@ void	ExplosionManager::Create_Explosion_At( int explosion_def_id, const Matrix3D
 
 			WWASSERT(pos.Is_Valid());
 
+			// Wake up any physics objects resting in the blast so they get timestepped again
+			PhysicsSceneClass::Get_Instance()->Force_Dynamic_Objects_Awake( AABoxClass( pos, Vector3( radius, radius, radius ) ) );
+
 			// Create an offense object to carry the damage information
 			OffenseObjectClass offense( explosion_def->DamageStrength, explosion_def->DamageWarhead, damager );
 
@@ -98,6 +98,7 @@ enum
 	NETCLASSID_CSANNOUNCEMENT,
 	NETCLASSID_DONATEEVENT,
 	NETCLASSID_GAMESPYCSCHALLENGERESPONSEEVENT,
+	NETCLASSID_CLIENTDELTAACK,
 };
 
 
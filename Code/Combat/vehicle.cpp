@@ -92,6 +92,20 @@ static void	Set_Subobject_Visibility (RenderObjClass *model, int bone_index, boo
 #define	NORMALIZE_RADIANS( v ) 	while ( v > (float)DEG_TO_RAD(  180.0f ) ) v -= (float)DEG_TO_RAD( 360.0f ); \
 											while ( v < (float)DEG_TO_RAD( -180.0f ) ) v += (float)DEG_TO_RAD( 360.0f );
 
+/*
+** Quantized state sent with every frequent update: position, orientation,
+** velocity and angular velocity.
+*/
+static const int VEHICLE_STATE_FIELD_COUNT = 13;
+
+static const int _VehicleStateTypes[VEHICLE_STATE_FIELD_COUNT] =
+{
+	BITPACK_WORLD_POSITION_X,			BITPACK_WORLD_POSITION_Y,			BITPACK_WORLD_POSITION_Z,
+	BITPACK_VEHICLE_QUATERNION,		BITPACK_VEHICLE_QUATERNION,		BITPACK_VEHICLE_QUATERNION,		BITPACK_VEHICLE_QUATERNION,
+	BITPACK_VEHICLE_VELOCITY,			BITPACK_VEHICLE_VELOCITY,			BITPACK_VEHICLE_VELOCITY,
+	BITPACK_VEHICLE_ANGULAR_VELOCITY,	BITPACK_VEHICLE_ANGULAR_VELOCITY,	BITPACK_VEHICLE_ANGULAR_VELOCITY
+};
+
 //
 // Class statics
 //
@@ -963,33 +977,24 @@ void VehicleGameObj::Import_Frequent(BitStreamClass & packet)
 				bool is_engine_on;
 
 				packet.Get(is_engine_on);
-				packet.Get(sc_position.X, BITPACK_WORLD_POSITION_X);
-				packet.Get(sc_position.Y, BITPACK_WORLD_POSITION_Y);
-				packet.Get(sc_position.Z, BITPACK_WORLD_POSITION_Z);
-
-				packet.Get(q.X, BITPACK_VEHICLE_QUATERNION);
-				packet.Get(q.Y, BITPACK_VEHICLE_QUATERNION);
-				packet.Get(q.Z, BITPACK_VEHICLE_QUATERNION);
-				packet.Get(q.W, BITPACK_VEHICLE_QUATERNION);
-				q.Normalize();
 
+				float state[VEHICLE_STATE_FIELD_COUNT];
+				packet.Get_Quantized(state, _VehicleStateTypes, VEHICLE_STATE_FIELD_COUNT);
+
+				sc_position.Set(state[0], state[1], state[2]);
+				q.Set(state[3], state[4], state[5], state[6]);
+				q.Normalize();
 
 #ifdef MULTIPLAYERDEMO
 				//
 				// Mix up the packet order to make demo/non-demo code more incompatible.
 				//
-				packet.Get(vel.Y, BITPACK_VEHICLE_VELOCITY);
-				packet.Get(vel.Z, BITPACK_VEHICLE_VELOCITY);
-				packet.Get(vel.X, BITPACK_VEHICLE_VELOCITY);
+				vel.Set(state[9], state[7], state[8]);
 #else
-				packet.Get(vel.X, BITPACK_VEHICLE_VELOCITY);
-				packet.Get(vel.Y, BITPACK_VEHICLE_VELOCITY);
-				packet.Get(vel.Z, BITPACK_VEHICLE_VELOCITY);
+				vel.Set(state[7], state[8], state[9]);
 #endif
 
-				packet.Get(ang_vel.X, BITPACK_VEHICLE_ANGULAR_VELOCITY);
-				packet.Get(ang_vel.Y, BITPACK_VEHICLE_ANGULAR_VELOCITY);
-				packet.Get(ang_vel.Z, BITPACK_VEHICLE_ANGULAR_VELOCITY);
+				ang_vel.Set(state[10], state[11], state[12]);
 
 				if (COMBAT_STAR && (COMBAT_STAR->Get_Vehicle() == this)) {
 					p_obj->Network_Latency_State_Update(		sc_position,
@@ -1069,33 +1074,24 @@ void VehicleGameObj::Export_Frequent(BitStreamClass & packet)
 				is_engine_on = p_obj->Is_Engine_Enabled();
 
 				packet.Add(is_engine_on);
-				packet.Add(pos.X, BITPACK_WORLD_POSITION_X);
-				packet.Add(pos.Y, BITPACK_WORLD_POSITION_Y);
-				packet.Add(pos.Z, BITPACK_WORLD_POSITION_Z);
-
-				packet.Add(q.X, BITPACK_VEHICLE_QUATERNION);
-				packet.Add(q.Y, BITPACK_VEHICLE_QUATERNION);
-				packet.Add(q.Z, BITPACK_VEHICLE_QUATERNION);
-				packet.Add(q.W, BITPACK_VEHICLE_QUATERNION);
-
 
 #ifdef MULTIPLAYERDEMO
 				//
 				// Mix up the packet order to make demo/non-demo code more incompatible.
 				//
-				packet.Add(vel.Y, BITPACK_VEHICLE_VELOCITY);
-				packet.Add(vel.Z, BITPACK_VEHICLE_VELOCITY);
-				packet.Add(vel.X, BITPACK_VEHICLE_VELOCITY);
+				const float state[VEHICLE_STATE_FIELD_COUNT] = {
+					pos.X, pos.Y, pos.Z,
+					q.X, q.Y, q.Z, q.W,
+					vel.Y, vel.Z, vel.X,
+					ang_vel.X, ang_vel.Y, ang_vel.Z };
 #else
-				packet.Add(vel.X, BITPACK_VEHICLE_VELOCITY);
-				packet.Add(vel.Y, BITPACK_VEHICLE_VELOCITY);
-				packet.Add(vel.Z, BITPACK_VEHICLE_VELOCITY);
+				const float state[VEHICLE_STATE_FIELD_COUNT] = {
+					pos.X, pos.Y, pos.Z,
+					q.X, q.Y, q.Z, q.W,
+					vel.X, vel.Y, vel.Z,
+					ang_vel.X, ang_vel.Y, ang_vel.Z };
 #endif
-
-
-				packet.Add(ang_vel.X, BITPACK_VEHICLE_ANGULAR_VELOCITY);
-				packet.Add(ang_vel.Y, BITPACK_VEHICLE_ANGULAR_VELOCITY);
-				packet.Add(ang_vel.Z, BITPACK_VEHICLE_ANGULAR_VELOCITY);
+				packet.Add_Quantized(state, _VehicleStateTypes, VEHICLE_STATE_FIELD_COUNT);
 			}
 
          break;
@@ -248,6 +248,7 @@ cAppPacketStats::Interpret_Type
 		ADD_CASE(APPPACKETTYPE_CSANNOUNCEMENT);
 		ADD_CASE(APPPACKETTYPE_DONATEEVENT);
 		ADD_CASE(APPPACKETTYPE_GAMESPYCSCHALLENGERESPONSEEVENT);
+		ADD_CASE(APPPACKETTYPE_CLIENTDELTAACK);
 
 		//
 		// Summation
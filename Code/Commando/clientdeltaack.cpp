@@ -0,0 +1,117 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "clientdeltaack.h"
+
+#include "networkobjectfactory.h"
+#include "networkobjectmgr.h"
+#include "networkobjectdelta.h"
+#include "cnetwork.h"
+#include "apppackettypes.h"
+#include "systimer.h"
+
+
+CClientDeltaAck *		PClientDeltaAck = nullptr;
+
+DECLARE_NETWORKOBJECT_FACTORY(CClientDeltaAck, NETCLASSID_CLIENTDELTAACK);
+
+//
+// Acks are batched rather than sent with every update. A slower rate only
+// means the server codes against slightly older states.
+//
+static const unsigned int ACK_INTERVAL_MS = 100;
+
+//-----------------------------------------------------------------------------
+CClientDeltaAck::CClientDeltaAck(void)
+{
+	ClientId			= -1;
+	LastSendTime	= 0;
+
+	Set_App_Packet_Type(APPPACKETTYPE_CLIENTDELTAACK);
+}
+
+//-----------------------------------------------------------------------------
+CClientDeltaAck::~CClientDeltaAck(void)
+{
+}
+
+//-----------------------------------------------------------------------------
+void
+CClientDeltaAck::Init(void)
+{
+	WWASSERT(cNetwork::I_Am_Client());
+
+	ClientId = cNetwork::Get_My_Id();
+
+	Set_Network_ID(NetworkObjectMgrClass::Get_New_Client_ID());
+
+	Set_Object_Dirty_Bit(0, NetworkObjectClass::BIT_CREATION, true);
+}
+
+//-----------------------------------------------------------------------------
+void
+CClientDeltaAck::Update(void)
+{
+	WWASSERT(cNetwork::I_Am_Client());
+
+	unsigned int time_now = TIMEGETTIME();
+	if (time_now - LastSendTime >= ACK_INTERVAL_MS && NetworkObjectDeltaClass::Has_Pending_Acks()) {
+		LastSendTime = time_now;
+		Set_Object_Dirty_Bit(0, NetworkObjectClass::BIT_FREQUENT, true);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void
+CClientDeltaAck::Export_Creation(BitStreamClass & packet)
+{
+	WWASSERT(cNetwork::I_Am_Client());
+
+	NetworkObjectClass::Export_Creation(packet);
+
+	packet.Add(ClientId);
+}
+
+//-----------------------------------------------------------------------------
+void
+CClientDeltaAck::Import_Creation(BitStreamClass & packet)
+{
+	WWASSERT(cNetwork::I_Am_Server());
+
+	NetworkObjectClass::Import_Creation(packet);
+
+	packet.Get(ClientId);
+}
+
+//-----------------------------------------------------------------------------
+void
+CClientDeltaAck::Export_Frequent(BitStreamClass & packet)
+{
+	WWASSERT(cNetwork::I_Am_Client());
+
+	NetworkObjectDeltaClass::Export_Acks(packet);
+}
+
+//-----------------------------------------------------------------------------
+void
+CClientDeltaAck::Import_Frequent(BitStreamClass & packet)
+{
+	WWASSERT(cNetwork::I_Am_Server());
+
+	NetworkObjectDeltaClass::Import_Acks(packet, ClientId);
+}
@@ -0,0 +1,61 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __CLIENTDELTAACK_H__
+#define __CLIENTDELTAACK_H__
+
+#include "networkobject.h"
+#include "netclassids.h"
+
+//-----------------------------------------------------------------------------
+//
+// A C-S mirrored object that tells the server which delta coded frequent
+// updates have arrived, so it can code later ones against them.
+//
+class	CClientDeltaAck : public NetworkObjectClass
+{
+public:
+
+	CClientDeltaAck();
+	~CClientDeltaAck();
+
+	void					Init(void);
+	virtual uint32		Get_Network_Class_ID(void) const override					{return NETCLASSID_CLIENTDELTAACK;}
+	virtual void		Delete(void) override											{delete this;}
+
+	void					Update(void);
+
+	virtual void		Export_Creation(BitStreamClass &packet) override;
+	virtual void		Import_Creation(BitStreamClass &packet) override;
+
+	virtual void		Export_Frequent(BitStreamClass &packet) override;
+	virtual void		Import_Frequent(BitStreamClass &packet) override;
+
+private:
+
+	int					ClientId;
+	unsigned int		LastSendTime;
+};
+
+//-----------------------------------------------------------------------------
+
+extern CClientDeltaAck *		PClientDeltaAck;
+
+//-----------------------------------------------------------------------------
+
+#endif	// __CLIENTDELTAACK_H__
@@ -74,8 +74,10 @@
 #include "DlgMessageBox.h"
 #include "apppacketstats.h"
 #include "clientfps.h"
+#include "clientdeltaack.h"
 #include "gamechanlist.h"
 #include "packetmgr.h"
+#include "netthread.h"
 #include "clientpingmanager.h"
 #include "bandwidthgraph.h"
 #include "buildnum.h"
@@ -126,6 +128,9 @@ bool												cNetwork::HaveDoneMotdDialog				= false;
 VisTableClass *								cNetwork::VisTable							= nullptr;
 bool												cNetwork::LastServerConnectionStateBad = false;
 bool												cNetwork::SensibleUpdates					= true;
+char												cNetwork::CaptureFile[]						= "";
+char												cNetwork::ReplayFile[]						= "";
+DWORD												cNetwork::ReplayStartTime					= 0;
 
 //-----------------------------------------------------------------------------
 void cNetwork::Init_Client([[maybe_unused]] unsigned short my_port)
@@ -271,6 +276,9 @@ void cNetwork::Cleanup_Client(void)
 	delete PClientFps;
 	PClientFps = nullptr;
 
+	delete PClientDeltaAck;
+	PClientDeltaAck = nullptr;
+
 #endif // !FREEDEDICATEDSERVER
 }
 
@@ -303,6 +311,13 @@ void cNetwork::Accept_Handler(void)
 		WWASSERT(PClientFps == nullptr);
 		PClientFps = new CClientFps;
 		PClientFps->Init();
+
+		//
+		// Create C->S mirrored delta ack object
+		//
+		WWASSERT(PClientDeltaAck == nullptr);
+		PClientDeltaAck = new CClientDeltaAck;
+		PClientDeltaAck->Init();
 	}
 
 
@@ -588,6 +603,8 @@ void cNetwork::Onetime_Shutdown(void)
 {
    WWDEBUG_SAY(("cNetwork::Onetime_Shutdown\n"));
 
+	NetworkThreadClass::Stop();
+
    Set_Receiver(nullptr);
 	delete NetworkReceiver;
 
@@ -701,6 +718,17 @@ void cNetwork::Init_Server(void)
 		The_Game()->IsDedicated.Get(),
 		ntohl(The_Game()->Get_Ip_Address()));
 
+	//
+	// Replay feeds the capture through the server's receive path in 10ms
+	// bursts, one burst per Service_Read, instead of reading the socket.
+	//
+	if (CaptureFile[0] != 0) {
+		PacketManager.Start_Capture(CaptureFile);
+	}
+	if (ReplayFile[0] != 0 && PacketManager.Start_Replay(ReplayFile, 10)) {
+		ReplayStartTime = TIMEGETTIME();
+	}
+
    //
    // Create teams
    //
@@ -725,6 +753,9 @@ void cNetwork::Cleanup_Server(void)
 
    if (I_Am_Server()) {
 
+		PacketManager.Stop_Capture();
+		PacketManager.Stop_Replay();
+
       delete PServerConnection;
       PServerConnection = nullptr;
    }
@@ -877,6 +908,12 @@ void cNetwork::Update(void)
 	recursion_level++;
 	WWASSERT(recursion_level == 1);
 
+	//
+	// Keep the network thread, if there is one, out until we are done.
+	//
+	NetworkThreadLockClass network_lock;
+	NetworkThreadClass::Note_Service();
+
 	Update_Fps();
 
 #ifdef WWDEBUG
@@ -912,6 +949,17 @@ void cNetwork::Update(void)
 		WWPROFILENAMED( "Server Read", mid );
 		PServerConnection->Service_Read();
 
+		if (PacketManager.Is_Replaying() && PacketManager.Is_Replay_Done()) {
+			DWORD elapsed_ms = std::max<DWORD>(TIMEGETTIME() - ReplayStartTime, 1);
+			int datagrams = PacketManager.Get_Replayed_Datagrams();
+			ConsoleBox.Print("Replay of %s done: %d datagrams, %u bytes in %u ms (%.0f datagrams/s)\n",
+				ReplayFile, datagrams, PacketManager.Get_Replayed_Bytes(), elapsed_ms, datagrams * 1000.0f / elapsed_ms);
+			PacketManager.Stop_Replay();
+
+			extern void Stop_Main_Loop(int exitcode);
+			Stop_Main_Loop(EXIT_SUCCESS);
+		}
+
 		if (!g_is_loading) {
 			WWPROFILE( "Shared CS Think" );
 			Shared_Client_And_Server_Think();
@@ -1678,3 +1726,19 @@ void cNetwork::Enable_Waiting_Players(void)
 		}
    }
 }
+
+//-----------------------------------------------------------------------------
+void cNetwork::Set_Capture_File(const char * filename)
+{
+	WWASSERT(filename != nullptr);
+	strncpy(CaptureFile, filename, sizeof(CaptureFile) - 1);
+	CaptureFile[sizeof(CaptureFile) - 1] = 0;
+}
+
+//-----------------------------------------------------------------------------
+void cNetwork::Set_Replay_File(const char * filename)
+{
+	WWASSERT(filename != nullptr);
+	strncpy(ReplayFile, filename, sizeof(ReplayFile) - 1);
+	ReplayFile[sizeof(ReplayFile) - 1] = 0;
+}
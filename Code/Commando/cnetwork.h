@@ -107,6 +107,7 @@ public:
 	// Sending Simple Client Packets
    static int Send_Object_Update(NetworkObjectClass *object, int client_id);
    static void Tell_Client_About_Dynamic_Objects(int recipient_client_id, Vector3 & dest_pos);
+   static void Tell_Clients_About_Dynamic_Objects(int client_count, const int * client_ids, const Vector3 * dest_positions);
 	static void Tell_Client_About_Delete_Notifications(int recipient_client_id);
    static void Tell_Server_About_Dynamic_Objects(void);
 
@@ -185,6 +186,12 @@ public:
 
 	static void Enable_Waiting_Players(void);
 
+	//
+	// Headless capture / replay of the server's datagrams (--capture, --replay)
+	//
+	static void Set_Capture_File(const char * filename);
+	static void Set_Replay_File(const char * filename);
+
 
 	//
 	// Hide...
@@ -243,6 +250,10 @@ private:
 	static int Fps;
 	static int ThinkCount;
 
+	static char CaptureFile[260];
+	static char ReplayFile[260];
+	static DWORD ReplayStartTime;
+
 	static cMsgStatList *		PClientStatList;
 	static cMsgStatListGroup *	PServerStatListGroup;
 
@@ -49,6 +49,10 @@
 #include "ServerSettings.h"
 #include "ConsoleMode.h"
 #include "demosupport.h"
+#include "devoptions.h"
+#include "networkobject.h"
+#include "networkobjectmgr.h"
+#include "networkobjectdelta.h"
 
 //-----------------------------------------------------------------------------
 void	CombatNetworkReceiverInstanceClass::Print( const char *format, ... )
@@ -157,6 +161,27 @@ bool CombatNetworkReceiverInstanceClass::Server_Update_Dynamic_Objects(bool is_u
 	//
 	cRemoteHost::Set_Priority_Update_Rate(cUserOptions::NetUpdateRate.Get());
 
+	//
+	// Frequent tiers are delta coded against each client's acked state.
+	//
+	NetworkObjectDeltaClass::Enable(cDevOptions::UseDeltaReplication.Is_True());
+
+	//
+	// Snapshot object positions for the relevance filtering in TCADO.
+	//
+	if (cDevOptions::UseRelevanceGrid.Is_True()) {
+		WWPROFILE("Spatial Index");
+		NetworkObjectMgrClass::Update_Spatial_Index();
+	}
+
+	//
+	// In parallel mode the clients are collected here and all handled in one go.
+	//
+	bool is_parallel = cDevOptions::UseNewTCADO.Is_True() && cDevOptions::UseParallelTCADO.Is_True();
+	int parallel_count = 0;
+	int parallel_ids[NetworkObjectClass::MAX_CLIENT_COUNT];
+	Vector3 parallel_positions[NetworkObjectClass::MAX_CLIENT_COUNT];
+
    //
    // TSS - bug
 	// Must handle sniper... also, should use camera position
@@ -234,8 +259,19 @@ bool CombatNetworkReceiverInstanceClass::Server_Update_Dynamic_Objects(bool is_u
 			dest_pos.Z += 1.5;
 		}
 
-      cNetwork::Tell_Client_About_Dynamic_Objects(client_id, dest_pos);
+		if (is_parallel) {
+			WWASSERT(parallel_count < NetworkObjectClass::MAX_CLIENT_COUNT);
+			parallel_ids[parallel_count] = client_id;
+			parallel_positions[parallel_count] = dest_pos;
+			parallel_count++;
+		} else {
+			cNetwork::Tell_Client_About_Dynamic_Objects(client_id, dest_pos);
+		}
    }
+
+	if (parallel_count > 0) {
+		cNetwork::Tell_Clients_About_Dynamic_Objects(parallel_count, parallel_ids, parallel_positions);
+	}
 	return(true);
 }
 
@@ -897,6 +897,12 @@ WWPROFILE( "Input Active" );
 					message += working_string;
 					working_string.Format("Rejected: %d  %10.3f pf\n",stats.CullNodesRejected,(float)stats.CullNodesRejected / (float)stats.FrameCount);
 					message += working_string;
+					working_string.Format("Vis Tables: %d hits  %d misses  %d prefetched\n",stats.VisTableHits,stats.VisTableMisses,stats.VisTablePrefetches);
+					message += working_string;
+					working_string.Format("Vis Decompress: %10.3f ms pf\n",stats.VisDecompressTime / (float)stats.FrameCount);
+					message += working_string;
+					working_string.Format("Objects: %d active  %d sleeping\n",stats.ActiveObjectCount,stats.SleepingObjectCount);
+					message += working_string;
 				}
 			}
 			StatisticsDisplayManager::Set_Stat( "culling", message );
@@ -67,6 +67,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <chrono>
 #include "objlibrary.h"
 #include "useroptions.h"
 #include "devoptions.h"
@@ -114,7 +115,18 @@
 #include "sctextobj.h"
 #include "consolecommandevent.h"
 #include "hudinfo.h"
+#include "init.h"
+#include "mixfile.h"
+#include "rawfile.h"
 #include "physresourcemgr.h"
+#include "jobpool.h"
+#include "w3dcache.h"
+#include "htree.h"
+#include "hanim.h"
+#include "hanimpose.h"
+#include "aabtree.h"
+#include "pathmgr.h"
+#include "pathsolve.h"
 #include "cstextobj.h"
 #include "suicideevent.h"
 #include "godmodeevent.h"
@@ -134,6 +146,8 @@
 #include "trackedvehicle.h"
 #include "WOLDiags.h"
 #include "packetmgr.h"
+#include "netthread.h"
+#include "networkobjectdelta.h"
 #include "requestkillevent.h"
 #include "csconsolecommandevent.h"
 #include "apppacketstats.h"
@@ -785,6 +799,753 @@ public:
 	}
 };
 
+class PhysIslandsConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "phys_islands"; }
+	virtual	const char * Get_Help( void ) override	{ return "PHYS_ISLANDS - toggles timestepping independent physics islands on the job pool, shows and resets the island stats."; }
+	virtual	void Activate( const char * /* input */ ) override {
+
+		const PhysicsSceneClass::IslandStatsStruct & stats = COMBAT_SCENE->Get_Island_Stats();
+		if (stats.StepCount > 0) {
+			Print("%d steps, %.1f islands (%.1f parallel), %.1f objects (%.1f parallel) per step, largest island %d\n",
+				stats.StepCount,
+				(float)stats.IslandCount / stats.StepCount,
+				(float)stats.ParallelIslandCount / stats.StepCount,
+				(float)stats.ObjectCount / stats.StepCount,
+				(float)stats.ParallelObjectCount / stats.StepCount,
+				stats.LargestIsland);
+		}
+		COMBAT_SCENE->Reset_Island_Stats();
+
+		COMBAT_SCENE->Enable_Island_Timestep(!COMBAT_SCENE->Is_Island_Timestep_Enabled());
+		if (COMBAT_SCENE->Is_Island_Timestep_Enabled()) {
+			Print("Physics islands are timestepped on the job pool (%d workers).\n",JobPoolClass::Get_Worker_Count());
+		} else {
+			Print("Physics objects are timestepped one at a time.\n");
+		}
+	}
+};
+
+class PhysFixedConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "phys_fixed"; }
+	virtual	const char * Get_Help( void ) override	{ return "PHYS_FIXED [rate [max_steps]] - toggles fixed rate physics timestepping (or sets the rate in steps per second and the catch-up limit), shows and resets the fixed step stats."; }
+	virtual	void Activate( const char * input ) override {
+
+		const PhysicsSceneClass::FixedStepStatsStruct & stats = COMBAT_SCENE->Get_Fixed_Step_Stats();
+		if (stats.UpdateCount > 0) {
+			Print("%d updates, %.2f steps per update (%d max), %d without a step, %d hit the catch-up limit dropping %.2f s\n",
+				stats.UpdateCount,
+				(float)stats.StepCount / stats.UpdateCount,
+				stats.MaxSteps,
+				stats.IdleCount,
+				stats.ClampCount,
+				stats.DroppedTime);
+		}
+		COMBAT_SCENE->Reset_Fixed_Step_Stats();
+
+		float rate = 0;
+		int max_steps = 0;
+		int count = (input != nullptr) ? sscanf(input, "%f %d", &rate, &max_steps) : 0;
+		if (count >= 1 && rate > 0) {
+			COMBAT_SCENE->Set_Fixed_Timestep(1.0f / rate);
+			if (count >= 2) {
+				COMBAT_SCENE->Set_Max_Catch_Up_Steps(max_steps);
+			}
+			COMBAT_SCENE->Enable_Fixed_Timestep(true);
+		} else {
+			COMBAT_SCENE->Enable_Fixed_Timestep(!COMBAT_SCENE->Is_Fixed_Timestep_Enabled());
+		}
+
+		if (COMBAT_SCENE->Is_Fixed_Timestep_Enabled()) {
+			Print("Physics is timestepped at %.1f steps per second, catching up at most %d steps per frame.\n",
+				1.0f / COMBAT_SCENE->Get_Fixed_Timestep(), COMBAT_SCENE->Get_Max_Catch_Up_Steps());
+		} else {
+			Print("Physics is timestepped by the frame time.\n");
+		}
+	}
+};
+
+class PhysSleepConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "phys_sleep"; }
+	virtual	const char * Get_Help( void ) override	{ return "PHYS_SLEEP [frames] - toggles taking resting physics objects out of the timestep (or sets how many frames they rest first), shows and resets the sleep counts."; }
+	virtual	void Activate( const char * input ) override {
+
+		Print("%d objects active, %d sleeping. %d went to sleep and %d woke up since the last check.\n",
+			COMBAT_SCENE->Get_Active_Object_Count(),
+			COMBAT_SCENE->Get_Sleeping_Object_Count(),
+			COMBAT_SCENE->Get_Sleep_Count(),
+			COMBAT_SCENE->Get_Wake_Count());
+		COMBAT_SCENE->Reset_Sleep_Counts();
+
+		int frames = 0;
+		if (input != nullptr && sscanf(input, "%d", &frames) == 1 && frames > 0) {
+			COMBAT_SCENE->Set_Sleep_Frames(frames);
+			COMBAT_SCENE->Enable_Object_Sleeping(true);
+		} else {
+			COMBAT_SCENE->Enable_Object_Sleeping(!COMBAT_SCENE->Is_Object_Sleeping_Enabled());
+		}
+
+		if (COMBAT_SCENE->Is_Object_Sleeping_Enabled()) {
+			Print("Physics objects go to sleep after %d frames at rest.\n",COMBAT_SCENE->Get_Sleep_Frames());
+		} else {
+			Print("Physics objects are always timestepped.\n");
+		}
+	}
+};
+
+class MixBenchConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "mix_bench"; }
+	virtual	const char * Get_Help( void ) override	{ return "MIX_BENCH [mix_file] - loads every file in a mix file (the current map by default) with and without memory mapping, and shows the file system calls and time taken."; }
+	virtual	void Activate( const char * input ) override {
+
+		StringClass mix_name(input, true);
+		if (mix_name.Is_Empty() && The_Game() != nullptr) {
+			mix_name = The_Game()->Get_Map_Name();
+		}
+		if (mix_name.Is_Empty()) {
+			Print("No mix file given.\n");
+			return;
+		}
+
+		bool was_enabled = MixFileFactoryClass::Is_Mapping_Enabled();
+		DynamicVectorClass<char> buffer;
+
+		//
+		//	Each mode is run twice and the second run reported, so both are timed
+		//	with the mix file already in the OS file cache.
+		//
+		for (int mode = 0; mode < 4; mode++) {
+			bool mapped = (mode & 2) != 0;
+			MixFileFactoryClass::Enable_Mapping(mapped);
+
+			unsigned int calls = RawFileClass::Get_System_Call_Count();
+			auto start = std::chrono::steady_clock::now();
+
+			MixFileFactoryClass factory(mix_name, &RenegadeBaseFileFactory);
+			DynamicVectorClass<StringClass> names;
+			if (!factory.Is_Valid() || !factory.Build_Filename_List(names)) {
+				Print("Unable to read %s.\n", mix_name.Peek_Buffer());
+				break;
+			}
+
+			//
+			//	Load every entry the way the asset loaders do
+			//
+			int bytes = 0;
+			for (int index = 0; index < names.Count(); index++) {
+				FileClass * file = factory.Get_File(names[index]);
+				if (file != nullptr && file->Is_Available()) {
+					file->Open();
+					int size = file->Size();
+					if (size > 0) {
+						if (buffer.Length() < size) {
+							buffer.Resize(size);
+						}
+						bytes += file->Read(&buffer[0], size);
+					}
+					file->Close();
+				}
+				factory.Return_File(file);
+			}
+
+			if (mode & 1) {
+				double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+				Print("%s: %d files, %.1f MB, %u file system calls, %.1f ms (%s)\n",
+					mapped ? "Mapped" : "Unmapped",
+					names.Count(),
+					bytes / (1024.0f * 1024.0f),
+					RawFileClass::Get_System_Call_Count() - calls,
+					ms,
+					factory.Is_Mapped() ? "mapped" : "not mapped");
+			}
+		}
+
+		MixFileFactoryClass::Enable_Mapping(was_enabled);
+	}
+};
+
+class PreloadStatsConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "preload_stats"; }
+	virtual	const char * Get_Help( void ) override	{ return "PRELOAD_STATS [on|off] - shows and resets the W3D preload times since the last call, optionally turning parallel loading on or off for the next level load."; }
+	virtual	void Activate( const char * input ) override {
+
+		WW3DAssetManager * asset_mgr = WW3DAssetManager::Get_Instance();
+		const WW3DAssetManager::LoadStatsStruct & stats = asset_mgr->Get_Load_Stats();
+		if (stats.FileCount > 0) {
+			Print("%d files: %d trees and %d anims parsed on %d workers, %d chunks loaded serially.\n",
+				stats.FileCount,
+				stats.TreeCount,
+				stats.AnimCount,
+				JobPoolClass::Get_Worker_Count(),
+				stats.SerialChunkCount);
+			Print("Read %.1f ms, anims %.1f ms, serial %.1f ms, total %.1f ms.\n",
+				stats.ReadTime,
+				stats.AnimTime,
+				stats.SerialTime,
+				stats.TotalTime);
+		}
+		asset_mgr->Reset_Load_Stats();
+
+		if (stricmp(input,"on") == 0) {
+			asset_mgr->Enable_Parallel_Loading(true);
+		} else if (stricmp(input,"off") == 0) {
+			asset_mgr->Enable_Parallel_Loading(false);
+		}
+		Print("Parallel loading %s.\n", asset_mgr->Is_Parallel_Loading_Enabled() ? "on" : "off");
+	}
+};
+
+class AssetCacheConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "asset_cache"; }
+	virtual	const char * Get_Help( void ) override	{ return "ASSET_CACHE [cache_file|off] - shows and resets the baked W3D asset cache hits, optionally opening another cache or turning it off."; }
+	virtual	void Activate( const char * input ) override {
+
+		WW3DAssetManager * asset_mgr = WW3DAssetManager::Get_Instance();
+		W3DCacheClass * cache = asset_mgr->Peek_Asset_Cache();
+		if (cache != nullptr) {
+			Print("%d files cached: %d loaded from the cache, %d out of date, %d not in the cache.\n",
+				cache->Get_File_Count(),
+				cache->Get_Hit_Count(),
+				cache->Get_Stale_Count(),
+				cache->Get_Miss_Count());
+			cache->Reset_Stats();
+		}
+
+		if (stricmp(input,"off") == 0) {
+			asset_mgr->Close_Asset_Cache();
+		} else if (*input != 0 && !asset_mgr->Open_Asset_Cache(input)) {
+			Print("Unable to open %s.\n", input);
+		}
+		Print("Asset cache %s.\n", asset_mgr->Peek_Asset_Cache() != nullptr ? "on" : "off");
+	}
+};
+
+class AnimBenchConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "anim_bench"; }
+	virtual	const char * Get_Help( void ) override	{ return "ANIM_BENCH [anim_name] - evaluates 100 skeletons per frame with and without batched poses, and shows the time taken per frame."; }
+	virtual	void Activate( const char * input ) override {
+
+		enum { SKELETON_COUNT = 100, FRAME_COUNT = 200 };
+
+		StringClass anim_name(input, true);
+		if (anim_name.Is_Empty()) {
+			anim_name = "S_A_HUMAN.H_A_A0A0";
+		}
+
+		HAnimClass * anim = WW3DAssetManager::Get_Instance()->Get_HAnim(anim_name);
+		if (anim == nullptr) {
+			Print("Unable to find %s.\n", anim_name.Peek_Buffer());
+			return;
+		}
+		HTreeClass * tree = WW3DAssetManager::Get_Instance()->Get_HTree(anim->Get_HName());
+		if (tree == nullptr) {
+			Print("Unable to find %s.\n", anim->Get_HName());
+			anim->Release_Ref();
+			return;
+		}
+
+		HTreeClass * skeletons[SKELETON_COUNT];
+		for (int index = 0; index < SKELETON_COUNT; index++) {
+			skeletons[index] = new HTreeClass(*tree);
+		}
+
+		bool was_enabled = HTreeClass::Are_Batched_Poses_Enabled();
+		float last_frame = (float)MAX(anim->Get_Num_Frames() - 1, 0);
+		double ms[2] = { 0, 0 };
+
+		//
+		//	Each mode is run twice and the second run reported.  Every skeleton is at a
+		//	different frame, and every other one blends two frames the way a soldier
+		//	changing animation does.
+		//
+		for (int mode = 0; mode < 4; mode++) {
+			bool batched = (mode & 2) != 0;
+			HTreeClass::Enable_Batched_Poses(batched);
+
+			auto start = std::chrono::steady_clock::now();
+
+			for (int frame = 0; frame < FRAME_COUNT; frame++) {
+				for (int index = 0; index < SKELETON_COUNT; index++) {
+					Matrix3D root(Vector3((float)index, 0, 0));
+					float frame0 = (last_frame > 0) ? fmodf(frame * 0.5f + index, last_frame) : 0;
+					if (index & 1) {
+						float frame1 = (last_frame > 0) ? fmodf(frame0 + 1.0f, last_frame) : 0;
+						skeletons[index]->Blend_Update(root, anim, frame0, anim, frame1, 0.5f);
+					} else {
+						skeletons[index]->Anim_Update(root, anim, frame0);
+					}
+				}
+			}
+
+			if (mode & 1) {
+				ms[batched ? 1 : 0] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / FRAME_COUNT;
+			}
+		}
+
+		//
+		//	Check the two modes agree
+		//
+		float max_error = 0;
+		Matrix3D root(1);
+		for (int index = 0; index < SKELETON_COUNT; index++) {
+			float frame0 = (last_frame > 0) ? fmodf((float)index, last_frame) : 0;
+			float frame1 = (last_frame > 0) ? fmodf(frame0 + 1.0f, last_frame) : 0;
+			HTreeClass::Enable_Batched_Poses(false);
+			skeletons[0]->Blend_Update(root, anim, frame0, anim, frame1, 0.25f);
+			HTreeClass::Enable_Batched_Poses(true);
+			skeletons[1]->Blend_Update(root, anim, frame0, anim, frame1, 0.25f);
+
+			for (int pivot = 0; pivot < tree->Num_Pivots(); pivot++) {
+				const Matrix3D & tm0 = skeletons[0]->Get_Transform(pivot);
+				const Matrix3D & tm1 = skeletons[1]->Get_Transform(pivot);
+				for (int row = 0; row < 3; row++) {
+					for (int col = 0; col < 4; col++) {
+						max_error = MAX(max_error, WWMath::Fabs(tm0[row][col] - tm1[row][col]));
+					}
+				}
+			}
+		}
+
+		Print("%d skeletons of %d pivots: %.3f ms per frame one pivot at a time, %.3f ms per frame batched, %.6f max difference\n",
+			SKELETON_COUNT,
+			tree->Num_Pivots(),
+			ms[0],
+			ms[1],
+			max_error);
+
+		HTreeClass::Enable_Batched_Poses(was_enabled);
+		for (int index = 0; index < SKELETON_COUNT; index++) {
+			delete skeletons[index];
+		}
+		anim->Release_Ref();
+	}
+};
+
+class AnimLodConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "anim_lod"; }
+	virtual	const char * Get_Help( void ) override	{ return "ANIM_LOD [on|off] - shows and resets the shared pose hits, optionally sharing poses snapped to whole frames or not."; }
+	virtual	void Activate( const char * input ) override {
+
+		Print("%d poses shared, %d poses decoded.\n",
+			HAnimPoseCacheClass::Get_Hit_Count(),
+			HAnimPoseCacheClass::Get_Miss_Count());
+		HAnimPoseCacheClass::Reset_Stats();
+
+		if (stricmp(input,"on") == 0) {
+			HAnimPoseCacheClass::Enable(true);
+			HAnimPoseCacheClass::Enable_Frame_Snap(true);
+		} else if (stricmp(input,"off") == 0) {
+			HAnimPoseCacheClass::Enable(false);
+			HAnimPoseCacheClass::Enable_Frame_Snap(false);
+		}
+		Print("Shared poses %s, frame snap %s.\n",
+			HAnimPoseCacheClass::Is_Enabled() ? "on" : "off",
+			HAnimPoseCacheClass::Is_Frame_Snap_Enabled() ? "on" : "off");
+	}
+};
+
+class PathStatsConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "path_stats"; }
+	virtual	const char * Get_Help( void ) override	{ return "PATH_STATS [max_paths] - shows and resets the path solver queue stats, optionally setting how many paths are solved at once."; }
+	virtual	void Activate( const char * input ) override {
+
+		const PathMgrClass::StatsStruct & stats = PathMgrClass::Get_Stats();
+		if (stats.PathsStarted > 0 && stats.PathsFinished > 0) {
+			Print("%d paths started, %d finished. Queue time %.1f ms average, %u ms max. Solve time %.1f ms average, %u ms max.\n",
+				stats.PathsStarted,
+				stats.PathsFinished,
+				(float)stats.TotalQueueTime / stats.PathsStarted,
+				stats.MaxQueueTime,
+				(float)stats.TotalSolveTime / stats.PathsFinished,
+				stats.MaxSolveTime);
+		}
+		Print("%d paths queued (%d max), %d in flight at most, %d lanes last frame.\n",
+			stats.QueueLength, stats.MaxQueueLength, stats.MaxPathsInFlight, stats.LanesUsed);
+		PathMgrClass::Reset_Stats();
+
+		PathfindClass * pathfind = PathfindClass::Get_Instance();
+		if (pathfind != nullptr) {
+			PathCorridorCacheClass & cache = pathfind->Get_Corridor_Cache();
+			PathCorridorCacheClass::StatsStruct cache_stats = cache.Get_Stats();
+			Print("%d clusters, %d links. Corridor cache %s: %d/%d hits (%.1f%%), %d fell back to a full search, %d unreachable, %d stored, %d evicted, %d cached.\n",
+				pathfind->Get_Cluster_Graph().Get_Cluster_Count(),
+				pathfind->Get_Cluster_Graph().Get_Link_Count(),
+				cache.Is_Enabled() ? "on" : "off",
+				cache_stats.Hits,
+				cache_stats.Lookups,
+				(cache_stats.Lookups > 0) ? (cache_stats.Hits * 100.0f / cache_stats.Lookups) : 0.0f,
+				cache_stats.Fallbacks,
+				cache_stats.Unreachable,
+				cache_stats.Stores,
+				cache_stats.Evictions,
+				cache.Get_Entry_Count());
+			cache.Reset_Stats();
+		}
+
+		int max_paths = 0;
+		if (input != nullptr && sscanf(input, "%d", &max_paths) == 1) {
+			PathMgrClass::Set_Max_Active_Paths(max_paths);
+		}
+		Print("Solving up to %d paths at once on the job pool (%d workers).\n",
+			PathMgrClass::Get_Max_Active_Paths(), JobPoolClass::Get_Worker_Count());
+	}
+};
+
+class PathBenchConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "path_bench"; }
+	virtual	const char * Get_Help( void ) override	{ return "PATH_BENCH [record | passes] - record toggles recording the path requests made while playing, otherwise the recorded requests are solved passes (default 5) times with the corridor cache off and on, and timed."; }
+	virtual	void Activate( const char * input ) override {
+
+		if (input != nullptr && strnicmp(input, "record", 6) == 0) {
+			if (PathMgrClass::Is_Request_Recording_Enabled()) {
+				PathMgrClass::Enable_Request_Recording(false);
+				Print("Stopped recording, %d path requests recorded.\n", PathMgrClass::Get_Recorded_Requests().Count());
+			} else {
+				PathMgrClass::Reset_Recorded_Requests();
+				PathMgrClass::Enable_Request_Recording(true);
+				Print("Recording path requests.\n");
+			}
+			return;
+		}
+
+		const DynamicVectorClass<PathMgrClass::RequestStruct> & requests = PathMgrClass::Get_Recorded_Requests();
+		if (requests.Count() == 0) {
+			Print("No path requests recorded, use path_bench record first.\n");
+			return;
+		}
+
+		int passes = 5;
+		if (input != nullptr) {
+			sscanf(input, "%d", &passes);
+		}
+		passes = std::max(passes, 1);
+
+		//
+		//	Don't record the requests we are replaying
+		//
+		bool was_recording = PathMgrClass::Is_Request_Recording_Enabled();
+		PathMgrClass::Enable_Request_Recording(false);
+
+		//
+		//	Solve everything with the corridor cache off, then again with it
+		// on (starting empty, so the first pass fills it).
+		//
+		PathCorridorCacheClass & cache = PathfindClass::Get_Instance()->Get_Corridor_Cache();
+		bool was_enabled = cache.Is_Enabled();
+		PathSolveClass * solver = new PathSolveClass;
+
+		for (int use_cache = 0; use_cache < 2; use_cache++) {
+			cache.Reset();
+			cache.Reset_Stats();
+			cache.Enable(use_cache != 0);
+
+			int solved = 0;
+			int failed = 0;
+			double nodes = 0;
+
+			std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+			for (int pass = 0; pass < passes; pass++) {
+				for (int i = 0; i < requests.Count(); i++) {
+					const PathMgrClass::RequestStruct & request = requests[i];
+					PathObjectClass path_object = request.PathObject;
+					solver->Set_Path_Object(path_object);
+					solver->Reset(request.StartPos, request.DestPos, request.SectorFudge);
+					solver->Process_Initial_Sector();
+					while (solver->Timestep(1000) == PathSolveClass::THINKING) ;
+
+					if (solver->Get_State() == PathSolveClass::SOLVED_PATH) {
+						solved++;
+					} else {
+						failed++;
+					}
+					nodes += solver->Get_Node_Count();
+				}
+			}
+			double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+			int total = solved + failed;
+			Print("Corridor cache %s, %d requests x %d passes: %d solved, %d failed, %.1f nodes per search\n",
+				use_cache ? "on" : "off", requests.Count(), passes, solved, failed, nodes / total);
+			Print("%.2f ms, %.0f solves/s\n", ms, total * 1000.0 / ms);
+
+			if (use_cache) {
+				PathCorridorCacheClass::StatsStruct cache_stats = cache.Get_Stats();
+				Print("%d/%d cache hits, %d fell back to a full search, %d unreachable\n",
+					cache_stats.Hits, cache_stats.Lookups, cache_stats.Fallbacks, cache_stats.Unreachable);
+			}
+		}
+
+		solver->Release_Ref();
+		cache.Reset();
+		cache.Reset_Stats();
+		cache.Enable(was_enabled);
+		PathMgrClass::Enable_Request_Recording(was_recording);
+	}
+};
+
+class VisCacheConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "vis_cache"; }
+	virtual	const char * Get_Help( void ) override	{ return "VIS_CACHE [budget_kb | full | prefetch seconds] - shows and resets the vis table cache stats, optionally setting the cache budget (0 releases tables a few frames after use), toggling full decompression or setting the prefetch time."; }
+	virtual	void Activate( const char * input ) override {
+
+		const VisTableMgrClass::CacheStatsStruct & stats = COMBAT_SCENE->Get_Vis_Cache_Stats();
+		int requests = stats.Hits + stats.Misses;
+		Print("%d/%d hits (%.1f%%), %d misses, %d prefetched, %d evicted, %.2f ms decompressing. %d tables (%d KB) cached.\n",
+			stats.Hits,
+			requests,
+			(requests > 0) ? (stats.Hits * 100.0f / requests) : 0.0f,
+			stats.Misses,
+			stats.Prefetches,
+			stats.Evictions,
+			stats.DecompressTime,
+			COMBAT_SCENE->Get_Vis_Cache_Table_Count(),
+			COMBAT_SCENE->Get_Vis_Cache_Bytes() / 1024);
+		COMBAT_SCENE->Reset_Vis_Cache_Stats();
+
+		int budget = 0;
+		float seconds = 0;
+		if (input != nullptr && stricmp(input, "full") == 0) {
+			COMBAT_SCENE->Enable_Vis_Full_Decompression(!COMBAT_SCENE->Is_Vis_Full_Decompression_Enabled());
+		} else if (input != nullptr && sscanf(input, "prefetch %f", &seconds) == 1) {
+			COMBAT_SCENE->Set_Vis_Prefetch_Time(seconds);
+		} else if (input != nullptr && sscanf(input, "%d", &budget) == 1) {
+			COMBAT_SCENE->Set_Vis_Cache_Budget(budget * 1024);
+		}
+
+		if (COMBAT_SCENE->Is_Vis_Full_Decompression_Enabled()) {
+			Print("All vis tables are kept decompressed.\n");
+		} else if (COMBAT_SCENE->Get_Vis_Cache_Budget() > 0) {
+			Print("Cache budget %d KB, prefetching %.1f s ahead.\n", COMBAT_SCENE->Get_Vis_Cache_Budget() / 1024, COMBAT_SCENE->Get_Vis_Prefetch_Time());
+		} else {
+			Print("No cache budget, tables are released a few frames after use. Prefetching %.1f s ahead.\n", COMBAT_SCENE->Get_Vis_Prefetch_Time());
+		}
+	}
+};
+
+class PhysIslandsCheckConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "phys_islands_check"; }
+	virtual	const char * Get_Help( void ) override	{ return "PHYS_ISLANDS_CHECK - toggles logging a per frame checksum of the physics transforms and counting island escapes."; }
+	virtual	void Activate( const char * /* input */ ) override {
+
+		COMBAT_SCENE->Enable_Island_Check(!COMBAT_SCENE->Is_Island_Check_Enabled());
+		if (COMBAT_SCENE->Is_Island_Check_Enabled()) {
+			Print("Physics island check enabled.\n");
+		} else {
+			Print("Physics island check disabled, last checksum %08X, %d escapes.\n",
+				COMBAT_SCENE->Get_Timestep_Checksum(),
+				COMBAT_SCENE->Get_Island_Stats().EscapeCount);
+		}
+	}
+};
+
+class RayBatchBenchConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "ray_batch_bench"; }
+	virtual	const char * Get_Help( void ) override	{ return "RAY_BATCH_BENCH [count] - casts count (default 10000) random bullet rays through the level one at a time and batched, compares the results and times."; }
+	virtual	void Activate( const char * input ) override {
+
+		int count = 10000;
+		if (input != nullptr) {
+			sscanf(input, "%d", &count);
+		}
+		if (count <= 0) {
+			Print("Nothing to cast.\n");
+			return;
+		}
+
+		/*
+		** Bullet sized rays from random points in the level in random directions
+		*/
+		Vector3 level_min, level_max;
+		COMBAT_SCENE->Get_Level_Extents(level_min, level_max);
+
+		RandomClass random(0x5eed);
+		LineSegClass * rays = new LineSegClass[count];
+		for (int i = 0; i < count; i++) {
+			Vector3 start;
+			start.X = level_min.X + (level_max.X - level_min.X) * random(0, 1000) / 1000.0f;
+			start.Y = level_min.Y + (level_max.Y - level_min.Y) * random(0, 1000) / 1000.0f;
+			start.Z = level_min.Z + (level_max.Z - level_min.Z) * random(0, 1000) / 1000.0f;
+
+			Vector3 dir(random(-1000, 1000) / 1000.0f, random(-1000, 1000) / 1000.0f, random(-1000, 1000) / 1000.0f);
+			if (dir.Length2() < WWMATH_EPSILON) {
+				dir.Set(1, 0, 0);
+			}
+			dir.Normalize();
+			rays[i].Set(start, start + dir * 100.0f);
+		}
+
+		CastResultStruct * single = new CastResultStruct[count];
+		CastResultStruct * batched = new CastResultStruct[count];
+		PhysRayCollisionTestClass ** tests = new PhysRayCollisionTestClass *[count];
+
+		/*
+		** One at a time
+		*/
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		int single_hits = 0;
+		for (int i = 0; i < count; i++) {
+			PhysRayCollisionTestClass raytest(rays[i], &(single[i]), BULLET_COLLISION_GROUP, COLLISION_TYPE_PROJECTILE);
+			if (COMBAT_SCENE->Cast_Ray(raytest)) {
+				single_hits++;
+			}
+		}
+		double single_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+		/*
+		** Batched, on this thread and then on the job pool
+		*/
+		double batch_ms[2];
+		int batch_hits[2];
+		int mismatches[2];
+		for (int pass = 0; pass < 2; pass++) {
+			for (int i = 0; i < count; i++) {
+				batched[i].Reset();
+				tests[i] = new PhysRayCollisionTestClass(rays[i], &(batched[i]), BULLET_COLLISION_GROUP, COLLISION_TYPE_PROJECTILE);
+			}
+
+			start_time = std::chrono::steady_clock::now();
+			batch_hits[pass] = COMBAT_SCENE->Cast_Rays(tests, count, pass == 1);
+			batch_ms[pass] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+			mismatches[pass] = 0;
+			for (int i = 0; i < count; i++) {
+				if (	(single[i].StartBad != batched[i].StartBad) ||
+						(WWMath::Fabs(single[i].Fraction - batched[i].Fraction) > WWMATH_EPSILON)) {
+					mismatches[pass]++;
+				}
+				delete tests[i];
+			}
+		}
+
+		Print("%d rays, %d hits: one at a time %.2f ms\n", count, single_hits, single_ms);
+		Print("batched %.2f ms (%d hits, %d mismatches), batched on %d workers %.2f ms (%d hits, %d mismatches)\n",
+			batch_ms[0], batch_hits[0], mismatches[0],
+			JobPoolClass::Get_Worker_Count(), batch_ms[1], batch_hits[1], mismatches[1]);
+
+		delete [] tests;
+		delete [] batched;
+		delete [] single;
+		delete [] rays;
+	}
+};
+
+class AABTreeBenchConsoleFunctionClass : public ConsoleFunctionClass
+{
+public:
+	virtual	const char * Get_Name( void ) override	{ return "aabtree_bench"; }
+	virtual	const char * Get_Help( void ) override	{ return "AABTREE_BENCH [count] - casts count (default 10000) random rays and boxes through the level walking the AAB-trees two and four nodes at a time, compares the results and times."; }
+	virtual	void Activate( const char * input ) override {
+
+		int count = 10000;
+		if (input != nullptr) {
+			sscanf(input, "%d", &count);
+		}
+		if (count <= 0) {
+			Print("Nothing to cast.\n");
+			return;
+		}
+
+		/*
+		** Bullet rays and character sized box sweeps from random points in the level
+		*/
+		Vector3 level_min, level_max;
+		COMBAT_SCENE->Get_Level_Extents(level_min, level_max);
+
+		RandomClass random(0x5eed);
+		LineSegClass * rays = new LineSegClass[count];
+		AABoxClass * boxes = new AABoxClass[count];
+		Vector3 * moves = new Vector3[count];
+		for (int i = 0; i < count; i++) {
+			Vector3 start;
+			start.X = level_min.X + (level_max.X - level_min.X) * random(0, 1000) / 1000.0f;
+			start.Y = level_min.Y + (level_max.Y - level_min.Y) * random(0, 1000) / 1000.0f;
+			start.Z = level_min.Z + (level_max.Z - level_min.Z) * random(0, 1000) / 1000.0f;
+
+			Vector3 dir(random(-1000, 1000) / 1000.0f, random(-1000, 1000) / 1000.0f, random(-1000, 1000) / 1000.0f);
+			if (dir.Length2() < WWMATH_EPSILON) {
+				dir.Set(1, 0, 0);
+			}
+			dir.Normalize();
+			rays[i].Set(start, start + dir * 100.0f);
+			boxes[i] = AABoxClass(start, Vector3(0.4f, 0.4f, 0.9f));
+			moves[i] = dir * 10.0f;
+		}
+
+		bool old_cull_wide = AABTreeCullSystemClass::Are_Wide_Nodes_Enabled();
+		bool old_mesh_wide = AABTreeClass::Are_Wide_Nodes_Enabled();
+
+		CastResultStruct * results[2];
+		double ray_ms[2];
+		double box_ms[2];
+		for (int pass = 0; pass < 2; pass++) {
+			AABTreeCullSystemClass::Enable_Wide_Nodes(pass == 1);
+			AABTreeClass::Enable_Wide_Nodes(pass == 1);
+			results[pass] = new CastResultStruct[count * 2];
+
+			std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+			for (int i = 0; i < count; i++) {
+				PhysRayCollisionTestClass raytest(rays[i], &(results[pass][i]), BULLET_COLLISION_GROUP, COLLISION_TYPE_PROJECTILE);
+				COMBAT_SCENE->Cast_Ray(raytest);
+			}
+			ray_ms[pass] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+			start_time = std::chrono::steady_clock::now();
+			for (int i = 0; i < count; i++) {
+				PhysAABoxCollisionTestClass boxtest(boxes[i], moves[i], &(results[pass][count + i]), DEFAULT_COLLISION_GROUP);
+				COMBAT_SCENE->Cast_AABox(boxtest);
+			}
+			box_ms[pass] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+		}
+
+		AABTreeCullSystemClass::Enable_Wide_Nodes(old_cull_wide);
+		AABTreeClass::Enable_Wide_Nodes(old_mesh_wide);
+
+		int mismatches = 0;
+		for (int i = 0; i < count * 2; i++) {
+			if (	(results[0][i].StartBad != results[1][i].StartBad) ||
+					(WWMath::Fabs(results[0][i].Fraction - results[1][i].Fraction) > WWMATH_EPSILON)) {
+				mismatches++;
+			}
+		}
+
+		Print("%d rays: two wide %.2f ms (%.0f casts/s), four wide %.2f ms (%.0f casts/s)\n",
+			count, ray_ms[0], count * 1000.0 / ray_ms[0], ray_ms[1], count * 1000.0 / ray_ms[1]);
+		Print("%d boxes: two wide %.2f ms (%.0f casts/s), four wide %.2f ms (%.0f casts/s), %d mismatches\n",
+			count, box_ms[0], count * 1000.0 / box_ms[0], box_ms[1], count * 1000.0 / box_ms[1], mismatches);
+
+		delete [] results[1];
+		delete [] results[0];
+		delete [] moves;
+		delete [] boxes;
+		delete [] rays;
+	}
+};
+
 class Phys3NetConsoleFunctionClass : public ConsoleFunctionClass
 {
 public:
@@ -1948,6 +2709,62 @@ public:
 
 
 
+class TogglePacketBatchConsoleFunctionClass : public ConsoleFunctionClass {
+public:
+   virtual	const char * Get_Name( void ) override		{ return "packet_batch"; }
+	virtual	const char * Get_Help( void ) override		{ return "packet_batch - toggle batched socket sends and receives."; }
+
+	virtual	void Activate( const char * ) override {
+		bool batch = PacketManager.Toggle_Batch_IO();
+
+		if (batch) {
+			Print("Datagrams are sent and received in batches.\n");
+		} else {
+			Print("Datagrams are sent and received one at a time.\n");
+		}
+	}
+};
+
+
+
+class ToggleNetThreadConsoleFunctionClass : public ConsoleFunctionClass {
+public:
+   virtual	const char * Get_Name( void ) override		{ return "net_thread"; }
+	virtual	const char * Get_Help( void ) override		{ return "net_thread - toggle servicing the sockets on a separate network thread."; }
+
+	virtual	void Activate( const char * ) override {
+		if (NetworkThreadClass::Is_Running()) {
+			NetworkThreadClass::Stop();
+			Print("Sockets are serviced once per game tick.\n");
+		} else {
+			NetworkThreadClass::Start();
+			Print("Sockets are serviced by the network thread.\n");
+		}
+	}
+};
+
+
+
+class NetJitterConsoleFunctionClass : public ConsoleFunctionClass {
+public:
+   virtual	const char * Get_Name( void ) override		{ return "net_jitter"; }
+	virtual	const char * Get_Help( void ) override		{ return "net_jitter - show and reset the time between socket services."; }
+
+	virtual	void Activate( const char * ) override {
+		static const char * mode_names[NetworkThreadClass::MODE_COUNT] = { "game thread", "network thread" };
+
+		for (int mode = 0; mode < NetworkThreadClass::MODE_COUNT; mode++) {
+			NetworkThreadClass::ServiceStatsStruct stats;
+			NetworkThreadClass::Get_Service_Stats((NetworkThreadClass::MODE)mode, stats);
+			Print("%-15s %6d services, mean %6.2f ms, jitter %6.2f ms, max %6.2f ms\n",
+				mode_names[mode], stats.Samples, stats.MeanMs, stats.JitterMs, stats.MaxMs);
+		}
+		NetworkThreadClass::Reset_Service_Stats();
+	}
+};
+
+
+
 class TogglePacketOptConsoleFunctionClass : public ConsoleFunctionClass {
 public:
    virtual	const char * Get_Name( void ) override		{ return "packet_opt"; }
@@ -4356,6 +5173,58 @@ public:
 	}
 };
 
+class ParallelTCADOConsoleFunctionClass : public ConsoleFunctionClass {
+public:
+	virtual	const char * Get_Name( void ) override	{ return "paralleltcado"; }
+	virtual	const char * Get_Help( void ) override	{ return "paralleltcado - Toggle building client updates on the job pool"; }
+	virtual	void Activate( const char * /* input */ ) override {
+		bool is_parallel = cDevOptions::UseParallelTCADO.Toggle();
+      Print(is_parallel ? "Using parallel TCADO.\n" : "Using serial TCADO.\n" );
+	}
+};
+
+class RelevanceGridConsoleFunctionClass : public ConsoleFunctionClass {
+public:
+	virtual	const char * Get_Name( void ) override	{ return "relevancegrid"; }
+	virtual	const char * Get_Help( void ) override	{ return "relevancegrid - Toggle skipping of objects outside the relevance radius"; }
+	virtual	void Activate( const char * /* input */ ) override {
+		bool is_enabled = cDevOptions::UseRelevanceGrid.Toggle();
+      Print(is_enabled ? "Relevance grid enabled.\n" : "Relevance grid disabled.\n" );
+	}
+};
+
+class DeltaReplicationConsoleFunctionClass : public ConsoleFunctionClass {
+public:
+	virtual	const char * Get_Name( void ) override	{ return "deltareplication"; }
+	virtual	const char * Get_Help( void ) override	{ return "deltareplication - Toggle delta coding of frequent updates against the client's acked state"; }
+	virtual	void Activate( const char * /* input */ ) override {
+		bool is_enabled = cDevOptions::UseDeltaReplication.Toggle();
+      Print(is_enabled ? "Delta replication enabled.\n" : "Delta replication disabled.\n" );
+	}
+};
+
+class DeltaRecordConsoleFunctionClass : public ConsoleFunctionClass {
+public:
+	virtual	const char * Get_Name( void ) override	{ return "delta_record"; }
+	virtual	const char * Get_Help( void ) override	{ return "DELTA_RECORD [<client id> <filename>] - record the frequent updates sent to a client, no arguments stops."; }
+	virtual	void Activate( const char * input ) override {
+		int client_id = 0;
+		char filename[256];
+		if (sscanf(input, "%d %255s", &client_id, filename) == 2) {
+			if (NetworkObjectDeltaClass::Start_Recording(filename, client_id)) {
+				Print("Recording updates for client %d to %s.\n", client_id, filename);
+			} else {
+				Print("Unable to record to %s.\n", filename);
+			}
+		} else if (NetworkObjectDeltaClass::Is_Recording()) {
+			NetworkObjectDeltaClass::Stop_Recording();
+			Print("Recording stopped.\n");
+		} else {
+			Print("%s\n", Get_Help());
+		}
+	}
+};
+
 
 class TimeOfDayConsoleFunctionClass : public ConsoleFunctionClass {
 public:
@@ -5032,6 +5901,20 @@ void	ConsoleFunctionManager::Init( void )
 	FunctionList.Add( new OpenConsoleFunctionClass() );
 	FunctionList.Add( new Phys3NetConsoleFunctionClass() );
 	FunctionList.Add( new PhysicsDebugConsoleFunctionClass() );
+	FunctionList.Add( new PhysIslandsConsoleFunctionClass() );
+	FunctionList.Add( new PhysIslandsCheckConsoleFunctionClass() );
+	FunctionList.Add( new PhysFixedConsoleFunctionClass() );
+	FunctionList.Add( new PhysSleepConsoleFunctionClass() );
+	FunctionList.Add( new MixBenchConsoleFunctionClass() );
+	FunctionList.Add( new PreloadStatsConsoleFunctionClass() );
+	FunctionList.Add( new AssetCacheConsoleFunctionClass() );
+	FunctionList.Add( new AnimBenchConsoleFunctionClass() );
+	FunctionList.Add( new AnimLodConsoleFunctionClass() );
+	FunctionList.Add( new RayBatchBenchConsoleFunctionClass() );
+	FunctionList.Add( new AABTreeBenchConsoleFunctionClass() );
+	FunctionList.Add( new PathStatsConsoleFunctionClass() );
+	FunctionList.Add( new PathBenchConsoleFunctionClass() );
+	FunctionList.Add( new VisCacheConsoleFunctionClass() );
 	FunctionList.Add( new PlayerPositionConsoleFunctionClass() );
 	FunctionList.Add( new ProfileCollectBeginConsoleFunctionClass() );
 	FunctionList.Add( new ProfileCollectEndConsoleFunctionClass() );
@@ -5130,11 +6013,18 @@ void	ConsoleFunctionManager::Init( void )
 	FunctionList.Add( new SetSendFrequencyConsoleFunctionClass() );
 	FunctionList.Add( new TogglePacketDeltasConsoleFunctionClass() );
 	FunctionList.Add( new TogglePacketComboConsoleFunctionClass() );
+	FunctionList.Add( new TogglePacketBatchConsoleFunctionClass() );
+	FunctionList.Add( new ToggleNetThreadConsoleFunctionClass() );
+	FunctionList.Add( new NetJitterConsoleFunctionClass() );
 	FunctionList.Add( new TogglePacketOptConsoleFunctionClass() );
 	FunctionList.Add( new SetLatencyConsoleFunctionClass() );
 	FunctionList.Add( new ToggleNewClientUpdateMethodConsoleFunctionClass() );
 	FunctionList.Add( new ToggleBandwidthBalancerConsoleFunctionClass() );
 	FunctionList.Add( new NewTCADOConsoleFunctionClass() );
+	FunctionList.Add( new ParallelTCADOConsoleFunctionClass() );
+	FunctionList.Add( new RelevanceGridConsoleFunctionClass() );
+	FunctionList.Add( new DeltaReplicationConsoleFunctionClass() );
+	FunctionList.Add( new DeltaRecordConsoleFunctionClass() );
 
    FunctionList.Add( new DebugDeviceConsoleFunctionClass() );
 	FunctionList.Add( new StatsConsoleFunctionClass() );
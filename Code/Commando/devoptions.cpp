@@ -128,6 +128,9 @@
    cRegistryBool cDevOptions::CompareExeVersionOnNetwork(	APPLICATION_SUB_KEY_NAME_DEBUG,	"CompareExeVersionOnNetwork",		true);
 
 	cRegistryBool cDevOptions::UseNewTCADO(						APPLICATION_SUB_KEY_NAME_DEBUG,	"NewTCADO",								true);
+	cRegistryBool cDevOptions::UseParallelTCADO(				APPLICATION_SUB_KEY_NAME_DEBUG,	"ParallelTCADO",						false);
+	cRegistryBool cDevOptions::UseRelevanceGrid(				APPLICATION_SUB_KEY_NAME_DEBUG,	"RelevanceGrid",						true);
+	cRegistryBool cDevOptions::UseDeltaReplication(			APPLICATION_SUB_KEY_NAME_DEBUG,	"DeltaReplication",					false);
    cRegistryBool cDevOptions::ShowFps(								APPLICATION_SUB_KEY_NAME_NETDEBUG, "ShowFps",							false);
 
 
@@ -153,6 +153,15 @@ class cDevOptions
 	// TEMP. ST - 12/10/2001 3:39PM
 	static cRegistryBool UseNewTCADO;
 
+	// Build the per-client update lists on the job pool (needs UseNewTCADO).
+	static cRegistryBool UseParallelTCADO;
+
+	// Skip priority work for objects outside the client's relevance radius.
+	static cRegistryBool UseRelevanceGrid;
+
+	// Delta code frequent updates against the state each client last acked.
+	static cRegistryBool UseDeltaReplication;
+
    private:
 
 };
@@ -52,6 +52,8 @@
 #include "packetmgr.h"
 #include "apppacketstats.h"
 #include "connect.h"
+#include "wwpacket.h"
+#include "networkobjectdelta.h"
 #include "wwprofile.h"
 #include "vehicle.h"
 #include "csdamageevent.h"
@@ -358,8 +360,20 @@ void cDiagnostics::Render(void)
 		if (cNetwork::I_Am_Server()) {
 			Add_Diagnostic("NetToCombatRatio:   %-5.2f", cSbboManager::Get_Net_To_Combat_Ratio());
 			Add_Diagnostic("ThinkCount:         %d", cNetwork::Get_Think_Count());
+			Add_Diagnostic("RelevanceSkipped:   %d", NetworkObjectMgrClass::Get_Relevance_Skipped_Pairs());
 		}
 
+		BitPackerBufferStatsStruct buffer_stats;
+		cPacket::Get_Buffer_Stats(buffer_stats);
+		Add_Diagnostic("PktBuffers:         alloc %u reuse %u share %u copy %u grow %u",
+			buffer_stats.Allocations, buffer_stats.Reuses, buffer_stats.Shares, buffer_stats.Copies, buffer_stats.Grows);
+
+		NetworkObjectDeltaClass::StatsStruct delta_stats;
+		NetworkObjectDeltaClass::Get_Stats(delta_stats);
+		Add_Diagnostic("DeltaRepl:          full %u delta %u bits %u/%u acks %u lost %u",
+			delta_stats.FullUpdates, delta_stats.DeltaUpdates, delta_stats.SentBits, delta_stats.RawBits,
+			delta_stats.AcksReceived, delta_stats.Undecodable);
+
 		Add_Diagnostic("I_Am_Client:        %d",		cNetwork::I_Am_Client());
 		Add_Diagnostic("I_Am_Server:        %d",		cNetwork::I_Am_Server());
 		Add_Diagnostic("NetUpdateRate:      %d",		cUserOptions::NetUpdateRate.Get());
@@ -90,6 +90,7 @@
 #include "ini.h"
 #include "dazzle.h"
 #include "scriptman.h"
+#include "hanimpose.h"
 
 
 
@@ -326,6 +327,9 @@ GameInitMgrClass::End_Game (void)
 		}
 	}
 
+	HAnimPoseCacheClass::Enable(false);
+	HAnimPoseCacheClass::Enable_Frame_Snap(false);
+
    if (GameModeManager::Find( "Combat" )->Is_Active()) {
       //
       // Combat is still active during the ingame menu and multiplayer gameplay.
@@ -575,6 +579,7 @@ GameInitMgrClass::Start_Client_Server (void)
 	if (IsServerRequired && !cNetwork::I_Am_Server ()) {
 		cNetwork::Init_Server ();
 		PacketManager.Set_Is_Server(true);
+		PacketManager.Set_Batch_IO(true);
 
 		//
 		// Dedicated server disables playing of sfx & music
@@ -591,6 +596,15 @@ GameInitMgrClass::Start_Client_Server (void)
 				RestoreMusic = true;
 			}
 		}
+
+		//
+		// A dedicated server only needs skeletons for hit boxes, so soldiers and vehicles
+		// share decoded poses, snapped to whole frames.
+		//
+		if (IsClientRequired == false) {
+			HAnimPoseCacheClass::Enable(true);
+			HAnimPoseCacheClass::Enable_Frame_Snap(true);
+		}
 	}
 
 	//
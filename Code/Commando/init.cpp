@@ -114,6 +114,7 @@
 #include "specialbuilds.h"
 #include "wwdialog.h"
 #include "debugbreak.h"
+#include "jobpool.h"
 #include <cstdio>
 
 extern const char *VALUE_NAME_TEXTURE_FILTER_MODE;
@@ -835,8 +836,14 @@ bool Game_Init(void)
 	asset_manager->Register_Prototype_Loader (&_SoundRenderObjLoader);
 	asset_manager->Set_Activate_Fog_On_Load (true);
 
+	// Load W3D files from the baked asset cache when it is up to date with them
+	asset_manager->Open_Asset_Cache ("Always.w3c");
+
 	//GameSettings::Init();
 
+	// Start the worker threads shared by the parallel update paths
+	JobPoolClass::Init();
+
 	// Initialize WWMath
 	WWMath::Init();
 
@@ -63,6 +63,7 @@
 #include "colors.h"
 #include "networkobject.h"
 #include "building.h"
+#include "vehicle.h"
 #include "vendor.h"
 #include "networkobjectfactorymgr.h"
 #include "networkobjectfactory.h"
@@ -70,6 +71,7 @@
 #include "cstextobj.h"
 #include "loadingevent.h"
 #include "clientcontrol.h"
+#include "clientdeltaack.h"
 #include "wwprofile.h"
 #include "changeteamevent.h"
 #include "DlgMPTeamSelect.h"
@@ -86,6 +88,9 @@
 #include "dlgcncwinscreen.h"
 #include "ConsoleMode.h"
 #include "CDKeyAuth.h"
+#include "jobpool.h"
+#include "networkobjectsnapshot.h"
+#include "networkobjectdelta.h"
 
 static int LastSortedSecond;
 
@@ -527,7 +532,6 @@ if (cDevOptions::UseNewTCADO.Is_False()) {
 			pvs = COMBAT_SCENE->Get_Vis_Table(dest_pos);
 		}
 	}
-	count = NetworkObjectMgrClass::Get_Object_Count();
 
 	/*
 	** List of objects requiring frequent updates.
@@ -538,13 +542,49 @@ if (cDevOptions::UseNewTCADO.Is_False()) {
 
 	SoldierGameObj * player_ptr = GameObjManager::Find_Soldier_Of_Client_ID(client_id);
 
+	/*
+	** Decompress the vis tables of the sectors the player is heading into so they're ready by the time we need them.
+	*/
+	if (player_ptr != nullptr) {
+		WWPROFILE("PrefetchVis");
+		Vector3 velocity;
+		if (player_ptr->Is_In_Vehicle()) {
+			player_ptr->Get_Vehicle()->Get_Velocity(velocity);
+		} else {
+			player_ptr->Get_Velocity(velocity);
+		}
+		COMBAT_SCENE->Prefetch_Vis_Tables(dest_pos, velocity);
+	}
+
+	/*
+	** Objects outside the relevance radius can never get a non zero priority so don't bother working it out when
+	** it's time to update the priorities. Guaranteed updates, hints and the player himself are still handled for
+	** every object, and in between updates everybody keeps their cached priority.
+	*/
+	static NetworkObjectMgrClass::RelevantSetClass relevant_set;
+	bool use_relevance_grid = update_priorities && cDevOptions::UseRelevanceGrid.Is_True();
+	int skipped_pairs = 0;
+	if (use_relevance_grid) {
+		WWPROFILE("Relevance");
+		NetworkObjectMgrClass::Collect_Relevant_Objects(dest_pos, cPriority::Get_Relevance_Radius(), relevant_set);
+	}
+
+	/*
+	** Only objects with dirty bits for this client can have anything to send, so just look at those. Sending clears
+	** bits and takes objects off the worklist, that's why we work on a copy.
+	*/
+	static DynamicVectorClass<int> dirty_list(500);
+	NetworkObjectMgrClass::Collect_Dirty_Objects(client_id, dirty_list);
+	count = dirty_list.Count();
+
 	{
 		WWPROFILE("ListBuild");
 		/*
-		** Go through the object list once and figure out all the priorities.
+		** Go through the dirty objects once and figure out all the priorities.
 		*/
-		for (int index = 0; index < count; index ++) {
+		for (int dirty_index = 0; dirty_index < count; dirty_index ++) {
 
+			int index = dirty_list[dirty_index];
 			NetworkObjectClass * p_object = NetworkObjectMgrClass::Get_Object(index);
 
 			if (p_object == nullptr) {
@@ -553,6 +593,8 @@ if (cDevOptions::UseNewTCADO.Is_False()) {
 
 			float priority = 0.0f;
 
+			bool is_relevant = !use_relevance_grid || relevant_set.Is_Relevant(index);
+
 			/*
 			** SERVERFPS events are low priority but must have some kind of priority.
 			*/
@@ -607,6 +649,9 @@ if (cDevOptions::UseNewTCADO.Is_False()) {
 							if (p_object->Get_Client_Hint_Count(client_id) > 0) {
 								priority = 1.0f;
 								p_object->Reset_Client_Hint_Count(client_id);
+							} else if (!is_relevant) {
+								priority = 0.0f;
+								skipped_pairs++;
 							} else {
 
 								/*
@@ -835,10 +880,493 @@ if (cDevOptions::UseNewTCADO.Is_False()) {
 		REF_PTR_RELEASE(pvs);
 	}
 
+	NetworkObjectMgrClass::Add_Relevance_Skipped_Pairs(skipped_pairs);
+}
+
+#endif // not BETACLIENT
+}
+
+//-----------------------------------------------------------------------------
+//
+// Parallel TCADO.
+//
+// Same filtering and bandwidth rules as the optimized TCADO above, but run for
+// all clients at once. Object state is frozen in a NetworkObjectSnapshotClass so
+// each tier is exported only once per tick, the per-client lists and packets are
+// built on the job pool, and the packets are then sent from the main thread in
+// client order so the wire output matches calling Tell_Client_About_Dynamic_Objects
+// for each client in turn.
+//
+// Workers only write the per-client slots of the network objects (cached priority,
+// update rate, last update time and hint count) for their own client. Everything
+// else - vis tables, remote host state, dirty bit clearing and sending - stays on
+// the main thread.
+//
+#ifndef BETACLIENT
+
+struct TCADOSendStruct
+{
+	int			ObjectIndex;	// Index into the snapshot
+	BYTE			DirtyBits;
+	int			Mode;
+	bool			HasData;
+	cPacket *	Packet;
+	int			TierBits[PACKET_TIER_COUNT];	// Bits each tier took up in the packet
+
+	bool operator== (const TCADOSendStruct & src)	{ return ObjectIndex == src.ObjectIndex && DirtyBits == src.DirtyBits && Packet == src.Packet; }
+	bool operator!= (const TCADOSendStruct & src)	{ return !(*this == src); }
+};
+
+struct TCADOClientStruct
+{
+	int											ClientID;
+	Vector3										DestPos;
+	cRemoteHost *								RHost;
+	VisTableClass *							Pvs;
+	SoldierGameObj *							Player;
+	bool											PlayerInVehicle;
+	bool											UpdatePriorities;
+	int											BitsPerSecond;
+	float											BandwidthMultiplier;
+	unsigned int								Time;
+
+	float											AveragePriority;
+	int											SkippedPairs;
+	NetworkObjectMgrClass::RelevantSetClass	RelevantSet;
+	DynamicVectorClass<int>					DirtyList;
+	DynamicVectorClass<int>					ObjectList;
+	DynamicVectorClass<TCADOSendStruct>	SendList;
+};
+
+static NetworkObjectSnapshotClass	_TCADOSnapshot;
+static TCADOClientStruct				_TCADOClients[NetworkObjectClass::MAX_CLIENT_COUNT];
+static int									_TCADOClientCount = 0;
+static int									_TCADONetUpdateRate = 1;
+
+
+//-----------------------------------------------------------------------------
+//
+// Build the update packet for one object and queue it for sending. Returns the
+// number of bits that will go out, like Send_Object_Update.
+//
+static int Queue_Object_Update(TCADOClientStruct & client, int index, BYTE dirty_bits)
+{
+	TCADOSendStruct send;
+	send.ObjectIndex = index;
+	send.DirtyBits = dirty_bits;
+	send.Packet = new cPacket;
+	send.HasData = _TCADOSnapshot.Build_Update_Packet(index, dirty_bits, *send.Packet, send.Mode, client.ClientID, send.TierBits);
+	client.SendList.Add(send);
+
+	return(send.HasData ? (int)send.Packet->Get_Bit_Write_Position() : 0);
+}
+
+
+//-----------------------------------------------------------------------------
+//
+// Frequent export sizes are shared between clients so work them out up front
+// rather than letting the workers race on them.
+//
+static void Update_Frequent_Export_Sizes(void)
+{
+	cPacket header;
+	header.Add((int)0);
+	header.Add((BYTE)0);
+	header.Add(false);
+	int header_bits = header.Get_Bit_Write_Position();
+
+	for (int index = 0; index < _TCADOSnapshot.Get_Object_Count(); index ++) {
+		const NetworkObjectSnapshotClass::ObjectStruct & entry = _TCADOSnapshot.Get_Object(index);
+		if (!entry.HasTier[PACKET_TIER_FREQUENT] || entry.Object->Get_Frequent_Update_Export_Size() != 0) {
+			continue;
+		}
+
+		int frequent_bits = entry.TierBits[PACKET_TIER_FREQUENT];
+		if (frequent_bits > 0) {
+			int packet_size = (header_bits + frequent_bits) / 8;
+			packet_size += cPacket::Get_Packet_Header_Size();
+			entry.Object->Set_Frequent_Update_Export_Size(static_cast<unsigned char>(packet_size));
+		} else {
+			/*
+			** For some reason, some objects have a frequent bit set but there is no frequent update export.
+			*/
+			entry.Object->Set_Frequent_Update_Export_Size(0xff);
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+//
+// Worker side of the parallel TCADO. Mirrors the optimized serial version.
+//
+static void Build_Client_Update_List(TCADOClientStruct & client)
+{
+	const unsigned char dirty_check = (NetworkObjectClass::BIT_FREQUENT ^ 0xffffffff) & (NetworkObjectClass::BIT_CREATION | NetworkObjectClass::BIT_RARE | NetworkObjectClass::BIT_OCCASIONAL);
+
+	int client_id = client.ClientID;
+	unsigned int time = client.Time;
+	bool global_packet_allowance_full = false;
+	int bits_per_second = client.BitsPerSecond;
+
+	float min_vis_distance = 15.0f;
+	if (bits_per_second > 60000) {
+		min_vis_distance = 50.0f;
+	}
+
+	int bytes_per_second = bits_per_second >> 3;
+	int net_update_rate = _TCADONetUpdateRate;
+	int avail_bytes_per_update = bytes_per_second / net_update_rate;
+
+	unsigned int bytes_out = 0;
+	unsigned int max_bytes = avail_bytes_per_update;
+	int global_count = 0;
+
+	DynamicVectorClass<int> & object_list = client.ObjectList;
+	object_list.Reset_Active();
+	client.SendList.Reset_Active();
+
+	/*
+	** Relevance only matters when it's time to update the priorities, in between everybody keeps their cached priority.
+	*/
+	bool use_relevance_grid = client.UpdatePriorities && cDevOptions::UseRelevanceGrid.Is_True();
+	client.SkippedPairs = 0;
+	if (use_relevance_grid) {
+		NetworkObjectMgrClass::Collect_Relevant_Objects(client.DestPos, cPriority::Get_Relevance_Radius(), client.RelevantSet);
+	}
+
+	/*
+	** Snapshot indices match the object manager's, so the dirty worklist can be used as is.
+	*/
+	DynamicVectorClass<int> & dirty_list = client.DirtyList;
+	NetworkObjectMgrClass::Collect_Dirty_Objects(client_id, dirty_list);
+
+	for (int dirty_index = 0; dirty_index < dirty_list.Count(); dirty_index ++) {
+
+		int index = dirty_list[dirty_index];
+		const NetworkObjectSnapshotClass::ObjectStruct & entry = _TCADOSnapshot.Get_Object(index);
+		NetworkObjectClass * p_object = entry.Object;
+		float priority = 0.0f;
+
+		bool is_relevant = !use_relevance_grid || client.RelevantSet.Is_Relevant(index);
+
+		if (entry.AppPacketType == APPPACKETTYPE_SERVERFPS) {
+			priority = 0.05f;
+			p_object->Set_Cached_Priority_2(client_id, priority);
+			object_list.Add(index);
+			continue;
+		}
+
+		unsigned char dirty = p_object->Get_Object_Dirty_Bits(client_id);
+
+		if (dirty & dirty_check) {
+			if (!global_packet_allowance_full || entry.AppPacketType == APPPACKETTYPE_CLIENTBBOEVENT) {
+				bytes_out += (Queue_Object_Update(client, index, dirty) >> 3);
+				p_object->Set_Last_Update_Time(client_id, time);
+			}
+			global_count++;
+
+			if (!global_packet_allowance_full && bytes_out > max_bytes) {
+#ifdef WWDEBUG
+				if (cDevOptions::ExtraNetDebug.Is_True()) {
+					WWDEBUG_SAY(("*** WARNING: Tell_Clients_About_Dynamic_Objects - Insufficient bandwidth to send all guaranteed packets to client %d ***\n", client_id));
+					WWDEBUG_SAY(("*** After %d objects, bytes_out = %d, max_bytes = %d\n", global_count, bytes_out, max_bytes));
+				}
+#endif //WWDEBUG
+				global_packet_allowance_full = true;
+			}
+			continue;
+		}
+
+		if ((dirty & NetworkObjectClass::BIT_FREQUENT) == 0) {
+			continue;
+		}
+
+		priority = p_object->Get_Cached_Priority_2(client_id);
+
+		if (p_object == client.Player) {
+			priority = client.PlayerInVehicle ? 0.1f : 0.8f;
+		} else if (p_object->Get_Client_Hint_Count(client_id) > 0) {
+			priority = 1.0f;
+			p_object->Reset_Client_Hint_Count(client_id);
+		} else if (!is_relevant) {
+			priority = 0.0f;
+			client.SkippedPairs++;
+		} else if (client.UpdatePriorities) {
+			int vis_id = p_object->Get_Vis_ID();
+			bool hidden = false;
+			if (client.Pvs && vis_id != -1 && !client.Pvs->Get_Bit(vis_id)) {
+				hidden = true;
+			}
+			if (hidden) {
+				int distance = int(cPriority::Get_Object_Distance_2(client.DestPos, p_object));
+				if (distance > min_vis_distance) {
+					if (bits_per_second > 100000 && distance < 150.0f) {
+						priority = 0.01f;
+					} else {
+						priority = 0.0f;
+					}
+				} else {
+					priority = 0.2f;
+				}
+			} else {
+				priority = cPriority::Compute_Object_Priority_2(client_id, client.DestPos, p_object, false, client.Player);
+			}
+		}
+
+		p_object->Set_Cached_Priority_2(client_id, priority);
+
+		if (priority > 0.001f && p_object->Get_Frequent_Update_Export_Size() > 0 && p_object->Get_Frequent_Update_Export_Size() < 0xff) {
+			object_list.Add(index);
+		}
+	}
+
+	/*
+	** Bandwidth multiplier and guaranteed packet throttling.
+	*/
+	avail_bytes_per_update = (int) (client.BandwidthMultiplier * (float)avail_bytes_per_update);
+	if (global_packet_allowance_full) {
+		avail_bytes_per_update >>= 1;
+	}
+
+	/*
+	** Work out the average priority and the per object update rates.
+	*/
+	float average_priority = 0.0f;
+	int num_priorities = 0;
+	int i;
+
+	for (i=0 ; i<object_list.Count() ; i++) {
+		const NetworkObjectSnapshotClass::ObjectStruct & entry = _TCADOSnapshot.Get_Object(object_list[i]);
+		if (entry.AppPacketType != APPPACKETTYPE_SERVERFPS) {
+			float pri = entry.Object->Get_Cached_Priority_2(client_id);
+			if (pri > 0.001f && pri < 1.0f) {
+				average_priority += pri;
+				num_priorities++;
+			}
+		}
+	}
+
+	client.AveragePriority = 0.0f;
+
+	if (num_priorities) {
+		average_priority = average_priority / (float)num_priorities;
+		client.AveragePriority = average_priority;
+
+		float ms_low = max_update_rate;
+		float ms_high = min_update_rate;
+		float spread = ms_high - ms_low;
+		int total_bps = 0;
+
+		for (i=0 ; i<object_list.Count() ; i++) {
+			NetworkObjectClass * temp_obj = _TCADOSnapshot.Get_Object(object_list[i]).Object;
+			float pri = temp_obj->Get_Cached_Priority_2(client_id);
+			unsigned int update_rate = infinity_update_rate;
+			if (pri > 0.025f) {
+				update_rate = (unsigned int)(((1.0f - pri) * spread) + ms_low);
+			} else {
+				if (pri > 0.009f) {
+					update_rate = int(min_update_rate);
+				}
+			}
+			temp_obj->Set_Update_Rate(client_id, (unsigned short) update_rate);
+			if (update_rate != infinity_update_rate) {
+				int bps = int((1000.0f / update_rate) * temp_obj->Get_Frequent_Update_Export_Size());
+				total_bps += bps;
+			}
+		}
 
+		total_bps = total_bps / net_update_rate;
+
+		float factor = 1.0;
+		if (total_bps) {
+			// Keep the integer division of the serial version so both modes agree.
+			factor = float(avail_bytes_per_update / total_bps);
+			if (factor < 0.00001f) {
+				factor = 0.00001f;
+			}
+		}
+
+		for (i=0 ; i<object_list.Count() ; i++) {
+			NetworkObjectClass * temp_obj = _TCADOSnapshot.Get_Object(object_list[i]).Object;
+			float obj_upd_rate = (float)temp_obj->Get_Update_Rate(client_id);
+			if (obj_upd_rate != infinity_update_rate && obj_upd_rate < (min_update_rate + WWMATH_EPSILON)) {
+				temp_obj->Set_Update_Rate(client_id, (unsigned short)(obj_upd_rate / factor));
+			}
+		}
+	}
+
+	/*
+	** Queue those packets whos time has come.
+	*/
+	for (i=0 ; i<object_list.Count() ; i++) {
+		int index = object_list[i];
+		NetworkObjectClass * temp_obj = _TCADOSnapshot.Get_Object(index).Object;
+		unsigned int rate =  (unsigned int)temp_obj->Get_Update_Rate(client_id);
+		if (rate != (unsigned int)infinity_update_rate) {
+			if (time - temp_obj->Get_Last_Update_Time(client_id) > rate) {
+				Queue_Object_Update(client, index, temp_obj->Get_Object_Dirty_Bits(client_id));
+				temp_obj->Set_Last_Update_Time(client_id, time);
+			}
+		}
+	}
 }
 
 #endif // not BETACLIENT
+
+
+//-----------------------------------------------------------------------------
+void cNetwork::Tell_Clients_About_Dynamic_Objects
+(
+	int					client_count,
+	const int *			client_ids,
+	const Vector3 *	dest_positions
+)
+{
+#ifndef BETACLIENT
+
+	WWPROFILE("TCADO Parallel");
+   WWASSERT(cNetwork::I_Am_Server());
+	WWASSERT(client_count <= NetworkObjectClass::MAX_CLIENT_COUNT);
+
+	int snapshot_ids[NetworkObjectClass::MAX_CLIENT_COUNT];
+	unsigned int time = TIMEGETTIME();
+
+	_TCADONetUpdateRate = cUserOptions::NetUpdateRate.Get();
+	_TCADOClientCount = 0;
+
+	{
+		WWPROFILE("Prepare");
+
+		for (int index = 0; index < client_count; index ++) {
+			int client_id = client_ids[index];
+			WWASSERT(client_id >= 0);
+
+			cRemoteHost * r_host = Get_Server_Rhost(client_id);
+			if (r_host == nullptr) {
+				continue;
+			}
+
+			if (cNetwork::I_Am_Client() && client_id == cNetwork::Get_My_Id()) {
+				//
+				// Server does not send to his own client.
+				//
+				continue;
+			}
+
+			TCADOClientStruct & client = _TCADOClients[_TCADOClientCount];
+			client.ClientID = client_id;
+			client.DestPos = dest_positions[index];
+			client.RHost = r_host;
+			client.Time = time;
+			client.BitsPerSecond = r_host->Get_Target_Bps();
+			client.AveragePriority = 0.0f;
+
+			client.UpdatePriorities = (r_host->Get_Priority_Update_Counter() == 0) ? true : false;
+			r_host->Increment_Priority_Count();
+
+			client.Pvs = nullptr;
+			if (client.UpdatePriorities) {
+				client.Pvs = COMBAT_SCENE->Get_Vis_Table(client.DestPos);
+			}
+
+			client.Player = GameObjManager::Find_Soldier_Of_Client_ID(client_id);
+			client.PlayerInVehicle = (client.Player != nullptr) && client.Player->Is_In_Vehicle();
+
+			//
+			// Decompress the vis tables of the sectors the player is heading into
+			// so they're ready by the time we need them.
+			//
+			if (client.Player != nullptr) {
+				Vector3 velocity;
+				if (client.PlayerInVehicle) {
+					client.Player->Get_Vehicle()->Get_Velocity(velocity);
+				} else {
+					client.Player->Get_Velocity(velocity);
+				}
+				COMBAT_SCENE->Prefetch_Vis_Tables(client.DestPos, velocity);
+			}
+
+			client.BandwidthMultiplier = r_host->Get_Bandwidth_Multiplier();
+			if (r_host->Get_Flood()) {
+				client.BandwidthMultiplier = (r_host->Get_Target_Bps() < 14400) ? 0.7f : 1.0f;
+			}
+
+			snapshot_ids[_TCADOClientCount] = client_id;
+			_TCADOClientCount++;
+		}
+	}
+
+	if (_TCADOClientCount == 0) {
+		return;
+	}
+
+	_TCADOSnapshot.Build(snapshot_ids, _TCADOClientCount);
+	WWASSERT(_TCADOSnapshot.Get_Object_Count() == NetworkObjectMgrClass::Get_Object_Count());
+	Update_Frequent_Export_Sizes();
+
+	{
+		WWPROFILE("ListBuild");
+		JobPoolClass::Run(_TCADOClientCount, [](int index) { Build_Client_Update_List(_TCADOClients[index]); });
+	}
+
+	{
+		WWPROFILE("Commit");
+
+		for (int index = 0; index < _TCADOClientCount; index ++) {
+			TCADOClientStruct & client = _TCADOClients[index];
+			int client_id = client.ClientID;
+
+			for (int send_index = 0; send_index < client.SendList.Count(); send_index ++) {
+				TCADOSendStruct & send = client.SendList[send_index];
+				NetworkObjectClass * object = _TCADOSnapshot.Get_Object(send.ObjectIndex).Object;
+				BYTE type = _TCADOSnapshot.Get_Object(send.ObjectIndex).AppPacketType;
+
+				if (send.HasData) {
+					Server_Send_Packet(*send.Packet, send.Mode, client_id);
+				}
+
+#ifdef WWDEBUG
+				for (int i = 0; i < cDevOptions::SpamCount.Get (); i ++) {
+					WWDEBUG_SAY(("Sending spam\n"));
+					Server_Send_Packet(*send.Packet, send.Mode, client_id);
+				}
+#endif // WWDEBUG
+
+				object->Set_Object_Dirty_Bit (client_id, NetworkObjectClass::BIT_CREATION, false);
+				object->Set_Object_Dirty_Bit (client_id, NetworkObjectClass::BIT_RARE, false);
+				object->Set_Object_Dirty_Bit (client_id, NetworkObjectClass::BIT_OCCASIONAL, false);
+
+				//
+				// Count what actually went into the packet, a delta coded frequent tier
+				// is smaller than the exported one.
+				//
+				int tier_bits = 0;
+				for (int tier = 0; tier < PACKET_TIER_COUNT; tier ++) {
+					if (NetworkObjectSnapshotClass::Is_Tier_Dirty(send.DirtyBits, (PACKET_TIER_ENUM)tier)) {
+						cAppPacketStats::Increment_Bits_Sent_Tier(type, (PACKET_TIER_ENUM)tier, send.TierBits[tier]);
+						tier_bits += send.TierBits[tier];
+					}
+				}
+				cAppPacketStats::Increment_Packets_Sent(type);
+				cAppPacketStats::Increment_Bits_Sent(type, tier_bits);
+
+				delete send.Packet;
+			}
+			client.SendList.Reset_Active();
+
+			client.RHost->Set_Average_Priority(client.AveragePriority);
+			NetworkObjectMgrClass::Add_Relevance_Skipped_Pairs(client.SkippedPairs);
+
+			if (client.Pvs) {
+				REF_PTR_RELEASE(client.Pvs);
+			}
+		}
+	}
+
+	_TCADOSnapshot.Reset();
+
+#endif // not BETACLIENT
 }
 
 //-----------------------------------------------------------------------------
@@ -851,16 +1379,22 @@ void cNetwork::Tell_Server_About_Dynamic_Objects
 
    WWASSERT (cNetwork::I_Am_Client());
 
+	if (PClientDeltaAck != nullptr) {
+		PClientDeltaAck->Update();
+	}
+
 	//
-	//	Loop over each network object
+	//	Loop over each network object that has something to send
 	//
-	int count = NetworkObjectMgrClass::Get_Object_Count();
+	static DynamicVectorClass<int> dirty_list;
+	NetworkObjectMgrClass::Collect_Dirty_Objects(0, dirty_list);
+	int count = dirty_list.Count();
 
 	//int debug_count = 0;
 
-	for (int index = 0; index < count; index ++) {
+	for (int dirty_index = 0; dirty_index < count; dirty_index ++) {
 
-		NetworkObjectClass * object = NetworkObjectMgrClass::Get_Object(index);
+		NetworkObjectClass * object = NetworkObjectMgrClass::Get_Object(dirty_list[dirty_index]);
 
 		//
 		//	Should we send update information for this object?
@@ -949,9 +1483,35 @@ cNetwork::Send_Object_Update(NetworkObjectClass *object, int client_id)
 	//	Build a packet that will contain enough information about
 	// the object so the client will be able to import the data
 	//
+	//
+	// A frequent tier that is to be delta coded against what the client has
+	// acked is exported up front, the header has to say how it is coded.
+	//
+	cPacket frequent;
+	bool is_frequent_exported = false;
+	bool is_delta = false;
+	if (client_id > 0) {
+		if (object->Get_Object_Dirty_Bit (client_id, NetworkObjectClass::BIT_CREATION)) {
+			NetworkObjectDeltaClass::Reset_Object(client_id, object->Get_Network_ID());
+		}
+
+		if (NetworkObjectDeltaClass::Is_Enabled() &&
+			 object->Get_Object_Dirty_Bit (client_id, NetworkObjectClass::BIT_FREQUENT))
+		{
+			object->Export_Frequent (frequent);
+			is_frequent_exported = true;
+			is_delta = (frequent.Get_Bit_Write_Position() > 0);
+		}
+	}
+
+	BYTE dirty_bits = object->Get_Object_Dirty_Bits(client_id);
+	if (is_delta) {
+		dirty_bits |= NetworkObjectDeltaClass::DELTA_CODED_BIT;
+	}
+
 	cPacket packet;
 	packet.Add(object->Get_Network_ID());
-	packet.Add(object->Get_Object_Dirty_Bits(client_id));
+	packet.Add(dirty_bits);
 	packet.Add(object->Is_Delete_Pending());
 	//packet.Add(object->Get_App_Packet_Type());
 
@@ -1033,7 +1593,12 @@ cNetwork::Send_Object_Update(NetworkObjectClass *object, int client_id)
 	//
 	if (object->Get_Object_Dirty_Bit (client_id, NetworkObjectClass::BIT_FREQUENT)) {
 		int bits_before = packet.Get_Bit_Write_Position();
-		object->Export_Frequent (packet);
+		if (is_delta) {
+			NetworkObjectDeltaClass::Write_Frequent(packet, client_id, object->Get_Network_ID(),
+				(const uint8 *)frequent.Peek_Data(), 0, frequent.Get_Bit_Write_Position());
+		} else if (!is_frequent_exported) {
+			object->Export_Frequent (packet);
+		}
 		int bits_after = packet.Get_Bit_Write_Position();
 		cAppPacketStats::Increment_Bits_Sent_Tier(type, PACKET_TIER_FREQUENT, bits_after - bits_before);
 	}
@@ -1549,6 +2114,8 @@ void cNetwork::Cleanup_After_Client(int client_id)
 
 	NetworkObjectMgrClass::Restore_Dirty_Bits(client_id);
 
+	NetworkObjectDeltaClass::Reset_Client(client_id);
+
 	CCDKeyAuth::DisconnectUser(client_id);
 }
 
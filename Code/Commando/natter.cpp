@@ -1264,12 +1264,12 @@ bool WOLNATInterfaceClass::Send_Game_Format_Packet_To(IPAddressClass *address, c
 		/*
 		** Send it.
 		*/
-		PacketManager.Take_Packet((unsigned char *)full_packet.Get_Data(), full_packet.Get_Compressed_Size_Bytes(), (unsigned char*)&sock_address.sin_addr.s_addr, sock_address.sin_port, socket_handler->Get_Socket());
+		PacketManager.Take_Packet((unsigned char *)full_packet.Peek_Data(), full_packet.Get_Compressed_Size_Bytes(), (unsigned char*)&sock_address.sin_addr.s_addr, sock_address.sin_port, socket_handler->Get_Socket());
 		PacketManager.Flush(true);	//Hmmmmm is this going to send a bunch of other packets to the wrong place?
 
 #if (0)
 		WWDEBUG_SAY(("WOLNATInterface - sendto %s\n", address->As_String()));
-		int result = sendto(socket_handler->Get_Socket(), full_packet.Get_Data(), full_packet.Get_Compressed_Size_Bytes(), 0, (LPSOCKADDR) &sock_address, sizeof(struct sockaddr_in));
+		int result = sendto(socket_handler->Get_Socket(), full_packet.Peek_Data(), full_packet.Get_Compressed_Size_Bytes(), 0, (LPSOCKADDR) &sock_address, sizeof(struct sockaddr_in));
 		if (result == SOCKET_ERROR){
 			if (LAST_ERROR != WSAEWOULDBLOCK) {
 				WWDEBUG_SAY(("WOLNATInterface - sendto returned error code %d\n", LAST_ERROR));
@@ -40,6 +40,7 @@
 #include "networkobjectmgr.h"
 #include "networkobjectfactory.h"
 #include "networkobjectfactorymgr.h"
+#include "networkobjectdelta.h"
 #include "playermanager.h"
 #include "apppacketstats.h"
 #include "specialbuilds.h"
@@ -306,6 +307,11 @@ void cNetwork::Client_Packet_Handler([[maybe_unused]] cPacket & packet)
 		}
 		object->Import_Creation (packet);
 
+		//
+		//	Frequent tiers from now on are coded against states of this object
+		//
+		NetworkObjectDeltaClass::Reset_Received (network_obj_id);
+
 		//
 		//	HACK - HACK
 		//
@@ -354,7 +360,11 @@ void cNetwork::Client_Packet_Handler([[maybe_unused]] cPacket & packet)
 		//	Do we need to update this object?
 		//
 		if ((dirty_bits & NetworkObjectClass::BIT_FREQUENT) == NetworkObjectClass::BIT_FREQUENT) {
-			object->Import_Frequent (packet);
+			if (dirty_bits & NetworkObjectDeltaClass::DELTA_CODED_BIT) {
+				NetworkObjectDeltaClass::Read_Frequent (packet, object);
+			} else {
+				object->Import_Frequent (packet);
+			}
 			//object->Increment_Import_State_Count ();
 		}
 
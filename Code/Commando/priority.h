@@ -54,6 +54,12 @@ public:
 	static float			Compute_Object_Priority_2(int client_id, const Vector3 & client_pos, NetworkObjectClass * p_netobject, bool do_it_anyway = false, SoldierGameObj *client_soldier = nullptr);
 	static float			Get_Object_Distance_2(const Vector3 &	client_pos, NetworkObjectClass * p_netobject);
 
+	//
+	// Objects further away than this always get a priority of zero from
+	// Compute_Object_Priority_2 so they can be skipped without computing it.
+	//
+	static float			Get_Relevance_Radius(void)	{return MaxDistance;}
+
 private:
 	static float			Compute_Facing_Factor(int client_id, const Vector3 &	client_pos, NetworkObjectClass * p_netobject, SoldierGameObj *client_soldier = nullptr);
 	static float			Compute_Type_Factor(NetworkObjectClass * p_netobject);
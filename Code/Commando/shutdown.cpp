@@ -80,6 +80,7 @@
 #include "registry.h"
 #include "specialbuilds.h"
 #include "openw3d.h"
+#include "jobpool.h"
 #include <windows.h>
 #include <lmcons.h>	// UNLEN
 extern SimpleFileFactoryClass RenegadeBaseFileFactory;
@@ -471,6 +472,7 @@ void Game_Shutdown(void)
 	WWSaveLoad::Shutdown();
 	WW3D::Shutdown();
 	WWPhys::Shutdown();
+	JobPoolClass::Shutdown();
 
 //	WW3DAssetManager::Get_Instance()->Free_Assets();
 	Debug_Refs();
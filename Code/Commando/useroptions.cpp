@@ -187,6 +187,30 @@ cUserOptions::ParseResult cUserOptions::Parse_Command_Line(int argc, char *argv[
 			continue;
 		}
 
+		// Record the datagrams the server sends and receives.
+		if (strcmp(cmd, "--capture") == 0) {
+			const char *argval = argv[i + 1];
+			i++;
+			if (i >= argc) {
+				retcode = FAILURE;
+				break;
+			}
+			cNetwork::Set_Capture_File(argval);
+			continue;
+		}
+
+		// Play a capture back through the server, report and exit.
+		if (strcmp(cmd, "--replay") == 0) {
+			const char *argval = argv[i + 1];
+			i++;
+			if (i >= argc) {
+				retcode = FAILURE;
+				break;
+			}
+			cNetwork::Set_Replay_File(argval);
+			continue;
+		}
+
 		if (strcmp(cmd, "--gamespyserver") == 0) {
             const char *argval = argv[i + 1];
 			i++;
@@ -310,6 +334,7 @@ void cUserOptions::Print_Command_Line_Help(bool error)
 	fprintf(file, "    [--gamedir PATH]\n");
 	fprintf(file, "    [--ini PATH]\n");
 	fprintf(file, "    [--gamespyserver ADDRESS] [--nodx]\n");
+	fprintf(file, "    [--capture FILE] [--replay FILE]\n");
 #ifndef BETACLIENT
 	fprintf(file, "    [--gamespy-connect IP[:PORT]]\n");
 	fprintf(file, "    [--gamespy-netplayername NAME]\n");
@@ -0,0 +1,442 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// BakeW3D.cpp : Bakes the W3D files in a set of mix files into a W3D asset cache (see
+// ww3d2/w3dcache.h) that the game maps into memory at startup.
+//
+// The files are baked in the order the mix files are given, and the first copy of a file
+// wins, so the mix files should be listed in the order the game searches them.  Every file
+// remembers the size and date the game will see for it; rebuilding a mix file makes the
+// cache out of date for all of its files, and they are loaded from the mix file again until
+// the cache is rebuilt.
+
+// Includes.
+#include "always.h"
+#include "mixfile.h"
+#include "rawfile.h"
+#include "ramfile.h"
+#include "chunkio.h"
+#include "realcrc.h"
+#include "w3d_file.h"
+#include "w3dcache.h"
+#include "aabtreebuilder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// A file baked into the cache.
+struct BakedFileStruct {
+	StringClass								Name;
+	uint32									NameCRC;
+	uint32									SourceSize;
+	uint32									SourceDateTime;
+	unsigned char *						Data;
+	int										Size;
+	DynamicVectorClass<W3dCacheChunkStruct>	Chunks;
+	int										MeshCount;		// meshes the tool built an AABTree for
+};
+
+
+// Private functions.
+static BakedFileStruct *	Bake_File (const char *filename, FileClass &file);
+static unsigned char *		Bake_Mesh (const unsigned char *chunk, int size, int &baked_size);
+static bool						Write_Cache (const char *filename, DynamicVectorClass<BakedFileStruct *> &files);
+static int						Baked_File_Compare (const void *a, const void *b);
+
+static inline uint32 Align (uint32 offset, uint32 alignment)
+{
+	return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+
+int main (int argc, char *argv[])
+{
+	// Must have at least 3 command line arguments - the executable, a cache file name and a mix file.
+	if (argc < 3) {
+		printf ("Usage - BakeW3D <cachefilename> <mixfile0>..<mixfile n>\n");
+		return (0);
+	}
+
+	DynamicVectorClass<BakedFileStruct *> files;
+	int mesh_count = 0;
+
+	for (int c = 2; c < argc; c++) {
+
+		MixFileFactoryClass mixfile (argv [c], _TheSimpleFileFactory);
+		DynamicVectorClass<StringClass> names;
+		if (!mixfile.Is_Valid () || !mixfile.Build_Filename_List (names)) {
+			printf ("Unable to read %s\n", argv [c]);
+			continue;
+		}
+
+		int filecount = 0;
+		for (int index = 0; index < names.Count (); index++) {
+
+			// Only W3D files are baked.
+			const char *name = names [index];
+			int length = (int)strlen (name);
+			if (length < 4 || stricmp (name + length - 4, ".w3d") != 0) {
+				continue;
+			}
+
+			// Skip files an earlier mix file had.
+			uint32 crc = CRC_Stringi (name);
+			bool found = false;
+			for (int f = 0; f < files.Count () && !found; f++) {
+				found = (files [f]->NameCRC == crc) && (stricmp (files [f]->Name, name) == 0);
+			}
+			if (found) {
+				continue;
+			}
+
+			FileClass *file = mixfile.Get_File (name);
+			if (file != nullptr) {
+				BakedFileStruct *baked = Bake_File (name, *file);
+				if (baked != nullptr) {
+					mesh_count += baked->MeshCount;
+					files.Add (baked);
+					filecount++;
+				}
+				mixfile.Return_File (file);
+			}
+		}
+
+		printf ("%s: %d files baked\n", argv [c], filecount);
+	}
+
+	if (!Write_Cache (argv [1], files)) {
+		printf ("Unable to write %s\n", argv [1]);
+	} else {
+		printf ("%s: %d files, %d AABTrees built\n", argv [1], files.Count (), mesh_count);
+	}
+
+	for (int f = 0; f < files.Count (); f++) {
+		delete [] files [f]->Data;
+		delete files [f];
+	}
+
+	return (0);
+}
+
+
+// Reads a W3D file and bakes each of its top level chunks.
+BakedFileStruct *Bake_File (const char *filename, FileClass &file)
+{
+	if (!file.Is_Available () || !file.Open ()) {
+		return (nullptr);
+	}
+
+	int size = file.Size ();
+	unsigned char *source = new unsigned char [size > 0 ? size : 1];
+	bool ok = (file.Read (source, size) == size);
+
+	BakedFileStruct *baked = new BakedFileStruct;
+	baked->Name				= filename;
+	baked->NameCRC			= CRC_Stringi (filename);
+	baked->SourceSize		= (uint32)size;
+	baked->SourceDateTime	= file.Get_Date_Time ();
+	baked->Data				= nullptr;
+	baked->Size				= 0;
+	baked->MeshCount		= 0;
+	file.Close ();
+
+	// The baked file can only grow by the AABTrees, so bake the chunks into a list first.
+	DynamicVectorClass<unsigned char *> chunk_data;
+	DynamicVectorClass<int> chunk_sizes;
+
+	int offset = 0;
+	while (ok && offset + (int)sizeof (ChunkHeader) <= size) {
+		ChunkHeader header;
+		memcpy (&header, source + offset, sizeof (header));
+		int chunk_size = (int)sizeof (header) + (int)header.Get_Size ();
+		if ((int)header.Get_Size () > size - offset - (int)sizeof (header)) {
+			printf ("%s: chunk %u runs past the end of the file\n", filename, header.Get_Type ());
+			ok = false;
+			break;
+		}
+
+		unsigned char *data = nullptr;
+		if (header.Get_Type () == W3D_CHUNK_MESH) {
+			int baked_size = 0;
+			data = Bake_Mesh (source + offset, chunk_size, baked_size);
+			if (data != nullptr) {
+				chunk_size = baked_size;
+				baked->MeshCount++;
+			}
+		}
+		if (data == nullptr) {
+			data = new unsigned char [chunk_size];
+			memcpy (data, source + offset, chunk_size);
+		}
+
+		W3dCacheChunkStruct chunk;
+		chunk.ChunkID	= header.Get_Type ();
+		chunk.Offset	= (uint32)baked->Size;
+		chunk.Size		= (uint32)chunk_size;
+		baked->Chunks.Add (chunk);
+
+		chunk_data.Add (data);
+		chunk_sizes.Add (chunk_size);
+		baked->Size += chunk_size;
+		offset += (int)sizeof (header) + (int)header.Get_Size ();
+	}
+
+	// Files that don't parse are left out, the game will report them when it loads them.
+	if (ok) {
+		baked->Data = new unsigned char [baked->Size > 0 ? baked->Size : 1];
+		for (int index = 0; index < chunk_data.Count (); index++) {
+			memcpy (baked->Data + baked->Chunks [index].Offset, chunk_data [index], chunk_sizes [index]);
+		}
+	}
+
+	for (int index = 0; index < chunk_data.Count (); index++) {
+		delete [] chunk_data [index];
+	}
+	delete [] source;
+
+	if (!ok) {
+		delete baked;
+		baked = nullptr;
+	}
+	return (baked);
+}
+
+
+// Builds the AABTree the game would build at load time for a collideable mesh exported
+// without one, and returns the mesh chunk with the tree added.  Returns nullptr to keep the
+// chunk as it is.
+unsigned char *Bake_Mesh (const unsigned char *chunk, int size, int &baked_size)
+{
+	const unsigned char *payload = chunk + sizeof (ChunkHeader);
+	int payload_size = size - (int)sizeof (ChunkHeader);
+
+	// The sub chunks aren't aligned, so everything is copied out of them.
+	W3dMeshHeader3Struct mesh_header;
+	bool has_header = false;
+	const unsigned char *verts = nullptr;
+	const unsigned char *tris = nullptr;
+	int vert_count = 0;
+	int tri_count = 0;
+
+	int offset = 0;
+	while (offset + (int)sizeof (ChunkHeader) <= payload_size) {
+		ChunkHeader header;
+		memcpy (&header, payload + offset, sizeof (header));
+		int sub_size = (int)header.Get_Size ();
+		const unsigned char *data = payload + offset + sizeof (header);
+		if (sub_size > payload_size - offset - (int)sizeof (header)) {
+			return (nullptr);
+		}
+
+		switch (header.Get_Type ()) {
+			case W3D_CHUNK_MESH_HEADER3:
+				if (sub_size >= (int)sizeof (W3dMeshHeader3Struct)) {
+					memcpy (&mesh_header, data, sizeof (mesh_header));
+					has_header = true;
+				}
+				break;
+
+			case W3D_CHUNK_VERTICES:
+				verts = data;
+				vert_count = sub_size / (int)sizeof (W3dVectorStruct);
+				break;
+
+			case W3D_CHUNK_TRIANGLES:
+				tris = data;
+				tri_count = sub_size / (int)sizeof (W3dTriStruct);
+				break;
+
+			case W3D_CHUNK_AABTREE:
+				return (nullptr);
+		}
+
+		offset += (int)sizeof (header) + sub_size;
+	}
+
+	// Same test as MeshModelClass::Load_W3D.
+	if (	!has_header || verts == nullptr || tris == nullptr ||
+			((mesh_header.Attributes & W3D_MESH_FLAG_COLLISION_TYPE_MASK) >> W3D_MESH_FLAG_COLLISION_TYPE_SHIFT) == 0 ||
+			vert_count < (int)mesh_header.NumVertices || tri_count < (int)mesh_header.NumTris ||
+			mesh_header.NumTris == 0)
+	{
+		return (nullptr);
+	}
+
+	vert_count = (int)mesh_header.NumVertices;
+	tri_count = (int)mesh_header.NumTris;
+
+	Vector3 *vertex_array = new Vector3 [vert_count];
+	for (int index = 0; index < vert_count; index++) {
+		W3dVectorStruct vert;
+		memcpy (&vert, verts + index * sizeof (W3dVectorStruct), sizeof (vert));
+		vertex_array [index].Set (vert.X, vert.Y, vert.Z);
+	}
+
+	TriIndex *poly_array = new TriIndex [tri_count];
+	for (int index = 0; index < tri_count; index++) {
+		W3dTriStruct tri;
+		memcpy (&tri, tris + index * sizeof (W3dTriStruct), sizeof (tri));
+		poly_array [index].I = static_cast<unsigned short>(tri.Vindex [0]);
+		poly_array [index].J = static_cast<unsigned short>(tri.Vindex [1]);
+		poly_array [index].K = static_cast<unsigned short>(tri.Vindex [2]);
+	}
+
+	AABTreeBuilderClass builder;
+	builder.Build_AABTree (tri_count, poly_array, vert_count, vertex_array);
+
+	int tree_size =	(int)sizeof (ChunkHeader) +
+							(int)sizeof (ChunkHeader) + (int)sizeof (W3dMeshAABTreeHeader) +
+							(int)sizeof (ChunkHeader) + builder.Poly_Count () * (int)sizeof (uint32) +
+							(int)sizeof (ChunkHeader) + builder.Node_Count () * (int)sizeof (W3dMeshAABTreeNode);
+
+	baked_size = size + tree_size;
+	unsigned char *baked = new unsigned char [baked_size];
+
+	RAMFileClass ramfile (baked, baked_size);
+	ramfile.Open (RAMFileClass::WRITE);
+	ChunkSaveClass csave (&ramfile);
+	csave.Begin_Chunk (W3D_CHUNK_MESH);
+	csave.Write (payload, payload_size);
+	builder.Export (csave);
+	csave.End_Chunk ();
+	bool ok = (ramfile.Size () == baked_size);
+	ramfile.Close ();
+
+	delete [] vertex_array;
+	delete [] poly_array;
+
+	if (!ok) {
+		delete [] baked;
+		baked = nullptr;
+	}
+	return (baked);
+}
+
+
+// Lays the cache out and writes it.
+bool Write_Cache (const char *filename, DynamicVectorClass<BakedFileStruct *> &files)
+{
+	if (files.Count () > 0) {
+		qsort (&files [0], files.Count (), sizeof (BakedFileStruct *), Baked_File_Compare);
+	}
+
+	// Work out where everything goes.
+	uint32 count = (uint32)files.Count ();
+	uint32 file_offset = Align (sizeof (W3dCacheHeaderStruct), 4);
+	uint32 chunk_offset = file_offset + count * sizeof (W3dCacheFileStruct);
+	uint32 name_offset = chunk_offset;
+	for (uint32 f = 0; f < count; f++) {
+		name_offset += files [f]->Chunks.Count () * sizeof (W3dCacheChunkStruct);
+	}
+	uint32 data_offset = name_offset;
+	for (uint32 f = 0; f < count; f++) {
+		data_offset += files [f]->Name.Get_Length () + 1;
+	}
+
+	DynamicVectorClass<W3dCacheFileStruct> entries;
+	uint32 next_chunk = chunk_offset;
+	uint32 next_name = name_offset;
+	uint32 next_data = Align (data_offset, W3DCACHE_DATA_ALIGNMENT);
+	for (uint32 f = 0; f < count; f++) {
+		W3dCacheFileStruct entry;
+		entry.NameCRC			= files [f]->NameCRC;
+		entry.NameOffset		= next_name;
+		entry.SourceSize		= files [f]->SourceSize;
+		entry.SourceDateTime	= files [f]->SourceDateTime;
+		entry.DataOffset		= next_data;
+		entry.DataSize			= (uint32)files [f]->Size;
+		entry.ChunkOffset		= next_chunk;
+		entry.ChunkCount		= (uint32)files [f]->Chunks.Count ();
+		entries.Add (entry);
+
+		next_chunk += entry.ChunkCount * sizeof (W3dCacheChunkStruct);
+		next_name += files [f]->Name.Get_Length () + 1;
+		next_data = Align (next_data + entry.DataSize, W3DCACHE_DATA_ALIGNMENT);
+	}
+
+	W3dCacheHeaderStruct header;
+	memset (&header, 0, sizeof (header));
+	memcpy (header.Signature, W3DCACHE_SIGNATURE, sizeof (header.Signature));
+	header.Version		= W3DCACHE_VERSION;
+	header.FileCount	= count;
+	header.FileOffset	= file_offset;
+	header.TotalSize	= next_data;
+
+	// And write it out in the same order.
+	RawFileClass cachefile (filename);
+	if (!cachefile.Open (RawFileClass::WRITE)) {
+		return (false);
+	}
+
+	static const char padding [W3DCACHE_DATA_ALIGNMENT] = { 0 };
+	uint32 written = 0;
+	bool ok = true;
+
+	ok &= (cachefile.Write (&header, sizeof (header)) == sizeof (header));
+	written = sizeof (header);
+
+	if (file_offset > written) {
+		ok &= (cachefile.Write (padding, file_offset - written) == (int)(file_offset - written));
+		written = file_offset;
+	}
+	for (uint32 f = 0; f < count; f++) {
+		ok &= (cachefile.Write (&entries [f], sizeof (W3dCacheFileStruct)) == sizeof (W3dCacheFileStruct));
+		written += sizeof (W3dCacheFileStruct);
+	}
+	for (uint32 f = 0; f < count; f++) {
+		int size = files [f]->Chunks.Count () * sizeof (W3dCacheChunkStruct);
+		if (size > 0) {
+			ok &= (cachefile.Write (&files [f]->Chunks [0], size) == size);
+		}
+		written += size;
+	}
+	for (uint32 f = 0; f < count; f++) {
+		int size = files [f]->Name.Get_Length () + 1;
+		ok &= (cachefile.Write (files [f]->Name.Peek_Buffer (), size) == size);
+		written += size;
+	}
+	for (uint32 f = 0; f < count; f++) {
+		int pad = (int)(entries [f].DataOffset - written);
+		if (pad > 0) {
+			ok &= (cachefile.Write (padding, pad) == pad);
+		}
+		if (files [f]->Size > 0) {
+			ok &= (cachefile.Write (files [f]->Data, files [f]->Size) == files [f]->Size);
+		}
+		written = entries [f].DataOffset + entries [f].DataSize;
+	}
+	int pad = (int)(header.TotalSize - written);
+	if (pad > 0) {
+		ok &= (cachefile.Write (padding, pad) == pad);
+	}
+
+	cachefile.Close ();
+	return (ok);
+}
+
+
+int Baked_File_Compare (const void *a, const void *b)
+{
+	uint32 crca = (*(const BakedFileStruct **)a)->NameCRC;
+	uint32 crcb = (*(const BakedFileStruct **)b)->NameCRC;
+	if (crca < crcb) return -1;
+	if (crca > crcb) return 1;
+	return 0;
+}
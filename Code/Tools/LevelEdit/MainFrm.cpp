@@ -3029,8 +3029,6 @@ CMainFrame::OnTestPathfind (void)
 		//
 		while (path->Timestep () == PathSolveClass::THINKING) ;
 
-		path->Unlink_Pathfind_Hooks ();
-
 		//
 		//	Did we find a path?
 		//
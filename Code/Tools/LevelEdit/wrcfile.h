@@ -83,7 +83,7 @@ class WinResourceFileClass final : public FileClass
 		void Error(int error, int canretry = false, char const * filename=nullptr) override;
 		void Bias(int /* start */, int /* length */=-1) override {}
 
-		virtual const unsigned char *Peek_Data(void) const					{ return FileBytes; }
+		virtual const void * Peek_Data(void) const override				{ return FileBytes; }
 
 	protected:
 
@@ -112,6 +112,8 @@ static inline CullableClass * get_next_object(CullableClass * obj)
 ** AABTreeCullSystemClass Implementation
 **
 *************************************************************************/
+bool AABTreeCullSystemClass::_WideNodesEnabled = true;
+
 AABTreeCullSystemClass::AABTreeCullSystemClass(void) :
 	ObjectCount(0),
 	NodeCount(0),
@@ -205,17 +207,70 @@ void AABTreeCullSystemClass::Update_Culling(CullableClass * obj)
 
 void AABTreeCullSystemClass::Collect_Objects(const Vector3 & point)
 {
-	Collect_Objects_Recursive(RootNode,point);
+	if (!Use_Wide_Nodes()) {
+		Collect_Objects_Recursive(RootNode,point);
+		return;
+	}
+
+	/*
+	** The root isn't in any of the wide nodes, test it on its own
+	*/
+	if (RootNode->Box.Contains(point) == false) {
+		NODE_REJECTED();
+		return;
+	}
+	NODE_ACCEPTED();
+	Collect_Node_Objects(RootNode,point);
+
+	WideAABoxQueryClass query;
+	query.Init(point,point);
+	Collect_Objects_Wide(0,point,query);
 }
 
 void AABTreeCullSystemClass::Collect_Objects(const AABoxClass & box)
 {
-	Collect_Objects_Recursive(RootNode,box);
+	if (!Use_Wide_Nodes()) {
+		Collect_Objects_Recursive(RootNode,box);
+		return;
+	}
+
+	CollisionMath::OverlapType overlap = CollisionMath::Overlap_Test(box,RootNode->Box);
+	if (overlap == CollisionMath::OUTSIDE) {
+		NODE_REJECTED();
+		return;
+	} else if (overlap == CollisionMath::INSIDE) {
+		Collect_Objects_Recursive(RootNode);
+		return;
+	}
+	NODE_ACCEPTED();
+	Collect_Node_Objects(RootNode,box);
+
+	WideAABoxQueryClass query;
+	query.Init(box.Center - box.Extent,box.Center + box.Extent);
+	Collect_Objects_Wide(0,box,query);
 }
 
 void AABTreeCullSystemClass::Collect_Objects(const OBBoxClass & box)
 {
-	Collect_Objects_Recursive(RootNode,box);
+	if (!Use_Wide_Nodes()) {
+		Collect_Objects_Recursive(RootNode,box);
+		return;
+	}
+
+	CollisionMath::OverlapType overlap = CollisionMath::Overlap_Test(box,RootNode->Box);
+	if (overlap == CollisionMath::OUTSIDE) {
+		NODE_REJECTED();
+		return;
+	} else if (overlap == CollisionMath::INSIDE) {
+		Collect_Objects_Recursive(RootNode);
+		return;
+	}
+	NODE_ACCEPTED();
+	Collect_Node_Objects(RootNode,box);
+
+	WideSweepQueryClass query;
+	query.Init_OBBox(box);
+	Collect_Objects_Wide(0,box,query);
 }
 
 void AABTreeCullSystemClass::Collect_Objects(const FrustumClass & frustum)
@@ -297,6 +352,7 @@ void AABTreeCullSystemClass::Add_Object_Recursive(AABTreeNodeClass * node,Cullab
 
 	// Ok, we have to fit in this node.
 	node->Add_Object(obj);
+	Update_Wide_Box(node);
 	ObjectCount++;
 }
 
@@ -315,6 +371,7 @@ void AABTreeCullSystemClass::Add_Loaded_Object(AABTreeNodeClass * node,CullableC
 	obj->Set_Cull_Link(new_link);
 
 	node->Add_Object(obj);
+	Update_Wide_Box(node);
 	ObjectCount++;
 	obj->Add_Ref();
 }
@@ -400,6 +457,7 @@ void AABTreeCullSystemClass::Re_Partition(const AABoxClass & bounds,SimpleDynVec
 void AABTreeCullSystemClass::Update_Bounding_Boxes(void)
 {
 	Update_Bounding_Boxes_Recursive(RootNode);
+	Build_Wide_Nodes();
 }
 
 const AABoxClass & AABTreeCullSystemClass::Get_Bounding_Box(void)
@@ -665,6 +723,239 @@ void AABTreeCullSystemClass::Collect_Objects_Recursive(AABTreeNodeClass * node,c
 	}
 }
 
+/*************************************************************************
+**
+** Four-wide traversal.  Each wide node holds the grandchildren of a node
+** (see Build_Wide_Nodes_Recursive); the children in between are never
+** tested but may still hold objects, so those are checked on their own.
+**
+*************************************************************************/
+void AABTreeCullSystemClass::Collect_Objects_Wide(int wide_index,const Vector3 & point,const WideAABoxQueryClass & query)
+{
+	const WideAABNodeStruct & wide = WideNodes[wide_index];
+
+	for (int i=0; i<2; i++) {
+		if (wide.Middle[i] != -1) {
+			AABTreeNodeClass * middle = IndexedNodes[wide.Middle[i]];
+			if (middle->Object && middle->Box.Contains(point)) {
+				Collect_Node_Objects(middle,point);
+			}
+		}
+	}
+
+	int overlap = query.Overlap_Mask(wide);
+
+	for (int lane=0; lane<WideAABNodeStruct::LANE_COUNT; lane++) {
+		int bit = 1 << lane;
+		if ((wide.LaneMask & bit) == 0) {
+			continue;
+		}
+		if ((overlap & bit) == 0) {
+			NODE_REJECTED();
+			continue;
+		}
+		NODE_ACCEPTED();
+
+		Collect_Node_Objects(IndexedNodes[wide.Link[lane]],point);
+		if (wide.Child[lane] != -1) {
+			Collect_Objects_Wide(wide.Child[lane],point,query);
+		}
+	}
+}
+
+void AABTreeCullSystemClass::Collect_Objects_Wide(int wide_index,const AABoxClass & box,const WideAABoxQueryClass & query)
+{
+	const WideAABNodeStruct & wide = WideNodes[wide_index];
+
+	for (int i=0; i<2; i++) {
+		if (wide.Middle[i] != -1) {
+			AABTreeNodeClass * middle = IndexedNodes[wide.Middle[i]];
+			if (middle->Object && (CollisionMath::Overlap_Test(box,middle->Box) != CollisionMath::OUTSIDE)) {
+				Collect_Node_Objects(middle,box);
+			}
+		}
+	}
+
+	/*
+	** Lanes completely inside the box are collected without any more volume checking
+	*/
+	int overlap = query.Overlap_Mask(wide);
+	int inside = query.Inside_Mask(wide) & overlap;
+
+	for (int lane=0; lane<WideAABNodeStruct::LANE_COUNT; lane++) {
+		int bit = 1 << lane;
+		if ((wide.LaneMask & bit) == 0) {
+			continue;
+		}
+		if ((overlap & bit) == 0) {
+			NODE_REJECTED();
+			continue;
+		}
+
+		AABTreeNodeClass * node = IndexedNodes[wide.Link[lane]];
+		if (inside & bit) {
+			Collect_Objects_Recursive(node);
+			continue;
+		}
+		NODE_ACCEPTED();
+
+		Collect_Node_Objects(node,box);
+		if (wide.Child[lane] != -1) {
+			Collect_Objects_Wide(wide.Child[lane],box,query);
+		}
+	}
+}
+
+void AABTreeCullSystemClass::Collect_Objects_Wide(int wide_index,const OBBoxClass & box,const WideSweepQueryClass & query)
+{
+	const WideAABNodeStruct & wide = WideNodes[wide_index];
+
+	for (int i=0; i<2; i++) {
+		if (wide.Middle[i] != -1) {
+			AABTreeNodeClass * middle = IndexedNodes[wide.Middle[i]];
+			if (middle->Object && (CollisionMath::Overlap_Test(box,middle->Box) != CollisionMath::OUTSIDE)) {
+				Collect_Node_Objects(middle,box);
+			}
+		}
+	}
+
+	int overlap = query.Overlap_Mask(wide);
+
+	for (int lane=0; lane<WideAABNodeStruct::LANE_COUNT; lane++) {
+		int bit = 1 << lane;
+		if ((wide.LaneMask & bit) == 0) {
+			continue;
+		}
+		if ((overlap & bit) == 0) {
+			NODE_REJECTED();
+			continue;
+		}
+		NODE_ACCEPTED();
+
+		Collect_Node_Objects(IndexedNodes[wide.Link[lane]],box);
+		if (wide.Child[lane] != -1) {
+			Collect_Objects_Wide(wide.Child[lane],box,query);
+		}
+	}
+}
+
+void AABTreeCullSystemClass::Collect_Node_Objects(AABTreeNodeClass * node,const Vector3 & point)
+{
+	CullableClass * obj = get_first_object(node);
+	while (obj) {
+		if (obj->Get_Cull_Box().Contains(point)) {
+			Add_To_Collection(obj);
+		}
+		obj = get_next_object(obj);
+	}
+}
+
+void AABTreeCullSystemClass::Collect_Node_Objects(AABTreeNodeClass * node,const AABoxClass & box)
+{
+	CullableClass * obj = get_first_object(node);
+	while (obj) {
+		if (CollisionMath::Overlap_Test(box,obj->Get_Cull_Box()) != CollisionMath::OUTSIDE) {
+			Add_To_Collection(obj);
+		}
+		obj = get_next_object(obj);
+	}
+}
+
+void AABTreeCullSystemClass::Collect_Node_Objects(AABTreeNodeClass * node,const OBBoxClass & box)
+{
+	CullableClass * obj = get_first_object(node);
+	while (obj) {
+		if (CollisionMath::Overlap_Test(box,obj->Get_Cull_Box()) != CollisionMath::OUTSIDE) {
+			Add_To_Collection(obj);
+		}
+		obj = get_next_object(obj);
+	}
+}
+
+void AABTreeCullSystemClass::Build_Wide_Nodes(void)
+{
+	WideNodes.Delete_All(false);
+	WideSlots.Resize(NodeCount);
+	for (int i=0; i<NodeCount; i++) {
+		WideSlots[i] = -1;
+	}
+
+	if (RootNode != nullptr) {
+		Build_Wide_Nodes_Recursive(RootNode);
+	}
+}
+
+int AABTreeCullSystemClass::Build_Wide_Nodes_Recursive(AABTreeNodeClass * node)
+{
+	/*
+	** Gather the grandchildren of this node.  A child without children of its own
+	** goes into a lane itself.
+	*/
+	AABTreeNodeClass * lanes[WideAABNodeStruct::LANE_COUNT];
+	int lane_count = 0;
+
+	WideAABNodeStruct wide;
+	wide.Init();
+	int middle_count = 0;
+
+	AABTreeNodeClass * children[2] = { node->Back, node->Front };
+	for (int i=0; i<2; i++) {
+		AABTreeNodeClass * child = children[i];
+		if (child == nullptr) {
+			continue;
+		}
+		if (child->Back || child->Front) {
+			wide.Middle[middle_count++] = child->Index;
+			if (child->Back) {
+				lanes[lane_count++] = child->Back;
+			}
+			if (child->Front) {
+				lanes[lane_count++] = child->Front;
+			}
+		} else {
+			lanes[lane_count++] = child;
+		}
+	}
+
+	if (lane_count == 0) {
+		return -1;
+	}
+
+	int wide_index = WideNodes.Count();
+	for (int lane=0; lane<lane_count; lane++) {
+		const AABoxClass & box = lanes[lane]->Box;
+		wide.Set_Lane(lane,box.Center - box.Extent,box.Center + box.Extent,lanes[lane]->Index);
+		WideSlots[lanes[lane]->Index] = wide_index * WideAABNodeStruct::LANE_COUNT + lane;
+	}
+	WideNodes.Add(wide,NodeCount / 2);
+
+	for (int lane=0; lane<lane_count; lane++) {
+		int child_index = Build_Wide_Nodes_Recursive(lanes[lane]);
+		WideNodes[wide_index].Child[lane] = child_index;
+	}
+	return wide_index;
+}
+
+void AABTreeCullSystemClass::Update_Wide_Box(AABTreeNodeClass * node)
+{
+	/*
+	** Adding an object can change the box of the node it lands in
+	*/
+	if ((int)node->Index >= WideSlots.Length()) {
+		return;
+	}
+	int slot = WideSlots[node->Index];
+	if (slot != -1) {
+		WWASSERT(IndexedNodes[node->Index] == node);
+		WideNodes[slot / WideAABNodeStruct::LANE_COUNT].Set_Lane_Box
+		(
+			slot % WideAABNodeStruct::LANE_COUNT,
+			node->Box.Center - node->Box.Extent,
+			node->Box.Center + node->Box.Extent
+		);
+	}
+}
+
 void AABTreeCullSystemClass::Update_Bounding_Boxes_Recursive(AABTreeNodeClass * node)
 {
 	MinMaxAABoxClass minmaxbox(node->Box);
@@ -865,6 +1156,14 @@ void AABTreeCullSystemClass::Load_Object_Linkage(ChunkLoadClass & cload,Cullable
 }
 
 void AABTreeCullSystemClass::Save_Object_Linkage(ChunkSaveClass & csave,CullableClass * obj)
+{
+	uint32 index = Get_Object_Node_Index(obj);
+	csave.Begin_Chunk(AABTREE_CHUNK_NODE_INDEX);
+	csave.Write(&index,sizeof(index));
+	csave.End_Chunk();
+}
+
+int AABTreeCullSystemClass::Get_Object_Node_Index(CullableClass * obj)
 {
 	WWASSERT(obj);
 	WWASSERT(obj->Get_Culling_System() == this);
@@ -875,10 +1174,7 @@ void AABTreeCullSystemClass::Save_Object_Linkage(ChunkSaveClass & csave,Cullable
 	AABTreeNodeClass * node = link->Node;
 	WWASSERT(node);
 
-	uint32 index = node->Index;
-	csave.Begin_Chunk(AABTREE_CHUNK_NODE_INDEX);
-	csave.Write(&index,sizeof(index));
-	csave.End_Chunk();
+	return node->Index;
 }
 
 
@@ -895,6 +1191,11 @@ void AABTreeCullSystemClass::Re_Index_Nodes(void)
 	int counter = 0;
 	Re_Index_Nodes_Recursive(RootNode,counter);
 	WWASSERT(counter == NodeCount);
+
+	/*
+	** The wide nodes refer to the nodes by index so they have to follow
+	*/
+	Build_Wide_Nodes();
 }
 
 
@@ -44,6 +44,7 @@
 
 #include "cullsys.h"
 #include "aaplane.h"
+#include "aabtreewide.h"
 #include "wwmath.h"
 #include "mempool.h"
 #include "simplevec.h"
@@ -118,6 +119,12 @@ public:
 	void					Load_Object_Linkage(ChunkLoadClass & cload,CullableClass * obj);
 	void					Save_Object_Linkage(ChunkSaveClass & csave,CullableClass * obj);
 
+	/*
+	** The linkage as a plain node index, for callers which store it in their own format.
+	** Pass it back to Add_Object to re-link the object.
+	*/
+	int					Get_Object_Node_Index(CullableClass * obj);
+
 	/*
 	** Bounding box of the entire tree
 	*/
@@ -138,6 +145,13 @@ public:
 	void					Reset_Statistics(void);
 	const StatsStruct & Get_Statistics(void);
 
+	/*
+	** The point and box collections walk a copy of the tree collapsed into four-wide nodes
+	** (see aabtreewide.h).  It can be turned off to compare against the binary walk.
+	*/
+	static void			Enable_Wide_Nodes(bool onoff)			{ _WideNodesEnabled = onoff; }
+	static bool			Are_Wide_Nodes_Enabled(void)			{ return _WideNodesEnabled; }
+
 protected:
 
 	/*
@@ -177,6 +191,18 @@ protected:
 
 	void					Update_Bounding_Boxes_Recursive(AABTreeNodeClass * node);
 
+	bool					Use_Wide_Nodes(void) const				{ return _WideNodesEnabled && (WideNodes.Count() > 0); }
+	void					Build_Wide_Nodes(void);
+	int					Build_Wide_Nodes_Recursive(AABTreeNodeClass * node);
+	void					Update_Wide_Box(AABTreeNodeClass * node);
+
+	void					Collect_Objects_Wide(int wide_index,const Vector3 & point,const WideAABoxQueryClass & query);
+	void					Collect_Objects_Wide(int wide_index,const AABoxClass & box,const WideAABoxQueryClass & query);
+	void					Collect_Objects_Wide(int wide_index,const OBBoxClass & box,const WideSweepQueryClass & query);
+	void					Collect_Node_Objects(AABTreeNodeClass * node,const Vector3 & point);
+	void					Collect_Node_Objects(AABTreeNodeClass * node,const AABoxClass & box);
+	void					Collect_Node_Objects(AABTreeNodeClass * node,const OBBoxClass & box);
+
 	void					Load_Nodes(AABTreeNodeClass * node,ChunkLoadClass & cload);
 	void					Save_Nodes(AABTreeNodeClass * node,ChunkSaveClass & csave);
 
@@ -191,6 +217,11 @@ protected:
 
 	StatsStruct				Stats;
 
+	SimpleDynVecClass<WideAABNodeStruct>	WideNodes;		// the tree collapsed into four-wide nodes, the first one is below the root
+	SimpleVecClass<int>							WideSlots;		// wide node * 4 + lane holding each indexed node's box, -1 if none
+
+	static bool				_WideNodesEnabled;
+
 	friend class AABTreeIterator;
 };
 
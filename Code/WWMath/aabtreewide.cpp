@@ -0,0 +1,238 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "aabtreewide.h"
+#include "lineseg.h"
+#include "obbox.h"
+#include "wwmath.h"
+#include "wwdebug.h"
+
+
+/*
+** Lane boxes grow by this much (relative to their coordinates) when they are stored
+*/
+static const float	WIDE_BOX_PADDING = WWMATH_EPSILON;
+
+/*
+** Stand-in for 1/0 in the slab test; big enough to push any slab the ray runs parallel
+** to and doesn't start inside of out of the [0,1] range, small enough to stay finite.
+*/
+static const float	WIDE_RAY_INV_ZERO = 1.0e30f;
+
+
+static inline float Pad_Down(float value)
+{
+	return value - WIDE_BOX_PADDING * (1.0f + WWMath::Fabs(value));
+}
+
+static inline float Pad_Up(float value)
+{
+	return value + WIDE_BOX_PADDING * (1.0f + WWMath::Fabs(value));
+}
+
+static inline float Safe_Inverse(float value)
+{
+	if (WWMath::Fabs(value) > 1.0e-20f) {
+		return 1.0f / value;
+	}
+	return (value < 0.0f) ? -WIDE_RAY_INV_ZERO : WIDE_RAY_INV_ZERO;
+}
+
+
+/*************************************************************************
+**
+** WideAABNodeStruct Implementation
+**
+*************************************************************************/
+void WideAABNodeStruct::Init(void)
+{
+	for (int lane=0; lane<LANE_COUNT; lane++) {
+		MinX[lane] = MinY[lane] = MinZ[lane] = 0.0f;
+		MaxX[lane] = MaxY[lane] = MaxZ[lane] = 0.0f;
+		Link[lane] = -1;
+		Child[lane] = -1;
+	}
+	Middle[0] = Middle[1] = -1;
+	LaneMask = 0;
+}
+
+void WideAABNodeStruct::Set_Lane(int lane,const Vector3 & min,const Vector3 & max,int link)
+{
+	WWASSERT((lane >= 0) && (lane < LANE_COUNT));
+	Set_Lane_Box(lane,min,max);
+	Link[lane] = link;
+	LaneMask |= (1 << lane);
+}
+
+void WideAABNodeStruct::Set_Lane_Box(int lane,const Vector3 & min,const Vector3 & max)
+{
+	WWASSERT((lane >= 0) && (lane < LANE_COUNT));
+	MinX[lane] = Pad_Down(min.X);
+	MinY[lane] = Pad_Down(min.Y);
+	MinZ[lane] = Pad_Down(min.Z);
+	MaxX[lane] = Pad_Up(max.X);
+	MaxY[lane] = Pad_Up(max.Y);
+	MaxZ[lane] = Pad_Up(max.Z);
+}
+
+
+/*************************************************************************
+**
+** WideAABoxQueryClass Implementation
+**
+*************************************************************************/
+void WideAABoxQueryClass::Init(const Vector3 & min,const Vector3 & max)
+{
+	MinX = Wide_Splat(min.X);
+	MinY = Wide_Splat(min.Y);
+	MinZ = Wide_Splat(min.Z);
+	MaxX = Wide_Splat(max.X);
+	MaxY = Wide_Splat(max.Y);
+	MaxZ = Wide_Splat(max.Z);
+}
+
+
+/*************************************************************************
+**
+** WideSweepQueryClass Implementation
+**
+*************************************************************************/
+void WideSweepQueryClass::Init_OBBox(const OBBoxClass & box)
+{
+	Vector3 extent;
+	box.Compute_Axis_Aligned_Extent(&extent);
+	Bounds.Init(box.Center - extent,box.Center + extent);
+
+	AxisCount = 0;
+	for (int i=0; i<3; i++) {
+		Vector3 axis(box.Basis[0][i],box.Basis[1][i],box.Basis[2][i]);
+		Add_Axis(axis,Vector3::Dot_Product(axis,box.Center),box.Extent[i]);
+	}
+}
+
+void WideSweepQueryClass::Init_AABox_Sweep
+(
+	const Vector3 &	center,
+	const Vector3 &	extent,
+	const Vector3 &	move,
+	const Vector3 &	sweep_min,
+	const Vector3 &	sweep_max
+)
+{
+	Bounds.Init(sweep_min,sweep_max);
+
+	/*
+	** The move crossed with each world axis.  The move projects to zero on these
+	** so the swept volume projects to the same interval as the box itself.
+	*/
+	AxisCount = 0;
+	if (move.Length2() > WWMATH_EPSILON2) {
+		Vector3 axis[3] =
+		{
+			Vector3(0.0f,-move.Z,move.Y),
+			Vector3(move.Z,0.0f,-move.X),
+			Vector3(-move.Y,move.X,0.0f)
+		};
+		for (int i=0; i<3; i++) {
+			float radius =	WWMath::Fabs(axis[i].X * extent.X) +
+								WWMath::Fabs(axis[i].Y * extent.Y) +
+								WWMath::Fabs(axis[i].Z * extent.Z);
+			Add_Axis(axis[i],Vector3::Dot_Product(axis[i],center),radius);
+		}
+	}
+}
+
+void WideSweepQueryClass::Init_OBBox_Sweep
+(
+	const OBBoxClass &	box,
+	const Vector3 &		move,
+	const Vector3 &		sweep_min,
+	const Vector3 &		sweep_max
+)
+{
+	Bounds.Init(sweep_min,sweep_max);
+	AxisCount = 0;
+
+	/*
+	** Faces of the box; along these the box is stretched by the move
+	*/
+	Vector3 box_axis[3];
+	for (int i=0; i<3; i++) {
+		box_axis[i].Set(box.Basis[0][i],box.Basis[1][i],box.Basis[2][i]);
+		float move_proj = Vector3::Dot_Product(box_axis[i],move);
+		Add_Axis(	box_axis[i],
+						Vector3::Dot_Product(box_axis[i],box.Center) + 0.5f * move_proj,
+						box.Extent[i] + 0.5f * WWMath::Fabs(move_proj)	);
+	}
+
+	/*
+	** The move crossed with each world axis
+	*/
+	if (move.Length2() > WWMATH_EPSILON2) {
+		Vector3 axis[3] =
+		{
+			Vector3(0.0f,-move.Z,move.Y),
+			Vector3(move.Z,0.0f,-move.X),
+			Vector3(-move.Y,move.X,0.0f)
+		};
+		for (int i=0; i<3; i++) {
+			float radius =	box.Extent[0] * WWMath::Fabs(Vector3::Dot_Product(axis[i],box_axis[0])) +
+								box.Extent[1] * WWMath::Fabs(Vector3::Dot_Product(axis[i],box_axis[1])) +
+								box.Extent[2] * WWMath::Fabs(Vector3::Dot_Product(axis[i],box_axis[2]));
+			Add_Axis(axis[i],Vector3::Dot_Product(axis[i],box.Center),radius);
+		}
+	}
+}
+
+void WideSweepQueryClass::Add_Axis(const Vector3 & axis,float center,float radius)
+{
+	WWASSERT(AxisCount < MAX_AXES);
+
+	/*
+	** Pad the radius the same way the lane boxes are padded, relative to the size of
+	** the numbers involved, so the test stays on the accepting side of any rounding.
+	*/
+	float scale = WWMath::Fabs(axis.X) + WWMath::Fabs(axis.Y) + WWMath::Fabs(axis.Z);
+	radius += WIDE_BOX_PADDING * (1.0f + WWMath::Fabs(center) + radius + scale);
+
+	AxisStruct & dest = Axis[AxisCount++];
+	dest.X = Wide_Splat(axis.X);
+	dest.Y = Wide_Splat(axis.Y);
+	dest.Z = Wide_Splat(axis.Z);
+	dest.AbsX = Wide_Splat(WWMath::Fabs(axis.X));
+	dest.AbsY = Wide_Splat(WWMath::Fabs(axis.Y));
+	dest.AbsZ = Wide_Splat(WWMath::Fabs(axis.Z));
+	dest.Center = Wide_Splat(center);
+	dest.Radius = Wide_Splat(radius);
+}
+
+
+/*************************************************************************
+**
+** WideRayQueryClass Implementation
+**
+*************************************************************************/
+void WideRayQueryClass::Init(const LineSegClass & ray)
+{
+	P0X = Wide_Splat(ray.Get_P0().X);
+	P0Y = Wide_Splat(ray.Get_P0().Y);
+	P0Z = Wide_Splat(ray.Get_P0().Z);
+	InvDPX = Wide_Splat(Safe_Inverse(ray.Get_DP().X));
+	InvDPY = Wide_Splat(Safe_Inverse(ray.Get_DP().Y));
+	InvDPZ = Wide_Splat(Safe_Inverse(ray.Get_DP().Z));
+}
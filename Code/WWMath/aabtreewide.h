@@ -0,0 +1,257 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef AABTREEWIDE_H
+#define AABTREEWIDE_H
+
+#include "always.h"
+#include "vector3.h"
+#include "widefloat.h"
+
+class LineSegClass;
+class OBBoxClass;
+
+
+/*
+** WideAABNodeStruct
+** Four axis-aligned boxes stored coordinate by coordinate so that one wide register holds
+** the same coordinate of all four.  The binary trees are collapsed two levels at a time:
+** the lanes of a wide node are the grandchildren of a node (or the child itself if that
+** child is a leaf) and the child of each lane is the wide node for that lane's grandchildren.
+** The boxes are padded outwards a little so that rounding can never make a wide test cull
+** something the scalar test would have accepted.
+*/
+struct WideAABNodeStruct
+{
+	enum { LANE_COUNT = 4 };
+
+	void			Init(void);
+	void			Set_Lane(int lane,const Vector3 & min,const Vector3 & max,int link);
+	void			Set_Lane_Box(int lane,const Vector3 & min,const Vector3 & max);
+
+	float			MinX[LANE_COUNT];
+	float			MinY[LANE_COUNT];
+	float			MinZ[LANE_COUNT];
+	float			MaxX[LANE_COUNT];
+	float			MaxY[LANE_COUNT];
+	float			MaxZ[LANE_COUNT];
+
+	int			Link[LANE_COUNT];			// owner's index of the binary node in each lane, -1 when unused
+	int			Child[LANE_COUNT];		// wide node holding the lane's grandchildren, -1 when there are none
+	int			Middle[2];					// owner's index of the collapsed children (they may hold objects), -1 when unused
+	int			LaneMask;					// one bit for each lane in use
+};
+
+
+/*
+** WideAABoxQueryClass
+** Tests a static axis-aligned box (or a point, when min == max) against the four lanes of a node.
+*/
+class WideAABoxQueryClass
+{
+public:
+
+	void			Init(const Vector3 & min,const Vector3 & max);
+
+	/*
+	** Lanes touching the box / lanes completely inside the box
+	*/
+	int			Overlap_Mask(const WideAABNodeStruct & node) const;
+	int			Inside_Mask(const WideAABNodeStruct & node) const;
+
+protected:
+
+	WideFloat	MinX,MinY,MinZ;
+	WideFloat	MaxX,MaxY,MaxZ;
+};
+
+
+/*
+** WideSweepQueryClass
+** Tests a box, optionally sweeping along a move vector, against the four lanes of a node.
+** The lanes are first checked against the axis-aligned bounds of the volume, then against
+** up to six more separating axes: the faces of an oriented box and the cross products of the
+** move with the world axes.  Since the lanes are axis-aligned, that is an exact test for
+** swept axis-aligned boxes; for oriented boxes the edge-edge axes are left out so the test
+** errs on the side of accepting.
+*/
+class WideSweepQueryClass
+{
+public:
+
+	void			Init_OBBox(const OBBoxClass & box);
+	void			Init_AABox_Sweep(const Vector3 & center,const Vector3 & extent,const Vector3 & move,const Vector3 & sweep_min,const Vector3 & sweep_max);
+	void			Init_OBBox_Sweep(const OBBoxClass & box,const Vector3 & move,const Vector3 & sweep_min,const Vector3 & sweep_max);
+
+	int			Overlap_Mask(const WideAABNodeStruct & node) const;
+
+protected:
+
+	void			Add_Axis(const Vector3 & axis,float center,float radius);
+
+	enum { MAX_AXES = 6 };
+
+	struct AxisStruct
+	{
+		WideFloat	X,Y,Z;			// the axis
+		WideFloat	AbsX,AbsY,AbsZ;
+		WideFloat	Center;			// the volume projected onto the axis
+		WideFloat	Radius;
+	};
+
+	WideAABoxQueryClass	Bounds;
+	int						AxisCount;
+	AxisStruct				Axis[MAX_AXES];
+};
+
+
+/*
+** WideRayQueryClass
+** Slab test of a line segment against the four lanes of a node.  Also hands back where the
+** segment enters each lane so the caller can visit the nearest lanes first and skip the ones
+** that start beyond the closest hit so far.
+*/
+class WideRayQueryClass
+{
+public:
+
+	void			Init(const LineSegClass & ray);
+
+	int			Overlap_Mask(const WideAABNodeStruct & node,float max_fraction,float * set_enter_fraction) const;
+
+protected:
+
+	WideFloat	P0X,P0Y,P0Z;
+	WideFloat	InvDPX,InvDPY,InvDPZ;
+};
+
+
+/*
+** WideAABNodeOrderClass
+** Sorts the accepted lanes of a node by the fraction where a ray enters them
+*/
+class WideAABNodeOrderClass
+{
+public:
+	WideAABNodeOrderClass(int mask,const float * enter_fraction);
+
+	int			Count;
+	int			Lane[WideAABNodeStruct::LANE_COUNT];
+};
+
+
+
+/***********************************************************************************************
+**
+** Inline implementations
+**
+***********************************************************************************************/
+inline int WideAABoxQueryClass::Overlap_Mask(const WideAABNodeStruct & node) const
+{
+	WideMask x = Wide_And(Wide_Less_Equal(Wide_Load(node.MinX),MaxX),Wide_Less_Equal(MinX,Wide_Load(node.MaxX)));
+	WideMask y = Wide_And(Wide_Less_Equal(Wide_Load(node.MinY),MaxY),Wide_Less_Equal(MinY,Wide_Load(node.MaxY)));
+	WideMask z = Wide_And(Wide_Less_Equal(Wide_Load(node.MinZ),MaxZ),Wide_Less_Equal(MinZ,Wide_Load(node.MaxZ)));
+	return Wide_Mask_Bits(Wide_And(Wide_And(x,y),z)) & node.LaneMask;
+}
+
+inline int WideAABoxQueryClass::Inside_Mask(const WideAABNodeStruct & node) const
+{
+	WideMask x = Wide_And(Wide_Less_Equal(MinX,Wide_Load(node.MinX)),Wide_Less_Equal(Wide_Load(node.MaxX),MaxX));
+	WideMask y = Wide_And(Wide_Less_Equal(MinY,Wide_Load(node.MinY)),Wide_Less_Equal(Wide_Load(node.MaxY),MaxY));
+	WideMask z = Wide_And(Wide_Less_Equal(MinZ,Wide_Load(node.MinZ)),Wide_Less_Equal(Wide_Load(node.MaxZ),MaxZ));
+	return Wide_Mask_Bits(Wide_And(Wide_And(x,y),z)) & node.LaneMask;
+}
+
+inline int WideSweepQueryClass::Overlap_Mask(const WideAABNodeStruct & node) const
+{
+	int mask = Bounds.Overlap_Mask(node);
+	if ((mask == 0) || (AxisCount == 0)) {
+		return mask;
+	}
+
+	WideFloat half = Wide_Splat(0.5f);
+	WideFloat minx = Wide_Load(node.MinX);
+	WideFloat miny = Wide_Load(node.MinY);
+	WideFloat minz = Wide_Load(node.MinZ);
+	WideFloat maxx = Wide_Load(node.MaxX);
+	WideFloat maxy = Wide_Load(node.MaxY);
+	WideFloat maxz = Wide_Load(node.MaxZ);
+	WideFloat cx = Wide_Mul(Wide_Add(minx,maxx),half);
+	WideFloat cy = Wide_Mul(Wide_Add(miny,maxy),half);
+	WideFloat cz = Wide_Mul(Wide_Add(minz,maxz),half);
+	WideFloat ex = Wide_Mul(Wide_Sub(maxx,minx),half);
+	WideFloat ey = Wide_Mul(Wide_Sub(maxy,miny),half);
+	WideFloat ez = Wide_Mul(Wide_Sub(maxz,minz),half);
+
+	for (int i=0; i<AxisCount; i++) {
+		const AxisStruct & axis = Axis[i];
+
+		// distance between the projected centers must not exceed the sum of the projected radii
+		WideFloat node_center = Wide_Add(Wide_Add(Wide_Mul(cx,axis.X),Wide_Mul(cy,axis.Y)),Wide_Mul(cz,axis.Z));
+		WideFloat node_radius = Wide_Add(Wide_Add(Wide_Mul(ex,axis.AbsX),Wide_Mul(ey,axis.AbsY)),Wide_Mul(ez,axis.AbsZ));
+		WideFloat dist = Wide_Abs(Wide_Sub(node_center,axis.Center));
+		mask &= Wide_Mask_Bits(Wide_Less_Equal(dist,Wide_Add(node_radius,axis.Radius)));
+		if (mask == 0) {
+			break;
+		}
+	}
+	return mask;
+}
+
+inline int WideRayQueryClass::Overlap_Mask(const WideAABNodeStruct & node,float max_fraction,float * set_enter_fraction) const
+{
+	WideFloat t0 = Wide_Mul(Wide_Sub(Wide_Load(node.MinX),P0X),InvDPX);
+	WideFloat t1 = Wide_Mul(Wide_Sub(Wide_Load(node.MaxX),P0X),InvDPX);
+	WideFloat enter = Wide_Max(Wide_Splat(0.0f),Wide_Min(t0,t1));
+	WideFloat leave = Wide_Min(Wide_Splat(max_fraction),Wide_Max(t0,t1));
+
+	t0 = Wide_Mul(Wide_Sub(Wide_Load(node.MinY),P0Y),InvDPY);
+	t1 = Wide_Mul(Wide_Sub(Wide_Load(node.MaxY),P0Y),InvDPY);
+	enter = Wide_Max(enter,Wide_Min(t0,t1));
+	leave = Wide_Min(leave,Wide_Max(t0,t1));
+
+	t0 = Wide_Mul(Wide_Sub(Wide_Load(node.MinZ),P0Z),InvDPZ);
+	t1 = Wide_Mul(Wide_Sub(Wide_Load(node.MaxZ),P0Z),InvDPZ);
+	enter = Wide_Max(enter,Wide_Min(t0,t1));
+	leave = Wide_Min(leave,Wide_Max(t0,t1));
+
+	Wide_Store(set_enter_fraction,enter);
+	return Wide_Mask_Bits(Wide_Less_Equal(enter,leave)) & node.LaneMask;
+}
+
+inline WideAABNodeOrderClass::WideAABNodeOrderClass(int mask,const float * enter_fraction) :
+	Count(0)
+{
+	for (int lane=0; lane<WideAABNodeStruct::LANE_COUNT; lane++) {
+		if (mask & (1<<lane)) {
+			int i = Count++;
+			while ((i > 0) && (enter_fraction[Lane[i-1]] > enter_fraction[lane])) {
+				Lane[i] = Lane[i-1];
+				i--;
+			}
+			Lane[i] = lane;
+		}
+	}
+}
+
+
+#endif // AABTREEWIDE_H
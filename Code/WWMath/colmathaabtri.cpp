@@ -179,7 +179,11 @@ private:
 	BTCollisionStruct & operator = (const BTCollisionStruct &);
 };
 
-static BTCollisionStruct CollisionContext;
+//
+// Scratch state for the sweep, one per thread since physics islands and batched casts
+// sweep boxes on the job pool.
+//
+static thread_local BTCollisionStruct CollisionContext;
 
 /***********************************************************************************************
  * aabtri_separation_test -- test the projected extents for separation                         *
@@ -872,7 +876,10 @@ private:
 	AABTIntersectStruct & operator = (const AABTIntersectStruct &);
 };
 
-static AABTIntersectStruct IntersectContext;
+//
+// Scratch state for the intersection test, one per thread (see CollisionContext).
+//
+static thread_local AABTIntersectStruct IntersectContext;
 
 
 /***********************************************************************************************
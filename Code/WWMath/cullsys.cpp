@@ -39,15 +39,23 @@
 #include "wwprofile.h"
 
 
+/*
+** Collection slot of the calling thread
+*/
+static thread_local int _CollectionSlot = 0;
+
+
 /*************************************************************************
 **
 ** CullableClass Implementation
 **
 *************************************************************************/
 CullableClass::CullableClass(void) :
-	CullLink(nullptr),
-	NextCollected(nullptr)
+	CullLink(nullptr)
 {
+	for (int i=0; i<MAX_COLLECTION_SLOTS; i++) {
+		NextCollected[i] = nullptr;
+	}
 	CullBox.Init(Vector3(0,0,0),Vector3(1,1,1));
 }
 
@@ -100,9 +108,11 @@ CullSystemClass * CullableClass::Get_Culling_System(void) const
 ** current collection list and iterating through it.
 **
 *************************************************************************/
-CullSystemClass::CullSystemClass(void) :
-	CollectionHead(nullptr)
+CullSystemClass::CullSystemClass(void)
 {
+	for (int i=0; i<CullableClass::MAX_COLLECTION_SLOTS; i++) {
+		CollectionHead[i] = nullptr;
+	}
 }
 
 CullSystemClass::~CullSystemClass(void)
@@ -111,42 +121,53 @@ CullSystemClass::~CullSystemClass(void)
 
 // NOTE: THE Get_() functions currently are the same as the Peek_() functions (e.g., they do not
 // add a Ref). This is wrong and will be fixed.
+void CullSystemClass::Set_Collection_Slot(int slot)
+{
+	WWASSERT(slot >= 0 && slot < CullableClass::MAX_COLLECTION_SLOTS);
+	_CollectionSlot = slot;
+}
+
+int CullSystemClass::Get_Collection_Slot(void)
+{
+	return _CollectionSlot;
+}
+
 CullableClass * CullSystemClass::Get_First_Collected_Object_Internal(void)
 {
-	return CollectionHead;
+	return CollectionHead[_CollectionSlot];
 }
 
 CullableClass * CullSystemClass::Get_Next_Collected_Object_Internal(CullableClass * obj)
 {
 	if (obj != nullptr) {
-		return obj->NextCollected;
+		return obj->NextCollected[_CollectionSlot];
 	}
 	return nullptr;
 }
 
 CullableClass * CullSystemClass::Peek_First_Collected_Object_Internal(void)
 {
-	return CollectionHead;
+	return CollectionHead[_CollectionSlot];
 }
 
 CullableClass * CullSystemClass::Peek_Next_Collected_Object_Internal(CullableClass * obj)
 {
 	if (obj != nullptr) {
-		return obj->NextCollected;
+		return obj->NextCollected[_CollectionSlot];
 	}
 	return nullptr;
 }
 
 void CullSystemClass::Reset_Collection(void)
 {
-	CollectionHead = nullptr;
+	CollectionHead[_CollectionSlot] = nullptr;
 }
 
 void CullSystemClass::Add_To_Collection(CullableClass * obj)
 {
 	WWASSERT(obj != nullptr);
-	obj->NextCollected = CollectionHead;
-	CollectionHead = obj;
+	obj->NextCollected[_CollectionSlot] = CollectionHead[_CollectionSlot];
+	CollectionHead[_CollectionSlot] = obj;
 }
 
 
@@ -82,6 +82,12 @@ class CullableClass : public RefCountClass
 {
 public:
 
+	/*
+	** Number of collections that can be built at the same time, one per thread taking
+	** part in a parallel phase (see CullSystemClass::Set_Collection_Slot)
+	*/
+	enum { MAX_COLLECTION_SLOTS = 8 };
+
 	CullableClass(void);
 	virtual ~CullableClass(void);
 
@@ -105,8 +111,6 @@ public:
 
 private:
 
-	void					Set_Next_Collected(CullableClass * c)			{ NextCollected = c; }
-	CullableClass *	Get_Next_Collected(void)							{ return NextCollected; }
 
 	/*
 	** Culling Data
@@ -128,10 +132,10 @@ private:
 
 	/*
 	** NextCollected
-	** This pointer is used by the culling system to keep a singly linked
-	** list of cullable object that have been "collected".
+	** These pointers are used by the culling system to keep a singly linked
+	** list of cullable object that have been "collected", one per collection slot.
 	*/
-	CullableClass *				NextCollected;
+	CullableClass *				NextCollected[MAX_COLLECTION_SLOTS];
 
 	// Not Implemented:
 	CullableClass(const CullableClass & src);
@@ -162,6 +166,8 @@ public:
 	** another list is built, only one list can be valid at any time.
 	** WARNING: Always call Reset_Collection if you want to start a
 	** fresh collection!
+	** Each thread builds its collections in its own slot; slot 0 is the default.  A thread
+	** that takes part in a parallel phase must select a slot no other thread is using.
 	*/
 	void					Reset_Collection(void);
 	virtual void		Collect_Objects(const Vector3 & point)					= 0;
@@ -174,6 +180,12 @@ public:
 	*/
 	virtual void		Update_Culling(CullableClass * obj)						= 0;
 
+	/*
+	** Collection slot used by the calling thread
+	*/
+	static void			Set_Collection_Slot(int slot);
+	static int			Get_Collection_Slot(void);
+
 protected:
 
 	/*
@@ -190,9 +202,9 @@ protected:
 	void					Add_To_Collection(CullableClass * obj);
 
 	/*
-	** Pointer to the head of the current collection of objects
+	** Pointer to the head of the current collection of objects in each slot
 	*/
-	CullableClass *	CollectionHead;
+	CullableClass *	CollectionHead[CullableClass::MAX_COLLECTION_SLOTS];
 
 	friend class CullableClass;
 };
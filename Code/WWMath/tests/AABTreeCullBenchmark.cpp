@@ -0,0 +1,246 @@
+#include "aabtreecull.h"
+#include "colmath.h"
+#include "obbox.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr float LevelSize = 1200.0f;
+constexpr int TileCount = 40;
+constexpr int BuildingCount = 300;
+constexpr int PropCount = 6000;
+constexpr int QueryCount = 20000;
+constexpr int PassCount = 5;
+
+class TestObjectClass : public CullableClass
+{
+public:
+    explicit TestObjectClass(int id) : Id(id) {}
+    int Id;
+};
+
+class TestTreeClass : public TypedAABTreeCullSystemClass<TestObjectClass>
+{
+};
+
+struct Query
+{
+    Vector3 Point;
+    AABoxClass Box;
+    OBBoxClass OBBox;
+};
+
+float Random(std::mt19937 &rng, float min, float max)
+{
+    return std::uniform_real_distribution<float>(min, max)(rng);
+}
+
+//
+// Laid out roughly like a Renegade map: big terrain tiles, buildings,
+// and lots of small props clustered around the buildings.
+//
+void Build_Level(std::mt19937 &rng, std::vector<TestObjectClass *> &objects)
+{
+    float tile = LevelSize / TileCount;
+    for (int x = 0; x < TileCount; ++x) {
+        for (int y = 0; y < TileCount; ++y) {
+            Vector3 center((x + 0.5f) * tile, (y + 0.5f) * tile, Random(rng, -5.0f, 5.0f));
+            Vector3 extent(tile * 0.5f, tile * 0.5f, Random(rng, 1.0f, 8.0f));
+            objects.push_back(new TestObjectClass(static_cast<int>(objects.size())));
+            objects.back()->Set_Cull_Box(AABoxClass(center, extent));
+        }
+    }
+
+    std::vector<Vector3> sites;
+    for (int i = 0; i < BuildingCount; ++i) {
+        Vector3 center(Random(rng, 0.0f, LevelSize), Random(rng, 0.0f, LevelSize), Random(rng, 5.0f, 15.0f));
+        Vector3 extent(Random(rng, 5.0f, 25.0f), Random(rng, 5.0f, 25.0f), Random(rng, 4.0f, 12.0f));
+        sites.push_back(center);
+        objects.push_back(new TestObjectClass(static_cast<int>(objects.size())));
+        objects.back()->Set_Cull_Box(AABoxClass(center, extent));
+    }
+
+    for (int i = 0; i < PropCount; ++i) {
+        const Vector3 &site = sites[i % sites.size()];
+        Vector3 center(site.X + Random(rng, -60.0f, 60.0f), site.Y + Random(rng, -60.0f, 60.0f), Random(rng, 0.0f, 6.0f));
+        Vector3 extent(Random(rng, 0.25f, 3.0f), Random(rng, 0.25f, 3.0f), Random(rng, 0.25f, 3.0f));
+        objects.push_back(new TestObjectClass(static_cast<int>(objects.size())));
+        objects.back()->Set_Cull_Box(AABoxClass(center, extent));
+    }
+}
+
+void Build_Queries(std::mt19937 &rng, std::vector<Query> &queries)
+{
+    queries.resize(QueryCount);
+    for (Query &query : queries) {
+        Vector3 center(Random(rng, 0.0f, LevelSize), Random(rng, 0.0f, LevelSize), Random(rng, 0.0f, 12.0f));
+        query.Point = center;
+        query.Box = AABoxClass(center, Vector3(Random(rng, 0.5f, 20.0f), Random(rng, 0.5f, 20.0f), Random(rng, 0.5f, 5.0f)));
+
+        Matrix3 basis(Vector3(0, 0, 1), Random(rng, 0.0f, 6.2831853f));
+        basis.Rotate_X(Random(rng, -0.5f, 0.5f));
+        query.OBBox = OBBoxClass(center, Vector3(Random(rng, 0.5f, 10.0f), Random(rng, 0.5f, 3.0f), Random(rng, 0.5f, 2.0f)), basis);
+    }
+}
+
+enum QueryType
+{
+    QUERY_POINT,
+    QUERY_AABOX,
+    QUERY_OBBOX,
+};
+
+void Collect(TestTreeClass &tree, const Query &query, QueryType type)
+{
+    tree.Reset_Collection();
+    switch (type) {
+    case QUERY_POINT: tree.Collect_Objects(query.Point); break;
+    case QUERY_AABOX: tree.Collect_Objects(query.Box); break;
+    case QUERY_OBBOX: tree.Collect_Objects(query.OBBox); break;
+    }
+}
+
+void Collected_Ids(TestTreeClass &tree, std::vector<int> &ids)
+{
+    ids.clear();
+    for (TestObjectClass *obj = tree.Get_First_Collected_Object(); obj != nullptr; obj = tree.Get_Next_Collected_Object(obj)) {
+        ids.push_back(obj->Id);
+    }
+    std::sort(ids.begin(), ids.end());
+}
+
+// Both walks have to collect exactly the same objects for every query.
+bool Check_Same_Collections(TestTreeClass &tree, const std::vector<Query> &queries, const char *when)
+{
+    static const char *names[] = {"point", "AABox", "OBBox"};
+    std::vector<int> binary;
+    std::vector<int> wide;
+
+    for (int type = QUERY_POINT; type <= QUERY_OBBOX; ++type) {
+        for (size_t index = 0; index < queries.size(); ++index) {
+            AABTreeCullSystemClass::Enable_Wide_Nodes(false);
+            Collect(tree, queries[index], static_cast<QueryType>(type));
+            Collected_Ids(tree, binary);
+
+            AABTreeCullSystemClass::Enable_Wide_Nodes(true);
+            Collect(tree, queries[index], static_cast<QueryType>(type));
+            Collected_Ids(tree, wide);
+
+            if (binary != wide) {
+                std::cerr << names[type] << " query " << index << " " << when << ": binary walk collected "
+                          << binary.size() << " objects, wide walk " << wide.size() << ".\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+struct Timing
+{
+    double QueriesPerSecond = 0;
+    double NodesPerSecond = 0;
+    int Collected = 0;
+};
+
+Timing Time_Queries(TestTreeClass &tree, const std::vector<Query> &queries, QueryType type, bool wide)
+{
+    AABTreeCullSystemClass::Enable_Wide_Nodes(wide);
+    tree.Reset_Statistics();
+
+    Timing timing;
+    Clock::time_point start = Clock::now();
+    for (int pass = 0; pass < PassCount; ++pass) {
+        for (const Query &query : queries) {
+            Collect(tree, query, type);
+            for (TestObjectClass *obj = tree.Get_First_Collected_Object(); obj != nullptr; obj = tree.Get_Next_Collected_Object(obj)) {
+                ++timing.Collected;
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // The node counters only run in debug builds.
+    const AABTreeCullSystemClass::StatsStruct &stats = tree.Get_Statistics();
+    double nodes = static_cast<double>(stats.NodesAccepted) + stats.NodesRejected + stats.NodesTriviallyAccepted;
+    timing.QueriesPerSecond = queries.size() * PassCount / seconds;
+    timing.NodesPerSecond = nodes / seconds;
+    return timing;
+}
+
+void Print(const char *name, const Timing &binary, const Timing &wide)
+{
+    std::cout << name << ": binary " << binary.QueriesPerSecond << " queries/s";
+    if (binary.NodesPerSecond > 0) {
+        std::cout << " (" << binary.NodesPerSecond << " nodes/s)";
+    }
+    std::cout << ", wide " << wide.QueriesPerSecond << " queries/s";
+    if (wide.NodesPerSecond > 0) {
+        std::cout << " (" << wide.NodesPerSecond << " nodes/s)";
+    }
+    std::cout << ", speedup " << wide.QueriesPerSecond / binary.QueriesPerSecond << "x\n";
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(0x5eed);
+
+    std::vector<TestObjectClass *> objects;
+    Build_Level(rng, objects);
+
+    TestTreeClass tree;
+    for (TestObjectClass *obj : objects) {
+        tree.Add_Object(obj);
+    }
+    tree.Re_Partition();
+
+    std::vector<Query> queries;
+    Build_Queries(rng, queries);
+
+    if (!Check_Same_Collections(tree, queries, "after partitioning")) {
+        return 1;
+    }
+
+    //
+    // Move some props around; the wide copy has to follow the node boxes
+    // which change as the objects are re-inserted.
+    //
+    for (size_t index = TileCount * TileCount + BuildingCount; index < objects.size(); index += 7) {
+        AABoxClass box = objects[index]->Get_Cull_Box();
+        box.Center += Vector3(Random(rng, -40.0f, 40.0f), Random(rng, -40.0f, 40.0f), 0.0f);
+        objects[index]->Set_Cull_Box(box);
+    }
+
+    if (!Check_Same_Collections(tree, queries, "after moving objects")) {
+        return 1;
+    }
+
+    std::cout << objects.size() << " objects, " << tree.Partition_Node_Count() << " nodes, depth "
+              << tree.Partition_Tree_Depth() << "\n";
+
+    static const char *names[] = {"Point", "AABox", "OBBox"};
+    for (int type = QUERY_POINT; type <= QUERY_OBBOX; ++type) {
+        Timing binary = Time_Queries(tree, queries, static_cast<QueryType>(type), false);
+        Timing wide = Time_Queries(tree, queries, static_cast<QueryType>(type), true);
+        if (binary.Collected != wide.Collected) {
+            std::cerr << names[type] << " timing runs collected " << binary.Collected << " and " << wide.Collected << " objects.\n";
+            return 1;
+        }
+        Print(names[type], binary, wide);
+    }
+
+    for (TestObjectClass *obj : objects) {
+        tree.Remove_Object(obj);
+        obj->Release_Ref();
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef WIDEFLOAT_H
+#define WIDEFLOAT_H
+
+#include "always.h"
+#include "bittype.h"
+
+
+/*
+** Pick the SIMD instruction set for the wide math.  Every x86-64 target has SSE and every
+** ARM64 target has NEON, anything else gets the plain C version.
+*/
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+#define WWMATH_WIDE_SSE
+#include <xmmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define WWMATH_WIDE_NEON
+#include <arm_neon.h>
+#endif
+
+
+/*
+** WideFloat - four floats, one for each lane.
+** WideMask - the result of comparing two WideFloats, one bit per lane.
+** Wide_Transpose swaps the rows and columns of four WideFloats taken as a 4x4 matrix.
+*/
+#if defined(WWMATH_WIDE_SSE)
+
+typedef __m128				WideFloat;
+typedef __m128				WideMask;
+
+inline WideFloat	Wide_Load(const float * src)							{ return _mm_loadu_ps(src); }
+inline WideFloat	Wide_Splat(float value)									{ return _mm_set1_ps(value); }
+inline void			Wide_Store(float * dest,WideFloat a)				{ _mm_storeu_ps(dest,a); }
+inline WideFloat	Wide_Add(WideFloat a,WideFloat b)					{ return _mm_add_ps(a,b); }
+inline WideFloat	Wide_Sub(WideFloat a,WideFloat b)					{ return _mm_sub_ps(a,b); }
+inline WideFloat	Wide_Mul(WideFloat a,WideFloat b)					{ return _mm_mul_ps(a,b); }
+inline WideFloat	Wide_Min(WideFloat a,WideFloat b)					{ return _mm_min_ps(a,b); }
+inline WideFloat	Wide_Max(WideFloat a,WideFloat b)					{ return _mm_max_ps(a,b); }
+inline WideFloat	Wide_Abs(WideFloat a)									{ return _mm_andnot_ps(_mm_set1_ps(-0.0f),a); }
+inline WideMask	Wide_Less_Equal(WideFloat a,WideFloat b)			{ return _mm_cmple_ps(a,b); }
+inline WideMask	Wide_And(WideMask a,WideMask b)						{ return _mm_and_ps(a,b); }
+inline int			Wide_Mask_Bits(WideMask a)								{ return _mm_movemask_ps(a); }
+inline void			Wide_Transpose(WideFloat & a,WideFloat & b,WideFloat & c,WideFloat & d)	{ _MM_TRANSPOSE4_PS(a,b,c,d); }
+
+#elif defined(WWMATH_WIDE_NEON)
+
+typedef float32x4_t		WideFloat;
+typedef uint32x4_t		WideMask;
+
+inline WideFloat	Wide_Load(const float * src)							{ return vld1q_f32(src); }
+inline WideFloat	Wide_Splat(float value)									{ return vdupq_n_f32(value); }
+inline void			Wide_Store(float * dest,WideFloat a)				{ vst1q_f32(dest,a); }
+inline WideFloat	Wide_Add(WideFloat a,WideFloat b)					{ return vaddq_f32(a,b); }
+inline WideFloat	Wide_Sub(WideFloat a,WideFloat b)					{ return vsubq_f32(a,b); }
+inline WideFloat	Wide_Mul(WideFloat a,WideFloat b)					{ return vmulq_f32(a,b); }
+inline WideFloat	Wide_Min(WideFloat a,WideFloat b)					{ return vminq_f32(a,b); }
+inline WideFloat	Wide_Max(WideFloat a,WideFloat b)					{ return vmaxq_f32(a,b); }
+inline WideFloat	Wide_Abs(WideFloat a)									{ return vabsq_f32(a); }
+inline WideMask	Wide_Less_Equal(WideFloat a,WideFloat b)			{ return vcleq_f32(a,b); }
+inline WideMask	Wide_And(WideMask a,WideMask b)						{ return vandq_u32(a,b); }
+inline int			Wide_Mask_Bits(WideMask a)
+{
+	static const uint32 lane_bits[4] = { 1,2,4,8 };
+	return (int)vaddvq_u32(vandq_u32(a,vld1q_u32(lane_bits)));
+}
+inline void			Wide_Transpose(WideFloat & a,WideFloat & b,WideFloat & c,WideFloat & d)
+{
+	float32x4x2_t ab = vtrnq_f32(a,b);
+	float32x4x2_t cd = vtrnq_f32(c,d);
+	a = vcombine_f32(vget_low_f32(ab.val[0]),vget_low_f32(cd.val[0]));
+	b = vcombine_f32(vget_low_f32(ab.val[1]),vget_low_f32(cd.val[1]));
+	c = vcombine_f32(vget_high_f32(ab.val[0]),vget_high_f32(cd.val[0]));
+	d = vcombine_f32(vget_high_f32(ab.val[1]),vget_high_f32(cd.val[1]));
+}
+
+#else
+
+struct WideFloat	{ float V[4]; };
+struct WideMask	{ int Bits; };
+
+inline WideFloat	Wide_Load(const float * src)							{ WideFloat r; for (int i=0; i<4; i++) r.V[i] = src[i]; return r; }
+inline WideFloat	Wide_Splat(float value)									{ WideFloat r; for (int i=0; i<4; i++) r.V[i] = value; return r; }
+inline void			Wide_Store(float * dest,WideFloat a)				{ for (int i=0; i<4; i++) dest[i] = a.V[i]; }
+inline WideFloat	Wide_Add(WideFloat a,WideFloat b)					{ for (int i=0; i<4; i++) a.V[i] += b.V[i]; return a; }
+inline WideFloat	Wide_Sub(WideFloat a,WideFloat b)					{ for (int i=0; i<4; i++) a.V[i] -= b.V[i]; return a; }
+inline WideFloat	Wide_Mul(WideFloat a,WideFloat b)					{ for (int i=0; i<4; i++) a.V[i] *= b.V[i]; return a; }
+inline WideFloat	Wide_Min(WideFloat a,WideFloat b)					{ for (int i=0; i<4; i++) a.V[i] = (a.V[i] < b.V[i]) ? a.V[i] : b.V[i]; return a; }
+inline WideFloat	Wide_Max(WideFloat a,WideFloat b)					{ for (int i=0; i<4; i++) a.V[i] = (a.V[i] > b.V[i]) ? a.V[i] : b.V[i]; return a; }
+inline WideFloat	Wide_Abs(WideFloat a)									{ for (int i=0; i<4; i++) a.V[i] = (a.V[i] < 0.0f) ? -a.V[i] : a.V[i]; return a; }
+inline WideMask	Wide_Less_Equal(WideFloat a,WideFloat b)			{ WideMask r; r.Bits = 0; for (int i=0; i<4; i++) r.Bits |= (a.V[i] <= b.V[i]) ? (1<<i) : 0; return r; }
+inline WideMask	Wide_And(WideMask a,WideMask b)						{ a.Bits &= b.Bits; return a; }
+inline int			Wide_Mask_Bits(WideMask a)								{ return a.Bits; }
+inline void			Wide_Transpose(WideFloat & a,WideFloat & b,WideFloat & c,WideFloat & d)
+{
+	WideFloat * rows[4] = { &a,&b,&c,&d };
+	for (int i=0; i<4; i++) {
+		for (int j=i+1; j<4; j++) {
+			float tmp = rows[i]->V[j];
+			rows[i]->V[j] = rows[j]->V[i];
+			rows[j]->V[i] = tmp;
+		}
+	}
+}
+
+#endif
+
+
+#endif
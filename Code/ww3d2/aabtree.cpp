@@ -47,6 +47,11 @@
  *   AABTreeClass::Cast_AABox_Recursive -- internal implementation of Cast_AABox               *
  *   AABTreeClass::Cast_OBBox_Recursive -- Internal implementation of Cast_OBBox               *
  *   AABTreeClass::Intersect_OBBox_Recursive -- internal implementation of Intersect_OBBox     *
+ *   AABTreeClass::Build_Wide_Nodes -- build the four-wide copy of the tree                    *
+ *   AABTreeClass::Build_Wide_Nodes_Recursive -- build the wide node below the given node      *
+ *   AABTreeClass::Cast_Ray_Wide -- Cast_Ray using the four-wide nodes                         *
+ *   AABTreeClass::Cast_AABox_Wide -- Cast_AABox using the four-wide nodes                     *
+ *   AABTreeClass::Cast_OBBox_Wide -- Cast_OBBox using the four-wide nodes                     *
  *   AABTreeClass::Cast_Ray_To_Polys -- cast the ray to polys in the given node                *
  *   AABTreeClass::Cast_Semi_Infinite_Axis_Aligned_Ray_To_Polys -- cast ray to polys in the nod*
  *   AABTreeClass::Cast_AABox_To_Polys -- cast aabox to polys in the given node                *
@@ -75,6 +80,12 @@
 #include "chunkio.h"
 
 
+/*
+** Static members of AABTreeClass
+*/
+bool AABTreeClass::_WideNodesEnabled = true;
+
+
 
 /***********************************************************************************************
  * AABTreeClass::AABTreeClass -- Constructor                                                   *
@@ -121,6 +132,7 @@ AABTreeClass::AABTreeClass(AABTreeBuilderClass * builder)
 
 	int curpolyindex = 0;
 	Build_Tree_Recursive(builder->Root,curpolyindex);
+	Build_Wide_Nodes();
 }
 
 
@@ -192,6 +204,7 @@ AABTreeClass & AABTreeClass::operator = (const AABTreeClass & that)
 	}
 
 	Mesh = that.Mesh;
+	Build_Wide_Nodes();
 
 	return *this;
 }
@@ -224,6 +237,7 @@ void AABTreeClass::Reset(void)
 	if (Mesh) {
 		Mesh = nullptr;
 	}
+	WideNodes.Delete_All();
 }
 
 
@@ -710,6 +724,216 @@ bool AABTreeClass::Intersect_OBBox_Recursive(AABTreeClass::CullNodeStruct * node
 }
 
 
+/***********************************************************************************************
+ * AABTreeClass::Build_Wide_Nodes -- build the four-wide copy of the tree                      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Has to be called whenever the nodes change.                                                 *
+ *                                                                                             *
+ *=============================================================================================*/
+void AABTreeClass::Build_Wide_Nodes(void)
+{
+	WideNodes.Delete_All(false);
+	if ((Nodes != nullptr) && (NodeCount > 0)) {
+		Build_Wide_Nodes_Recursive(0);
+	}
+}
+
+
+/***********************************************************************************************
+ * AABTreeClass::Build_Wide_Nodes_Recursive -- build the wide node below the given node        *
+ *                                                                                             *
+ * The lanes of the wide node are the grandchildren of the given node.  A child which is a     *
+ * leaf goes into a lane itself.  Since only the leaves hold polygons, nothing is lost by      *
+ * never testing the children in between.                                                      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * node_index - node whose grandchildren go into the wide node                                 *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * index of the new wide node or -1 if the node is a leaf                                      *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+int AABTreeClass::Build_Wide_Nodes_Recursive(int node_index)
+{
+	CullNodeStruct * node = &(Nodes[node_index]);
+	if (node->Is_Leaf()) {
+		return -1;
+	}
+
+	int lanes[WideAABNodeStruct::LANE_COUNT];
+	int lane_count = 0;
+
+	int children[2] = { node->Get_Front_Child(), node->Get_Back_Child() };
+	for (int i=0; i<2; i++) {
+		CullNodeStruct * child = &(Nodes[children[i]]);
+		if (child->Is_Leaf()) {
+			lanes[lane_count++] = children[i];
+		} else {
+			lanes[lane_count++] = child->Get_Front_Child();
+			lanes[lane_count++] = child->Get_Back_Child();
+		}
+	}
+
+	WideAABNodeStruct wide;
+	wide.Init();
+	for (int lane=0; lane<lane_count; lane++) {
+		wide.Set_Lane(lane,Nodes[lanes[lane]].Min,Nodes[lanes[lane]].Max,lanes[lane]);
+	}
+
+	int wide_index = WideNodes.Count();
+	WideNodes.Add(wide,NodeCount / 2);
+
+	for (int lane=0; lane<lane_count; lane++) {
+		int child_index = Build_Wide_Nodes_Recursive(lanes[lane]);
+		WideNodes[wide_index].Child[lane] = child_index;
+	}
+	return wide_index;
+}
+
+
+/***********************************************************************************************
+ * AABTreeClass::Cast_Ray_Wide -- Cast_Ray using the four-wide nodes                           *
+ *                                                                                             *
+ * Visits the lanes of each wide node nearest first and skips any that start beyond the        *
+ * closest hit found so far.                                                                   *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * raytest - contains all of the ray test information                                          *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+bool AABTreeClass::Cast_Ray_Wide(RayCollisionTestClass & raytest)
+{
+	if (raytest.Cull(Nodes[0].Min,Nodes[0].Max)) {
+		return false;
+	}
+
+	WideRayQueryClass query;
+	query.Init(raytest.Ray);
+	return Cast_Ray_Wide(0,raytest,query);
+}
+
+bool AABTreeClass::Cast_Ray_Wide(int wide_index,RayCollisionTestClass & raytest,const WideRayQueryClass & query)
+{
+	const WideAABNodeStruct & wide = WideNodes[wide_index];
+
+	float enter[WideAABNodeStruct::LANE_COUNT];
+	int overlap = query.Overlap_Mask(wide,raytest.Result->Fraction,enter);
+	WideAABNodeOrderClass order(overlap,enter);
+
+	bool res = false;
+	for (int i=0; i<order.Count; i++) {
+		int lane = order.Lane[i];
+		if (enter[lane] > raytest.Result->Fraction) {
+			continue;
+		}
+
+		if (wide.Child[lane] != -1) {
+			res = res | Cast_Ray_Wide(wide.Child[lane],raytest,query);
+		} else {
+			res = res | Cast_Ray_To_Polys(&(Nodes[wide.Link[lane]]),raytest);
+		}
+	}
+	return res;
+}
+
+
+/***********************************************************************************************
+ * AABTreeClass::Cast_AABox_Wide -- Cast_AABox using the four-wide nodes                       *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * boxtest - contains description of the collision operation to be performed                   *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+bool AABTreeClass::Cast_AABox_Wide(AABoxCollisionTestClass & boxtest)
+{
+	if (boxtest.Cull(Nodes[0].Min,Nodes[0].Max)) {
+		return false;
+	}
+
+	WideSweepQueryClass query;
+	query.Init_AABox_Sweep(boxtest.Box.Center,boxtest.Box.Extent,boxtest.Move,boxtest.SweepMin,boxtest.SweepMax);
+	return Cast_AABox_Wide(0,boxtest,query);
+}
+
+bool AABTreeClass::Cast_AABox_Wide(int wide_index,AABoxCollisionTestClass & boxtest,const WideSweepQueryClass & query)
+{
+	const WideAABNodeStruct & wide = WideNodes[wide_index];
+	int overlap = query.Overlap_Mask(wide);
+
+	bool res = false;
+	for (int lane=0; lane<WideAABNodeStruct::LANE_COUNT; lane++) {
+		if ((overlap & (1 << lane)) == 0) {
+			continue;
+		}
+
+		if (wide.Child[lane] != -1) {
+			res = res | Cast_AABox_Wide(wide.Child[lane],boxtest,query);
+		} else {
+			res = res | Cast_AABox_To_Polys(&(Nodes[wide.Link[lane]]),boxtest);
+		}
+	}
+	return res;
+}
+
+
+/***********************************************************************************************
+ * AABTreeClass::Cast_OBBox_Wide -- Cast_OBBox using the four-wide nodes                       *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * boxtest - contains description of the collision test to be performed                        *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+bool AABTreeClass::Cast_OBBox_Wide(OBBoxCollisionTestClass & boxtest)
+{
+	if (boxtest.Cull(Nodes[0].Min,Nodes[0].Max)) {
+		return false;
+	}
+
+	WideSweepQueryClass query;
+	query.Init_OBBox_Sweep(boxtest.Box,boxtest.Move,boxtest.SweepMin,boxtest.SweepMax);
+	return Cast_OBBox_Wide(0,boxtest,query);
+}
+
+bool AABTreeClass::Cast_OBBox_Wide(int wide_index,OBBoxCollisionTestClass & boxtest,const WideSweepQueryClass & query)
+{
+	const WideAABNodeStruct & wide = WideNodes[wide_index];
+	int overlap = query.Overlap_Mask(wide);
+
+	bool res = false;
+	for (int lane=0; lane<WideAABNodeStruct::LANE_COUNT; lane++) {
+		if ((overlap & (1 << lane)) == 0) {
+			continue;
+		}
+
+		if (wide.Child[lane] != -1) {
+			res = res | Cast_OBBox_Wide(wide.Child[lane],boxtest,query);
+		} else {
+			res = res | Cast_OBBox_To_Polys(&(Nodes[wide.Link[lane]]),boxtest);
+		}
+	}
+	return res;
+}
+
+
 /***********************************************************************************************
  * AABTreeClass::Cast_Ray_To_Polys -- cast the ray to polys in the given node                  *
  *                                                                                             *
@@ -1154,6 +1378,8 @@ void AABTreeClass::Load_W3D(ChunkLoadClass & cload)
 		}
 		cload.Close_Chunk();
 	}
+
+	Build_Wide_Nodes();
 }
 
 
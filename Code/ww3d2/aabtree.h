@@ -52,6 +52,7 @@
 #include "wwdebug.h"
 #include "aabtreebuilder.h"
 #include "obbox.h"
+#include "aabtreewide.h"
 #include <tri.h>
 #include <float.h>
 
@@ -106,6 +107,13 @@ public:
 	bool						Cast_OBBox(OBBoxCollisionTestClass & boxtest);
 	bool						Intersect_OBBox(OBBoxIntersectionTestClass & boxtest);
 
+	/*
+	** The ray and box casts walk a copy of the tree collapsed into four-wide nodes
+	** (see aabtreewide.h).  It can be turned off to compare against the binary walk.
+	*/
+	static void				Enable_Wide_Nodes(bool onoff)		{ _WideNodesEnabled = onoff; }
+	static bool				Are_Wide_Nodes_Enabled(void)		{ return _WideNodesEnabled; }
+
 private:
 
 	AABTreeClass &			operator = (const AABTreeClass & that);
@@ -200,12 +208,26 @@ private:
 
 	void						Update_Bounding_Boxes_Recursive(CullNodeStruct * node);
 
+	bool						Use_Wide_Nodes(void) const			{ return _WideNodesEnabled && (WideNodes.Count() > 0); }
+	void						Build_Wide_Nodes(void);
+	int						Build_Wide_Nodes_Recursive(int node_index);
+	bool						Cast_Ray_Wide(RayCollisionTestClass & raytest);
+	bool						Cast_AABox_Wide(AABoxCollisionTestClass & boxtest);
+	bool						Cast_OBBox_Wide(OBBoxCollisionTestClass & boxtest);
+	bool						Cast_Ray_Wide(int wide_index,RayCollisionTestClass & raytest,const WideRayQueryClass & query);
+	bool						Cast_AABox_Wide(int wide_index,AABoxCollisionTestClass & boxtest,const WideSweepQueryClass & query);
+	bool						Cast_OBBox_Wide(int wide_index,OBBoxCollisionTestClass & boxtest,const WideSweepQueryClass & query);
+
 	int						NodeCount;			// number of nodes in the tree
 	CullNodeStruct *		Nodes;				// array of nodes
 	int						PolyCount;			// number of polygons in the parent mesh (and the number of indexes in our array)
 	uint32 *					PolyIndices;		// linear array of polygon indices, nodes index into this array
 	MeshGeometryClass *	Mesh;					// pointer to the parent mesh (non-ref-counted; we are a member of this mesh)
 
+	SimpleDynVecClass<WideAABNodeStruct>	WideNodes;	// the tree collapsed into four-wide nodes, the first one is below the root
+
+	static bool				_WideNodesEnabled;
+
 	friend class MeshClass;
 	friend class MeshGeometryClass;
 	friend class AuxMeshDataClass;
@@ -217,12 +239,16 @@ inline int AABTreeClass::Compute_Ram_Size(void)
 {
 	return	NodeCount * sizeof(CullNodeStruct) +
 				PolyCount * sizeof(int) +
+				WideNodes.Count() * sizeof(WideAABNodeStruct) +
 				sizeof(AABTreeClass);
 }
 
 inline bool AABTreeClass::Cast_Ray(RayCollisionTestClass & raytest)
 {
 	WWASSERT(Nodes != nullptr);
+	if (Use_Wide_Nodes()) {
+		return Cast_Ray_Wide(raytest);
+	}
 	return Cast_Ray_Recursive(&(Nodes[0]),raytest);
 }
 
@@ -254,12 +280,18 @@ inline int AABTreeClass::Cast_Semi_Infinite_Axis_Aligned_Ray(const Vector3 & sta
 inline bool AABTreeClass::Cast_AABox(AABoxCollisionTestClass & boxtest)
 {
 	WWASSERT(Nodes != nullptr);
+	if (Use_Wide_Nodes()) {
+		return Cast_AABox_Wide(boxtest);
+	}
 	return Cast_AABox_Recursive(&(Nodes[0]),boxtest);
 }
 
 inline bool AABTreeClass::Cast_OBBox(OBBoxCollisionTestClass & boxtest)
 {
 	WWASSERT(Nodes != nullptr);
+	if (Use_Wide_Nodes()) {
+		return Cast_OBBox_Wide(boxtest);
+	}
 	return Cast_OBBox_Recursive(&(Nodes[0]),boxtest);
 }
 
@@ -273,6 +305,7 @@ inline void AABTreeClass::Update_Bounding_Boxes(void)
 {
 	WWASSERT(Nodes != nullptr);
 	Update_Bounding_Boxes_Recursive(&(Nodes[0]));
+	Build_Wide_Nodes();
 }
 
 
@@ -844,8 +844,25 @@ bool Animatable3DObjClass::Simple_Evaluate_Bone(int boneindex, Matrix3D *tm) con
 
 	} else {
 
-		const_cast <Animatable3DObjClass *>(this)->Update_Sub_Object_Transforms();
-		*tm = HTree->Get_Transform(boneindex);
+		//
+		//	A blend only needs the bone and its parents evaluated, not the whole tree,
+		// unless one of them is captured.
+		//
+		if (CurMotionMode == DOUBLE_ANIM && HTree != nullptr) {
+			retval = HTree->Simple_Evaluate_Pivot (ModeInterp.Motion0, ModeInterp.Frame0,
+																ModeInterp.Motion1, ModeInterp.Frame1, ModeInterp.Percentage,
+																boneindex, Get_Transform (), tm);
+		}
+
+		//
+		//	Anything else needs the whole tree, but only if it has changed
+		//
+		if (!retval) {
+			if (!Is_Hierarchy_Valid ()) {
+				const_cast <Animatable3DObjClass *>(this)->Update_Sub_Object_Transforms();
+			}
+			*tm = HTree->Get_Transform(boneindex);
+		}
 
 	}
 
@@ -38,6 +38,8 @@
  *   WW3DAssetManager::Free -- free all memory (un-needed?)                                    *
  *   WW3DAssetManager::Free_Assets -- Release all loaded assets                                *
  *   WW3DAssetManager::Load_3D_Assets -- Load 3D assets from a .W3D file                       *
+ *   WW3DAssetManager::Open_Asset_Cache -- Maps a baked asset cache                            *
+ *   WW3DAssetManager::Close_Asset_Cache -- Stops using the baked asset cache                  *
  *   WW3DAssetManager::Load_Prototype -- loads a prototype from a W3D chunk                    *
  *   WW3DAssetManager::Create_Render_Obj -- Create a render object for the user                *
  *   WW3DAssetManager::Render_Obj_Exists -- Check whether a render object with the given name  *
@@ -111,6 +113,8 @@
 #include "texture.h"
 #include "wwprofile.h"
 #include "assetstatus.h"
+#include "w3dcache.h"
+#include "ramfile.h"
 
 #include <filesystem>
 
@@ -206,6 +210,8 @@ WW3DAssetManager::WW3DAssetManager(void) :
 
 	WW3D_Load_On_Demand		(false),
 	Activate_Fog_On_Load		(false),
+	ParallelLoadingEnabled	(true),
+	AssetCache					(nullptr),
 	MetalManager(0)
 {
 	assert(TheInstance == nullptr);
@@ -248,6 +254,7 @@ WW3DAssetManager::~WW3DAssetManager(void)
 {
 	if (MetalManager) delete MetalManager;
 	Free();
+	Close_Asset_Cache();
 	TheInstance = nullptr;
 
 	// If we need to, free the hash table
@@ -521,7 +528,21 @@ bool WW3DAssetManager::Load_3D_Assets( const char * filename )
 	FileClass * file = _TheFileFactory->Get_File( filename );
 	if ( file ) {
 		if ( file->Is_Available() ) {
-			result = WW3DAssetManager::Load_3D_Assets( *file );
+
+			/*
+			** Load the baked copy of the file if the asset cache has an up to date one
+			*/
+			const W3DCacheClass::FileStruct * cached = nullptr;
+			if ( AssetCache != nullptr ) {
+				cached = AssetCache->Find_File( filename, *file );
+			}
+
+			if ( cached != nullptr ) {
+				RAMFileClass cached_file( const_cast<unsigned char *>( cached->Data ), cached->Size );
+				result = WW3DAssetManager::Load_3D_Assets( cached_file );
+			} else {
+				result = WW3DAssetManager::Load_3D_Assets( *file );
+			}
 		}
 		_TheFileFactory->Return_File( file );
 	}
@@ -530,6 +551,60 @@ bool WW3DAssetManager::Load_3D_Assets( const char * filename )
 }
 
 
+/***********************************************************************************************
+ * WW3DAssetManager::Open_Asset_Cache -- Maps a baked asset cache                              *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * filename - name of the cache file, as baked by bakew3d                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * true if the cache was opened                                                                *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * The cache is found through the file factory but has to be a loose file, so it can be        *
+ * mapped into memory.                                                                         *
+ *                                                                                             *
+ *=============================================================================================*/
+bool WW3DAssetManager::Open_Asset_Cache( const char * filename )
+{
+	Close_Asset_Cache();
+
+	FileClass * file = _TheFileFactory->Get_File( filename );
+	if ( file == nullptr ) {
+		return false;
+	}
+
+	if ( file->Is_Available() ) {
+		AssetCache = new W3DCacheClass;
+		if ( !AssetCache->Open( file->File_Name() ) ) {
+			delete AssetCache;
+			AssetCache = nullptr;
+		}
+	}
+	_TheFileFactory->Return_File( file );
+
+	return AssetCache != nullptr;
+}
+
+
+/***********************************************************************************************
+ * WW3DAssetManager::Close_Asset_Cache -- Stops using the baked asset cache                    *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Assets already loaded from the cache keep their own copies of everything and stay valid.    *
+ *                                                                                             *
+ *=============================================================================================*/
+void WW3DAssetManager::Close_Asset_Cache( void )
+{
+	delete AssetCache;
+	AssetCache = nullptr;
+}
+
+
 /***********************************************************************************************
  * WW3DAssetManager::Load_3D_Assets -- Load 3D assets from a .W3D file                         *
  *                                                                                             *
@@ -74,6 +74,7 @@ class StreamingTextureClass;
 struct StreamingTextureConfig;
 class TextureClass;
 class MetalMapManagerClass;
+class W3DCacheClass;
 
 /*
 ** AssetIterator
@@ -210,6 +211,43 @@ public:
 	virtual bool						Load_3D_Assets( const char * filename);
 	virtual bool						Load_3D_Assets(FileClass & assetfile);
 
+	/*
+	** Load data from a list of w3d files (see assetmgr_batch.cpp).  The files are read and
+	** their hierarchy trees and animations are parsed on the job pool; registering them and
+	** loading every other kind of prototype is still done one chunk at a time, in file order.
+	** The progress callback, if any, gets the name of each file as its load completes.
+	*/
+	typedef void (*LoadProgressCallback)(const char * filename);
+	virtual bool						Load_3D_Assets(const DynamicVectorClass<StringClass> & filenames, LoadProgressCallback progress = nullptr);
+	void									Enable_Parallel_Loading(bool onoff)		{ ParallelLoadingEnabled = onoff; }
+	bool									Is_Parallel_Loading_Enabled(void) const	{ return ParallelLoadingEnabled; }
+
+	struct LoadStatsStruct
+	{
+		LoadStatsStruct(void)			{ Reset(); }
+		void			Reset(void);
+
+		int			FileCount;			// files loaded through the list version of Load_3D_Assets
+		int			TreeCount;			// hierarchy trees parsed on the job pool
+		int			AnimCount;			// animations parsed on the job pool
+		int			SerialChunkCount;	// chunks loaded one at a time
+		float			ReadTime;			// ms spent reading and parsing files on the job pool
+		float			AnimTime;			// ms spent parsing animations on the job pool
+		float			SerialTime;			// ms spent registering and loading serial chunks
+		float			TotalTime;
+	};
+
+	const LoadStatsStruct &			Get_Load_Stats(void) const						{ return LoadStats; }
+	void									Reset_Load_Stats(void)							{ LoadStats.Reset(); }
+
+	/*
+	** Baked asset cache (see w3dcache.h).  While a cache is open, W3D files it has an up to
+	** date copy of are loaded from the cache instead.  The cache must be a loose file.
+	*/
+	bool									Open_Asset_Cache(const char * filename);
+	void									Close_Asset_Cache(void);
+	W3DCacheClass *					Peek_Asset_Cache(void)							{ return AssetCache; }
+
 	/*
 	** Get rid of all of the currently loaded assets
 	*/
@@ -407,6 +445,17 @@ protected:
 	*/
 	bool									Activate_Fog_On_Load;
 
+	/*
+	** Should lists of files be loaded on the job pool
+	*/
+	bool									ParallelLoadingEnabled;
+	LoadStatsStruct					LoadStats;
+
+	/*
+	** Baked copies of W3D files, nullptr if no cache is open
+	*/
+	W3DCacheClass *					AssetCache;
+
 	// Metal Map Manager
 	MetalMapManagerClass * MetalManager;
 
@@ -0,0 +1,459 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+** Loading lists of W3D files for the WW3DAssetManager.
+**
+** Level loads preload hundreds of W3D files, one Load_3D_Assets call after another.  Here a
+** whole list is loaded in passes:
+**
+** 1. On the job pool, each file is read into memory (or used in place when it is in a mapped
+**    mix file or the asset cache), split into its top level chunks, and its hierarchy trees
+**    are parsed.
+** 2. The trees are registered with the HTreeManager in file order.
+** 3. The animations whose hierarchy tree is now loaded are created, and parsed on the job
+**    pool.  The trees are only looked up during this pass, never added.
+** 4. In file order, the animations are registered with the HAnimManager and every other chunk
+**    is loaded exactly as Load_3D_Assets would.
+**
+** Meshes, HLods and the other prototypes stay in the last, serial pass: their loaders create
+** textures, materials and vertex buffers through the asset manager and the renderer, none of
+** which can be used from more than one thread.  Morph animations look up other animations
+** and are loaded serially too.  The first of several trees or animations with the same name
+** still wins, as the files are registered in the order given.
+*/
+
+#include "assetmgr.h"
+#include "htreemgr.h"
+#include "hanimmgr.h"
+#include "htree.h"
+#include "hrawanim.h"
+#include "hcanim.h"
+#include "chunkio.h"
+#include "ramfile.h"
+#include "ffactory.h"
+#include "w3d_file.h"
+#include "w3dcache.h"
+#include "jobpool.h"
+#include "wwdebug.h"
+#include "wwprofile.h"
+#include "wwmemlog.h"
+
+#include <chrono>
+#include <string.h>
+
+
+namespace
+{
+
+/*
+** One top level chunk of a file in the list
+*/
+struct BatchChunkStruct
+{
+	bool operator== (const BatchChunkStruct &)	{ return false; }
+	bool operator!= (const BatchChunkStruct &)	{ return true; }
+
+	int						Offset;		// offset of the chunk header in the file
+	int						ChunkID;
+	HTreeClass *			Tree;			// parsed on the job pool, nullptr if it failed
+	HAnimClass *			Anim;			// created for the job pool, nullptr if loaded serially
+	bool						AnimLoaded;
+};
+
+struct BatchFileStruct
+{
+	bool operator== (const BatchFileStruct &)		{ return false; }
+	bool operator!= (const BatchFileStruct &)		{ return true; }
+
+	FileClass *				File;
+	bool						IsOpen;
+	const unsigned char *	Data;		// the file's data, in place or in Buffer
+	unsigned char *		Buffer;
+	int						Size;
+	DynamicVectorClass<BatchChunkStruct>	Chunks;
+};
+
+struct BatchAnimJobStruct
+{
+	bool operator== (const BatchAnimJobStruct &)	{ return false; }
+	bool operator!= (const BatchAnimJobStruct &)	{ return true; }
+
+	BatchFileStruct *		File;
+	BatchChunkStruct *	Chunk;
+};
+
+struct BatchLoadStruct
+{
+	const DynamicVectorClass<StringClass> *	Filenames;
+	BatchFileStruct *								Files;
+	DynamicVectorClass<BatchAnimJobStruct>	AnimJobs;
+	W3DCacheClass *								Cache;
+};
+
+
+/*
+** Makes a read-only RAM file over a loaded file, positioned at one of its chunks
+*/
+class BatchChunkFileClass : public RAMFileClass
+{
+public:
+	BatchChunkFileClass(const BatchFileStruct & file, const BatchChunkStruct & chunk) :
+		RAMFileClass(const_cast<unsigned char *>(file.Data), file.Size)
+	{
+		Open(READ);
+		Seek(chunk.Offset, SEEK_SET);
+	}
+};
+
+
+float Elapsed_Ms(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+/*
+** Adds a top level chunk to a file's list, parsing it if it is a hierarchy tree
+*/
+void Add_Chunk(BatchFileStruct & file, int offset, int chunk_id)
+{
+	BatchChunkStruct chunk;
+	chunk.Offset = offset;
+	chunk.ChunkID = chunk_id;
+	chunk.Tree = nullptr;
+	chunk.Anim = nullptr;
+	chunk.AnimLoaded = false;
+
+	if (chunk.ChunkID == W3D_CHUNK_HIERARCHY) {
+		WWMEMLOG(MEM_ANIMATION);
+		BatchChunkFileClass chunk_file(file, chunk);
+		ChunkLoadClass cload(&chunk_file);
+		cload.Open_Chunk();
+		chunk.Tree = new HTreeClass;
+		if (chunk.Tree->Load_W3D(cload) != HTreeClass::OK) {
+			delete chunk.Tree;
+			chunk.Tree = nullptr;
+		}
+		cload.Close_Chunk();
+	}
+
+	file.Chunks.Add(chunk);
+}
+
+
+/*
+** Job: read one file, split it into its top level chunks and parse its hierarchy trees
+*/
+void Read_File_Job(int index, void * user_data)
+{
+	BatchLoadStruct * batch = (BatchLoadStruct *)user_data;
+	BatchFileStruct & file = batch->Files[index];
+	const char * filename = (*batch->Filenames)[index];
+
+	file.File = _TheFileFactory->Get_File(filename);
+	if (file.File == nullptr || !file.File->Is_Available() || !file.File->Open()) {
+		return;
+	}
+	file.IsOpen = true;
+
+	/*
+	** The asset cache has the file's chunks listed already
+	*/
+	const W3DCacheClass::FileStruct * cached = nullptr;
+	if (batch->Cache != nullptr) {
+		cached = batch->Cache->Find_File(filename, *file.File);
+	}
+
+	if (cached != nullptr) {
+		file.Data = cached->Data;
+		file.Size = cached->Size;
+		for (int chunk_index = 0; chunk_index < cached->ChunkCount; chunk_index++) {
+			Add_Chunk(file, (int)cached->Chunks[chunk_index].Offset, (int)cached->Chunks[chunk_index].ChunkID);
+		}
+		return;
+	}
+
+	file.Size = file.File->Size();
+	file.Data = (const unsigned char *)file.File->Peek_Data();
+	if (file.Data == nullptr && file.Size > 0) {
+		file.Buffer = new unsigned char[file.Size];
+		file.Size = file.File->Read(file.Buffer, file.Size);
+		file.Data = file.Buffer;
+	}
+
+	int offset = 0;
+	while (offset + (int)sizeof(ChunkHeader) <= file.Size) {
+		ChunkHeader header;
+		::memcpy(&header, file.Data + offset, sizeof(header));
+		int next = offset + (int)sizeof(header);
+		if ((int)header.Get_Size() > file.Size - next) {
+			WWDEBUG_SAY(("%s: chunk %d runs past the end of the file\n", filename, header.Get_Type()));
+			break;
+		}
+
+		Add_Chunk(file, offset, header.Get_Type());
+		offset = next + (int)header.Get_Size();
+	}
+}
+
+
+/*
+** Job: parse one animation
+*/
+void Load_Anim_Job(int index, void * user_data)
+{
+	BatchLoadStruct * batch = (BatchLoadStruct *)user_data;
+	BatchAnimJobStruct & job = batch->AnimJobs[index];
+	BatchChunkStruct & chunk = *job.Chunk;
+
+	WWMEMLOG(MEM_ANIMATION);
+	BatchChunkFileClass chunk_file(*job.File, chunk);
+	ChunkLoadClass cload(&chunk_file);
+	cload.Open_Chunk();
+
+	if (chunk.ChunkID == W3D_CHUNK_ANIMATION) {
+		chunk.AnimLoaded = (((HRawAnimClass *)chunk.Anim)->Load_W3D(cload) == HRawAnimClass::OK);
+	} else {
+		chunk.AnimLoaded = (((HCompressedAnimClass *)chunk.Anim)->Load_W3D(cload) == HCompressedAnimClass::OK);
+	}
+
+	cload.Close_Chunk();
+}
+
+
+/*
+** Reads the name of the hierarchy tree an animation chunk uses.  The raw and compressed
+** animation headers both start with the version, the name and the hierarchy name.
+*/
+bool Peek_Anim_Hierarchy_Name(const BatchFileStruct & file, const BatchChunkStruct & chunk, char * name)
+{
+	BatchChunkFileClass chunk_file(file, chunk);
+	ChunkLoadClass cload(&chunk_file);
+	cload.Open_Chunk();
+
+	bool found = false;
+	if (cload.Open_Chunk()) {
+		if (	cload.Cur_Chunk_ID() == W3D_CHUNK_ANIMATION_HEADER ||
+				cload.Cur_Chunk_ID() == W3D_CHUNK_COMPRESSED_ANIMATION_HEADER)
+		{
+			W3dAnimHeaderStruct header;
+			if (cload.Read(&header, sizeof(header)) == sizeof(header)) {
+				::memcpy(name, header.HierarchyName, W3D_NAME_LEN);
+				name[W3D_NAME_LEN] = 0;
+				found = true;
+			}
+		}
+		cload.Close_Chunk();
+	}
+
+	cload.Close_Chunk();
+	return found;
+}
+
+} // namespace
+
+
+/***********************************************************************************************
+ * WW3DAssetManager::Load_3D_Assets -- Load 3D assets from a list of .W3D files                *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * filenames - the files to load, in the order they would be passed to Load_3D_Assets          *
+ * progress - called with each filename once that file is loaded, may be nullptr               *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * true if every file was found                                                                *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+bool WW3DAssetManager::Load_3D_Assets(const DynamicVectorClass<StringClass> & filenames, LoadProgressCallback progress)
+{
+	WWPROFILE( "WW3DAssetManager::Load_3D_Assets" );
+
+	if (!ParallelLoadingEnabled) {
+		bool result = true;
+		for (int index = 0; index < filenames.Count(); index++) {
+			result &= Load_3D_Assets(filenames[index]);
+			if (progress != nullptr) {
+				progress(filenames[index]);
+			}
+		}
+		return result;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	BatchLoadStruct batch;
+	batch.Filenames = &filenames;
+	batch.Files = new BatchFileStruct[filenames.Count()];
+	batch.Cache = AssetCache;
+	for (int index = 0; index < filenames.Count(); index++) {
+		batch.Files[index].File = nullptr;
+		batch.Files[index].IsOpen = false;
+		batch.Files[index].Data = nullptr;
+		batch.Files[index].Buffer = nullptr;
+		batch.Files[index].Size = 0;
+	}
+
+	/*
+	** Read the files and parse their trees
+	*/
+	JobPoolClass::Run(filenames.Count(), Read_File_Job, &batch);
+	LoadStats.ReadTime += Elapsed_Ms(start);
+
+	/*
+	** Register the trees, then set up the animations whose tree is loaded.  Looking a tree
+	** up may load it on demand, so this has to be done before the animations are parsed.
+	*/
+	auto serial_start = std::chrono::steady_clock::now();
+	for (int file_index = 0; file_index < filenames.Count(); file_index++) {
+		BatchFileStruct & file = batch.Files[file_index];
+		for (int chunk_index = 0; chunk_index < file.Chunks.Count(); chunk_index++) {
+			BatchChunkStruct & chunk = file.Chunks[chunk_index];
+			if (chunk.Tree != nullptr) {
+				HTreeManager.Add_Tree(chunk.Tree);
+				chunk.Tree = nullptr;
+				LoadStats.TreeCount++;
+			}
+		}
+	}
+
+	for (int file_index = 0; file_index < filenames.Count(); file_index++) {
+		BatchFileStruct & file = batch.Files[file_index];
+		for (int chunk_index = 0; chunk_index < file.Chunks.Count(); chunk_index++) {
+			BatchChunkStruct & chunk = file.Chunks[chunk_index];
+			if (chunk.ChunkID != W3D_CHUNK_ANIMATION && chunk.ChunkID != W3D_CHUNK_COMPRESSED_ANIMATION) {
+				continue;
+			}
+
+			char tree_name[W3D_NAME_LEN + 1];
+			if (!Peek_Anim_Hierarchy_Name(file, chunk, tree_name) || Get_HTree(tree_name) == nullptr) {
+				continue;
+			}
+
+			if (chunk.ChunkID == W3D_CHUNK_ANIMATION) {
+				chunk.Anim = new HRawAnimClass;
+			} else {
+				chunk.Anim = new HCompressedAnimClass;
+			}
+			SET_REF_OWNER( chunk.Anim );
+
+			BatchAnimJobStruct job;
+			job.File = &file;
+			job.Chunk = &chunk;
+			batch.AnimJobs.Add(job);
+		}
+	}
+	LoadStats.SerialTime += Elapsed_Ms(serial_start);
+
+	/*
+	** Parse the animations
+	*/
+	auto anim_start = std::chrono::steady_clock::now();
+	JobPoolClass::Run(batch.AnimJobs.Count(), Load_Anim_Job, &batch);
+	LoadStats.AnimCount += batch.AnimJobs.Count();
+	LoadStats.AnimTime += Elapsed_Ms(anim_start);
+
+	/*
+	** Register the animations and load everything else in file order
+	*/
+	serial_start = std::chrono::steady_clock::now();
+	bool result = true;
+	for (int file_index = 0; file_index < filenames.Count(); file_index++) {
+		BatchFileStruct & file = batch.Files[file_index];
+		if (!file.IsOpen) {
+			result = false;
+		}
+
+		for (int chunk_index = 0; chunk_index < file.Chunks.Count(); chunk_index++) {
+			BatchChunkStruct & chunk = file.Chunks[chunk_index];
+
+			if (chunk.ChunkID == W3D_CHUNK_HIERARCHY) {
+				continue;
+			}
+
+			if (chunk.Anim != nullptr) {
+				if (chunk.AnimLoaded && HAnimManager.Peek_Anim(chunk.Anim->Get_Name()) == nullptr) {
+					HAnimManager.Add_Anim(chunk.Anim);
+				}
+				chunk.Anim->Release_Ref();
+				chunk.Anim = nullptr;
+				continue;
+			}
+
+			BatchChunkFileClass chunk_file(file, chunk);
+			ChunkLoadClass cload(&chunk_file);
+			cload.Open_Chunk();
+
+			switch (chunk.ChunkID) {
+
+				case W3D_CHUNK_ANIMATION:
+				case W3D_CHUNK_COMPRESSED_ANIMATION:
+				case W3D_CHUNK_MORPH_ANIMATION:
+					HAnimManager.Load_Anim(cload);
+					break;
+
+				default:
+					Load_Prototype(cload);
+					break;
+			}
+
+			cload.Close_Chunk();
+			LoadStats.SerialChunkCount++;
+		}
+
+		if (file.File != nullptr) {
+			if (file.IsOpen) {
+				file.File->Close();
+			}
+			_TheFileFactory->Return_File(file.File);
+		}
+		delete [] file.Buffer;
+
+		if (progress != nullptr) {
+			progress(filenames[file_index]);
+		}
+	}
+	delete [] batch.Files;
+
+	LoadStats.SerialTime += Elapsed_Ms(serial_start);
+	LoadStats.FileCount += filenames.Count();
+	LoadStats.TotalTime += Elapsed_Ms(start);
+	return result;
+}
+
+
+/******************************************************************************************
+**
+**
+** WW3DAssetManager::LoadStatsStruct Implementation
+**
+**
+******************************************************************************************/
+void WW3DAssetManager::LoadStatsStruct::Reset(void)
+{
+	FileCount = 0;
+	TreeCount = 0;
+	AnimCount = 0;
+	SerialChunkCount = 0;
+	ReadTime = 0.0f;
+	AnimTime = 0.0f;
+	SerialTime = 0.0f;
+	TotalTime = 0.0f;
+}
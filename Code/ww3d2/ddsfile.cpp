@@ -22,6 +22,8 @@
 #include "formconv.h"
 #include "dx8wrapper.h"
 #include "bitmaphandler.h"
+#include "mappedfile.h"
+#include "refcount.h"
 #include <string.h>
 
 // ----------------------------------------------------------------------------
@@ -29,6 +31,8 @@
 DDSFileClass::DDSFileClass(const char* name,unsigned reduction_factor)
 	:
 	DDSMemory(nullptr),
+	DDSData(nullptr),
+	DDSMapping(nullptr),
 	Width(0),
 	Height(0),
 	FullWidth(0),
@@ -119,6 +123,7 @@ DDSFileClass::DDSFileClass(const char* name,unsigned reduction_factor)
 DDSFileClass::~DDSFileClass()
 {
 	delete[] DDSMemory;
+	REF_PTR_RELEASE(DDSMapping);
 	delete[] LevelSizes;
 	delete[] LevelOffsets;
 }
@@ -142,7 +147,7 @@ unsigned DDSFileClass::Get_Height(unsigned level) const
 const unsigned char* DDSFileClass::Get_Memory_Pointer(unsigned level) const
 {
 	WWASSERT(level<MipLevels);
-	return DDSMemory+LevelOffsets[level];
+	return DDSData+LevelOffsets[level];
 }
 
 unsigned DDSFileClass::Get_Level_Size(unsigned level) const
@@ -176,7 +181,7 @@ unsigned DDSFileClass::Calculate_DXTC_Surface_Size(unsigned width, unsigned heig
 
 bool DDSFileClass::Load()
 {
-	if (DDSMemory) return false;
+	if (DDSData) return false;
 	if (!LevelSizes || !LevelOffsets) return false;
 
 	file_auto_ptr file(_TheFileFactory,Name);
@@ -203,12 +208,21 @@ bool DDSFileClass::Load()
 	WWASSERT(seek_size==(SurfaceDesc.Size+4+skipped_offset));
 
 	if (size) {
-		// Allocate memory for the data excluding the headers
-		DDSMemory=new unsigned char[size];
-		// Read data
-		[[maybe_unused]] unsigned read_size=file->Read(DDSMemory,size);
-		// Verify we got all the data
-		WWASSERT(read_size==size);
+		// Files in a mapped mix file can be used in place, without the copy. Keep the
+		// mapping alive for as long as we point into it, the file goes back right away.
+		const unsigned char* mapped=static_cast<const unsigned char*>(file->Peek_Data());
+		if (mapped && file->Peek_Mapping()) {
+			REF_PTR_SET(DDSMapping,file->Peek_Mapping());
+			DDSData=mapped+SurfaceDesc.Size+4+skipped_offset;
+		} else {
+			// Allocate memory for the data excluding the headers
+			DDSMemory=new unsigned char[size];
+			// Read data
+			[[maybe_unused]] unsigned read_size=file->Read(DDSMemory,size);
+			// Verify we got all the data
+			WWASSERT(read_size==size);
+			DDSData=DDSMemory;
+		}
 	}
 	file->Close();
 	return true;
@@ -262,7 +276,7 @@ void DDSFileClass::Copy_Level_To_Surface(
 	unsigned char* dest_surface,
 	unsigned dest_pitch)
 {
-	WWASSERT(DDSMemory);
+	WWASSERT(DDSData);
 	WWASSERT(dest_surface);
 
 	// If the format and size is a match just copy the contents
@@ -28,6 +28,7 @@
 #include "wwstring.h"
 
 struct IDirect3DSurface9;
+class MappedFileClass;
 
 // ----------------------------------------------------------------------------
 //
@@ -170,6 +171,8 @@ class DDSFileClass
 	unsigned int DateTime;
 	unsigned ReductionFactor;
 	unsigned char* DDSMemory;
+	const unsigned char* DDSData;	// DDSMemory, or the data in place if the file is memory mapped
+	MappedFileClass* DDSMapping;	// the mapping DDSData points into, referenced until we're done with it
 	WW3DFormat Format;
 	unsigned* LevelSizes;
 	unsigned* LevelOffsets;
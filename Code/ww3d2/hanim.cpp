@@ -33,10 +33,12 @@
  *                                                                                             *
  *---------------------------------------------------------------------------------------------*
  * Functions:                                                                                  *
+ *   HAnimClass::Get_Pose -- decodes every pivot of a pose at the given frame                  *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 
 #include "hanim.h"
+#include "hanimpose.h"
 #include "assetmgr.h"
 #include "htree.h"
 #include "motchan.h"
@@ -48,6 +50,37 @@
 
 
 
+std::atomic<unsigned int> HAnimClass::_SerialCounter(0);
+
+
+/***********************************************************************************************
+ * HAnimClass::Get_Pose -- decodes every pivot of a pose at the given frame                    *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * pose - pose to fill in, its pivot count says how many pivots to decode                      *
+ * frame - frame of the animation                                                              *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * This default version asks for each pivot in turn, animation formats override it to decode  *
+ * all of their channels in one pass.                                                          *
+ *                                                                                             *
+ *=============================================================================================*/
+void HAnimClass::Get_Pose(HAnimPoseClass & pose,float frame)
+{
+	WWASSERT(pose.Get_Pivot_Count() <= Get_Num_Pivots());
+
+	for (int pividx = 0; pividx < pose.Get_Pivot_Count(); pividx++) {
+		Vector3 trans;
+		Quaternion q;
+		Get_Translation(trans,pividx,frame);
+		Get_Orientation(q,pividx,frame);
+		pose.Set_Pivot(pividx,trans,q,Get_Visibility(pividx,frame));
+	}
+}
+
+
 /*
 **
 **	HAnimComboClass
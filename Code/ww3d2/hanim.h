@@ -52,6 +52,7 @@
 #include <refcount.h>
 #include <slist.h>
 #include <vector.h>
+#include <atomic>
 
 struct NodeMotionStruct;
 class MotionChannelClass;
@@ -60,6 +61,7 @@ class HTreeClass;
 class ChunkLoadClass;
 class ChunkSaveClass;
 class HTreeClass;
+class HAnimPoseClass;
 
 
 
@@ -77,7 +79,8 @@ class HAnimClass : public RefCountClass, public	HashableClass
 public:
 
 	HAnimClass(void)	:
-		HasEmbeddedSounds (false)	{ }
+		HasEmbeddedSounds (false),
+		SerialNumber (++_SerialCounter)	{ }
 	virtual ~HAnimClass(void)		{ }
 
 	virtual const char *		Get_Name(void) const = 0;
@@ -99,6 +102,9 @@ public:
 	virtual void				Get_Transform(Matrix3D&, int pividx, float frame) const = 0;
 	virtual bool				Get_Visibility(int pividx,float frame) = 0;
 
+	// Decodes every pivot of the pose (pose.Get_Pivot_Count()) at the given frame in one call.
+	virtual void				Get_Pose(HAnimPoseClass & pose,float frame);
+
 	virtual int					Get_Num_Pivots(void) const = 0;
 	virtual bool				Is_Node_Motion_Present(int pividx) = 0;
 
@@ -113,8 +119,16 @@ public:
 	virtual bool				Has_Embedded_Sounds (void) const			{ return HasEmbeddedSounds; }
 	virtual void				Set_Has_Embedded_Sounds (bool onoff)	{ HasEmbeddedSounds = onoff; }
 
+	// Unique to this animation for the life of the program, so caches can be keyed on the
+	// animation without holding a reference to it.
+	unsigned int				Get_Serial_Number (void) const			{ return SerialNumber; }
+
 protected:
 	bool							HasEmbeddedSounds;
+
+private:
+	unsigned int							SerialNumber;
+	static std::atomic<unsigned int>	_SerialCounter;
 };
 
 
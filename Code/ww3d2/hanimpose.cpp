@@ -0,0 +1,356 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***                            Confidential - Westwood Studios                              ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Commando / G 3D Library                                      *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/ww3d2/hanimpose.cpp                          $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   HAnimPoseClass::Init -- sets the number of pivots in the pose                             *
+ *   HAnimPoseClass::Blend -- sets this pose to a blend of two others                          *
+ *   HAnimPoseClass::Build_Transforms -- turns every pivot of the pose into a matrix           *
+ *   HAnimPoseCacheClass::Get_Pose -- returns a decoded pose, sharing recently decoded ones    *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "hanimpose.h"
+#include "hanim.h"
+#include "widefloat.h"
+#include "wwmath.h"
+#include "wwdebug.h"
+
+#include <string.h>
+
+
+/*
+** Each of the seven channels gets Capacity floats in one allocation
+*/
+#define POSE_CHANNEL_COUNT		7
+
+
+HAnimPoseClass::HAnimPoseClass(void) :
+	TX(nullptr),
+	TY(nullptr),
+	TZ(nullptr),
+	QX(nullptr),
+	QY(nullptr),
+	QZ(nullptr),
+	QW(nullptr),
+	Visible(nullptr),
+	Channels(nullptr),
+	Transforms(nullptr),
+	PivotCount(0),
+	Capacity(0),
+	TransformsBuilt(false),
+	TransformScale(1.0f)
+{
+}
+
+HAnimPoseClass::~HAnimPoseClass(void)
+{
+	delete [] Channels;
+	delete [] Transforms;
+	delete [] Visible;
+}
+
+
+/***********************************************************************************************
+ * HAnimPoseClass::Init -- sets the number of pivots in the pose                               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * pivot_count - number of pivots                                                              *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * The arrays only grow, so a pose that is re-used doesn't allocate once it has seen its       *
+ * largest skeleton.                                                                           *
+ *                                                                                             *
+ *=============================================================================================*/
+void HAnimPoseClass::Init(int pivot_count)
+{
+	int padded = (pivot_count + 3) & ~3;
+
+	if (padded > Capacity) {
+		delete [] Channels;
+		delete [] Transforms;
+		delete [] Visible;
+
+		Capacity = padded;
+		Channels = new float[Capacity * POSE_CHANNEL_COUNT];
+		Transforms = new Matrix3D[Capacity];
+		Visible = new bool[Capacity];
+
+		TX = Channels;
+		TY = TX + Capacity;
+		TZ = TY + Capacity;
+		QX = TZ + Capacity;
+		QY = QX + Capacity;
+		QZ = QY + Capacity;
+		QW = QZ + Capacity;
+	}
+
+	PivotCount = pivot_count;
+	TransformsBuilt = false;
+
+	for (int pividx = pivot_count; pividx < padded; pividx++) {
+		Set_Pivot(pividx,Vector3(0.0f,0.0f,0.0f),Quaternion(true),true);
+	}
+}
+
+
+/***********************************************************************************************
+ * HAnimPoseClass::Blend -- sets this pose to a blend of two others                            *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * pose0, pose1 - poses to blend, must have the same number of pivots as this one              *
+ * percentage - 0.0 = pose0, 1.0 = pose1                                                       *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+void HAnimPoseClass::Blend(const HAnimPoseClass & pose0,const HAnimPoseClass & pose1,float percentage)
+{
+	WWASSERT(pose0.PivotCount == PivotCount);
+	WWASSERT(pose1.PivotCount == PivotCount);
+
+	TransformsBuilt = false;
+
+	WideFloat w0 = Wide_Splat(1.0f - percentage);
+	WideFloat w1 = Wide_Splat(percentage);
+
+	for (int pividx = 0; pividx < PivotCount; pividx += 4) {
+
+		/*
+		** Translations are lerped
+		*/
+		Wide_Store(TX + pividx,Wide_Add(Wide_Mul(w0,Wide_Load(pose0.TX + pividx)),Wide_Mul(w1,Wide_Load(pose1.TX + pividx))));
+		Wide_Store(TY + pividx,Wide_Add(Wide_Mul(w0,Wide_Load(pose0.TY + pividx)),Wide_Mul(w1,Wide_Load(pose1.TY + pividx))));
+		Wide_Store(TZ + pividx,Wide_Add(Wide_Mul(w0,Wide_Load(pose0.TZ + pividx)),Wide_Mul(w1,Wide_Load(pose1.TZ + pividx))));
+
+		/*
+		** Orientations are slerped.  The angle between the quaternions is found four at a
+		** time, the weights are worked out for each lane the way Fast_Slerp does it (it
+		** looks them up in tables) and then the quaternions are summed four at a time again.
+		*/
+		WideFloat px = Wide_Load(pose0.QX + pividx);
+		WideFloat py = Wide_Load(pose0.QY + pividx);
+		WideFloat pz = Wide_Load(pose0.QZ + pividx);
+		WideFloat pw = Wide_Load(pose0.QW + pividx);
+		WideFloat qx = Wide_Load(pose1.QX + pividx);
+		WideFloat qy = Wide_Load(pose1.QY + pividx);
+		WideFloat qz = Wide_Load(pose1.QZ + pividx);
+		WideFloat qw = Wide_Load(pose1.QW + pividx);
+
+		float cos_t[4];
+		Wide_Store(cos_t,Wide_Add(Wide_Add(Wide_Mul(px,qx),Wide_Mul(py,qy)),Wide_Add(Wide_Mul(pz,qz),Wide_Mul(pw,qw))));
+
+		float beta[4];
+		float alpha[4];
+		for (int lane = 0; lane < 4; lane++) {
+			bool qflip = (cos_t[lane] < 0.0f);
+			float cos_lane = qflip ? -cos_t[lane] : cos_t[lane];
+
+			if (1.0f - cos_lane < WWMATH_EPSILON * WWMATH_EPSILON) {
+				beta[lane] = 1.0f - percentage;
+				alpha[lane] = percentage;
+			} else {
+				float theta = WWMath::Fast_Acos(cos_lane);
+				float oo_sin_t = 1.0f / WWMath::Fast_Sin(theta);
+				beta[lane] = WWMath::Fast_Sin(theta - percentage*theta) * oo_sin_t;
+				alpha[lane] = WWMath::Fast_Sin(percentage*theta) * oo_sin_t;
+			}
+
+			if (qflip) {
+				alpha[lane] = -alpha[lane];
+			}
+		}
+
+		WideFloat b = Wide_Load(beta);
+		WideFloat a = Wide_Load(alpha);
+		Wide_Store(QX + pividx,Wide_Add(Wide_Mul(b,px),Wide_Mul(a,qx)));
+		Wide_Store(QY + pividx,Wide_Add(Wide_Mul(b,py),Wide_Mul(a,qy)));
+		Wide_Store(QZ + pividx,Wide_Add(Wide_Mul(b,pz),Wide_Mul(a,qz)));
+		Wide_Store(QW + pividx,Wide_Add(Wide_Mul(b,pw),Wide_Mul(a,qw)));
+	}
+
+	for (int pividx = 0; pividx < PivotCount; pividx++) {
+		Visible[pividx] = pose0.Visible[pividx] || pose1.Visible[pividx];
+	}
+}
+
+
+/***********************************************************************************************
+ * HAnimPoseClass::Build_Transforms -- turns every pivot of the pose into a matrix             *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * scale - scale applied to the translations (HTreeClass::Scale)                               *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * The rotation is built the same way as Build_Matrix3D(Quaternion) but in single precision.   *
+ *                                                                                             *
+ *=============================================================================================*/
+void HAnimPoseClass::Build_Transforms(float scale)
+{
+	WideFloat one = Wide_Splat(1.0f);
+	WideFloat s = Wide_Splat(scale);
+
+	for (int pividx = 0; pividx < PivotCount; pividx += 4) {
+
+		WideFloat x = Wide_Load(QX + pividx);
+		WideFloat y = Wide_Load(QY + pividx);
+		WideFloat z = Wide_Load(QZ + pividx);
+		WideFloat w = Wide_Load(QW + pividx);
+
+		WideFloat x2 = Wide_Add(x,x);
+		WideFloat y2 = Wide_Add(y,y);
+		WideFloat z2 = Wide_Add(z,z);
+
+		WideFloat xx = Wide_Mul(x,x2);
+		WideFloat yy = Wide_Mul(y,y2);
+		WideFloat zz = Wide_Mul(z,z2);
+		WideFloat xy = Wide_Mul(x,y2);
+		WideFloat yz = Wide_Mul(y,z2);
+		WideFloat zx = Wide_Mul(z,x2);
+		WideFloat xw = Wide_Mul(w,x2);
+		WideFloat yw = Wide_Mul(w,y2);
+		WideFloat zw = Wide_Mul(w,z2);
+
+		/*
+		** One register per matrix element, then transpose each row so every register holds
+		** one row of one pivot's matrix.
+		*/
+		WideFloat m00 = Wide_Sub(one,Wide_Add(yy,zz));
+		WideFloat m01 = Wide_Sub(xy,zw);
+		WideFloat m02 = Wide_Add(zx,yw);
+		WideFloat m03 = Wide_Mul(Wide_Load(TX + pividx),s);
+		Wide_Transpose(m00,m01,m02,m03);
+
+		WideFloat m10 = Wide_Add(xy,zw);
+		WideFloat m11 = Wide_Sub(one,Wide_Add(zz,xx));
+		WideFloat m12 = Wide_Sub(yz,xw);
+		WideFloat m13 = Wide_Mul(Wide_Load(TY + pividx),s);
+		Wide_Transpose(m10,m11,m12,m13);
+
+		WideFloat m20 = Wide_Sub(zx,yw);
+		WideFloat m21 = Wide_Add(yz,xw);
+		WideFloat m22 = Wide_Sub(one,Wide_Add(yy,xx));
+		WideFloat m23 = Wide_Mul(Wide_Load(TZ + pividx),s);
+		Wide_Transpose(m20,m21,m22,m23);
+
+		Matrix3D * tm = Transforms + pividx;
+		Wide_Store(&tm[0][0][0],m00);	Wide_Store(&tm[0][1][0],m10);	Wide_Store(&tm[0][2][0],m20);
+		Wide_Store(&tm[1][0][0],m01);	Wide_Store(&tm[1][1][0],m11);	Wide_Store(&tm[1][2][0],m21);
+		Wide_Store(&tm[2][0][0],m02);	Wide_Store(&tm[2][1][0],m12);	Wide_Store(&tm[2][2][0],m22);
+		Wide_Store(&tm[3][0][0],m03);	Wide_Store(&tm[3][1][0],m13);	Wide_Store(&tm[3][2][0],m23);
+	}
+
+	TransformsBuilt = true;
+	TransformScale = scale;
+}
+
+
+/*
+** The pose cache is two-way set associative.  The way used last in each set is remembered
+** and the other one is replaced, so the last two poses handed out are never replaced by the
+** next one.
+*/
+#define POSE_CACHE_SET_COUNT		16
+
+bool					HAnimPoseCacheClass::_Enabled = false;
+bool					HAnimPoseCacheClass::_FrameSnapEnabled = false;
+std::atomic<int>	HAnimPoseCacheClass::_HitCount(0);
+std::atomic<int>	HAnimPoseCacheClass::_MissCount(0);
+
+struct PoseCacheEntryStruct
+{
+	PoseCacheEntryStruct(void) : Serial(0), Frame(0.0f), PivotCount(0) { }
+
+	unsigned int		Serial;			// serial number of the animation, 0 when unused
+	float					Frame;
+	int					PivotCount;
+	HAnimPoseClass		Pose;
+};
+
+struct PoseCacheSetStruct
+{
+	PoseCacheSetStruct(void) : LastUsed(0) { }
+
+	PoseCacheEntryStruct	Way[2];
+	int						LastUsed;
+};
+
+static thread_local PoseCacheSetStruct		_PoseCache[POSE_CACHE_SET_COUNT];
+
+
+/***********************************************************************************************
+ * HAnimPoseCacheClass::Get_Pose -- returns a decoded pose, sharing recently decoded ones      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * motion - animation to decode                                                                *
+ * frame - frame of the animation                                                              *
+ * pivot_count - number of pivots to decode                                                    *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * the pose, owned by the cache                                                                *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Only the two poses returned last on this thread stay valid.                                 *
+ *                                                                                             *
+ *=============================================================================================*/
+HAnimPoseClass & HAnimPoseCacheClass::Get_Pose(HAnimClass * motion,float frame,int pivot_count)
+{
+	if (_FrameSnapEnabled) {
+		int last_frame = MAX(motion->Get_Num_Frames() - 1,0);
+		frame = (float)MIN((int)(frame + 0.5f),last_frame);
+	}
+
+	unsigned int serial = motion->Get_Serial_Number();
+	unsigned int frame_bits;
+	::memcpy(&frame_bits,&frame,sizeof(frame_bits));
+
+	PoseCacheSetStruct & set = _PoseCache[((serial * 2654435761u) ^ frame_bits ^ (frame_bits >> 16)) % POSE_CACHE_SET_COUNT];
+
+	for (int way = 0; way < 2; way++) {
+		PoseCacheEntryStruct & entry = set.Way[way];
+		if (entry.Serial == serial && entry.Frame == frame && entry.PivotCount == pivot_count) {
+			set.LastUsed = way;
+			_HitCount++;
+			return entry.Pose;
+		}
+	}
+
+	set.LastUsed ^= 1;
+	PoseCacheEntryStruct & entry = set.Way[set.LastUsed];
+	entry.Serial = serial;
+	entry.Frame = frame;
+	entry.PivotCount = pivot_count;
+	entry.Pose.Init(pivot_count);
+	motion->Get_Pose(entry.Pose,frame);
+
+	_MissCount++;
+	return entry.Pose;
+}
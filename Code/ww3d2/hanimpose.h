@@ -0,0 +1,173 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***                            Confidential - Westwood Studios                              ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Commando / G 3D Library                                      *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/ww3d2/hanimpose.h                            $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef HANIMPOSE_H
+#define HANIMPOSE_H
+
+#include "always.h"
+#include "matrix3d.h"
+#include "quat.h"
+#include "vector3.h"
+
+#include <atomic>
+
+class HAnimClass;
+
+
+/*
+
+	HAnimPoseClass
+
+	The translation, orientation and visibility of every pivot of an animation at one frame.
+	The channels are stored one array per component so that four pivots can be blended and
+	turned into matrices at once with the wide math in widefloat.h.  The arrays are padded
+	out to a multiple of four pivots; the padding always holds the identity.
+
+	HAnimClass::Get_Pose fills one of these in, HTreeClass::Anim_Update and Blend_Update
+	use them to evaluate the whole skeleton.
+
+*/
+class HAnimPoseClass
+{
+public:
+
+	HAnimPoseClass(void);
+	~HAnimPoseClass(void);
+
+	/*
+	** Sets the number of pivots in the pose.  The pivots are left undefined.
+	*/
+	void						Init(int pivot_count);
+	int						Get_Pivot_Count(void) const							{ return PivotCount; }
+
+	void						Set_Pivot(int pividx,const Vector3 & trans,const Quaternion & q,bool visible);
+
+	/*
+	** Sets this pose to a blend of two others, 0.0 gives pose0, 1.0 gives pose1.  Either may
+	** be this pose.  The orientations are interpolated with the same weights as Fast_Slerp,
+	** visibility is or'ed together.
+	*/
+	void						Blend(const HAnimPoseClass & pose0,const HAnimPoseClass & pose1,float percentage);
+
+	/*
+	** Turns every pivot into a matrix; the translation is scaled by scale.  The matrices are
+	** kept until the pose is changed with Init or Blend.
+	*/
+	void						Build_Transforms(float scale);
+	bool						Are_Transforms_Built(float scale) const			{ return TransformsBuilt && (TransformScale == scale); }
+	const Matrix3D &		Get_Transform(int pividx) const						{ return Transforms[pividx]; }
+
+	float *					TX;
+	float *					TY;
+	float *					TZ;
+	float *					QX;
+	float *					QY;
+	float *					QZ;
+	float *					QW;
+	bool *					Visible;
+
+private:
+
+	HAnimPoseClass(const HAnimPoseClass &) = delete;
+	HAnimPoseClass & operator=(const HAnimPoseClass &) = delete;
+
+	float *					Channels;
+	Matrix3D *				Transforms;
+	int						PivotCount;
+	int						Capacity;
+	bool						TransformsBuilt;
+	float						TransformScale;
+};
+
+
+/*
+
+	HAnimPoseCacheClass
+
+	Remembers the poses decoded most recently on each thread, so that trees playing the same
+	animation at the same frame decode it (and build its matrices) once between them.  Poses
+	are keyed on the animation's serial number, so the cache never holds a reference to an
+	animation.
+
+	With frame snapping on, frames are rounded to the nearest whole frame first.  Many more
+	trees then share poses, at the cost of the in-between frames; dedicated servers use this
+	for the hit boxes of soldiers and vehicles.
+
+*/
+class HAnimPoseCacheClass
+{
+public:
+
+	static void				Enable(bool onoff)										{ _Enabled = onoff; }
+	static bool				Is_Enabled(void)											{ return _Enabled; }
+	static void				Enable_Frame_Snap(bool onoff)							{ _FrameSnapEnabled = onoff; }
+	static bool				Is_Frame_Snap_Enabled(void)							{ return _FrameSnapEnabled; }
+
+	/*
+	** Returns the first pivot_count pivots of motion at frame.  The two poses returned last
+	** on a thread stay valid; the caller may build their transforms but not change them.
+	*/
+	static HAnimPoseClass &	Get_Pose(HAnimClass * motion,float frame,int pivot_count);
+
+	/*
+	** Get_Pose results since the last reset
+	*/
+	static int				Get_Hit_Count(void)										{ return _HitCount; }
+	static int				Get_Miss_Count(void)										{ return _MissCount; }
+	static void				Reset_Stats(void)											{ _HitCount = 0; _MissCount = 0; }
+
+private:
+
+	static bool					_Enabled;
+	static bool					_FrameSnapEnabled;
+	static std::atomic<int>	_HitCount;
+	static std::atomic<int>	_MissCount;
+};
+
+
+inline void HAnimPoseClass::Set_Pivot(int pividx,const Vector3 & trans,const Quaternion & q,bool visible)
+{
+	TX[pividx] = trans.X;
+	TY[pividx] = trans.Y;
+	TZ[pividx] = trans.Z;
+	QX[pividx] = q.X;
+	QY[pividx] = q.Y;
+	QZ[pividx] = q.Z;
+	QW[pividx] = q.W;
+	Visible[pividx] = visible;
+}
+
+
+#endif
@@ -99,6 +99,7 @@ public:
 	void							Get_Orientation(Quaternion& orientation, int pividx,float frame) const override;
 	void							Get_Transform(Matrix3D& transform, int pividx,float frame) const override;
 	bool							Get_Visibility(int pividx,float frame) override;
+	void							Get_Pose(HAnimPoseClass & pose,float frame) override;
 
 	bool							Is_Node_Motion_Present(int pividx) override;
 	int							Get_Num_Pivots(void) const override	{ return NumNodes; }
@@ -41,6 +41,7 @@
  *   HTreeClass::Base_Update -- Computes the base pose transform for each pivot                *
  *   HTreeClass::Anim_Update -- Computes the transform for each pivot with motion              *
  *   HTreeClass::Blend_Update -- computes each pivot as a blend of two anims                   *
+ *   HTreeClass::Pose_Update -- computes the transform for each pivot from a decoded pose      *
  *   HTreeClass::Combo_Update -- compute each pivot's transform using an anim combo            *
  *   HTreeClass::Get_Transform -- returns the transformation for the desired pivot             *
  *   HTreeClass::Find_Bone -- Find a bone by name                                              *
@@ -54,6 +55,8 @@
 #include "htree.h"
 #include "hanim.h"
 #include "hcanim.h"
+#include "hanimpose.h"
+#include "widefloat.h"
 #include <string.h>
 #include <assert.h>
 #include "wwmath.h"
@@ -62,6 +65,35 @@
 #include "wwmemlog.h"
 
 
+bool HTreeClass::_BatchedPosesEnabled = true;
+
+/*
+** Poses used by Anim_Update and Blend_Update.  Each thread gets its own pair so that trees
+** can be updated on several threads; they are re-used so updating doesn't allocate.
+*/
+static thread_local HAnimPoseClass	_Pose0;
+static thread_local HAnimPoseClass	_Pose1;
+
+
+/*
+** res = a * b, each row of the result is built as a weighted sum of the rows of b.
+** res must not be a or b.
+*/
+static inline void Multiply_Wide(const Matrix3D & a,const Matrix3D & b,Matrix3D * res)
+{
+	WideFloat b0 = Wide_Load(&b[0][0]);
+	WideFloat b1 = Wide_Load(&b[1][0]);
+	WideFloat b2 = Wide_Load(&b[2][0]);
+
+	for (int row = 0; row < 3; row++) {
+		WideFloat r = Wide_Add(	Wide_Add(Wide_Mul(Wide_Splat(a[row][0]),b0),Wide_Mul(Wide_Splat(a[row][1]),b1)),
+										Wide_Mul(Wide_Splat(a[row][2]),b2));
+		Wide_Store(&(*res)[row][0],r);
+		(*res)[row][3] += a[row][3];
+	}
+}
+
+
 /***********************************************************************************************
  * HTreeClass::HTreeClass -- constructor                                                       *
  *                                                                                             *
@@ -485,6 +517,90 @@ bool HTreeClass::Simple_Evaluate_Pivot
 }
 
 
+/***********************************************************************************************
+ * HTreeClass::Simple_Evaluate_Pivot -- Returns the transform of a pivot in a blend of anims.  *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * motion0, frame0 - first animation and its frame                                             *
+ * motion1, frame1 - second animation and its frame                                            *
+ * percentage - 0.0 = motion0, 1.0 = motion1                                                   *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Only the pivot and its parents are evaluated, the same way Blend_Update does it.  Returns   *
+ * false if any of them is captured, the caller has to update the whole tree to get those.     *
+ *                                                                                             *
+ *=============================================================================================*/
+bool HTreeClass::Simple_Evaluate_Pivot
+(
+	HAnimClass *		motion0,
+	float					frame0,
+	HAnimClass *		motion1,
+	float					frame1,
+	float					percentage,
+	int					pivot_index,
+	const Matrix3D &	obj_tm,
+	Matrix3D *			end_tm
+) const
+{
+	bool retval = false;
+	end_tm->Make_Identity ();
+
+	if (	motion0 != nullptr &&
+			motion1 != nullptr &&
+			pivot_index >= 0 &&
+			pivot_index < NumPivots)
+	{
+		//
+		//	Captured pivots are controlled from outside (e.g. a soldier's spine twisted
+		// towards his target), leave those to the full update.
+		//
+		for (	const PivotClass *pivot = &Pivot[pivot_index];
+				pivot != nullptr && pivot->Parent != nullptr;
+				pivot = pivot->Parent)
+		{
+			if (pivot->IsCaptured) {
+				return false;
+			}
+		}
+
+		int num_anim_pivots = MIN( motion0->Get_Num_Pivots (), motion1->Get_Num_Pivots () );
+
+		for (	PivotClass *pivot = &Pivot[pivot_index];
+				pivot != nullptr && pivot->Parent != nullptr;
+				pivot = pivot->Parent)
+		{
+			Matrix3D curr_tm = pivot->BaseTransform;
+
+			if (pivot->Index < num_anim_pivots) {
+				Vector3 trans0;
+				motion0->Get_Translation(trans0,pivot->Index,frame0);
+				Vector3 trans1;
+				motion1->Get_Translation(trans1,pivot->Index,frame1);
+				Vector3 lerped = (1.0f - percentage) * trans0 + (percentage) * trans1;
+				curr_tm.Translate(lerped * ScaleFactor);
+
+				Quaternion q0;
+				motion0->Get_Orientation(q0,pivot->Index,frame0);
+				Quaternion q1;
+				motion1->Get_Orientation(q1,pivot->Index,frame1);
+				Quaternion q;
+				Fast_Slerp(q,q0,q1,percentage);
+				curr_tm = curr_tm * Build_Matrix3D(q);
+			}
+
+			Matrix3D::Multiply (curr_tm, *end_tm, end_tm);
+		}
+
+		Matrix3D::Multiply (obj_tm, *end_tm, end_tm);
+		retval = true;
+	}
+
+	return retval;
+}
+
+
 /***********************************************************************************************
  * HTreeClass::Base_Update -- Computes the base pose transform for each pivot                  *
  *                                                                                             *
@@ -531,6 +647,18 @@ void HTreeClass::Base_Update(const Matrix3D & root)
  *=============================================================================================*/
 void HTreeClass::Anim_Update(const Matrix3D & root,HAnimClass * motion,float frame)
 {
+	if (_BatchedPosesEnabled) {
+		int pose_pivots = MIN(motion->Get_Num_Pivots(),NumPivots);
+		if (HAnimPoseCacheClass::Is_Enabled()) {
+			Pose_Update(root,HAnimPoseCacheClass::Get_Pose(motion,frame,pose_pivots));
+		} else {
+			_Pose0.Init(pose_pivots);
+			motion->Get_Pose(_Pose0,frame);
+			Pose_Update(root,_Pose0);
+		}
+		return;
+	}
+
 	PivotClass *pivot;
 
 	Pivot[0].Transform = root;
@@ -593,6 +721,24 @@ void HTreeClass::Blend_Update
 	float									percentage		// 0.0 = motion0.  1.0 = motion1
 )
 {
+	if (_BatchedPosesEnabled) {
+		int pose_pivots = MIN(MIN(motion0->Get_Num_Pivots(),motion1->Get_Num_Pivots()),NumPivots);
+		if (HAnimPoseCacheClass::Is_Enabled()) {
+			const HAnimPoseClass & pose0 = HAnimPoseCacheClass::Get_Pose(motion0,frame0,pose_pivots);
+			const HAnimPoseClass & pose1 = HAnimPoseCacheClass::Get_Pose(motion1,frame1,pose_pivots);
+			_Pose0.Init(pose_pivots);
+			_Pose0.Blend(pose0,pose1,percentage);
+		} else {
+			_Pose0.Init(pose_pivots);
+			_Pose1.Init(pose_pivots);
+			motion0->Get_Pose(_Pose0,frame0);
+			motion1->Get_Pose(_Pose1,frame1);
+			_Pose0.Blend(_Pose0,_Pose1,percentage);
+		}
+		Pose_Update(root,_Pose0);
+		return;
+	}
+
 	PivotClass *pivot;
 
 	Pivot[0].Transform = root;
@@ -637,6 +783,50 @@ void HTreeClass::Blend_Update
 
 
 
+/***********************************************************************************************
+ * HTreeClass::Pose_Update -- computes the transform for each pivot from a decoded pose        *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * root - transform of the root pivot                                                          *
+ * pose - the animation (or blend of animations) at the frame, pivots past its pivot count     *
+ *        are left in the base pose.  Its transforms are built if they haven't been yet.       *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Gives the same transforms as the per-pivot Anim_Update, to within float rounding.           *
+ *                                                                                             *
+ *=============================================================================================*/
+void HTreeClass::Pose_Update(const Matrix3D & root,HAnimPoseClass & pose)
+{
+	Pivot[0].Transform = root;
+	Pivot[0].IsVisible = true;
+
+	if (!pose.Are_Transforms_Built(ScaleFactor)) {
+		pose.Build_Transforms(ScaleFactor);
+	}
+
+	for (int piv_idx=1; piv_idx < NumPivots; piv_idx++) {
+		PivotClass * pivot = &Pivot[piv_idx];
+		assert(pivot->Parent != nullptr);
+
+		if (piv_idx < pose.Get_Pivot_Count()) {
+			Matrix3D local;
+			Multiply_Wide(pivot->BaseTransform,pose.Get_Transform(piv_idx),&local);
+			Multiply_Wide(pivot->Parent->Transform,local,&(pivot->Transform));
+			pivot->IsVisible = pose.Visible[piv_idx];
+		} else {
+			Matrix3D::Multiply(pivot->Parent->Transform,pivot->BaseTransform,&(pivot->Transform));
+		}
+
+		if (pivot->IsCaptured) {
+			pivot->Capture_Update();
+			pivot->IsVisible = true;
+		}
+	}
+}
+
+
 /***********************************************************************************************
  * HTreeClass::Combo_Update -- compute each pivot's transform using an anim combo              *
  *                                                                                             *
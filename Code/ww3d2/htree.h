@@ -52,6 +52,7 @@
 
 class HAnimClass;
 class HAnimComboClass;
+class HAnimPoseClass;
 class MeshClass;
 class ChunkLoadClass;
 class ChunkSaveClass;
@@ -129,10 +130,18 @@ public:
 	//
 	bool					Simple_Evaluate_Pivot (HAnimClass *motion, int pivot_index, float frame, const Matrix3D &obj_tm, Matrix3D *end_tm) const;
 	bool					Simple_Evaluate_Pivot (int pivot_index, const Matrix3D &obj_tm, Matrix3D *end_tm) const;
+	bool					Simple_Evaluate_Pivot (HAnimClass *motion0, float frame0, HAnimClass *motion1, float frame1, float percentage,
+													 int pivot_index, const Matrix3D &obj_tm, Matrix3D *end_tm) const;
 
 	// Scale this HTree by a constant factor:
 	void					Scale(float factor);
 
+	// Anim_Update and Blend_Update decode the whole pose at once and evaluate it four pivots
+	// at a time (see hanimpose.h).  This can be turned off to compare against the per-pivot
+	// evaluation.
+	static void			Enable_Batched_Poses(bool onoff)		{ _BatchedPosesEnabled = onoff; }
+	static bool			Are_Batched_Poses_Enabled(void)		{ return _BatchedPosesEnabled; }
+
 	// Morph the bones on the HTree using weights from a number of other HTrees
 	static HTreeClass *	Create_Morphed( int num_morph_sources,
 													 const float morph_weights[],
@@ -160,6 +169,9 @@ private:
 
 	void					Free(void);
 	bool					read_pivots(ChunkLoadClass & cload,bool pre30);
+	void					Pose_Update(const Matrix3D & root,HAnimPoseClass & pose);
+
+	static bool			_BatchedPosesEnabled;
 
 	friend class MeshClass;
 };
@@ -38,6 +38,7 @@
  *   HTreeManagerClass::Free -- de-allocate all memory in use                                  *
  *   HTreeManagerClass::Free_All_Trees -- de-allocates all hierarchy trees currently loaded    *
  *   HTreeManagerClass::Load_Tree -- load a hierarchy tree from a file                         *
+ *   HTreeManagerClass::Add_Tree -- add a loaded hierarchy tree                                *
  *   HTreeManagerClass::Get_Tree_ID -- look up the ID of a named hierarchy tree                *
  *   HTreeManagerClass::Get_Tree -- get a pointer to the specified hierarchy tree              *
  *   HTreeManagerClass::Get_Tree -- get a pointer to the specified hierarchy tree              *
@@ -158,30 +159,49 @@ int HTreeManagerClass::Load_Tree(ChunkLoadClass & cload)
 		delete newtree;
 		goto Error;
 
-	} else if (Get_Tree_ID(newtree->Get_Name()) != -1) {
+	}
 
-		// tree with this name already exists, reject it!
-		delete newtree;
-		goto Error;
+	return Add_Tree(newtree);
 
-	} else {
+Error:
 
-		// ok, accept this hierarchy tree!
-		TreePtr[NumTrees] = newtree;
-		NumTrees++;
+	return 1;
 
-		// Insert to hash table for fast name based search
-		StringClass lower_case_name(newtree->Get_Name(),true);
-        lower_case_name.To_Lower();
-		TreeHash.Insert(lower_case_name,newtree);
-	}
+}
 
-	return 0;
+/***********************************************************************************************
+ * HTreeManagerClass::Add_Tree -- add a loaded hierarchy tree                                  *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * newtree - tree that has been loaded, the manager takes ownership of it                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * 0 if the tree was added, 1 if a tree with the same name exists (newtree is deleted)         *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ * HISTORY:                                                                                    *
+ *=============================================================================================*/
+int HTreeManagerClass::Add_Tree(HTreeClass * newtree)
+{
+	if (Get_Tree_ID(newtree->Get_Name()) != -1) {
 
-Error:
+		// tree with this name already exists, reject it!
+		delete newtree;
+		return 1;
 
-	return 1;
+	}
 
+	// ok, accept this hierarchy tree!
+	TreePtr[NumTrees] = newtree;
+	NumTrees++;
+
+	// Insert to hash table for fast name based search
+	StringClass lower_case_name(newtree->Get_Name(),true);
+	lower_case_name.To_Lower();
+	TreeHash.Insert(lower_case_name,newtree);
+
+	return 0;
 }
 
 /***********************************************************************************************
@@ -78,7 +78,25 @@ static float filtertable[FILTER_TABLE_SIZE] = {
 	10000000.0f,
 
 };
-static bool table_valid = false;
+
+/*
+** Fills in the generated part of the filter table.  Called through a function static so that
+** channels constructed on several loader threads at once only build it once.
+*/
+static bool Build_Filter_Table(void)
+{
+	for (int i=0; i<FILTER_TABLE_GEN_SIZE; i++)
+	{
+		float ratio = float(i);
+
+		//ratio = ((ratio + 1.0f) / 128.0f);
+		ratio/=((float) FILTER_TABLE_GEN_SIZE);
+
+		filtertable[i + FILTER_TABLE_GEN_START] = 1.0f - WWMath::Sin( DEG_TO_RADF(90.0f * ratio));
+	}
+
+	return true;
+}
 
 /***********************************************************************************************
  * MotionChannelClass::MotionChannelClass -- constructor                                       *
@@ -862,22 +880,8 @@ AdaptiveDeltaMotionChannelClass::AdaptiveDeltaMotionChannelClass(void) :
 	Scale(0.0f)
 {
 
-	if (false == table_valid) {
-		// Create Filter Table, used in delta compression
-
-		for (int i=0; i<FILTER_TABLE_GEN_SIZE; i++)
-		{
-			float ratio = float(i);
-
-			//ratio = ((ratio + 1.0f) / 128.0f);
-			ratio/=((float) FILTER_TABLE_GEN_SIZE);
-
-			filtertable[i + FILTER_TABLE_GEN_START] = 1.0f - WWMath::Sin( DEG_TO_RADF(90.0f * ratio));
-		}
-
-		table_valid = true;
-
-	}
+	// Create Filter Table, used in delta compression
+	[[maybe_unused]] static const bool table_valid = Build_Filter_Table();
 
 }
 
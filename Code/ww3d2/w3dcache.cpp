@@ -0,0 +1,251 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***                            Confidential - Westwood Studios                              ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Commando / G 3D Library                                      *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/ww3d2/w3dcache.cpp                           $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ *   W3DCacheClass::Open -- maps an asset cache into memory                                    *
+ *   W3DCacheClass::Close -- unmaps the asset cache                                            *
+ *   W3DCacheClass::Fix_Up -- validates the cache and turns its offsets into pointers          *
+ *   W3DCacheClass::Find_File -- finds the up to date baked copy of a file                     *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#include "w3dcache.h"
+#include "wwfile.h"
+#include "realcrc.h"
+#include "wwdebug.h"
+
+#include <string.h>
+
+
+W3DCacheClass::W3DCacheClass(void) :
+	Files(nullptr),
+	FileCount(0),
+	HitCount(0),
+	StaleCount(0),
+	MissCount(0)
+{
+}
+
+W3DCacheClass::~W3DCacheClass(void)
+{
+	Close();
+}
+
+
+/***********************************************************************************************
+ * W3DCacheClass::Open -- maps an asset cache into memory                                      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * filename - path of the cache file                                                           *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * true if the cache was mapped and is valid                                                   *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * A cache baked by a different version of the tool is rejected.                               *
+ *                                                                                             *
+ *=============================================================================================*/
+bool W3DCacheClass::Open(const char * filename)
+{
+	Close();
+
+	if (!Mapping.Map(filename)) {
+		return false;
+	}
+
+	if (!Fix_Up()) {
+		WWDEBUG_SAY(("W3DCacheClass: %s is not a valid version %d asset cache\n", filename, W3DCACHE_VERSION));
+		Close();
+		return false;
+	}
+
+	WWDEBUG_SAY(("W3DCacheClass: %s opened, %d files\n", filename, FileCount));
+	return true;
+}
+
+
+/***********************************************************************************************
+ * W3DCacheClass::Close -- unmaps the asset cache                                              *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Nothing may still be loading from the cache.                                                *
+ *                                                                                             *
+ *=============================================================================================*/
+void W3DCacheClass::Close(void)
+{
+	delete [] Files;
+	Files = nullptr;
+	FileCount = 0;
+	Mapping.Unmap();
+}
+
+
+/***********************************************************************************************
+ * W3DCacheClass::Fix_Up -- validates the cache and turns its offsets into pointers            *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * false if anything in the cache is out of bounds                                             *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+bool W3DCacheClass::Fix_Up(void)
+{
+	const unsigned char * base = Mapping.Peek_Data();
+	uint32 size = (uint32)Mapping.Get_Size();
+
+	if (size < sizeof(W3dCacheHeaderStruct)) {
+		return false;
+	}
+
+	W3dCacheHeaderStruct header;
+	::memcpy(&header, base, sizeof(header));
+	if (	::memcmp(header.Signature, W3DCACHE_SIGNATURE, sizeof(header.Signature)) != 0 ||
+			header.Version != W3DCACHE_VERSION ||
+			header.TotalSize != size ||
+			header.FileOffset > size ||
+			header.FileCount > (size - header.FileOffset) / sizeof(W3dCacheFileStruct))
+	{
+		return false;
+	}
+
+	const W3dCacheFileStruct * entries = (const W3dCacheFileStruct *)(base + header.FileOffset);
+	Files = new FileStruct[header.FileCount];
+
+	for (uint32 index = 0; index < header.FileCount; index++) {
+		const W3dCacheFileStruct & entry = entries[index];
+
+		if (	entry.DataOffset > size || entry.DataSize > size - entry.DataOffset ||
+				entry.ChunkOffset > size || entry.ChunkCount > (size - entry.ChunkOffset) / sizeof(W3dCacheChunkStruct) ||
+				entry.NameOffset >= size || ::memchr(base + entry.NameOffset, 0, size - entry.NameOffset) == nullptr ||
+				(index > 0 && entry.NameCRC < entries[index - 1].NameCRC))
+		{
+			return false;
+		}
+
+		const W3dCacheChunkStruct * chunks = (const W3dCacheChunkStruct *)(base + entry.ChunkOffset);
+		for (uint32 chunk_index = 0; chunk_index < entry.ChunkCount; chunk_index++) {
+			if (chunks[chunk_index].Offset > entry.DataSize || chunks[chunk_index].Size > entry.DataSize - chunks[chunk_index].Offset) {
+				return false;
+			}
+		}
+
+		FileStruct & file = Files[index];
+		file.Name = (const char *)(base + entry.NameOffset);
+		file.NameCRC = entry.NameCRC;
+		file.SourceSize = entry.SourceSize;
+		file.SourceDateTime = entry.SourceDateTime;
+		file.Data = base + entry.DataOffset;
+		file.Size = (int)entry.DataSize;
+		file.Chunks = chunks;
+		file.ChunkCount = (int)entry.ChunkCount;
+	}
+
+	FileCount = (int)header.FileCount;
+	return true;
+}
+
+
+/***********************************************************************************************
+ * W3DCacheClass::Find_File -- finds the up to date baked copy of a file                       *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * filename - name the file was requested with                                                 *
+ * source - the file the file factory returned for it                                          *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * the baked copy, or nullptr to load from source                                              *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * source is opened (and closed again) to get its date if it isn't already open.               *
+ *                                                                                             *
+ *=============================================================================================*/
+const W3DCacheClass::FileStruct * W3DCacheClass::Find_File(const char * filename, FileClass & source)
+{
+	if (Files == nullptr) {
+		return nullptr;
+	}
+
+	/*
+	** Binary search for the first entry with this CRC, then check the names
+	*/
+	uint32 crc = CRC_Stringi(filename);
+	int low = 0;
+	int high = FileCount;
+	while (low < high) {
+		int mid = (low + high) / 2;
+		if (Files[mid].NameCRC < crc) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	const FileStruct * file = nullptr;
+	for (int index = low; index < FileCount && Files[index].NameCRC == crc; index++) {
+		if (::stricmp(Files[index].Name, filename) == 0) {
+			file = &Files[index];
+			break;
+		}
+	}
+
+	if (file == nullptr) {
+		MissCount++;
+		return nullptr;
+	}
+
+	/*
+	** Only use the baked copy if the source file hasn't changed since
+	*/
+	bool opened = false;
+	if (!source.Is_Open()) {
+		if (!source.Open()) {
+			MissCount++;
+			return nullptr;
+		}
+		opened = true;
+	}
+
+	bool up_to_date = ((uint32)source.Size() == file->SourceSize) && (source.Get_Date_Time() == file->SourceDateTime);
+
+	if (opened) {
+		source.Close();
+	}
+
+	if (!up_to_date) {
+		StaleCount++;
+		return nullptr;
+	}
+
+	HitCount++;
+	return file;
+}
@@ -0,0 +1,172 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***                            Confidential - Westwood Studios                              ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : Commando / G 3D Library                                      *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/ww3d2/w3dcache.h                             $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef W3DCACHE_H
+#define W3DCACHE_H
+
+#include "always.h"
+#include "bittype.h"
+#include "mappedfile.h"
+
+#include <atomic>
+
+class FileClass;
+
+
+/*
+** W3D asset cache file format
+**
+** An asset cache is baked offline by the bakew3d tool from the W3D files in one or more mix
+** files.  Every file is stored ready to load: meshes that can be collided with but were
+** exported without an AABTree get one built by the tool, and the top level chunks of each
+** file are listed so the loader doesn't have to walk them.  Every offset is relative to the
+** start of the cache file, so the cache can be mapped anywhere.
+**
+**	W3dCacheHeaderStruct
+**	W3dCacheFileStruct[FileCount]		sorted on NameCRC
+**	W3dCacheChunkStruct[...]			each file's top level chunks
+**	file names								null terminated
+**	file data								each file 16 byte aligned
+**
+** Each file remembers the size and date of the file it was baked from.  The cache is only
+** used for a file while the one the file factory finds still matches, so assets that have
+** been changed since the cache was baked are loaded from their W3D files as before.
+*/
+#define W3DCACHE_SIGNATURE				"W3DC"
+#define W3DCACHE_VERSION				1
+#define W3DCACHE_DATA_ALIGNMENT		16
+
+struct W3dCacheHeaderStruct
+{
+	char						Signature[4];		// W3DCACHE_SIGNATURE
+	uint32					Version;				// W3DCACHE_VERSION
+	uint32					FileCount;
+	uint32					FileOffset;			// offset of the W3dCacheFileStruct array
+	uint32					TotalSize;			// size of the whole cache file
+};
+
+struct W3dCacheFileStruct
+{
+	uint32					NameCRC;				// CRC_Stringi of the file name
+	uint32					NameOffset;
+	uint32					SourceSize;			// size and date of the file this was baked from
+	uint32					SourceDateTime;
+	uint32					DataOffset;
+	uint32					DataSize;
+	uint32					ChunkOffset;		// offset of this file's W3dCacheChunkStruct array
+	uint32					ChunkCount;
+
+	bool operator== (const W3dCacheFileStruct &src) const	{ return NameCRC == src.NameCRC && DataOffset == src.DataOffset; }
+	bool operator!= (const W3dCacheFileStruct &src) const	{ return !(*this == src); }
+};
+
+struct W3dCacheChunkStruct
+{
+	uint32					ChunkID;
+	uint32					Offset;				// offset of the chunk header in the file's data
+	uint32					Size;					// size of the chunk, header included
+
+	bool operator== (const W3dCacheChunkStruct &src) const	{ return ChunkID == src.ChunkID && Offset == src.Offset && Size == src.Size; }
+	bool operator!= (const W3dCacheChunkStruct &src) const	{ return !(*this == src); }
+};
+
+
+/*
+
+	W3DCacheClass
+
+	Maps an asset cache into memory and finds the baked copies of W3D files in it.  The
+	offsets in the cache are turned into pointers into the mapping once, when the cache is
+	opened; the cache is never written to.
+
+	Find_File may be called from several threads at once.
+
+*/
+class W3DCacheClass
+{
+public:
+
+	struct FileStruct
+	{
+		const char *						Name;
+		uint32								NameCRC;
+		uint32								SourceSize;
+		uint32								SourceDateTime;
+		const unsigned char *			Data;
+		int									Size;
+		const W3dCacheChunkStruct *	Chunks;
+		int									ChunkCount;
+	};
+
+	W3DCacheClass(void);
+	~W3DCacheClass(void);
+
+	bool							Open(const char * filename);
+	void							Close(void);
+	bool							Is_Open(void) const					{ return Files != nullptr; }
+	int							Get_File_Count(void) const			{ return FileCount; }
+
+	/*
+	** Returns the baked copy of the given file, or nullptr if the cache doesn't have one or
+	** source (the file the factory returned for filename) doesn't match it any more.
+	*/
+	const FileStruct *		Find_File(const char * filename, FileClass & source);
+
+	/*
+	** Find_File results since the last reset
+	*/
+	int							Get_Hit_Count(void) const			{ return HitCount; }
+	int							Get_Stale_Count(void) const		{ return StaleCount; }
+	int							Get_Miss_Count(void) const			{ return MissCount; }
+	void							Reset_Stats(void)						{ HitCount = 0; StaleCount = 0; MissCount = 0; }
+
+private:
+
+	W3DCacheClass(const W3DCacheClass &) = delete;
+	W3DCacheClass & operator=(const W3DCacheClass &) = delete;
+
+	bool							Fix_Up(void);
+
+	MappedFileClass			Mapping;
+	FileStruct *				Files;
+	int							FileCount;
+
+	std::atomic<int>			HitCount;
+	std::atomic<int>			StaleCount;
+	std::atomic<int>			MissCount;
+};
+
+
+#endif
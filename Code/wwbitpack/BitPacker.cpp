@@ -27,13 +27,141 @@
 #include "BitPacker.h"
 
 #include <string.h>	// for memset
+#include <atomic>
+#include <mutex>
+#include <new>
 
 #include "wwdebug.h"
 
+//-----------------------------------------------------------------------------
+//
+// Payload buffer pool. Blocks are never handed back to the heap, each size
+// class keeps its own free list.
+//
+struct BitPackerBlockStruct
+{
+	std::atomic<int>		RefCount;
+	int						SizeClass;
+	BitPackerBlockStruct *	NextFree;
+
+	uint8_t * Get_Data() {return reinterpret_cast<uint8_t *>(this + 1);}
+};
+
+namespace {
+
+const uint32_t BufferSizeClasses[] = {64, 128, 256, MAX_BUFFER_SIZE};
+
+// Every block has this many bytes past its capacity so a 64 bit word can be
+// loaded or stored at any byte inside it.
+const uint32_t BufferSlack = sizeof(uint64_t);
+const int BufferSizeClassCount = sizeof(BufferSizeClasses) / sizeof(BufferSizeClasses[0]);
+
+struct BufferPoolStruct
+{
+	std::mutex					Lock;
+	BitPackerBlockStruct *	FreeList[BufferSizeClassCount] = {};
+};
+
+std::atomic<uint32_t> StatAllocations{0};
+std::atomic<uint32_t> StatReuses{0};
+std::atomic<uint32_t> StatShares{0};
+std::atomic<uint32_t> StatCopies{0};
+std::atomic<uint32_t> StatGrows{0};
+std::atomic<uint32_t> StatBytesCopied{0};
+
+// Read only stand in for packers that have never been written to.
+const uint8_t EmptyBuffer[MAX_BUFFER_SIZE + BufferSlack] = {};
+
+// Never destroyed, packets with static storage may still release blocks at exit.
+BufferPoolStruct & Get_Buffer_Pool()
+{
+	static BufferPoolStruct * pool = new BufferPoolStruct;
+	return *pool;
+}
+
+int Get_Size_Class(uint32_t num_bytes)
+{
+	for (int size_class = 0; size_class < BufferSizeClassCount - 1; size_class++) {
+		if (num_bytes <= BufferSizeClasses[size_class]) {
+			return size_class;
+		}
+	}
+	return BufferSizeClassCount - 1;
+}
+
+BitPackerBlockStruct * Allocate_Block(int size_class)
+{
+	BufferPoolStruct & pool = Get_Buffer_Pool();
+	BitPackerBlockStruct * block = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(pool.Lock);
+		block = pool.FreeList[size_class];
+		if (block != nullptr) {
+			pool.FreeList[size_class] = block->NextFree;
+		}
+	}
+
+	if (block != nullptr) {
+		StatReuses.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		void * memory = ::operator new(sizeof(BitPackerBlockStruct) + BufferSizeClasses[size_class] + BufferSlack);
+		block = new (memory) BitPackerBlockStruct;
+		block->SizeClass = size_class;
+		StatAllocations.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	block->RefCount.store(1, std::memory_order_relaxed);
+	block->NextFree = nullptr;
+	return block;
+}
+
+void Free_Block(BitPackerBlockStruct * block)
+{
+	BufferPoolStruct & pool = Get_Buffer_Pool();
+	std::lock_guard<std::mutex> lock(pool.Lock);
+	block->NextFree = pool.FreeList[block->SizeClass];
+	pool.FreeList[block->SizeClass] = block;
+}
+
+//
+// The stream is MSB first, so words are loaded and stored big endian.
+//
+inline uint64_t Load_Word(const uint8_t * data)
+{
+	return
+		(uint64_t(data[0]) << 56) | (uint64_t(data[1]) << 48) |
+		(uint64_t(data[2]) << 40) | (uint64_t(data[3]) << 32) |
+		(uint64_t(data[4]) << 24) | (uint64_t(data[5]) << 16) |
+		(uint64_t(data[6]) << 8)  |  uint64_t(data[7]);
+}
+
+inline void Store_Word(uint8_t * data, uint64_t word)
+{
+	data[0] = static_cast<uint8_t>(word >> 56);
+	data[1] = static_cast<uint8_t>(word >> 48);
+	data[2] = static_cast<uint8_t>(word >> 40);
+	data[3] = static_cast<uint8_t>(word >> 32);
+	data[4] = static_cast<uint8_t>(word >> 24);
+	data[5] = static_cast<uint8_t>(word >> 16);
+	data[6] = static_cast<uint8_t>(word >> 8);
+	data[7] = static_cast<uint8_t>(word);
+}
+
+inline uint32_t Low_Bits(uint32_t value, uint32_t num_bits)
+{
+	return value & (0xFFFFFFFFu >> (32 - num_bits));
+}
+
+} // namespace
+
 //-----------------------------------------------------------------------------
 //cBitPacker::cBitPacker(uint32_t buffer_size) :
 cBitPacker::cBitPacker() :
 	//BufferSize(buffer_size),
+	Block(nullptr),
+	Buffer(nullptr),
+	Capacity(0),
 	BitWritePosition(0),
 	BitReadPosition(0)
 {
@@ -42,13 +170,13 @@ cBitPacker::cBitPacker() :
 	//Buffer = new uint8_t[BufferSize];
 	//WWASSERT(Buffer != nullptr);
 	//memset(Buffer, 0, BufferSize);
-	memset(Buffer, 0, MAX_BUFFER_SIZE);
 }
 
 //-----------------------------------------------------------------------------
 cBitPacker::~cBitPacker()
 {
 	//delete [] Buffer;
+	Release_Buffer();
 }
 
 //-----------------------------------------------------------------------------
@@ -56,14 +184,118 @@ cBitPacker& cBitPacker::operator=(const cBitPacker& rhs)
 {
 	//WWASSERT(BufferSize == rhs.BufferSize);
 
-	//memcpy(Buffer, rhs.Buffer, rhs.BufferSize);
-	memcpy(Buffer, rhs.Buffer, MAX_BUFFER_SIZE);
+	//
+	// Share the payload instead of copying it
+	//
+	if (Block != rhs.Block) {
+		if (rhs.Block != nullptr) {
+			rhs.Block->RefCount.fetch_add(1, std::memory_order_relaxed);
+			StatShares.fetch_add(1, std::memory_order_relaxed);
+		}
+		Release_Buffer();
+		Block		= rhs.Block;
+		Buffer	= rhs.Buffer;
+		Capacity	= rhs.Capacity;
+	}
+
 	BitReadPosition		= rhs.BitReadPosition;
 	BitWritePosition		= rhs.BitWritePosition;
 
    return * this;
 }
 
+//-----------------------------------------------------------------------------
+void cBitPacker::Release_Buffer()
+{
+	if (Block != nullptr && Block->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		Free_Block(Block);
+	}
+	Block		= nullptr;
+	Buffer	= nullptr;
+	Capacity	= 0;
+}
+
+//-----------------------------------------------------------------------------
+//
+// Make sure we own the payload and that it holds at least num_bytes. Only
+// the bytes up to the write position are carried over, the rest is zeroed
+// since Add_Bits ORs into the first partial byte.
+//
+void cBitPacker::Make_Writable(uint32_t num_bytes)
+{
+	if (num_bytes > MAX_BUFFER_SIZE) {
+		num_bytes = MAX_BUFFER_SIZE;
+	}
+
+	bool is_shared = (Block != nullptr && Block->RefCount.load(std::memory_order_acquire) > 1);
+	if (Block != nullptr && !is_shared && Capacity >= num_bytes) {
+		return;
+	}
+
+	uint32_t used_bytes = (BitWritePosition + 7) >> 3;
+	if (used_bytes > Capacity) {
+		used_bytes = Capacity;
+	}
+	if (num_bytes < used_bytes) {
+		num_bytes = used_bytes;
+	}
+
+	BitPackerBlockStruct * block = Allocate_Block(Get_Size_Class(num_bytes));
+	uint32_t capacity = BufferSizeClasses[block->SizeClass];
+	uint8_t * buffer = block->Get_Data();
+
+	if (used_bytes > 0) {
+		memcpy(buffer, Buffer, used_bytes);
+		if (is_shared) {
+			StatCopies.fetch_add(1, std::memory_order_relaxed);
+		} else {
+			StatGrows.fetch_add(1, std::memory_order_relaxed);
+		}
+		StatBytesCopied.fetch_add(used_bytes, std::memory_order_relaxed);
+	}
+	memset(buffer + used_bytes, 0, capacity + BufferSlack - used_bytes);
+
+	Release_Buffer();
+	Block		= block;
+	Buffer	= buffer;
+	Capacity	= capacity;
+}
+
+//-----------------------------------------------------------------------------
+char * cBitPacker::Get_Data(uint32_t num_bytes)
+{
+	Make_Writable(num_bytes);
+	return (char *) Buffer;
+}
+
+//-----------------------------------------------------------------------------
+const char * cBitPacker::Peek_Data() const
+{
+	return (const char *) ((Buffer != nullptr) ? Buffer : EmptyBuffer);
+}
+
+//-----------------------------------------------------------------------------
+void cBitPacker::Get_Buffer_Stats(BitPackerBufferStatsStruct & stats)
+{
+	stats.Allocations	= StatAllocations.load(std::memory_order_relaxed);
+	stats.Reuses		= StatReuses.load(std::memory_order_relaxed);
+	stats.Shares		= StatShares.load(std::memory_order_relaxed);
+	stats.Copies		= StatCopies.load(std::memory_order_relaxed);
+	stats.Grows			= StatGrows.load(std::memory_order_relaxed);
+	stats.BytesCopied	= StatBytesCopied.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+void cBitPacker::Reset_Buffer_Stats()
+{
+	StatAllocations	= 0;
+	StatReuses			= 0;
+	StatShares			= 0;
+	StatCopies			= 0;
+	StatGrows			= 0;
+	StatBytesCopied	= 0;
+}
+
 //-----------------------------------------------------------------------------
 //
 // This method needs optimization
@@ -72,6 +304,9 @@ cBitPacker& cBitPacker::operator=(const cBitPacker& rhs)
 // the bit order and the new one doesn't, so the versions are not compatible.
 // If you use optimized Add_Bits() you need to also use optimize Get_Bits().
 //
+// The field is now merged into a 64 bit word instead of being written a byte
+// at a time. The bit order is unchanged.
+//
 
 void cBitPacker::Add_Bits(uint32_t value, uint32_t num_bits)
 {
@@ -105,34 +340,20 @@ void cBitPacker::Add_Bits(uint32_t value, uint32_t num_bits)
 	WWASSERT(num_bits > 0 && num_bits <= MAX_BITS);
 	WWASSERT(BitWritePosition+num_bits <= MAX_BUFFER_SIZE * 8);
 
-	// Fill the remaining bits of the write byte first
 	uint32_t byte_num = BitWritePosition >> 3;
 	uint32_t bit_offset = BitWritePosition & 0x7;
+	Make_Writable(((BitWritePosition + num_bits) >> 3) + 1);
 	BitWritePosition+=num_bits;		// Advance the write position
 
-	// If write buffer is not byte aligned, write the remaining bits first
-	value <<= 32-num_bits;
-	if (bit_offset) {
-		uint32_t bit_count = 8 - bit_offset;
-		if (bit_count>num_bits) bit_count=num_bits;
-
-		uint32_t bit_value = value;
-		value <<= bit_count;					// Remove the copied bits
-		num_bits -= bit_count;
-		bit_value >>= (24+bit_offset);
-		Buffer[byte_num++] |= bit_value;
-	}
-
-	// Write the rest of the data as bytes
-	if (num_bits>8) {
-		for (unsigned a=0;a<num_bits;a+=8) {
-			Buffer[byte_num++]=static_cast<unsigned char>(value>>24);
-			value<<=8;
-		}
-	}
-	else {
-		Buffer[byte_num]=static_cast<unsigned char>(value>>24);
-	}
+	//
+	// Merge the field into the 64 bit word starting at the write byte. The
+	// bits already written to that byte are kept, everything after the
+	// field is cleared.
+	//
+	uint64_t word = Load_Word(Buffer + byte_num);
+	word &= ~(~uint64_t(0) >> bit_offset);
+	word |= uint64_t(Low_Bits(value, num_bits)) << (64 - bit_offset - num_bits);
+	Store_Word(Buffer + byte_num, word);
 #endif
 }
 
@@ -140,6 +361,7 @@ void cBitPacker::Add_Bits(uint32_t value, uint32_t num_bits)
 //
 // This method needs optimization
 // 02-14-2002 Jani: Optimized. See Add_Bits() for notes.
+// Now reads a whole 64 bit word instead of one byte at a time.
 //
 void cBitPacker::Get_Bits(uint32_t & value, uint32_t num_bits)
 {
@@ -167,22 +389,116 @@ void cBitPacker::Get_Bits(uint32_t & value, uint32_t num_bits)
 	WWASSERT(BitReadPosition+num_bits <= MAX_BUFFER_SIZE * 8);
 	WWASSERT(BitReadPosition+num_bits <= BitWritePosition);
 
-	uint32_t read_len=num_bits;
-	uint32_t byte_num = BitReadPosition / 8;
-	uint32_t bit_offset = BitReadPosition % 8;
+	const uint8_t * buffer = (const uint8_t *) Peek_Data();
+	uint32_t byte_num = BitReadPosition >> 3;
+	uint32_t bit_offset = BitReadPosition & 0x7;
 	BitReadPosition += num_bits;
 
-	uint32_t bit_count = 8 - bit_offset;
-	if (bit_count>num_bits) bit_count=num_bits;
-	value = (uint32_t(Buffer[byte_num++]) << (bit_offset+24));
-	num_bits-=bit_count;
+	// A field never spans more than 5 bytes so one word always covers it
+	uint64_t word = Load_Word(buffer + byte_num);
+	value = static_cast<uint32_t>((word << bit_offset) >> (64 - num_bits));
+#endif
+}
+
+//-----------------------------------------------------------------------------
+//
+// Writes count fields exactly as count Add_Bits() calls would. Fields are
+// collected in a 64 bit accumulator and flushed 32 bits at a time.
+//
+void cBitPacker::Add_Bits_Batch(const uint32_t * values, const uint32_t * num_bits, int count)
+{
+	WWASSERT(values != nullptr && num_bits != nullptr);
+	WWASSERT(count >= 0);
+
+	uint32_t total_bits = 0;
+	for (int index = 0; index < count; index++) {
+		WWASSERT(num_bits[index] > 0 && num_bits[index] <= MAX_BITS);
+		total_bits += num_bits[index];
+	}
+	if (total_bits == 0) {
+		return;
+	}
+	WWASSERT(BitWritePosition+total_bits <= MAX_BUFFER_SIZE * 8);
+	Make_Writable(((BitWritePosition + total_bits) >> 3) + 1);
+
+	//
+	// Start with the bits already written to the first byte
+	//
+	uint8_t * data = Buffer + (BitWritePosition >> 3);
+	uint32_t pending_bits = BitWritePosition & 0x7;
+	uint64_t accumulator = uint64_t(data[0] & (0xFF00 >> pending_bits)) << 56;
+
+	for (int index = 0; index < count; index++) {
+		uint32_t bits = num_bits[index];
+		accumulator |= uint64_t(Low_Bits(values[index], bits)) << (64 - pending_bits - bits);
+		pending_bits += bits;
+
+		if (pending_bits >= 32) {
+			Store_Word(data, accumulator);
+			data += 4;
+			accumulator <<= 32;
+			pending_bits -= 32;
+		}
+	}
 
-	int shift;
-	for (shift=24-bit_count;shift>0;shift-=8,num_bits-=8) value|=unsigned(Buffer[byte_num++]) << shift;
-	if (num_bits>0) value|=Buffer[byte_num++]>>(-shift);
+	Store_Word(data, accumulator);
+	BitWritePosition += total_bits;
+}
 
-	value >>= 32-read_len;
-#endif
+//-----------------------------------------------------------------------------
+//
+// Reads count fields exactly as count Get_Bits() calls would.
+//
+void cBitPacker::Get_Bits_Batch(uint32_t * values, const uint32_t * num_bits, int count)
+{
+	WWASSERT(values != nullptr && num_bits != nullptr);
+	WWASSERT(count >= 0);
+
+	const uint8_t * buffer = (const uint8_t *) Peek_Data();
+	uint32_t position = BitReadPosition;
+
+	for (int index = 0; index < count; index++) {
+		uint32_t bits = num_bits[index];
+		WWASSERT(bits > 0 && bits <= MAX_BITS);
+		WWASSERT(position+bits <= BitWritePosition);
+
+		uint64_t word = Load_Word(buffer + (position >> 3));
+		values[index] = static_cast<uint32_t>((word << (position & 0x7)) >> (64 - bits));
+		position += bits;
+	}
+
+	BitReadPosition = position;
+}
+
+//-----------------------------------------------------------------------------
+//
+// Copies a bit range out of another payload, a field sized chunk at a time.
+//
+void cBitPacker::Add_Bit_Range(const uint8_t * source, uint32_t start_bit, uint32_t num_bits)
+{
+	WWASSERT(source != nullptr || num_bits == 0);
+
+	while (num_bits > 0) {
+		uint32_t chunk_bits = (num_bits > (uint32_t)MAX_BITS) ? (uint32_t)MAX_BITS : num_bits;
+		uint32_t byte_num = start_bit >> 3;
+		uint32_t bit_offset = start_bit & 0x7;
+		uint32_t byte_count = (bit_offset + chunk_bits + 7) >> 3;
+
+		//
+		// Only the bytes covering the chunk are touched, the source need not
+		// have the slack a packer buffer has.
+		//
+		uint64_t word = 0;
+		for (uint32_t index = 0; index < byte_count; index++) {
+			word = (word << 8) | source[byte_num + index];
+		}
+		word <<= (8 - byte_count) * 8;
+
+		Add_Bits(static_cast<uint32_t>((word << bit_offset) >> (64 - chunk_bits)), chunk_bits);
+
+		start_bit += chunk_bits;
+		num_bits -= chunk_bits;
+	}
 }
 
 //-----------------------------------------------------------------------------
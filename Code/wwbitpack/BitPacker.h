@@ -38,6 +38,27 @@ static constexpr int MAX_BITS = 8 * sizeof(uint32_t);
 //static const int MAX_BUFFER_SIZE = 1400;
 static const int MAX_BUFFER_SIZE = 548;
 
+//
+// Counters for the payload buffer pool, shared by all packers
+//
+struct BitPackerBufferStatsStruct
+{
+	uint32_t Allocations;	// Blocks allocated from the heap
+	uint32_t Reuses;			// Blocks taken from the free lists
+	uint32_t Shares;			// Assignments that shared the source payload
+	uint32_t Copies;			// Shared payloads copied before a write
+	uint32_t Grows;			// Payloads moved to a bigger size class
+	uint32_t BytesCopied;	// Bytes moved by copies and grows
+};
+
+struct BitPackerBlockStruct;
+
+//
+// The payload lives in a reference counted block from a size classed pool
+// rather than inside the packer. Assignment shares the block and the first
+// write to a shared block copies it, but only up to the write position, so
+// fanning one packet out to many queues costs no payload copies at all.
+//
 class cBitPacker
 {
 	public:
@@ -45,7 +66,13 @@ class cBitPacker
 		cBitPacker();
 		virtual ~cBitPacker();
 
-		char * Get_Data() const {return (char *) Buffer;}
+		//
+		// Get_Data is for writing straight into the buffer and makes sure the
+		// payload is private and at least num_bytes long. Use Peek_Data to
+		// read, it never copies.
+		//
+		char * Get_Data(uint32_t num_bytes = MAX_BUFFER_SIZE);
+		const char * Peek_Data() const;
 		//uint32_t Get_Buffer_Size() const {return BufferSize;}
 		uint32_t Get_Buffer_Size() const {return MAX_BUFFER_SIZE;}
 		void Flush() {BitReadPosition = BitWritePosition;}
@@ -54,8 +81,25 @@ class cBitPacker
 		void Add_Bits(uint32_t value, uint32_t num_bits);
 		void Get_Bits(uint32_t & value, uint32_t num_bits);
 
+		//
+		// Same stream as a run of Add_Bits / Get_Bits calls, but the fields
+		// are gathered in a 64 bit accumulator and stored a word at a time.
+		//
+		void Add_Bits_Batch(const uint32_t * values, const uint32_t * num_bits, int count);
+		void Get_Bits_Batch(uint32_t * values, const uint32_t * num_bits, int count);
+
+		//
+		// Appends num_bits bits of another stream, starting at bit start_bit of
+		// its payload. The source is only read.
+		//
+		void Add_Bit_Range(const uint8_t * source, uint32_t start_bit, uint32_t num_bits);
+
 		void Set_Bit_Write_Position(uint32_t position);
 		uint32_t Get_Bit_Write_Position() const {return BitWritePosition;}
+		uint32_t Get_Bit_Read_Position() const {return BitReadPosition;}
+
+		static void Get_Buffer_Stats(BitPackerBufferStatsStruct & stats);
+		static void Reset_Buffer_Stats();
 
 	protected:
       cBitPacker& operator=(const cBitPacker& rhs);
@@ -64,9 +108,14 @@ class cBitPacker
 
       cBitPacker(const cBitPacker& source); // Disallow copy constructor
 
+		void Make_Writable(uint32_t num_bytes);
+		void Release_Buffer();
+
 		//uint8_t * Buffer;
 		//const uint32_t BufferSize;
-		uint8_t Buffer[MAX_BUFFER_SIZE];
+		BitPackerBlockStruct * Block;
+		uint8_t * Buffer;
+		uint32_t Capacity;
 		uint32_t BitWritePosition;
 		uint32_t BitReadPosition;
 };
@@ -39,7 +39,7 @@
 
 #include "bitstream.h"
 
-#include <string.h>	// for strlen
+#include <string.h>	// for strlen, memcpy
 #include <math.h>		// for ceil
 
 #include "wwdebug.h"
@@ -215,6 +215,103 @@ void BitStreamClass::Get_Wide_Terminated_String(unichar_t *buffer, uint16_t buff
 }
 
 
+//-----------------------------------------------------------------------------
+void BitStreamClass::Add_Quantized(const float * values, const int * types, int count)
+{
+	WWASSERT(values != nullptr && types != nullptr);
+	WWASSERT(count >= 0);
+
+	const int CHUNK_SIZE = 16;
+	uint32_t scaled_values[CHUNK_SIZE];
+	uint32_t num_bits[CHUNK_SIZE];
+
+	bool is_compression_enabled = cEncoderList::Is_Compression_Enabled();
+
+	for (int first = 0; first < count; first += CHUNK_SIZE) {
+		int chunk_count = count - first;
+		if (chunk_count > CHUNK_SIZE) {
+			chunk_count = CHUNK_SIZE;
+		}
+
+		for (int index = 0; index < chunk_count; index++) {
+			float value = values[first + index];
+			int type = types[first + index];
+
+			if (is_compression_enabled && type != NO_ENCODER) {
+				WWASSERT(type >= 0 && type < MAX_ENCODERTYPES);
+				cEncoderTypeEntry & entry = cEncoderList::Get_Encoder_Type_Entry(type);
+				WWASSERT(entry.Is_Valid());
+
+				entry.Scale(value, scaled_values[index]);
+				num_bits[index] = entry.Get_Bit_Precision();
+			} else {
+				memcpy(&scaled_values[index], &value, sizeof(value));
+				num_bits[index] = BIT_DEPTH(float);
+			}
+		}
+
+		Add_Bits_Batch(scaled_values, num_bits, chunk_count);
+	}
+
+	UncompressedSizeBytes += count * BYTE_DEPTH(float);
+}
+
+//-----------------------------------------------------------------------------
+void BitStreamClass::Get_Quantized(float * values, const int * types, int count)
+{
+	WWASSERT(values != nullptr && types != nullptr);
+	WWASSERT(count >= 0);
+
+	const int CHUNK_SIZE = 16;
+	uint32_t scaled_values[CHUNK_SIZE];
+	uint32_t num_bits[CHUNK_SIZE];
+
+	bool is_compression_enabled = cEncoderList::Is_Compression_Enabled();
+
+	for (int first = 0; first < count; first += CHUNK_SIZE) {
+		int chunk_count = count - first;
+		if (chunk_count > CHUNK_SIZE) {
+			chunk_count = CHUNK_SIZE;
+		}
+
+		for (int index = 0; index < chunk_count; index++) {
+			int type = types[first + index];
+			if (is_compression_enabled && type != NO_ENCODER) {
+				WWASSERT(type >= 0 && type < MAX_ENCODERTYPES);
+				num_bits[index] = cEncoderList::Get_Encoder_Type_Entry(type).Get_Bit_Precision();
+			} else {
+				num_bits[index] = BIT_DEPTH(float);
+			}
+		}
+
+		Get_Bits_Batch(scaled_values, num_bits, chunk_count);
+
+		//
+		// Same conversion as Internal_Get
+		//
+		for (int index = 0; index < chunk_count; index++) {
+			int type = types[first + index];
+			float & value = values[first + index];
+
+			if (is_compression_enabled && type != NO_ENCODER) {
+				cEncoderTypeEntry & entry = cEncoderList::Get_Encoder_Type_Entry(type);
+				WWASSERT(entry.Is_Valid());
+
+				double f_value = entry.Unscale(scaled_values[index]);
+				if ((::fabs(f_value - static_cast<float>(f_value)) < MISCUTIL_EPSILON)) {
+					value = static_cast<float>(f_value);
+				} else {
+					value = static_cast<float>(cMathUtil::Round(f_value));
+				}
+
+				WWASSERT(entry.Is_Value_In_Range(value));
+			} else {
+				memcpy(&value, &scaled_values[index], sizeof(value));
+			}
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 uint32_t BitStreamClass::Get_Compressed_Size_Bytes() const
 {
@@ -137,6 +137,14 @@ class BitStreamClass : public cBitPacker
 		unichar_t	Get(unichar_t & set_val,int type = NO_ENCODER)				{ return Internal_Get(set_val,type); }
 #endif
 
+		//
+		// Batched float fields, such as a position or a quaternion. The bits on
+		// the wire are the same as calling Add / Get for each value with its
+		// type in turn, but the stream is written and read in one pass.
+		//
+		void		Add_Quantized(const float * values, const int * types, int count);
+		void		Get_Quantized(float * values, const int * types, int count);
+
 	private:
 
 		//
@@ -43,10 +43,3 @@ void cEncoderList::Clear_Entries()
 		EncoderTypes[i].Invalidate();
 	}
 }
-
-//-----------------------------------------------------------------------------
-cEncoderTypeEntry & cEncoderList::Get_Encoder_Type_Entry(int index)
-{
-	WWASSERT(index >= 0 && index < MAX_ENCODERTYPES);
-	return EncoderTypes[index];
-}
@@ -42,7 +42,11 @@ class cEncoderList
 		static void Set_Compression_Enabled(bool flag) {IsCompressionEnabled = flag;}
 		static bool Is_Compression_Enabled() {return IsCompressionEnabled;}
 
-		static cEncoderTypeEntry & Get_Encoder_Type_Entry(int index);
+		static cEncoderTypeEntry & Get_Encoder_Type_Entry(int index)
+		{
+			WWASSERT(index >= 0 && index < MAX_ENCODERTYPES);
+			return EncoderTypes[index];
+		}
 
 #pragma auto_inline(off)
 		//------------------------------------------------------------------------------------
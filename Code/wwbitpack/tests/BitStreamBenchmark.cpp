@@ -0,0 +1,376 @@
+#include "bitpackids.h"
+#include "bitstream.h"
+#include "encoderlist.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr int ObjectCount = 4096;
+constexpr int Rounds = 200;
+
+// Encoder types used by the benchmark that the game does not define.
+enum {
+    TYPE_HUMAN_STATE = MAX_ENCODERTYPES - 2,
+    TYPE_HUMAN_SUB_STATE = MAX_ENCODERTYPES - 1,
+};
+
+constexpr int VehicleFieldCount = 13;
+
+const int VehicleTypes[VehicleFieldCount] = {
+    BITPACK_WORLD_POSITION_X, BITPACK_WORLD_POSITION_Y, BITPACK_WORLD_POSITION_Z,
+    BITPACK_VEHICLE_QUATERNION, BITPACK_VEHICLE_QUATERNION, BITPACK_VEHICLE_QUATERNION, BITPACK_VEHICLE_QUATERNION,
+    BITPACK_VEHICLE_VELOCITY, BITPACK_VEHICLE_VELOCITY, BITPACK_VEHICLE_VELOCITY,
+    BITPACK_VEHICLE_ANGULAR_VELOCITY, BITPACK_VEHICLE_ANGULAR_VELOCITY, BITPACK_VEHICLE_ANGULAR_VELOCITY,
+};
+
+// The state VehicleGameObj and SoldierGameObj put in Export_Frequent.
+struct ObjectState
+{
+    bool IsVehicle;
+    bool Flag;
+    int Rounds;
+    int State;
+    int SubState;
+    float Fields[VehicleFieldCount];
+};
+
+void Set_Precisions()
+{
+    cEncoderList::Set_Precision(BITPACK_WORLD_POSITION_X, -1200.0f, 1200.0f, 0.2f);
+    cEncoderList::Set_Precision(BITPACK_WORLD_POSITION_Y, -1200.0f, 1200.0f, 0.2f);
+    cEncoderList::Set_Precision(BITPACK_WORLD_POSITION_Z, -200.0f, 300.0f, 0.2f);
+    cEncoderList::Set_Precision(BITPACK_VEHICLE_VELOCITY, -90.0f, 90.0f, 0.01f);
+    cEncoderList::Set_Precision(BITPACK_VEHICLE_ANGULAR_VELOCITY, -20.0f, 20.0f, 0.01f);
+    cEncoderList::Set_Precision(BITPACK_VEHICLE_QUATERNION, -1.0f, 1.0f, 0.0005f);
+    cEncoderList::Set_Precision(TYPE_HUMAN_STATE, 0, 12);
+    cEncoderList::Set_Precision(TYPE_HUMAN_SUB_STATE, 0, 40);
+}
+
+uint32_t Next_Random(uint32_t &state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+float Random_Float(uint32_t &state, float min, float max)
+{
+    return min + (max - min) * static_cast<float>(Next_Random(state) & 0xffff) / 65535.0f;
+}
+
+std::vector<ObjectState> Make_Objects()
+{
+    std::vector<ObjectState> objects(ObjectCount);
+    uint32_t seed = 4242;
+    for (ObjectState &object : objects) {
+        object.IsVehicle = (Next_Random(seed) % 4) == 0;
+        object.Flag = (Next_Random(seed) & 1) != 0;
+        object.Rounds = static_cast<int>(Next_Random(seed) % 500);
+        object.State = static_cast<int>(Next_Random(seed) % 13);
+        object.SubState = static_cast<int>(Next_Random(seed) % 41);
+        object.Fields[0] = Random_Float(seed, -1000.0f, 1000.0f);
+        object.Fields[1] = Random_Float(seed, -1000.0f, 1000.0f);
+        object.Fields[2] = Random_Float(seed, -50.0f, 200.0f);
+        for (int index = 3; index < 7; ++index) {
+            object.Fields[index] = Random_Float(seed, -1.0f, 1.0f);
+        }
+        for (int index = 7; index < 10; ++index) {
+            object.Fields[index] = Random_Float(seed, -80.0f, 80.0f);
+        }
+        for (int index = 10; index < 13; ++index) {
+            object.Fields[index] = Random_Float(seed, -15.0f, 15.0f);
+        }
+    }
+    return objects;
+}
+
+// One field at a time, as the game exports today.
+void Export_Fields(BitStreamClass &packet, const ObjectState &object)
+{
+    packet.Add(object.Flag);
+    packet.Add(object.Rounds);
+    if (object.IsVehicle) {
+        for (int index = 0; index < VehicleFieldCount; ++index) {
+            packet.Add(object.Fields[index], VehicleTypes[index]);
+        }
+    } else {
+        packet.Add(object.Fields[0], BITPACK_WORLD_POSITION_X);
+        packet.Add(object.Fields[1], BITPACK_WORLD_POSITION_Y);
+        packet.Add(object.Fields[2], BITPACK_WORLD_POSITION_Z);
+        packet.Add(object.State, TYPE_HUMAN_STATE);
+        packet.Add(object.SubState, TYPE_HUMAN_SUB_STATE);
+    }
+    packet.Add(object.Flag);
+}
+
+// Same stream with the float fields batched.
+void Export_Batched(BitStreamClass &packet, const ObjectState &object)
+{
+    packet.Add(object.Flag);
+    packet.Add(object.Rounds);
+    if (object.IsVehicle) {
+        packet.Add_Quantized(object.Fields, VehicleTypes, VehicleFieldCount);
+    } else {
+        packet.Add_Quantized(object.Fields, VehicleTypes, 3);
+        packet.Add(object.State, TYPE_HUMAN_STATE);
+        packet.Add(object.SubState, TYPE_HUMAN_SUB_STATE);
+    }
+    packet.Add(object.Flag);
+}
+
+void Import_Fields(BitStreamClass &packet, bool is_vehicle, ObjectState &object)
+{
+    object.IsVehicle = is_vehicle;
+    packet.Get(object.Flag);
+    packet.Get(object.Rounds);
+    if (is_vehicle) {
+        for (int index = 0; index < VehicleFieldCount; ++index) {
+            packet.Get(object.Fields[index], VehicleTypes[index]);
+        }
+    } else {
+        packet.Get(object.Fields[0], BITPACK_WORLD_POSITION_X);
+        packet.Get(object.Fields[1], BITPACK_WORLD_POSITION_Y);
+        packet.Get(object.Fields[2], BITPACK_WORLD_POSITION_Z);
+        packet.Get(object.State, TYPE_HUMAN_STATE);
+        packet.Get(object.SubState, TYPE_HUMAN_SUB_STATE);
+    }
+    packet.Get(object.Flag);
+}
+
+void Import_Batched(BitStreamClass &packet, bool is_vehicle, ObjectState &object)
+{
+    object.IsVehicle = is_vehicle;
+    packet.Get(object.Flag);
+    packet.Get(object.Rounds);
+    if (is_vehicle) {
+        packet.Get_Quantized(object.Fields, VehicleTypes, VehicleFieldCount);
+    } else {
+        packet.Get_Quantized(object.Fields, VehicleTypes, 3);
+        packet.Get(object.State, TYPE_HUMAN_STATE);
+        packet.Get(object.SubState, TYPE_HUMAN_SUB_STATE);
+    }
+    packet.Get(object.Flag);
+}
+
+//
+// Bit at a time reference writer for the wire format: MSB first, fields
+// packed back to back.
+//
+class ReferenceWriter
+{
+public:
+    void Add_Bits(uint32_t value, uint32_t num_bits)
+    {
+        for (int bit = static_cast<int>(num_bits) - 1; bit >= 0; --bit) {
+            if ((Bits % 8) == 0) {
+                Bytes.push_back(0);
+            }
+            if ((value >> bit) & 1) {
+                Bytes.back() |= static_cast<unsigned char>(0x80 >> (Bits % 8));
+            }
+            ++Bits;
+        }
+    }
+
+    void Add_Float(float value, int type)
+    {
+        uint32_t scaled;
+        cEncoderTypeEntry &entry = cEncoderList::Get_Encoder_Type_Entry(type);
+        entry.Scale(value, scaled);
+        Add_Bits(scaled, entry.Get_Bit_Precision());
+    }
+
+    void Add_Int(int value, int type)
+    {
+        uint32_t scaled;
+        cEncoderTypeEntry &entry = cEncoderList::Get_Encoder_Type_Entry(type);
+        entry.Scale(value, scaled);
+        Add_Bits(scaled, entry.Get_Bit_Precision());
+    }
+
+    std::vector<unsigned char> Bytes;
+    uint32_t Bits = 0;
+};
+
+void Export_Reference(ReferenceWriter &writer, const ObjectState &object)
+{
+    writer.Add_Bits(object.Flag, 1);
+    writer.Add_Bits(static_cast<uint32_t>(object.Rounds), 32);
+    if (object.IsVehicle) {
+        for (int index = 0; index < VehicleFieldCount; ++index) {
+            writer.Add_Float(object.Fields[index], VehicleTypes[index]);
+        }
+    } else {
+        writer.Add_Float(object.Fields[0], BITPACK_WORLD_POSITION_X);
+        writer.Add_Float(object.Fields[1], BITPACK_WORLD_POSITION_Y);
+        writer.Add_Float(object.Fields[2], BITPACK_WORLD_POSITION_Z);
+        writer.Add_Int(object.State, TYPE_HUMAN_STATE);
+        writer.Add_Int(object.SubState, TYPE_HUMAN_SUB_STATE);
+    }
+    writer.Add_Bits(object.Flag, 1);
+}
+
+//
+// Packs the objects into as many full size streams as it takes. Returns
+// the number of objects in each stream so the reader can walk them again.
+//
+template <class ExportFunction>
+void Fill_Streams(const std::vector<ObjectState> &objects, std::vector<BitStreamClass> &streams,
+                  std::vector<int> &counts, ExportFunction export_function)
+{
+    // Largest update is a vehicle: 2 bools, an int and 13 quantized floats.
+    const uint32_t max_update_bits = 2 + 32 + VehicleFieldCount * 32;
+
+    size_t stream = 0;
+    counts.assign(1, 0);
+    for (const ObjectState &object : objects) {
+        if (streams[stream].Get_Bit_Write_Position() + max_update_bits > MAX_BUFFER_SIZE * 8) {
+            ++stream;
+            counts.push_back(0);
+        }
+        export_function(streams[stream], object);
+        ++counts[stream];
+    }
+}
+
+bool Same_Bytes(BitStreamClass &stream, const unsigned char *expected, uint32_t bits)
+{
+    return stream.Get_Bit_Write_Position() == bits
+        && memcmp(stream.Peek_Data(), expected, (bits + 7) / 8) == 0;
+}
+
+bool Same_Object(const ObjectState &a, const ObjectState &b)
+{
+    if (a.IsVehicle != b.IsVehicle || a.Flag != b.Flag || a.Rounds != b.Rounds) {
+        return false;
+    }
+    int count = a.IsVehicle ? VehicleFieldCount : 3;
+    for (int index = 0; index < count; ++index) {
+        if (a.Fields[index] != b.Fields[index]) {
+            return false;
+        }
+    }
+    return a.IsVehicle || (a.State == b.State && a.SubState == b.SubState);
+}
+
+} // namespace
+
+int main()
+{
+    using Clock = std::chrono::steady_clock;
+
+    Set_Precisions();
+    std::vector<ObjectState> objects = Make_Objects();
+
+    //
+    // Both write paths must produce the reference bit stream.
+    //
+    {
+        std::vector<BitStreamClass> field_streams(ObjectCount);
+        std::vector<BitStreamClass> batched_streams(ObjectCount);
+        std::vector<int> field_counts;
+        std::vector<int> batched_counts;
+        Fill_Streams(objects, field_streams, field_counts, Export_Fields);
+        Fill_Streams(objects, batched_streams, batched_counts, Export_Batched);
+
+        size_t first = 0;
+        for (size_t stream = 0; stream < field_counts.size(); ++stream) {
+            ReferenceWriter reference;
+            for (int index = 0; index < field_counts[stream]; ++index) {
+                Export_Reference(reference, objects[first + index]);
+            }
+
+            if (!Same_Bytes(field_streams[stream], reference.Bytes.data(), reference.Bits)) {
+                std::cerr << "Add() stream " << stream << " differs from the reference layout.\n";
+                return 1;
+            }
+            if (batched_counts[stream] != field_counts[stream]
+                || !Same_Bytes(batched_streams[stream], reference.Bytes.data(), reference.Bits)) {
+                std::cerr << "Add_Quantized() stream " << stream << " differs from the reference layout.\n";
+                return 1;
+            }
+
+            for (int index = 0; index < field_counts[stream]; ++index) {
+                const ObjectState &object = objects[first + index];
+                ObjectState field_object;
+                ObjectState batched_object;
+                Import_Fields(field_streams[stream], object.IsVehicle, field_object);
+                Import_Batched(batched_streams[stream], object.IsVehicle, batched_object);
+                if (!Same_Object(field_object, batched_object)) {
+                    std::cerr << "Get_Quantized() disagrees with Get() for object " << first + index << ".\n";
+                    return 1;
+                }
+            }
+            if (!field_streams[stream].Is_Flushed() || !batched_streams[stream].Is_Flushed()) {
+                std::cerr << "Stream " << stream << " was not read to the end.\n";
+                return 1;
+            }
+            first += field_counts[stream];
+        }
+    }
+
+    //
+    // Throughput, in payload megabytes per second.
+    //
+    struct PathTimes
+    {
+        Clock::duration Write{};
+        Clock::duration Read{};
+        uint64_t Bytes = 0;
+    };
+    PathTimes field_times;
+    PathTimes batched_times;
+
+    for (int round = 0; round < Rounds; ++round) {
+        for (int path = 0; path < 2; ++path) {
+            bool batched = (path == 1);
+            PathTimes &times = batched ? batched_times : field_times;
+
+            std::vector<BitStreamClass> streams(ObjectCount);
+            std::vector<int> counts;
+
+            Clock::time_point start = Clock::now();
+            if (batched) {
+                Fill_Streams(objects, streams, counts, Export_Batched);
+            } else {
+                Fill_Streams(objects, streams, counts, Export_Fields);
+            }
+            times.Write += Clock::now() - start;
+
+            ObjectState object;
+            size_t first = 0;
+            start = Clock::now();
+            for (size_t stream = 0; stream < counts.size(); ++stream) {
+                for (int index = 0; index < counts[stream]; ++index) {
+                    if (batched) {
+                        Import_Batched(streams[stream], objects[first + index].IsVehicle, object);
+                    } else {
+                        Import_Fields(streams[stream], objects[first + index].IsVehicle, object);
+                    }
+                }
+                first += counts[stream];
+            }
+            times.Read += Clock::now() - start;
+
+            for (size_t stream = 0; stream < counts.size(); ++stream) {
+                times.Bytes += streams[stream].Get_Compressed_Size_Bytes();
+            }
+        }
+    }
+
+    auto megabytes_per_second = [](uint64_t bytes, Clock::duration time) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0) / std::chrono::duration<double>(time).count();
+    };
+
+    std::cout << "Export_Frequent streams, " << ObjectCount << " objects x " << Rounds << " rounds\n"
+              << "Add/Get:                 write " << megabytes_per_second(field_times.Bytes, field_times.Write)
+              << " MB/s, read " << megabytes_per_second(field_times.Bytes, field_times.Read) << " MB/s\n"
+              << "Add/Get_Quantized:       write " << megabytes_per_second(batched_times.Bytes, batched_times.Write)
+              << " MB/s, read " << megabytes_per_second(batched_times.Bytes, batched_times.Read) << " MB/s\n";
+
+    return 0;
+}
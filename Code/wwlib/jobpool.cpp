@@ -0,0 +1,213 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "jobpool.h"
+#include "wwdebug.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+struct JobPoolStateStruct
+{
+	std::vector<std::thread>	Workers;
+
+	// Guards the job description below and the wake up / shutdown signalling.
+	std::mutex						Mutex;
+	std::condition_variable		WorkReady;
+	std::condition_variable		WorkDone;
+
+	// Serializes Run() calls coming from different threads.
+	std::mutex						RunMutex;
+
+	JobPoolClass::JobFunction	Function = nullptr;
+	void *							UserData = nullptr;
+	int								Count = 0;
+	unsigned							Generation = 0;
+	bool								Quit = false;
+
+	std::atomic<int>				NextIndex{0};
+	std::atomic<int>				Remaining{0};
+	int								ActiveWorkers = 0;
+
+	// Stop the workers if nobody called Shutdown() before exit.
+	~JobPoolStateStruct(void)	{ JobPoolClass::Shutdown(); }
+};
+
+JobPoolStateStruct	PoolState;
+thread_local bool		IsPoolWorker = false;
+
+// Pull indices off the shared counter until the loop is exhausted.
+void Process_Indices(JobPoolClass::JobFunction function, void *user_data, int count)
+{
+	for (;;) {
+		int index = PoolState.NextIndex.fetch_add(1, std::memory_order_relaxed);
+		if (index >= count) {
+			break;
+		}
+		function(index, user_data);
+		PoolState.Remaining.fetch_sub(1, std::memory_order_acq_rel);
+	}
+}
+
+void Worker_Main(void)
+{
+	IsPoolWorker = true;
+	unsigned seen_generation = 0;
+
+	for (;;) {
+		JobPoolClass::JobFunction function;
+		void *user_data;
+		int count;
+
+		{
+			std::unique_lock<std::mutex> lock(PoolState.Mutex);
+			PoolState.WorkReady.wait(lock, [&] { return PoolState.Quit || PoolState.Generation != seen_generation; });
+			if (PoolState.Quit) {
+				return;
+			}
+			seen_generation = PoolState.Generation;
+
+			//
+			// A worker that wakes after the loop has already been drained must not
+			// join, otherwise it could end up pulling indices of the next Run().
+			//
+			if (PoolState.Remaining.load(std::memory_order_acquire) == 0) {
+				continue;
+			}
+			function = PoolState.Function;
+			user_data = PoolState.UserData;
+			count = PoolState.Count;
+			PoolState.ActiveWorkers++;
+		}
+
+		Process_Indices(function, user_data, count);
+
+		{
+			std::lock_guard<std::mutex> lock(PoolState.Mutex);
+			PoolState.ActiveWorkers--;
+		}
+		PoolState.WorkDone.notify_all();
+	}
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+
+void JobPoolClass::Init(int worker_count)
+{
+	Shutdown();
+
+	if (worker_count < 0) {
+		int cores = (int)std::thread::hardware_concurrency();
+		worker_count = (cores > 1) ? cores - 1 : 0;
+	}
+
+	WWDEBUG_SAY(("JobPoolClass::Init - starting %d worker threads\n", worker_count));
+
+	PoolState.Quit = false;
+	PoolState.Workers.reserve(worker_count);
+	for (int i = 0; i < worker_count; i++) {
+		PoolState.Workers.emplace_back(Worker_Main);
+	}
+}
+
+void JobPoolClass::Shutdown(void)
+{
+	if (PoolState.Workers.empty()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(PoolState.Mutex);
+		PoolState.Quit = true;
+	}
+	PoolState.WorkReady.notify_all();
+
+	for (std::thread &worker : PoolState.Workers) {
+		worker.join();
+	}
+	PoolState.Workers.clear();
+	PoolState.Quit = false;
+}
+
+bool JobPoolClass::Is_Initialized(void)
+{
+	return !PoolState.Workers.empty();
+}
+
+int JobPoolClass::Get_Worker_Count(void)
+{
+	return (int)PoolState.Workers.size();
+}
+
+bool JobPoolClass::Is_Worker_Thread(void)
+{
+	return IsPoolWorker;
+}
+
+void JobPoolClass::Run(int count, JobFunction function, void *user_data)
+{
+	WWASSERT(function != nullptr);
+
+	if (count <= 0) {
+		return;
+	}
+
+	//
+	// Nothing to gain from waking the workers for a single item, and nested
+	// calls from inside a job must not wait on the pool they are running in.
+	//
+	if (count == 1 || PoolState.Workers.empty() || IsPoolWorker) {
+		for (int index = 0; index < count; index++) {
+			function(index, user_data);
+		}
+		return;
+	}
+
+	std::lock_guard<std::mutex> run_lock(PoolState.RunMutex);
+
+	{
+		std::lock_guard<std::mutex> lock(PoolState.Mutex);
+		PoolState.Function = function;
+		PoolState.UserData = user_data;
+		PoolState.Count = count;
+		PoolState.NextIndex.store(0, std::memory_order_relaxed);
+		PoolState.Remaining.store(count, std::memory_order_relaxed);
+		PoolState.Generation++;
+	}
+	PoolState.WorkReady.notify_all();
+
+	Process_Indices(function, user_data, count);
+
+	//
+	// Wait for the last items to finish and for every worker to let go of the
+	// job description so the next Run() can safely replace it.
+	//
+	std::unique_lock<std::mutex> lock(PoolState.Mutex);
+	PoolState.WorkDone.wait(lock, [] {
+		return PoolState.Remaining.load(std::memory_order_acquire) == 0 && PoolState.ActiveWorkers == 0;
+	});
+}
@@ -0,0 +1,79 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JOBPOOL_H
+#define JOBPOOL_H
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include "always.h"
+
+
+// ----------------------------------------------------------------------------
+//
+// JobPoolClass is a small fixed size pool of worker threads used to split
+// embarrassingly parallel loops (per client, per island, per file...) across
+// the available cores.
+//
+// Run() blocks until every index in [0, count) has been processed. The
+// calling thread takes part in the work, so a pool with zero workers (the
+// default until Init() is called) simply runs the loop inline. Calling Run()
+// from inside a job also runs inline rather than deadlocking.
+//
+// Jobs must not touch anything that is not safe to access from more than one
+// thread at a time; the pool provides no synchronization beyond the barrier at
+// the end of Run().
+//
+// ----------------------------------------------------------------------------
+
+class JobPoolClass
+{
+public:
+	typedef void (*JobFunction)(int index, void *user_data);
+
+	// Start the worker threads. A negative count uses one worker per core,
+	// minus one for the calling thread.
+	static void Init(int worker_count = -1);
+	static void Shutdown(void);
+
+	static bool Is_Initialized(void);
+	static int Get_Worker_Count(void);
+
+	// Call function(index, user_data) for every index in [0, count).
+	static void Run(int count, JobFunction function, void *user_data);
+
+	// Convenience wrapper for lambdas and other functors taking an int index.
+	template<class T> static void Run(int count, const T &functor)
+	{
+		Run(count, &Functor_Trampoline<T>, const_cast<T *>(&functor));
+	}
+
+	// True if the calling thread is one of the pool workers.
+	static bool Is_Worker_Thread(void);
+
+private:
+	template<class T> static void Functor_Trampoline(int index, void *user_data)
+	{
+		(*static_cast<const T *>(user_data))(index);
+	}
+};
+
+
+#endif
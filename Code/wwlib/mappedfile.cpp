@@ -0,0 +1,120 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mappedfile.h"
+#include "wwdebug.h"
+
+#include <climits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+MappedFileClass::MappedFileClass(void) :
+	Data(nullptr),
+	Size(0),
+	NumRefs(1)
+{
+}
+
+MappedFileClass::~MappedFileClass(void)
+{
+	Unmap();
+}
+
+bool MappedFileClass::Map(const char *filename)
+{
+	Unmap();
+
+#ifdef _WIN32
+	HANDLE file = ::CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER file_size;
+	if (!::GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0 || file_size.QuadPart > INT_MAX) {
+		::CloseHandle(file);
+		return false;
+	}
+
+	//
+	// The view keeps the mapping object alive, so neither handle is needed
+	// once the view exists.
+	//
+	HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	::CloseHandle(file);
+	if (mapping == nullptr) {
+		return false;
+	}
+
+	void *data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	::CloseHandle(mapping);
+	if (data == nullptr) {
+		WWDEBUG_SAY(("MappedFileClass: unable to map %s (%lu)\n", filename, ::GetLastError()));
+		return false;
+	}
+	int size = static_cast<int>(file_size.QuadPart);
+#else
+	int fd = ::open(filename, O_RDONLY);
+	if (fd == -1) {
+		return false;
+	}
+
+	struct stat info;
+	if (::fstat(fd, &info) != 0 || info.st_size == 0 || info.st_size > INT_MAX) {
+		::close(fd);
+		return false;
+	}
+
+	void *data = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED) {
+		WWDEBUG_SAY(("MappedFileClass: unable to map %s\n", filename));
+		return false;
+	}
+	int size = static_cast<int>(info.st_size);
+#endif
+
+	Data = static_cast<const unsigned char *>(data);
+	Size = size;
+	return true;
+}
+
+void MappedFileClass::Unmap(void)
+{
+	if (Data == nullptr) {
+		return;
+	}
+
+#ifdef _WIN32
+	::UnmapViewOfFile(Data);
+#else
+	::munmap(const_cast<unsigned char *>(Data), Size);
+#endif
+
+	Data = nullptr;
+	Size = 0;
+}
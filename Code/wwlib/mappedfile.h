@@ -0,0 +1,75 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include "always.h"
+
+#include <atomic>
+
+
+// ----------------------------------------------------------------------------
+//
+// MappedFileClass maps a whole file read-only into memory. The OS pages the
+// data in as it is touched and shares the pages between every reader, so once
+// a file is mapped any part of it can be read with a plain memory access and
+// no further file system calls.
+//
+// Map() fails (and the object stays empty) if the file can't be opened, is
+// empty, or there is no room in the address space for it; callers are
+// expected to fall back to regular file access in that case.
+//
+// The mapping stays valid until Unmap() or the destructor, and anything that
+// kept a pointer into it must be done with it by then. A mapping shared by
+// several owners is created with new and reference counted instead: each
+// owner that keeps a pointer into it holds a reference, and the last
+// Release_Ref unmaps and deletes it. The count may be changed from any thread.
+//
+// ----------------------------------------------------------------------------
+
+class MappedFileClass
+{
+public:
+	MappedFileClass(void);
+	~MappedFileClass(void);
+
+	bool Map(const char *filename);
+	void Unmap(void);
+
+	bool Is_Mapped(void) const					{ return Data != nullptr; }
+	const unsigned char * Peek_Data(void) const	{ return Data; }
+	int Get_Size(void) const					{ return Size; }
+
+	void Add_Ref(void)							{ NumRefs++; }
+	void Release_Ref(void)						{ if (--NumRefs == 0) delete this; }
+
+private:
+	MappedFileClass(const MappedFileClass &) = delete;
+	MappedFileClass & operator=(const MappedFileClass &) = delete;
+
+	const unsigned char *	Data;
+	int						Size;
+	std::atomic<int>		NumRefs;
+};
+
+#endif
@@ -43,6 +43,10 @@
 #include "pathutil.h"
 #include "win.h"
 #include "bittype.h"
+#include "refcount.h"
+
+#include <algorithm>
+#include <string.h>
 
 /*
 **
@@ -62,6 +66,107 @@ typedef struct
 } MIXFILE_DATA_HEADER;
 
 
+/*
+**	A read-only file whose data lives in a mapped mix file.  Reads are memory copies, and
+**	Peek_Data lets callers use the data in place.  The view holds a reference to the mapping,
+**	so it stays valid however long the view lives, even past its factory.
+*/
+class MixFileViewClass : public FileClass
+{
+public:
+	MixFileViewClass( const char * filename, MappedFileClass * mapping, const unsigned char * data, int size, unsigned int date_time ) :
+		Filename( filename ),
+		Mapping( mapping ),
+		FullData( data ),
+		FullSize( size ),
+		Data( data ),
+		Length( size ),
+		Position( 0 ),
+		DateTime( date_time ),
+		IsOpen( false )				{ Mapping->Add_Ref(); }
+	virtual ~MixFileViewClass( void )										{ Mapping->Release_Ref(); }
+
+	virtual char const * File_Name( void ) const override					{ return Filename; }
+	virtual char const * Set_Name( char const * filename ) override		{ Filename = filename; return Filename; }
+	virtual int Create( void ) override											{ return false; }
+	virtual int Delete( void ) override											{ return false; }
+	virtual bool Is_Available( int /*forced*/ ) override						{ return true; }
+	virtual bool Is_Open( void ) const override									{ return IsOpen; }
+	virtual int Open( char const * filename, int rights ) override		{ Set_Name( filename ); return Open( rights ); }
+	virtual int Open( int rights ) override;
+	virtual int Read( void * buffer, int size ) override;
+	virtual int Seek( int pos, int dir ) override;
+	virtual int Size( void ) override												{ return Length; }
+	virtual int Write( void const * /*buffer*/, int /*size*/ ) override	{ return 0; }
+	virtual void Close( void ) override												{ IsOpen = false; }
+	virtual unsigned int Get_Date_Time( void ) override						{ return DateTime; }
+	virtual void Error( int, int, char const * ) override						{}
+	virtual void Bias( int start, int length ) override;
+	virtual const void * Peek_Data( void ) const override						{ return Data; }
+	virtual MappedFileClass * Peek_Mapping( void ) const override			{ return Mapping; }
+
+private:
+	StringClass					Filename;
+	MappedFileClass *			Mapping;
+	const unsigned char *	FullData;		// the whole entry
+	int							FullSize;
+	const unsigned char *	Data;				// the biased part of it
+	int							Length;
+	int							Position;
+	unsigned int				DateTime;
+	bool							IsOpen;
+};
+
+int	MixFileViewClass::Open( int rights )
+{
+	if ( rights & WRITE ) {
+		return false;
+	}
+	IsOpen = true;
+	Position = 0;
+	return true;
+}
+
+int	MixFileViewClass::Read( void * buffer, int size )
+{
+	size = std::min( size, Length - Position );
+	if ( size <= 0 ) {
+		return 0;
+	}
+	::memcpy( buffer, Data + Position, size );
+	Position += size;
+	return size;
+}
+
+int	MixFileViewClass::Seek( int pos, int dir )
+{
+	switch ( dir ) {
+		case SEEK_SET:	break;
+		case SEEK_CUR:	pos += Position;	break;
+		case SEEK_END:	pos += Length;		break;
+	}
+	Position = std::clamp( pos, 0, Length );
+	return Position;
+}
+
+void	MixFileViewClass::Bias( int start, int length )
+{
+	start = std::clamp( start, 0, FullSize );
+	if ( length < 0 || length > FullSize - start ) {
+		length = FullSize - start;
+	}
+	Data = FullData + start;
+	Length = length;
+	Position = 0;
+}
+
+
+/*
+**
+*/
+bool	MixFileFactoryClass::MappingEnabled = true;
+
+
 /*
 **
 */
@@ -71,7 +176,9 @@ MixFileFactoryClass::MixFileFactoryClass( const char * mix_filename, FileFactory
 	IsValid (false),
 	BaseOffset (0),
 	Factory (nullptr),
-	IsModified (false)
+	IsModified (false),
+	Mapping (nullptr),
+	MixDateTime (0)
 {
 //	WWDEBUG_SAY(( "MixFileFactory( %s )\n", mix_filename ));
 	MixFilename	= mix_filename;
@@ -126,7 +233,12 @@ MixFileFactoryClass::MixFileFactoryClass( const char * mix_filename, FileFactory
 		if ( IsValid ) {
 			BaseOffset	= 0;
 			NamesOffset	= header.names_offset;
+			MixDateTime	= file->Get_Date_Time();
 			WWDEBUG_SAY(( "MixFileFactory( %s ) loaded successfully  %d files\n", MixFilename.Peek_Buffer(), FileInfo.Length() ));
+
+			if ( MappingEnabled ) {
+				Map_Mix_File( file->File_Name() );
+			}
 		} else {
 			FileInfo.Resize(0);
 		}
@@ -140,9 +252,30 @@ MixFileFactoryClass::MixFileFactoryClass( const char * mix_filename, FileFactory
 
 MixFileFactoryClass::~MixFileFactoryClass( void )
 {
+	REF_PTR_RELEASE( Mapping );
 	FileInfo.Resize(0);
 }
 
+void	MixFileFactoryClass::Map_Mix_File( const char * full_path )
+{
+	Mapping = new MappedFileClass;
+	if ( !Mapping->Map( full_path ) ) {
+		REF_PTR_RELEASE( Mapping );
+		return;
+	}
+
+	//
+	//	Don't hand out views that would run off the end of a truncated mix file
+	//
+	for ( int index = 0; index < FileInfo.Length(); index ++ ) {
+		if ( (unsigned int)BaseOffset + FileInfo[index].Offset + FileInfo[index].Size > (unsigned int)Mapping->Get_Size() ) {
+			WWDEBUG_SAY(( "MixFileFactory( %s ) entries past the end of the file, not mapping\n", MixFilename.Peek_Buffer() ));
+			REF_PTR_RELEASE( Mapping );
+			return;
+		}
+	}
+}
+
 bool	MixFileFactoryClass::Build_Filename_List (DynamicVectorClass<StringClass> &list)
 {
 	if (IsValid == false) {
@@ -238,6 +371,10 @@ FileClass * MixFileFactoryClass::Get_File( char const *filename )
 		}
 	}
 
+	if ( info != nullptr && Mapping != nullptr ) {
+		return new MixFileViewClass( filename, Mapping, Mapping->Peek_Data() + BaseOffset + info->Offset, info->Size, MixDateTime );
+	}
+
 	if ( info != nullptr) {
 //		WWDEBUG_SAY(( "MixFileFactoryClass::Get_File( %s ) FOUND\n", filename ));
 		file = (RawFileClass *)Factory->Get_File( MixFilename );
@@ -255,7 +392,11 @@ FileClass * MixFileFactoryClass::Get_File( char const *filename )
 void	MixFileFactoryClass::Return_File( FileClass * file )
 {
 	if ( file != nullptr ) {
-		Factory->Return_File( file );
+		if ( file->Peek_Mapping() != nullptr ) {
+			delete file;
+		} else {
+			Factory->Return_File( file );
+		}
 	}
 }
 
@@ -363,8 +504,12 @@ MixFileFactoryClass::Flush_Changes (void)
 	}
 
 	//
-	//	Delete the old mix file and rename the new one
+	//	Delete the old mix file and rename the new one.  The old one can't be deleted
+	//	while it is mapped, and the file table no longer matches the new one anyway.
+	//	Views that are still out keep the old mapping alive until they are returned.
 	//
+	REF_PTR_RELEASE (Mapping);
+
 	::DeleteFileA (MixFilename);
 	::MoveFileA (full_path, MixFilename);
 
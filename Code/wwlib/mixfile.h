@@ -50,6 +50,7 @@
 #endif
 
 #include "vector.h"
+#include "mappedfile.h"
 
 class FileClass;
 
@@ -87,6 +88,16 @@ public:
 	//	Information
 	//
 	bool		Is_Valid (void) const	{ return IsValid; }
+	bool		Is_Mapped (void) const	{ return Mapping != nullptr; }
+
+	//
+	//	Memory mapping.  Mix files created while this is enabled (the default) are mapped
+	//	into memory once, and Get_File hands out views that read straight from the mapping
+	//	instead of opening the mix file again for every entry.  Mix files that can't be
+	//	mapped fall back to biased file access.
+	//
+	static void	Enable_Mapping (bool onoff)	{ MappingEnabled = onoff; }
+	static bool	Is_Mapping_Enabled (void)		{ return MappingEnabled; }
 
 private:
 
@@ -94,6 +105,7 @@ private:
 	//	Utility functions
 	//
 	bool		Get_Temp_Filename (const char *path, StringClass &full_path);
+	void		Map_Mix_File (const char *full_path);
 
 	struct FileInfoStruct {
 		bool operator== (const FileInfoStruct &/* src*/)	{ return false; }
@@ -124,6 +136,11 @@ private:
 
 	DynamicVectorClass<AddInfoStruct>	PendingAddFileList;
 	bool											IsModified;
+
+	MappedFileClass *							Mapping;			// shared with the views handed out, null if not mapped
+	unsigned int								MixDateTime;
+
+	static bool									MappingEnabled;
 };
 
 /*
@@ -39,11 +39,30 @@
 #include "multilist.h"
 #include "wwmemlog.h"
 
+#include <atomic>
+#include <mutex>
+
 /*
 ** Delcare the pool for ListNodes
 */
 DEFINE_AUTO_POOL(MultiListNodeClass, 256);
 
+/*
+** Lock used while thread safety is enabled, see GenericMultiListClass::Enable_Thread_Safety
+*/
+static std::atomic<bool>		_ThreadSafe(false);
+static std::recursive_mutex	_ListMutex;
+
+class MultiListLockClass
+{
+public:
+	MultiListLockClass(void) : Locked(_ThreadSafe.load(std::memory_order_acquire))	{ if (Locked) _ListMutex.lock(); }
+	~MultiListLockClass(void)																		{ if (Locked) _ListMutex.unlock(); }
+
+private:
+	bool	Locked;
+};
+
 
 /***********************************************************************************************
 
@@ -72,9 +91,20 @@ GenericMultiListClass::~GenericMultiListClass(void)
 	assert(Is_Empty());
 }
 
+void GenericMultiListClass::Enable_Thread_Safety(bool onoff)
+{
+	_ThreadSafe.store(onoff,std::memory_order_release);
+}
+
+bool GenericMultiListClass::Is_Thread_Safety_Enabled(void)
+{
+	return _ThreadSafe.load(std::memory_order_acquire);
+}
+
 bool GenericMultiListClass::Contains(MultiListObjectClass * obj)
 {
 	assert(obj);
+	MultiListLockClass lock;
 
 	MultiListNodeClass* lnode = obj->Get_List_Node();
 	while (lnode) {
@@ -97,6 +127,7 @@ int GenericMultiListClass::Count(void)
 bool GenericMultiListClass::Internal_Add(MultiListObjectClass *obj, bool onlyonce)
 {
 	WWMEMLOG(MEM_GAMEDATA);
+	MultiListLockClass lock;
 	assert(obj);
 
 	if (onlyonce && Is_In_List(obj)) {
@@ -126,6 +157,7 @@ bool GenericMultiListClass::Internal_Add(MultiListObjectClass *obj, bool onlyonc
 bool GenericMultiListClass::Internal_Add_Tail(MultiListObjectClass * obj,bool onlyonce)
 {
 	WWMEMLOG(MEM_GAMEDATA);
+	MultiListLockClass lock;
 	assert(obj);
 
 	if (onlyonce && Is_In_List(obj)) {
@@ -155,6 +187,7 @@ bool GenericMultiListClass::Internal_Add_Tail(MultiListObjectClass * obj,bool on
 bool GenericMultiListClass::Internal_Add_After(MultiListObjectClass * obj,const MultiListObjectClass * existing_list_member,bool onlyonce)
 {
 	WWMEMLOG(MEM_GAMEDATA);
+	MultiListLockClass lock;
 	assert(obj);
 	assert(existing_list_member);
 
@@ -192,6 +225,8 @@ bool GenericMultiListClass::Internal_Add_After(MultiListObjectClass * obj,const
 
 bool GenericMultiListClass::Internal_Remove(MultiListObjectClass *obj)
 {
+	MultiListLockClass lock;
+
 	// find the list node in this object that belongs to this list
 	MultiListNodeClass * lnode = obj->Get_List_Node();
 	MultiListNodeClass * prevlnode = 0;
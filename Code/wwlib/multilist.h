@@ -129,6 +129,16 @@ public:
 	bool							Is_Empty(void);
 	int							Count(void);
 
+	/*
+	** Every object carries the chain of nodes for all of the lists it is in and the nodes come
+	** from a shared pool, so adding an object to a list touches state shared with every other
+	** list.  While thread safety is enabled, all adds, removes and membership tests are done
+	** under one lock.  Iterating a list is not protected, keep lists that are iterated private
+	** to a thread.
+	*/
+	static void					Enable_Thread_Safety(bool onoff);
+	static bool					Is_Thread_Safety_Enabled(void);
+
 protected:
 
 	bool							Internal_Add(MultiListObjectClass *obj,bool onlyonce = true);
@@ -72,6 +72,9 @@
 #endif
 
 
+std::atomic<unsigned int> RawFileClass::SystemCallCount(0);
+
+
 #ifdef NEVER
 	/*
 	**	This is a duplicate of the error numbers. The error handler for the RawFileClass handles
@@ -455,6 +458,7 @@ int RawFileClass::Open(int rights)
 				#endif
 				break;
 		}
+		SystemCallCount++;
 
 		/*
 		**	Biased files must be positioned past the bias start position.
@@ -543,6 +547,7 @@ bool RawFileClass::Is_Available(int forced)
 	/*
 	**	Since the file could be opened, then close it and return that the file exists.
 	*/
+	SystemCallCount += 2;
 	int closeok;
 	#if defined(OPENW3D_WIN32)
 		closeok=CloseHandle(Handle);
@@ -589,6 +594,7 @@ void RawFileClass::Close(void)
 		**	Try to close the file. If there was an error (who knows what that could be), then
 		**	call the error routine.
 		*/
+		SystemCallCount++;
 		int closeok;
 		#if defined(OPENW3D_WIN32)
 			closeok=CloseHandle(Handle);
@@ -668,6 +674,7 @@ int RawFileClass::Read(void * buffer, int size)
 		bytesread = 0;
 
 		int readok=true;
+		SystemCallCount++;
 
 		#if defined(OPENW3D_WIN32)
 			readok=ReadFile(Handle, buffer, size, &(DWORD&)bytesread, nullptr);
@@ -742,6 +749,7 @@ int RawFileClass::Write(void const * buffer, int size)
 	}
 
 	int writeok=true;
+	SystemCallCount++;
 	#if defined(OPENW3D_WIN32)
 		writeok=WriteFile(Handle, buffer, size, reinterpret_cast<LPDWORD>(&byteswritten), nullptr);
 		if (!writeok) {
@@ -888,6 +896,7 @@ int RawFileClass::Size(void)
 	**	If the file is open, then proceed normally.
 	*/
 	if (Is_Open()) {
+		SystemCallCount++;
 
 		#if defined(OPENW3D_WIN32)
 			size = GetFileSize(Handle, nullptr);
@@ -1275,6 +1284,7 @@ int RawFileClass::Raw_Seek(int pos, int dir)
 	if (!Is_Open()) {
 		Error(EBADF, false, Filename);
 	}
+	SystemCallCount++;
 
 	#if defined(OPENW3D_WIN32)
 		switch (dir) {
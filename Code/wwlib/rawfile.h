@@ -51,6 +51,8 @@
 #include	"wwfile.h"
 #include "wwstring.h"
 
+#include <atomic>
+
 
 #ifndef WWERROR
 #define WWERROR	-1
@@ -107,6 +109,12 @@ class RawFileClass : public FileClass
 		virtual void	Attach (HANDLE_TYPE handle, int rights=READ);
 		virtual void	Detach (void);
 
+		/*
+		**	Running count of the low level open, close, read, write, seek and size calls made
+		**	by all raw files. Used to measure how much file system traffic a load causes.
+		*/
+		static unsigned int Get_System_Call_Count(void) { return SystemCallCount; }
+
 		/*
 		**	These bias values enable a sub-portion of a file to appear as if it
 		**	were the whole file. This comes in very handy for multi-part files such as
@@ -128,6 +136,8 @@ class RawFileClass : public FileClass
 
 	private:
 
+		static std::atomic<unsigned int> SystemCallCount;
+
 		/*
 		**	This is the low level DOS handle. A -1 indicates an empty condition.
 		*/
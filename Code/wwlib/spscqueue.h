@@ -0,0 +1,95 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include "always.h"
+
+#include <atomic>
+
+
+// ----------------------------------------------------------------------------
+//
+// SpscQueueClass is a fixed size lock free ring buffer for handing items from
+// exactly one producer thread to exactly one consumer thread.
+//
+// Push() may only be called by the producer and Pop() only by the consumer.
+// The other calls are safe from either side but only give a snapshot. SIZE
+// must be a power of two; the queue holds at most SIZE items.
+//
+// ----------------------------------------------------------------------------
+
+template<class T, int SIZE>
+class SpscQueueClass
+{
+public:
+	SpscQueueClass(void) : Head(0), Tail(0) {}
+
+	// Returns false, and leaves the queue alone, if it is full.
+	bool Push(const T &item)
+	{
+		unsigned tail = Tail.load(std::memory_order_relaxed);
+		if (tail - Head.load(std::memory_order_acquire) >= (unsigned)SIZE) {
+			return false;
+		}
+		Items[tail & (SIZE - 1)] = item;
+		Tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Returns false, and leaves item alone, if the queue is empty.
+	bool Pop(T &item)
+	{
+		unsigned head = Head.load(std::memory_order_relaxed);
+		if (head == Tail.load(std::memory_order_acquire)) {
+			return false;
+		}
+		item = Items[head & (SIZE - 1)];
+		Head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	int Count(void) const
+	{
+		return (int)(Tail.load(std::memory_order_acquire) - Head.load(std::memory_order_acquire));
+	}
+
+	bool Is_Empty(void) const	{ return Count() == 0; }
+	bool Is_Full(void) const	{ return Count() >= SIZE; }
+
+private:
+	static_assert(SIZE > 0 && (SIZE & (SIZE - 1)) == 0, "SpscQueueClass size must be a power of two");
+
+	SpscQueueClass(const SpscQueueClass &);
+	SpscQueueClass &operator=(const SpscQueueClass &);
+
+	T								Items[SIZE];
+
+	// Head is only written by the consumer and Tail only by the producer.
+	// Keep them on separate cache lines so the two sides don't fight.
+	alignas(64) std::atomic<unsigned>	Head;
+	alignas(64) std::atomic<unsigned>	Tail;
+};
+
+
+#endif
@@ -69,6 +69,8 @@
 #endif
 
 
+class MappedFileClass;
+
 class FileClass
 {
 	public:
@@ -99,6 +101,14 @@ class FileClass
 		virtual bool Set_Date_Time(unsigned int ) {return(false);}
 		virtual void Error(int error, int canretry = false, char const * filename=nullptr) = 0;
 		virtual HANDLE_TYPE Get_File_Handle(void) { return nullptr; }
+
+		// files that live in memory (resources, views of a mapped mix file) return a pointer to the
+		// start of their data here so callers can use it without reading it into a buffer.
+		virtual const void * Peek_Data(void) const { return nullptr; }
+
+		// a file whose data lives in a shared mapping returns it here. Whoever keeps using the
+		// Peek_Data pointer after returning the file must Add_Ref the mapping and release it later.
+		virtual MappedFileClass * Peek_Mapping(void) const { return nullptr; }
 		virtual void Bias(int start, int length=-1) = 0;
 
 		operator char const * ()
@@ -160,6 +160,7 @@ cConnection::cConnection() :
 	ApplicationAcceptanceHandler(nullptr),
 	ServerPacketHandler(nullptr),
 	ClientPacketHandler(nullptr),
+	ReceiveScratchPacket(nullptr),
 	IsBadConnection(false),
 	ExtraTimeoutTime(0),
 	ExtraTimeoutTimeStarted(0),
@@ -211,6 +212,17 @@ cConnection::~cConnection()
 {
 	WWDEBUG_SAY(("cConnection::~cConnection\n"));
 
+	NetworkThreadClass::Unregister_Service(this);
+	NetworkThreadLockClass lock;
+
+	ReceivedPacketStruct received;
+	while (ReceivedPackets.Pop(received)) {
+		received.Packet->Flush();
+		delete received.Packet;
+	}
+	delete ReceiveScratchPacket;
+	ReceiveScratchPacket = nullptr;
+
 	//Remove_All();
 
    if (!cSinglePlayerData::Is_Single_Player()) {
@@ -304,6 +316,10 @@ void cConnection::Init_As_Client(struct sockaddr_in* p_server_address, unsigned
 	Init_Stats();
 
 	InitDone = true;
+
+   if (!cSinglePlayerData::Is_Single_Player()) {
+		NetworkThreadClass::Register_Service(this);
+	}
 }
 
 //------------------------------------------------------------------------------------
@@ -381,6 +397,8 @@ void cConnection::Init_As_Server(USHORT server_port, int max_players,
 #ifdef _WIN32
 		WOLNATInterface.Set_Server(true);
 #endif
+
+		NetworkThreadClass::Register_Service(this);
    }
 
 	InitDone = true;
@@ -621,7 +639,7 @@ int cConnection::Single_Player_recvfrom(char * data)
 
       cPacket * p_packet = objnode->Data();
       WWASSERT(p_packet != nullptr);
-      memcpy(data, p_packet->Get_Data(), p_packet->Get_Max_Size());
+      memcpy(data, p_packet->Peek_Data(), p_packet->Get_Compressed_Size_Bytes());
 
 		ret_code = p_packet->Get_Compressed_Size_Bytes();
 
@@ -637,15 +655,14 @@ int cConnection::Single_Player_recvfrom(char * data)
 //
 // Return true if we receive a valid packet on this call
 //
-bool cConnection::Receive_Packet()
+cConnection::RECEIVE_RESULT cConnection::Receive_And_Acknowledge(cPacket & packet, int & ret_code, bool & is_acked)
 {
-	//WWDEBUG_SAY(("cConnection::Receive_Packet start\n"));
+	//WWDEBUG_SAY(("cConnection::Receive_And_Acknowledge start\n"));
 
    WWASSERT(InitDone);
 
-   cPacket packet;
-
-	int ret_code = 0;
+	ret_code = 0;
+	is_acked = false;
 
 #if 0 //def WWDEBUG // TODO LaggedPacketRetCodes.Delete(p) ambiguous
 	//
@@ -671,10 +688,10 @@ bool cConnection::Receive_Packet()
 		ret_code = Receive_Wrapper(packet);
 
 		if (ret_code == 0) {
-			return(false);
+			return(RECEIVED_NOTHING);
 		}
 		if (cSinglePlayerData::Is_Single_Player() && ret_code == SOCKET_ERROR) {
-			return(false);
+			return(RECEIVED_NOTHING);
 		}
 
 
@@ -686,7 +703,7 @@ bool cConnection::Receive_Packet()
       	WWDEBUG_SAY(("*** CRC FAILURE: PACKET DISCARDED ***\n"));
       	WWDEBUG_SAY(("*** CRC FAILURE: Packet from %s\n", Addr_As_String(addr_ptr)));
       	packet.Flush();
-      	return true;
+      	return(RECEIVED_CONSUMED);
    	}
 #endif //WRAPPER_CRC
 
@@ -714,22 +731,17 @@ bool cConnection::Receive_Packet()
 			LaggedPacketTimes.Add(time);
 			LaggedPacketRetCodes.Add(ret_code);
 			packet.Flush();
-			return(true);
+			return(RECEIVED_CONSUMED);
 		}
 #endif //WWDEBUG
 	}
 
-#ifdef _WIN32
 	//
-	// Intercept packets intended for the firewall negotiation code.
+	// Packets for the firewall negotiation code go straight up.
 	//
    if (packet.Get_Type() == PACKETTYPE_FIREWALL_PROBE) {
-		WOLNATInterface.Intercept_Game_Packet(packet);
-		packet.Flush();
-      WWDEBUG_SAY(("cConnection:: Packet transferred to WOLNAT interface\n"));
-		return(true);
-	};
-#endif
+		return(RECEIVED_FOR_PROCESSING);
+	}
 
 
 	//
@@ -772,19 +784,21 @@ bool cConnection::Receive_Packet()
       if (p_sender_rhost == nullptr) {
 			packet.Flush();
 			WWDEBUG_SAY(("Packet from null rhost (%d) discarded.\n", sender_id));
-			return true;
+			return(RECEIVED_CONSUMED);
 		}
 	}
 
+   //
+	// Acks are sent, and received acks applied, as soon as the packet
+	// is in. Everything else is up to Process_Packet.
+	//
    switch (packet.Get_Type()) {
 
-      case PACKETTYPE_KEEPALIVE: {
-				//WWDEBUG_SAY(("CONNECT: PACKETTYPE_KEEPALIVE received\n"));
-
+      case PACKETTYPE_KEEPALIVE:
             if (!Sender_Id_Tests(packet)) {
 					WWDEBUG_SAY(("PACKETTYPE_KEEPALIVE flushed due to Sender_Id_Tests. Packet id = %d\n", packet_id));
 					packet.Flush();
-               return true;
+               return(RECEIVED_CONSUMED);
             }
 
 			//
@@ -793,13 +807,141 @@ bool cConnection::Receive_Packet()
 			if ( LocalId == ID_UNKNOWN) {
 				WWDEBUG_SAY(("PACKETTYPE_KEEPALIVE flushed due to LocalId == ID_UNKNOWN. Packet id = %d\n", packet_id));
 				packet.Flush();
-				return true;
+				return(RECEIVED_CONSUMED);
 			}
 
             //
             // The main purpose of the keepalive is to stimulate this ack.
             //
             Send_Ack(p_from_address, packet_id);
+				is_acked = true;
+				break;
+
+      case PACKETTYPE_RELIABLE:
+				//
+            // Discard all reliable packets until we have an id.
+				// We still don't have LocalId, therefore we can't Ack this.
+				//
+				if (LocalId == ID_UNKNOWN) {
+               packet.Flush();
+					WWDEBUG_SAY(("Reliable packet %d flushed due to unknown id.\n", packet_id));
+               return(RECEIVED_CONSUMED);
+				}
+
+				//
+            // Discard data with an address mismatch.
+				//
+				if (!Sender_Id_Tests(packet)) {
+               packet.Flush();
+					WWDEBUG_SAY(("Reliable packet %d flushed due to address mismatch.\n", packet_id));
+               return(RECEIVED_CONSUMED);
+				}
+
+            Send_Ack(p_from_address, packet_id);
+				is_acked = true;
+				break;
+
+      case PACKETTYPE_ACK: {
+				//WWDEBUG_SAY(("CONNECT: PACKETTYPE_ACK received\n"));
+            //WWDEBUG_SAY(("(Received Ack for packet %d)\n", packet_id));
+
+            if (!Sender_Id_Tests(packet)) {
+               return(RECEIVED_CONSUMED);
+            }
+
+            WWASSERT(p_sender_rhost != nullptr);
+				cNetStats & sender_stats = p_sender_rhost->Get_Stats();
+            sender_stats.StatSample[STAT_AckCountRcv]++;
+
+            p_sender_rhost->Remove_Packet(packet_id, RELIABLE_SEND_LIST);
+
+            return(RECEIVED_CONSUMED);
+         }
+
+      default:
+         break;
+   }
+
+   return(RECEIVED_FOR_PROCESSING);
+}
+
+//-----------------------------------------------------------------------------
+bool cConnection::Receive_Packet()
+{
+   WWASSERT(InitDone);
+
+	//
+	// Packets the network thread took in come first, they arrived before
+	// anything that is still in the socket.
+	//
+	ReceivedPacketStruct received;
+	if (ReceivedPackets.Pop(received)) {
+		Process_Packet(*received.Packet, received.Bytes, received.IsAcked);
+		delete received.Packet;
+		return true;
+	}
+
+   cPacket packet;
+	int ret_code = 0;
+	bool is_acked = false;
+
+	RECEIVE_RESULT result = Receive_And_Acknowledge(packet, ret_code, is_acked);
+	if (result == RECEIVED_NOTHING) {
+		return false;
+	}
+
+	if (result == RECEIVED_FOR_PROCESSING) {
+		Process_Packet(packet, ret_code, is_acked);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void cConnection::Process_Packet(cPacket & packet, int ret_code, [[maybe_unused]] bool is_acked)
+{
+#ifdef _WIN32
+	//
+	// Intercept packets intended for the firewall negotiation code.
+	//
+   if (packet.Get_Type() == PACKETTYPE_FIREWALL_PROBE) {
+		WOLNATInterface.Intercept_Game_Packet(packet);
+		packet.Flush();
+      WWDEBUG_SAY(("cConnection:: Packet transferred to WOLNAT interface\n"));
+		return;
+	};
+#endif
+
+	//
+	// Aliases
+	//
+	const int packet_id = packet.Get_Id();
+	const int sender_id = packet.Get_Sender_Id();
+	struct sockaddr_in * p_from_address = &packet.Get_From_Address_Wrapper()->FromAddress;
+	WWASSERT(p_from_address != nullptr);
+	cRemoteHost * p_sender_rhost = nullptr;
+	if (sender_id != cPacket::UNDEFINED_ID) {
+		p_sender_rhost = PRHost[sender_id];
+
+		//
+		// The rhost may have gone since the network thread took the packet in.
+		//
+      if (p_sender_rhost == nullptr) {
+			packet.Flush();
+			WWDEBUG_SAY(("Packet from null rhost (%d) discarded.\n", sender_id));
+			return;
+		}
+	}
+
+   switch (packet.Get_Type()) {
+
+      case PACKETTYPE_KEEPALIVE: {
+				//WWDEBUG_SAY(("CONNECT: PACKETTYPE_KEEPALIVE received\n"));
+
+				//
+				// Checked and acked on the way in.
+				//
+				WWASSERT(is_acked);
 
 				float packetloss_pc = packet.Get(packetloss_pc);
 
@@ -818,7 +960,7 @@ bool cConnection::Receive_Packet()
             WWASSERT(packet.Is_Flushed());
 
 				p_sender_rhost->Add_Packet(packet, RELIABLE_RCV_LIST);
-		      return true;
+		      return;
          }
 
       case PACKETTYPE_CONNECT_CS: {
@@ -834,7 +976,7 @@ bool cConnection::Receive_Packet()
 
             Process_Connection_Request(packet);
 
-				return true;
+				return;
          }
 
       case PACKETTYPE_ACCEPT_SC: {
@@ -888,7 +1030,7 @@ bool cConnection::Receive_Packet()
                p_sender_rhost->Add_Packet(packet, RELIABLE_RCV_LIST);
             }
 
-		      return true;
+		      return;
          }
 
       case PACKETTYPE_REFUSAL_SC: {
@@ -923,7 +1065,7 @@ bool cConnection::Receive_Packet()
                packet.Flush();
             }
 
-		      return true;
+		      return;
          }
 
       case PACKETTYPE_UNRELIABLE: {
@@ -935,7 +1077,7 @@ bool cConnection::Receive_Packet()
 				if (LocalId == ID_UNKNOWN) {
                packet.Flush();
 					WWDEBUG_SAY(("Unreliable packet flushed due to unknown id.\n"));
-               return true;
+               return;
 				}
 
 				//
@@ -944,7 +1086,7 @@ bool cConnection::Receive_Packet()
 				if (!Sender_Id_Tests(packet)) {
                packet.Flush();
 					WWDEBUG_SAY(("Unreliable packet flushed due to address mismatch.\n"));
-               return true;
+               return;
 				}
 
 				//
@@ -954,7 +1096,7 @@ bool cConnection::Receive_Packet()
 				if (packet_id < p_sender_rhost->Get_Unreliable_Packet_Rcv_Id()) {
                packet.Flush();
 					//WWDEBUG_SAY(("Unreliable packet flushed due to being out-of-date.\n"));
-               return true;
+               return;
 				}
 
             //
@@ -976,33 +1118,18 @@ bool cConnection::Receive_Packet()
 
             p_sender_rhost->Add_Packet(packet, UNRELIABLE_RCV_LIST);
 
-			   return true;
+			   return;
          }
 
 
       case PACKETTYPE_RELIABLE: {
 
 				//WWDEBUG_SAY(("CONNECT: PACKETTYPE_RELIABLE received\n"));
-				//
-            // Discard all reliable packets until we have an id.
-				// We still don't have LocalId, therefore we can't Ack this.
-				//
-				if (LocalId == ID_UNKNOWN) {
-               packet.Flush();
-					WWDEBUG_SAY(("Reliable packet %d flushed due to unknown id.\n", packet_id));
-               return true;
-				}
 
 				//
-            // Discard data with an address mismatch.
+				// Checked and acked on the way in.
 				//
-				if (!Sender_Id_Tests(packet)) {
-               packet.Flush();
-					WWDEBUG_SAY(("Reliable packet %d flushed due to address mismatch.\n", packet_id));
-               return true;
-				}
-
-            Send_Ack(p_from_address, packet_id);
+				WWASSERT(is_acked);
 
             //
 			   // Keep track of how many of each packet is received
@@ -1016,24 +1143,7 @@ bool cConnection::Receive_Packet()
 
             p_sender_rhost->Add_Packet(packet, RELIABLE_RCV_LIST);
 
-				return true;
-         }
-
-      case PACKETTYPE_ACK: {
-				//WWDEBUG_SAY(("CONNECT: PACKETTYPE_ACK received\n"));
-            //WWDEBUG_SAY(("(Received Ack for packet %d)\n", packet_id));
-
-            if (!Sender_Id_Tests(packet)) {
-               return true;
-            }
-
-            WWASSERT(p_sender_rhost != nullptr);
-				cNetStats & sender_stats = p_sender_rhost->Get_Stats();
-            sender_stats.StatSample[STAT_AckCountRcv]++;
-
-            p_sender_rhost->Remove_Packet(packet_id, RELIABLE_SEND_LIST);
-
-            return true;
+				return;
          }
 
       default:
@@ -1042,7 +1152,6 @@ bool cConnection::Receive_Packet()
    }
 
    DIE; // shouldn't get here
-   return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -1203,7 +1312,7 @@ memcpy(last_packet, packet.Get_Data(), last_packet_len);
 		//
 		// Just pass the packet to the packet manager for deltaing and coagulation.
 		//
-		bool took = PacketManager.Take_Packet((unsigned char *)packet.Get_Data(), packet.Get_Compressed_Size_Bytes(), (unsigned char*)&p_address->sin_addr.s_addr, p_address->sin_port, Sock);
+		bool took = PacketManager.Take_Packet((unsigned char *)packet.Peek_Data(), packet.Get_Compressed_Size_Bytes(), (unsigned char*)&p_address->sin_addr.s_addr, p_address->sin_port, Sock);
 
 		if (!took) {
 			WWDEBUG_SAY(("Low_Level_Send_Wrapper - Failed to pass packet to packet manager\n"));
@@ -1309,7 +1418,9 @@ int cConnection::Low_Level_Receive_Wrapper(cPacket & packet)
 					// which will cause a DataSafe access from the wrong (main) thread with potentially catastrophic effects.
 					// ST - 1/17/2002 11:18AM
 					//
-					if (CanProcess) {
+					// The network thread doesn't either, the connection times out on the game thread instead.
+					//
+					if (CanProcess && !NetworkThreadClass::Is_Network_Thread()) {
 
 						WWASSERT(ServerBrokenConnectionHandler != nullptr);
 
@@ -1491,6 +1602,8 @@ void cConnection::Send_Packet_To_Address(cPacket & packet, struct sockaddr_in* p
 
    WWASSERT(InitDone);
 
+	NetworkThreadLockClass lock;
+
 	// TSS - need reverse lookup of addressee from address
    int rhost_id = Address_To_Rhostid(p_address);
    if (rhost_id != INVALID_RHOST_ID) {
@@ -1575,6 +1688,8 @@ void cConnection::Send_Packet_To_Individual(cPacket & packet, int addressee, BYT
 {
    WWASSERT(InitDone);
 
+	NetworkThreadLockClass lock;
+
    //
    // Validate inputs
    //
@@ -1665,6 +1780,8 @@ void cConnection::Connect_Cs(cPacket & packet)
    WWASSERT(PRHost[SERVER_RHOST_ID] != nullptr);
    WWASSERT(LocalId == ID_UNKNOWN);
 
+	NetworkThreadLockClass lock;
+
    //WWDEBUG_SAY(("Connect_Cs at time %s\n", cMiscUtil::Get_Text_Time()));
 
    int packet_id = PRHost[SERVER_RHOST_ID]->Get_Reliable_Packet_Send_Id();
@@ -1781,6 +1898,8 @@ void cConnection::Destroy_Connection(int rhost_id)
 	WWASSERT(rhost_id >= 0);
 
    WWASSERT(InitDone);
+
+	NetworkThreadLockClass lock;
    WWASSERT(rhost_id >= MinRHost && rhost_id <= MaxRHost);
    if (PRHost[rhost_id] != nullptr) {
 		delete PRHost[rhost_id];
@@ -1895,6 +2014,8 @@ void cConnection::Service_Read()
 
    WWASSERT(InitDone);
 
+	NetworkThreadLockClass lock;
+
    CombinedStats.StatSample[STAT_ServiceCount]++;
 
 	ThisFrameTimeMs = TIMEGETTIME();
@@ -2143,6 +2264,59 @@ void cConnection::Service_Read()
 	}
 }
 
+//-----------------------------------------------------------------------------
+//
+// Called by the network thread while the game thread is busy elsewhere.
+// Takes in what has arrived, acks it and queues it for Service_Read, and
+// sends reliable packets that are due. Nothing here calls the application.
+//
+void cConnection::Service_Network_Thread(void)
+{
+	if (!InitDone || cSinglePlayerData::Is_Single_Player()) {
+		return;
+	}
+
+	ThisFrameTimeMs = TIMEGETTIME();
+
+	//
+	// Stop taking packets in when the game thread has fallen this far
+	// behind. Whatever is left stays in the socket, unacked.
+	//
+	while (!ReceivedPackets.Is_Full()) {
+
+		//
+		// Receive into the scratch packet and only hand it over once it holds
+		// something to process. An empty poll, which ends every pump, leaves
+		// it untouched for next time. Consumed packets have been read to the
+		// end and can't be rewound, so those are replaced.
+		//
+		if (ReceiveScratchPacket == nullptr) {
+			ReceiveScratchPacket = new cPacket;
+		}
+
+		ReceivedPacketStruct received;
+		received.Packet = ReceiveScratchPacket;
+		received.Bytes = 0;
+		received.IsAcked = false;
+
+		RECEIVE_RESULT result = Receive_And_Acknowledge(*received.Packet, received.Bytes, received.IsAcked);
+		if (result == RECEIVED_NOTHING) {
+			break;
+		}
+
+		if (result == RECEIVED_FOR_PROCESSING) {
+			ReceivedPackets.Push(received);
+		} else {
+			delete received.Packet;
+		}
+		ReceiveScratchPacket = nullptr;
+	}
+
+	Send_Reliable_Packets(false);
+
+	PacketManager.Flush();
+}
+
 //-----------------------------------------------------------------------------
 void cConnection::Set_Bandwidth_Budget_Out(ULONG bw_budget)
 {
@@ -2202,59 +2376,14 @@ cRemoteHost * cConnection::Get_Remote_Host(int rhost)
 
 //-----------------------------------------------------------------------------
 //
-// Service_Send() should be called once per frame on both C & S
+// Sends new reliable packets and resends the ones that are due. Connections
+// only time out when check_timeouts is set, the broken connection handlers
+// must run on the game thread.
 //
-void cConnection::Service_Send(bool is_urgent)
+void cConnection::Send_Reliable_Packets(bool check_timeouts)
 {
-   WWASSERT(InitDone);
-
-	ServiceCount++;
-
-	//
-	// Set TargetBps for all rhosts
-	//
-	int num_real_remote_hosts = NumRHosts;
-	if (IsServer && !IsDedicatedServer) {
-		num_real_remote_hosts--;
-		if (PRHost[1] != nullptr) {
-			PRHost[1]->Set_Target_Bps(10000000);//TSS - won't this just be overwritten below???
-		}
-	}
-
-	if (num_real_remote_hosts > 0) { // necessary?
-
-		if (IsServer && BandwidthBalancer.IsEnabled) {
-			BandwidthBalancer.Adjust(this, IsDedicatedServer);
-		} else {
-
-			ULONG bps_per_rhost = (ULONG) (BandwidthBudgetOut / (float) num_real_remote_hosts);
-
-			for (int rhost_id = MinRHost; rhost_id <= MaxRHost; rhost_id++) {
-				if (PRHost[rhost_id] != nullptr) {
-
-					//
-					// Do not exceed the max bps set by the client.
-					//
-					int bps = bps_per_rhost;
-					int max_bps = PRHost[rhost_id]->Get_Maximum_Bps();
-					if (max_bps != 0 && max_bps < bps) {
-						bps = max_bps;
-					}
-
-					PRHost[rhost_id]->Set_Target_Bps(bps);
-
-					//WWDEBUG_SAY(("Compressed bandwidth out to client = %d bps\n", PacketManager.Get_Compressed_Bandwidth_Out(&(PRHost[rhost_id]->Get_Address()))));
-				}
-			}
-		}
-	}
-	int rhost_id;
-
-   //
-   // Reliable sends and resends
-   //
 	bool any_bad = false;
-	for (rhost_id = MinRHost; rhost_id <= MaxRHost; rhost_id++) {
+	for (int rhost_id = MinRHost; rhost_id <= MaxRHost; rhost_id++) {
 
 		cRemoteHost * p_rhost = PRHost[rhost_id];
 
@@ -2342,7 +2471,7 @@ void cConnection::Service_Send(bool is_urgent)
 					// ST 1/24/2002 2:16PM. Can't time out players when we are loading or we get DataSafe access from the wrong
 					// thread.
 					//
-               if (Is_Packet_Too_Old(p_packet, p_rhost) && CanProcess) {
+               if (check_timeouts && Is_Packet_Too_Old(p_packet, p_rhost) && CanProcess) {
 
 						WWDEBUG_SAY(("*** WWNET: Connection timed out - assuming connection to rhost %d is broken.\n", rhost_id));
 						WWDEBUG_SAY(("*** WWNET: ThisFrameTimeMs - p_packet->Get_First_Send_Time() == %d\n", ThisFrameTimeMs - p_packet->Get_First_Send_Time()));
@@ -2381,6 +2510,64 @@ void cConnection::Service_Send(bool is_urgent)
 	}
 
 	IsBadConnection = any_bad;
+}
+
+//-----------------------------------------------------------------------------
+//
+// Service_Send() should be called once per frame on both C & S
+//
+void cConnection::Service_Send(bool is_urgent)
+{
+   WWASSERT(InitDone);
+
+	NetworkThreadLockClass lock;
+
+	ServiceCount++;
+
+	//
+	// Set TargetBps for all rhosts
+	//
+	int num_real_remote_hosts = NumRHosts;
+	if (IsServer && !IsDedicatedServer) {
+		num_real_remote_hosts--;
+		if (PRHost[1] != nullptr) {
+			PRHost[1]->Set_Target_Bps(10000000);//TSS - won't this just be overwritten below???
+		}
+	}
+
+	if (num_real_remote_hosts > 0) { // necessary?
+
+		if (IsServer && BandwidthBalancer.IsEnabled) {
+			BandwidthBalancer.Adjust(this, IsDedicatedServer);
+		} else {
+
+			ULONG bps_per_rhost = (ULONG) (BandwidthBudgetOut / (float) num_real_remote_hosts);
+
+			for (int rhost_id = MinRHost; rhost_id <= MaxRHost; rhost_id++) {
+				if (PRHost[rhost_id] != nullptr) {
+
+					//
+					// Do not exceed the max bps set by the client.
+					//
+					int bps = bps_per_rhost;
+					int max_bps = PRHost[rhost_id]->Get_Maximum_Bps();
+					if (max_bps != 0 && max_bps < bps) {
+						bps = max_bps;
+					}
+
+					PRHost[rhost_id]->Set_Target_Bps(bps);
+
+					//WWDEBUG_SAY(("Compressed bandwidth out to client = %d bps\n", PacketManager.Get_Compressed_Bandwidth_Out(&(PRHost[rhost_id]->Get_Address()))));
+				}
+			}
+		}
+	}
+	int rhost_id;
+
+   //
+   // Reliable sends and resends
+   //
+	Send_Reliable_Packets(true);
 
 
 	//
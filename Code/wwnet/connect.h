@@ -38,6 +38,8 @@
 #include "slist.h"
 #include "wwpacket.h"
 #include "packettype.h"
+#include "netthread.h"
+#include "spscqueue.h"
 
 //
 // A server can have this many clients (a client has only 1 rhost: the server)
@@ -96,7 +98,7 @@ extern char* Addr_As_String(sockaddr_in* addr);
 // This class represents the link between C & S.
 // The 1-many S-C relationship is expressed in the cRemoteHost component.
 //
-class cConnection
+class cConnection : public NetworkThreadServiceClass
 {
 	public:
 		cConnection();
@@ -111,6 +113,7 @@ class cConnection
       bool Is_Established() const;
 		void Service_Read();
 		void Service_Send(bool is_urgent = false);
+		virtual void Service_Network_Thread(void) override;
 		ULONG Get_Bandwidth_Budget_Out() const {return BandwidthBudgetOut;}
 		void Set_Bandwidth_Budget_Out(ULONG bw_budget);
       void Destroy_Connection(int rhost_id);
@@ -166,6 +169,25 @@ class cConnection
 
 
    private:
+		typedef enum {
+			RECEIVED_NOTHING,				// nothing waiting
+			RECEIVED_CONSUMED,			// discarded, or an ack that has been applied
+			RECEIVED_FOR_PROCESSING		// hand to Process_Packet
+		} RECEIVE_RESULT;
+
+		//
+		// Packets the network thread took in (and acked) for Service_Read.
+		//
+		struct ReceivedPacketStruct {
+			cPacket *	Packet;
+			int			Bytes;
+			bool			IsAcked;
+		};
+
+		enum {
+			RECEIVED_QUEUE_SIZE = 1024
+		};
+
       cConnection(const cConnection& rhs); // Disallow copy (compile/link time)
       cConnection& operator=(const cConnection& rhs); // Disallow assignment (compile/link time)
 
@@ -174,6 +196,9 @@ class cConnection
       void Send_Accept_Sc(int new_rhost_id);
       bool Bind(USHORT port, ULONG addr = 0);
       bool Receive_Packet();
+		RECEIVE_RESULT Receive_And_Acknowledge(cPacket & packet, int & ret_code, bool & is_acked);
+		void Process_Packet(cPacket & packet, int ret_code, bool is_acked);
+		void Send_Reliable_Packets(bool check_timeouts);
 		int Low_Level_Send_Wrapper(cPacket & packet, struct sockaddr_in* p_address);
       int Send_Wrapper(cPacket & packet, struct sockaddr_in* p_address);
       int Send_Wrapper(cPacket & packet, int addressee);
@@ -237,6 +262,9 @@ class cConnection
 		Server_Packet_Handler					ServerPacketHandler;
 		Client_Packet_Handler					ClientPacketHandler;
 
+		SpscQueueClass<ReceivedPacketStruct, RECEIVED_QUEUE_SIZE>	ReceivedPackets;
+		cPacket *										ReceiveScratchPacket;	// network thread only
+
 #ifdef WWDEBUG
 		// Testing support for high latency connections.
 		// Dynamic vector is ineffecient here but it doesn't matter since this is a debug testing only kinda thing.
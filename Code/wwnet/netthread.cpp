@@ -0,0 +1,322 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "netthread.h"
+#include "wwdebug.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+typedef std::chrono::steady_clock ClockType;
+
+struct ServiceIntervalsStruct
+{
+	int		Samples = 0;
+	double	SumMs = 0;
+	double	SumSquaresMs = 0;
+	double	MaxMs = 0;
+};
+
+struct NetworkThreadStateStruct
+{
+	std::thread										Thread;
+	std::atomic<bool>								Running{false};
+	std::atomic<bool>								Quit{false};
+	unsigned int									PumpIntervalMs = NetworkThreadClass::DEFAULT_PUMP_INTERVAL_MS;
+
+	//
+	//	Holders counts the game side threads inside the network code,
+	// Pumping is set while the network thread is. Both sides set their
+	// own flag before they look at the other's, so with sequentially
+	// consistent atomics they can never both be inside.
+	//
+	std::atomic<int>								Holders{0};
+	std::atomic<bool>								Pumping{false};
+
+	std::vector<NetworkThreadServiceClass *>	Services;
+
+	//
+	//	Tick jitter, only touched from inside the network code
+	//
+	ClockType::time_point						LastService;
+	NetworkThreadClass::MODE					LastServiceMode = NetworkThreadClass::MODE_GAME_THREAD;
+	bool												HasLastService = false;
+	ServiceIntervalsStruct						Intervals[NetworkThreadClass::MODE_COUNT];
+
+	// Stop the thread if nobody called Stop() before exit.
+	~NetworkThreadStateStruct(void)	{ NetworkThreadClass::Stop(); }
+};
+
+NetworkThreadStateStruct	ThreadState;
+thread_local bool				IsNetworkThread = false;
+
+
+void Thread_Main(void)
+{
+	IsNetworkThread = true;
+
+	while (!ThreadState.Quit.load()) {
+
+		if (ThreadState.Holders.load() == 0) {
+			ThreadState.Pumping.store(true);
+			if (ThreadState.Holders.load() == 0) {
+				for (NetworkThreadServiceClass *service : ThreadState.Services) {
+					service->Service_Network_Thread();
+				}
+				NetworkThreadClass::Note_Service();
+			}
+			ThreadState.Pumping.store(false);
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(ThreadState.PumpIntervalMs));
+	}
+}
+
+} // namespace
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Start
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkThreadClass::Start (unsigned int pump_interval_ms)
+{
+	WWASSERT (!IsNetworkThread);
+	if (Is_Running ()) {
+		return ;
+	}
+
+	NetworkThreadLockClass lock;
+	ThreadState.PumpIntervalMs	= pump_interval_ms;
+	ThreadState.HasLastService	= false;
+	ThreadState.Quit.store (false);
+	ThreadState.Running.store (true);
+	ThreadState.Thread			= std::thread (Thread_Main);
+
+	WWDEBUG_SAY (("NetworkThreadClass - started, pumping every %u ms\n", pump_interval_ms));
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Stop
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkThreadClass::Stop (void)
+{
+	WWASSERT (!IsNetworkThread);
+	if (!ThreadState.Thread.joinable ()) {
+		return ;
+	}
+
+	ThreadState.Quit.store (true);
+	ThreadState.Thread.join ();
+	ThreadState.Running.store (false);
+
+	NetworkThreadLockClass lock;
+	ThreadState.HasLastService = false;
+
+	WWDEBUG_SAY (("NetworkThreadClass - stopped\n"));
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Is_Running
+//
+////////////////////////////////////////////////////////////////
+bool
+NetworkThreadClass::Is_Running (void)
+{
+	return ThreadState.Running.load ();
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Is_Network_Thread
+//
+////////////////////////////////////////////////////////////////
+bool
+NetworkThreadClass::Is_Network_Thread (void)
+{
+	return IsNetworkThread;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Register_Service
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkThreadClass::Register_Service (NetworkThreadServiceClass *service)
+{
+	WWASSERT (service != nullptr);
+	NetworkThreadLockClass lock;
+
+	if (std::find (ThreadState.Services.begin (), ThreadState.Services.end (), service) == ThreadState.Services.end ()) {
+		ThreadState.Services.push_back (service);
+	}
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Unregister_Service
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkThreadClass::Unregister_Service (NetworkThreadServiceClass *service)
+{
+	NetworkThreadLockClass lock;
+
+	ThreadState.Services.erase (std::remove (ThreadState.Services.begin (), ThreadState.Services.end (), service),
+		ThreadState.Services.end ());
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Lock
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkThreadClass::Lock (void)
+{
+	//
+	//	The network thread already owns everything while it pumps
+	//
+	if (IsNetworkThread) {
+		return ;
+	}
+
+	ThreadState.Holders.fetch_add (1);
+	while (ThreadState.Pumping.load ()) {
+		std::this_thread::yield ();
+	}
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Unlock
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkThreadClass::Unlock (void)
+{
+	if (IsNetworkThread) {
+		return ;
+	}
+
+	WWASSERT (ThreadState.Holders.load () > 0);
+	ThreadState.Holders.fetch_sub (1);
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Note_Service
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkThreadClass::Note_Service (void)
+{
+	ClockType::time_point now	= ClockType::now ();
+	MODE mode						= Get_Mode ();
+
+	//
+	//	Intervals that span a mode switch belong to neither mode
+	//
+	if (ThreadState.HasLastService && ThreadState.LastServiceMode == mode) {
+		double interval_ms = std::chrono::duration<double, std::milli> (now - ThreadState.LastService).count ();
+
+		ServiceIntervalsStruct &intervals = ThreadState.Intervals[mode];
+		intervals.Samples ++;
+		intervals.SumMs			+= interval_ms;
+		intervals.SumSquaresMs	+= interval_ms * interval_ms;
+		intervals.MaxMs			= std::max (intervals.MaxMs, interval_ms);
+	}
+
+	ThreadState.LastService		= now;
+	ThreadState.LastServiceMode	= mode;
+	ThreadState.HasLastService	= true;
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Get_Service_Stats
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkThreadClass::Get_Service_Stats (MODE mode, ServiceStatsStruct &stats)
+{
+	WWASSERT (mode >= 0 && mode < MODE_COUNT);
+	NetworkThreadLockClass lock;
+
+	const ServiceIntervalsStruct &intervals = ThreadState.Intervals[mode];
+	stats.Samples	= intervals.Samples;
+	stats.MeanMs	= 0;
+	stats.JitterMs	= 0;
+	stats.MaxMs		= (float)intervals.MaxMs;
+
+	if (intervals.Samples > 0) {
+		double mean		= intervals.SumMs / intervals.Samples;
+		double variance	= intervals.SumSquaresMs / intervals.Samples - mean * mean;
+		stats.MeanMs	= (float)mean;
+		stats.JitterMs	= (float)std::sqrt (std::max (variance, 0.0));
+	}
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Reset_Service_Stats
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkThreadClass::Reset_Service_Stats (void)
+{
+	NetworkThreadLockClass lock;
+
+	for (int mode = 0; mode < MODE_COUNT; mode ++) {
+		ThreadState.Intervals[mode] = ServiceIntervalsStruct ();
+	}
+	ThreadState.HasLastService = false;
+	return ;
+}
@@ -0,0 +1,149 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef	__NETTHREAD_H
+#define	__NETTHREAD_H
+
+#include "always.h"
+
+
+////////////////////////////////////////////////////////////////
+//
+//	NetworkThreadServiceClass
+//
+//	Anything the network thread should service. Service_Network_Thread
+// is called every pump while the game thread is not inside the
+// network code; it must not call back into the game.
+//
+////////////////////////////////////////////////////////////////
+class NetworkThreadServiceClass
+{
+public:
+	virtual ~NetworkThreadServiceClass (void)	{}
+	virtual void	Service_Network_Thread (void) = 0;
+};
+
+
+////////////////////////////////////////////////////////////////
+//
+//	NetworkThreadClass
+//
+//	Optional thread that keeps the sockets serviced while the game
+// thread is busy elsewhere (level load steps, script spikes...),
+// so acks and resends go out on time instead of once per tick.
+//
+//	The game thread and the network thread never run the network
+// code at the same time. The game thread holds the network code
+// (NetworkThreadLockClass) while it is in there; the network thread
+// only pumps the registered services while nobody holds it. Taking
+// it is two atomic operations, plus a wait of at most one pump if
+// the thread is in the middle of one. It may be taken recursively.
+// It only keeps the network thread out, game side threads (e.g. the
+// job pool workers building updates) are not serialized by it.
+//
+//	Tick jitter: Note_Service is called each time the sockets are
+// serviced, by the game tick and by every pump. The intervals are
+// kept separately for the game thread only and network thread modes
+// so the two can be compared.
+//
+////////////////////////////////////////////////////////////////
+class NetworkThreadClass
+{
+public:
+
+	////////////////////////////////////////////////////////////////
+	//	Public constants
+	////////////////////////////////////////////////////////////////
+	typedef enum
+	{
+		MODE_GAME_THREAD		= 0,
+		MODE_NETWORK_THREAD,
+		MODE_COUNT
+	} MODE;
+
+	enum
+	{
+		DEFAULT_PUMP_INTERVAL_MS	= 1
+	};
+
+	struct ServiceStatsStruct
+	{
+		int		Samples;			// Intervals measured
+		float		MeanMs;			// Average time between services
+		float		JitterMs;		// Standard deviation of that time
+		float		MaxMs;			// Longest a datagram could have waited
+	};
+
+	////////////////////////////////////////////////////////////////
+	//	Public methods
+	////////////////////////////////////////////////////////////////
+
+	//
+	//	Thread control, game thread only
+	//
+	static void		Start (unsigned int pump_interval_ms = DEFAULT_PUMP_INTERVAL_MS);
+	static void		Stop (void);
+	static bool		Is_Running (void);
+	static bool		Is_Network_Thread (void);
+	static MODE		Get_Mode (void)			{ return Is_Running () ? MODE_NETWORK_THREAD : MODE_GAME_THREAD; }
+
+	//
+	//	Services pumped by the thread
+	//
+	static void		Register_Service (NetworkThreadServiceClass *service);
+	static void		Unregister_Service (NetworkThreadServiceClass *service);
+
+	//
+	//	Exclusive access to the network code, see NetworkThreadLockClass
+	//
+	static void		Lock (void);
+	static void		Unlock (void);
+
+	//
+	//	Tick jitter
+	//
+	static void		Note_Service (void);
+	static void		Get_Service_Stats (MODE mode, ServiceStatsStruct &stats);
+	static void		Reset_Service_Stats (void);
+};
+
+
+////////////////////////////////////////////////////////////////
+//
+//	NetworkThreadLockClass
+//
+//	Holds the network code for the lifetime of the object.
+//
+////////////////////////////////////////////////////////////////
+class NetworkThreadLockClass
+{
+public:
+	NetworkThreadLockClass (void)		{ NetworkThreadClass::Lock (); }
+	~NetworkThreadLockClass (void)	{ NetworkThreadClass::Unlock (); }
+
+private:
+	NetworkThreadLockClass (const NetworkThreadLockClass &);
+	NetworkThreadLockClass &operator= (const NetworkThreadLockClass &);
+};
+
+
+#endif	// __NETTHREAD_H
@@ -581,7 +581,7 @@ void cNetUtil::Broadcast(SOCKET & sock, USHORT port, cPacket & packet)
 	//WSA_CHECK(bytes_sent = sendto(sock, packet.Data, packet.SendLength,
    //   0, &broadcast_address, sizeof(struct sockaddr_in)));
    socklen_t addr_len = sizeof(struct sockaddr_in);
-   bytes_sent = wwnet::SocketSendTo(sock, packet.Get_Data(), packet.Get_Compressed_Size_Bytes(),
+   bytes_sent = wwnet::SocketSendTo(sock, packet.Peek_Data(), packet.Get_Compressed_Size_Bytes(),
 	   0, (const sockaddr*)&broadcast_address, &addr_len);
 // FIXME (TSS) WSAENOBUFS
    //WWDEBUG_SAY(("Sent broadcast, length = %d bytes\n", bytes_sent));
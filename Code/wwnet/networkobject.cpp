@@ -55,6 +55,7 @@ bool		NetworkObjectClass::IsServer		= false;
 //
 ////////////////////////////////////////////////////////////////
 NetworkObjectClass::NetworkObjectClass (void)	:
+	ObjectListIndex (-1),
 	ImportStateCount (0),
 	LastClientsideUpdateTime (0),
 	NetworkID (0),
@@ -89,6 +90,10 @@ NetworkObjectClass::NetworkObjectClass (void)	:
 	// Static objects therefore don't need to remember to set this in their constructor.
 	// Game objects will set BIT_CREATION.
 	//
+	for (int index = 0; index < MAX_CLIENT_COUNT; index ++) {
+		DirtyListIndex[index] = -1;
+	}
+
 	Clear_Object_Dirty_Bits ();
 
 	memset(CachedPriority_2, 0, sizeof(CachedPriority_2));
@@ -108,6 +113,13 @@ NetworkObjectClass::~NetworkObjectClass (void)
 	//	Unregister this object from network updates
 	//
 	NetworkObjectMgrClass::Unregister_Object (this);
+
+	for (int index = 0; index < MAX_CLIENT_COUNT; index ++) {
+		if (DirtyListIndex[index] != -1) {
+			NetworkObjectMgrClass::Remove_Dirty_Object (index, this);
+		}
+	}
+
 	return ;
 }
 
@@ -155,6 +167,7 @@ void
 NetworkObjectClass::Set_Object_Dirty_Bits (int client_id, BYTE bits)
 {
 	ClientStatus[client_id] = bits;
+	Update_Dirty_List (client_id);
 }
 
 
@@ -186,6 +199,7 @@ NetworkObjectClass::Clear_Object_Dirty_Bits (void)
 		UpdateInfo[index].LastUpdateTime = 0;
 		UpdateInfo[index].UpdateRate = 50;
 		UpdateInfo[index].ClientHintCount = 0;
+		Update_Dirty_List (index);
 	}
 
 	return ;
@@ -206,6 +220,7 @@ NetworkObjectClass::Set_Object_Dirty_Bit (int client_id, DIRTY_BIT dirty_bit, bo
 		ClientStatus[client_id] &= (~dirty_bit);
 	}
 
+	Update_Dirty_List (client_id);
 	return ;
 }
 
@@ -234,6 +249,29 @@ NetworkObjectClass::Set_Object_Dirty_Bit (DIRTY_BIT dirty_bit, bool onoff)
 		} else {
 			ClientStatus[index] &= (~dirty_bit);
 		}
+
+		Update_Dirty_List (index);
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Update_Dirty_List
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectClass::Update_Dirty_List (int client_id)
+{
+	bool is_listed = (DirtyListIndex[client_id] != -1);
+	if (ClientStatus[client_id] != 0) {
+		if (is_listed == false) {
+			NetworkObjectMgrClass::Add_Dirty_Object (client_id, this);
+		}
+	} else if (is_listed) {
+		NetworkObjectMgrClass::Remove_Dirty_Object (client_id, this);
 	}
 
 	return ;
@@ -225,6 +225,16 @@ public:
 
 private:
 
+	////////////////////////////////////////////////////////////////
+	//	Private methods
+	////////////////////////////////////////////////////////////////
+
+	//
+	//	Keeps the object on NetworkObjectMgrClass's dirty worklist of
+	// the client for as long as it has dirty bits for it.
+	//
+	void					Update_Dirty_List (int client_id);
+
 	////////////////////////////////////////////////////////////////
 	//	Private constants
 	////////////////////////////////////////////////////////////////
@@ -249,6 +259,14 @@ private:
 	} UpdateInfo [MAX_CLIENT_COUNT];
 
 	BYTE					ClientStatus[MAX_CLIENT_COUNT];
+
+	//
+	// Position in each client's dirty worklist, -1 if not on it,
+	// and in the manager's object list
+	//
+	friend class NetworkObjectMgrClass;
+	int					DirtyListIndex[MAX_CLIENT_COUNT];
+	int					ObjectListIndex;
 	int					ImportStateCount;
 	ULONG					LastClientsideUpdateTime;
 	ULONG					ClientsideUpdateFrequencySampleStartTime;
@@ -0,0 +1,824 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkobjectdelta.h"
+#include "networkobject.h"
+#include "bitstream.h"
+#include "wwpacket.h"
+#include "systimer.h"
+#include "wwdebug.h"
+
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////////
+//	Local types
+////////////////////////////////////////////////////////////////
+namespace {
+
+enum
+{
+	SEQUENCE_MASK	= (1 << NetworkObjectDeltaClass::SEQUENCE_BITS) - 1,
+	HISTORY_MASK	= NetworkObjectDeltaClass::HISTORY_SIZE - 1
+};
+
+//
+//	A frequent tier as it was sent or received, left aligned
+//
+struct HistoryEntryStruct
+{
+	int						Sequence = -1;
+	unsigned int			NumBits = 0;
+	std::vector<uint8>	Data;
+};
+
+//
+//	The server keeps full sequence numbers, only their low
+// SEQUENCE_BITS go on the wire.
+//
+struct SentStateStruct
+{
+	int						NextSequence = 0;
+	int						AckedSequence = -1;
+	HistoryEntryStruct	History[NetworkObjectDeltaClass::HISTORY_SIZE];
+};
+
+struct ReceivedStateStruct
+{
+	HistoryEntryStruct	History[NetworkObjectDeltaClass::HISTORY_SIZE];
+};
+
+typedef std::unordered_map<int, SentStateStruct>	SENT_TABLE;
+
+SENT_TABLE *										_SentTables[NetworkObjectClass::MAX_CLIENT_COUNT] = { nullptr };
+
+//
+//	One bit per client that has a sent table, so removing an object
+// only visits those. Tables are created by the update jobs.
+//
+std::atomic<uint32>	_SentTableMask[NetworkObjectClass::MAX_CLIENT_COUNT / 32];
+std::unordered_map<int, ReceivedStateStruct>	_ReceivedStates;
+std::unordered_map<int, int>					_PendingAcks;
+
+std::atomic<uint32>	_StatFullUpdates{0};
+std::atomic<uint32>	_StatDeltaUpdates{0};
+std::atomic<uint32>	_StatRawBits{0};
+std::atomic<uint32>	_StatSentBits{0};
+std::atomic<uint32>	_StatAcksReceived{0};
+std::atomic<uint32>	_StatUndecodable{0};
+
+FILE *	_RecordFile			= nullptr;
+int		_RecordClientID	= -1;
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Extract_Bits
+//
+//	Copies num_bits bits starting at start_bit of the source into
+// dest, left aligned, with the unused bits of the last byte clear.
+//
+////////////////////////////////////////////////////////////////
+void
+Extract_Bits (std::vector<uint8> &dest, const uint8 *source, unsigned int start_bit, unsigned int num_bits)
+{
+	unsigned int byte_count = (num_bits + 7) >> 3;
+	dest.resize (byte_count);
+
+	unsigned int shift = start_bit & 0x7;
+	const uint8 *bytes = source + (start_bit >> 3);
+	for (unsigned int index = 0; index < byte_count; index ++) {
+		unsigned int value = (unsigned int)bytes[index] << shift;
+		unsigned int bits_left = num_bits - index * 8;
+		if (shift != 0 && bits_left > 8 - shift) {
+			value |= bytes[index + 1] >> (8 - shift);
+		}
+		dest[index] = (uint8)value;
+	}
+
+	if ((num_bits & 0x7) != 0) {
+		dest[byte_count - 1] &= (uint8)(0xFF << (8 - (num_bits & 0x7)));
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Byte_Bits - number of payload bits in the given byte
+//
+////////////////////////////////////////////////////////////////
+inline unsigned int
+Byte_Bits (unsigned int byte_index, unsigned int num_bits)
+{
+	unsigned int bits_left = num_bits - byte_index * 8;
+	return (bits_left < 8) ? bits_left : 8;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Get_Delta_Bits
+//
+//	Size of the delta between two equally long tiers, not
+// counting the header.
+//
+////////////////////////////////////////////////////////////////
+unsigned int
+Get_Delta_Bits (const uint8 *current, const uint8 *baseline, unsigned int num_bits)
+{
+	unsigned int byte_count	= (num_bits + 7) >> 3;
+	unsigned int total		= 0;
+
+	for (unsigned int word_start = 0; word_start < byte_count; word_start += 4) {
+		unsigned int word_end = (word_start + 4 < byte_count) ? word_start + 4 : byte_count;
+
+		total ++;
+		if (::memcmp (current + word_start, baseline + word_start, word_end - word_start) == 0) {
+			continue;
+		}
+
+		for (unsigned int index = word_start; index < word_end; index ++) {
+			total ++;
+			if (current[index] != baseline[index]) {
+				total += Byte_Bits (index, num_bits);
+			}
+		}
+	}
+
+	return total;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Write_Delta
+//
+////////////////////////////////////////////////////////////////
+void
+Write_Delta (BitStreamClass &packet, const uint8 *current, const uint8 *baseline, unsigned int num_bits)
+{
+	unsigned int byte_count = (num_bits + 7) >> 3;
+
+	for (unsigned int word_start = 0; word_start < byte_count; word_start += 4) {
+		unsigned int word_end	= (word_start + 4 < byte_count) ? word_start + 4 : byte_count;
+		bool is_changed			= (::memcmp (current + word_start, baseline + word_start, word_end - word_start) != 0);
+
+		packet.Add_Bits (is_changed, 1);
+		if (is_changed == false) {
+			continue;
+		}
+
+		//
+		//	Byte mask first, then the bytes themselves
+		//
+		for (unsigned int index = word_start; index < word_end; index ++) {
+			packet.Add_Bits (current[index] != baseline[index], 1);
+		}
+		for (unsigned int index = word_start; index < word_end; index ++) {
+			if (current[index] != baseline[index]) {
+				unsigned int bits = Byte_Bits (index, num_bits);
+				packet.Add_Bits (current[index] >> (8 - bits), bits);
+			}
+		}
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Read_Delta - applies a delta to a copy of the baseline
+//
+////////////////////////////////////////////////////////////////
+void
+Read_Delta (BitStreamClass &packet, std::vector<uint8> &data, unsigned int num_bits)
+{
+	unsigned int byte_count = (num_bits + 7) >> 3;
+
+	for (unsigned int word_start = 0; word_start < byte_count; word_start += 4) {
+		unsigned int word_end = (word_start + 4 < byte_count) ? word_start + 4 : byte_count;
+
+		uint32_t is_changed = 0;
+		packet.Get_Bits (is_changed, 1);
+		if (is_changed == 0) {
+			continue;
+		}
+
+		bool byte_changed[4];
+		for (unsigned int index = word_start; index < word_end; index ++) {
+			uint32_t bit = 0;
+			packet.Get_Bits (bit, 1);
+			byte_changed[index - word_start] = (bit != 0);
+		}
+		for (unsigned int index = word_start; index < word_end; index ++) {
+			if (byte_changed[index - word_start]) {
+				unsigned int bits = Byte_Bits (index, num_bits);
+				uint32_t value = 0;
+				packet.Get_Bits (value, bits);
+				data[index] = (uint8)(value << (8 - bits));
+			}
+		}
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Write_Int / Read_Int - little endian file fields
+//
+////////////////////////////////////////////////////////////////
+bool
+Write_Int (FILE *file, uint32 value, int byte_count)
+{
+	uint8 bytes[4];
+	for (int index = 0; index < byte_count; index ++) {
+		bytes[index] = (uint8)(value >> (index * 8));
+	}
+	return (::fwrite (bytes, 1, byte_count, file) == (size_t)byte_count);
+}
+
+bool
+Read_Int (FILE *file, uint32 &value, int byte_count)
+{
+	uint8 bytes[4];
+	if (::fread (bytes, 1, byte_count, file) != (size_t)byte_count) {
+		return false;
+	}
+
+	value = 0;
+	for (int index = 0; index < byte_count; index ++) {
+		value |= (uint32)bytes[index] << (index * 8);
+	}
+	return true;
+}
+
+} // namespace
+
+
+////////////////////////////////////////////////////////////////
+//	Static member initialization
+////////////////////////////////////////////////////////////////
+bool	NetworkObjectDeltaClass::IsEnabled = false;
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Write_Frequent
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Write_Frequent
+(
+	BitStreamClass &	packet,
+	int					client_id,
+	int					object_id,
+	const uint8 *		source,
+	unsigned int		start_bit,
+	unsigned int		num_bits
+)
+{
+	WWASSERT (client_id >= 0 && client_id < NetworkObjectClass::MAX_CLIENT_COUNT);
+
+	SENT_TABLE *&table = _SentTables[client_id];
+	if (table == nullptr) {
+		table = new SENT_TABLE;
+		_SentTableMask[client_id >> 5].fetch_or (1u << (client_id & 31), std::memory_order_relaxed);
+	}
+	SentStateStruct &state = (*table)[object_id];
+
+	int sequence	= state.NextSequence ++;
+
+	//
+	//	The new tier goes into the history slot of its sequence, which
+	// is also where a baseline 16 updates old would be. Keep a copy
+	// of the data until the delta has been written.
+	//
+	HistoryEntryStruct &entry = state.History[sequence & HISTORY_MASK];
+	std::vector<uint8> current;
+	Extract_Bits (current, source, start_bit, num_bits);
+
+	//
+	//	Can we code against the last acked state?
+	//
+	const HistoryEntryStruct *baseline = nullptr;
+	int age = 0;
+	if (state.AckedSequence >= 0) {
+		age = sequence - state.AckedSequence;
+		const HistoryEntryStruct &acked = state.History[state.AckedSequence & HISTORY_MASK];
+		if (	age > 0 && age < HISTORY_SIZE &&
+				acked.Sequence == state.AckedSequence &&
+				acked.NumBits == num_bits)
+		{
+			baseline = &acked;
+		}
+	}
+
+	unsigned int delta_bits = 0;
+	if (baseline != nullptr && num_bits > 0) {
+		delta_bits = AGE_BITS + Get_Delta_Bits (current.data (), baseline->Data.data (), num_bits);
+		if (delta_bits >= num_bits) {
+			baseline = nullptr;
+		}
+	}
+
+	int bits_before = packet.Get_Bit_Write_Position ();
+	packet.Add_Bits (sequence & SEQUENCE_MASK, SEQUENCE_BITS);
+	packet.Add_Bits (baseline != nullptr, 1);
+
+	if (baseline != nullptr) {
+		packet.Add_Bits (age, AGE_BITS);
+		Write_Delta (packet, current.data (), baseline->Data.data (), num_bits);
+		_StatDeltaUpdates.fetch_add (1, std::memory_order_relaxed);
+	} else {
+		packet.Add_Bit_Range (current.data (), 0, num_bits);
+		_StatFullUpdates.fetch_add (1, std::memory_order_relaxed);
+	}
+
+	_StatRawBits.fetch_add (num_bits, std::memory_order_relaxed);
+	_StatSentBits.fetch_add (packet.Get_Bit_Write_Position () - bits_before, std::memory_order_relaxed);
+
+	entry.Sequence	= sequence;
+	entry.NumBits	= num_bits;
+	entry.Data.swap (current);
+
+	//
+	//	Only the recorded client's job ever gets here
+	//
+	if (_RecordFile != nullptr && client_id == _RecordClientID) {
+		RecordedUpdateStruct update;
+		update.Time			= TIMEGETTIME ();
+		update.ObjectID	= object_id;
+		update.NumBits		= (uint16)num_bits;
+		::memcpy (update.Data, entry.Data.data (), entry.Data.size ());
+		Write_Recorded_Update (_RecordFile, update);
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Reset_Object
+//
+//	Forget what the client has acked, for instance because the
+// object is being created on it again. The sequence keeps
+// counting so late acks can't match the new history.
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Reset_Object (int client_id, int object_id)
+{
+	WWASSERT (client_id >= 0 && client_id < NetworkObjectClass::MAX_CLIENT_COUNT);
+
+	SENT_TABLE *table = _SentTables[client_id];
+	if (table == nullptr) {
+		return ;
+	}
+
+	SENT_TABLE::iterator it = table->find (object_id);
+	if (it != table->end ()) {
+		it->second.AckedSequence = -1;
+		for (int index = 0; index < HISTORY_SIZE; index ++) {
+			it->second.History[index].Sequence = -1;
+		}
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Reset_Client
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Reset_Client (int client_id)
+{
+	WWASSERT (client_id >= 0 && client_id < NetworkObjectClass::MAX_CLIENT_COUNT);
+
+	delete _SentTables[client_id];
+	_SentTables[client_id] = nullptr;
+	_SentTableMask[client_id >> 5].fetch_and (~(1u << (client_id & 31)), std::memory_order_relaxed);
+
+	if (client_id == _RecordClientID) {
+		Stop_Recording ();
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Import_Acks
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Import_Acks (BitStreamClass &packet, int client_id)
+{
+	BYTE count = 0;
+	packet.Get (count);
+
+	SENT_TABLE *table = nullptr;
+	if (client_id >= 0 && client_id < NetworkObjectClass::MAX_CLIENT_COUNT) {
+		table = _SentTables[client_id];
+	}
+
+	for (int index = 0; index < count; index ++) {
+		int object_id = 0;
+		uint32_t sequence = 0;
+		packet.Get (object_id);
+		packet.Get_Bits (sequence, SEQUENCE_BITS);
+
+		if (table == nullptr) {
+			continue;
+		}
+
+		SENT_TABLE::iterator it = table->find (object_id);
+		if (it == table->end ()) {
+			continue;
+		}
+
+		//
+		//	Work out the full sequence from the last one sent. Acks for
+		// anything older than the history are stale and would match a
+		// newer state in the same slot, so drop them.
+		//
+		SentStateStruct &state = it->second;
+		int last_sent = state.NextSequence - 1;
+		int age = (last_sent - (int)sequence) & SEQUENCE_MASK;
+		if (last_sent < 0 || age >= HISTORY_SIZE) {
+			continue;
+		}
+
+		//
+		//	Only move forward, and only onto a state we still have
+		//
+		int full_sequence = last_sent - age;
+		if (full_sequence <= state.AckedSequence || state.History[full_sequence & HISTORY_MASK].Sequence != full_sequence) {
+			continue;
+		}
+
+		state.AckedSequence = full_sequence;
+		_StatAcksReceived.fetch_add (1, std::memory_order_relaxed);
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Read_Frequent
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Read_Frequent (BitStreamClass &packet, NetworkObjectClass *object)
+{
+	WWASSERT (object != nullptr);
+
+	uint32_t sequence		= 0;
+	uint32_t has_baseline	= 0;
+	packet.Get_Bits (sequence, SEQUENCE_BITS);
+	packet.Get_Bits (has_baseline, 1);
+
+	int object_id = object->Get_Network_ID ();
+	ReceivedStateStruct &state = _ReceivedStates[object_id];
+	HistoryEntryStruct &entry = state.History[sequence & HISTORY_MASK];
+
+	if (has_baseline == 0) {
+
+		//
+		//	Full tier, import it in place and keep a copy
+		//
+		unsigned int start_bit = packet.Get_Bit_Read_Position ();
+		object->Import_Frequent (packet);
+		unsigned int end_bit = packet.Get_Bit_Read_Position ();
+
+		Extract_Bits (entry.Data, (const uint8 *)packet.Peek_Data (), start_bit, end_bit - start_bit);
+		entry.NumBits = end_bit - start_bit;
+
+	} else {
+
+		uint32_t age = 0;
+		packet.Get_Bits (age, AGE_BITS);
+		int baseline_sequence = ((int)sequence - (int)age) & SEQUENCE_MASK;
+
+		//
+		//	Without the baseline the length of the delta isn't known either.
+		// The frequent tier comes last so the rest of the packet is dropped,
+		// the missing ack makes the server fall back to a full update.
+		//
+		const HistoryEntryStruct &baseline = state.History[baseline_sequence & HISTORY_MASK];
+		if (age == 0 || baseline.Sequence != baseline_sequence) {
+			packet.Flush ();
+			_StatUndecodable.fetch_add (1, std::memory_order_relaxed);
+			return ;
+		}
+
+		std::vector<uint8> data (baseline.Data);
+		unsigned int num_bits = baseline.NumBits;
+		Read_Delta (packet, data, num_bits);
+
+		cPacket tier;
+		tier.Add_Bit_Range (data.data (), 0, num_bits);
+		object->Import_Frequent (tier);
+
+		entry.Data.swap (data);
+		entry.NumBits = num_bits;
+	}
+
+	entry.Sequence = (int)sequence;
+	_PendingAcks[object_id] = (int)sequence;
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Reset_Received
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Reset_Received (int object_id)
+{
+	_ReceivedStates.erase (object_id);
+	_PendingAcks.erase (object_id);
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Has_Pending_Acks
+//
+////////////////////////////////////////////////////////////////
+bool
+NetworkObjectDeltaClass::Has_Pending_Acks (void)
+{
+	return (_PendingAcks.empty () == false);
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Export_Acks
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Export_Acks (BitStreamClass &packet)
+{
+	BYTE count = (BYTE)((_PendingAcks.size () < MAX_ACKS_PER_PACKET) ? _PendingAcks.size () : MAX_ACKS_PER_PACKET);
+	packet.Add (count);
+
+	std::unordered_map<int, int>::iterator it = _PendingAcks.begin ();
+	for (int index = 0; index < count; index ++) {
+		packet.Add (it->first);
+		packet.Add_Bits (it->second, SEQUENCE_BITS);
+		it = _PendingAcks.erase (it);
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Remove_Object
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Remove_Object (int object_id)
+{
+	for (int word = 0; word < NetworkObjectClass::MAX_CLIENT_COUNT / 32; word ++) {
+		uint32 mask = _SentTableMask[word].load (std::memory_order_relaxed);
+		while (mask != 0) {
+			int client_id = (word * 32) + std::countr_zero (mask);
+			mask &= mask - 1;
+			_SentTables[client_id]->erase (object_id);
+		}
+	}
+
+	Reset_Received (object_id);
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Reset
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Reset (void)
+{
+	for (int client_id = 0; client_id < NetworkObjectClass::MAX_CLIENT_COUNT; client_id ++) {
+		delete _SentTables[client_id];
+		_SentTables[client_id] = nullptr;
+	}
+	for (int word = 0; word < NetworkObjectClass::MAX_CLIENT_COUNT / 32; word ++) {
+		_SentTableMask[word].store (0, std::memory_order_relaxed);
+	}
+
+	_ReceivedStates.clear ();
+	_PendingAcks.clear ();
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Get_Stats
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Get_Stats (StatsStruct &stats)
+{
+	stats.FullUpdates		= _StatFullUpdates.load (std::memory_order_relaxed);
+	stats.DeltaUpdates	= _StatDeltaUpdates.load (std::memory_order_relaxed);
+	stats.RawBits			= _StatRawBits.load (std::memory_order_relaxed);
+	stats.SentBits			= _StatSentBits.load (std::memory_order_relaxed);
+	stats.AcksReceived	= _StatAcksReceived.load (std::memory_order_relaxed);
+	stats.Undecodable		= _StatUndecodable.load (std::memory_order_relaxed);
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Reset_Stats
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Reset_Stats (void)
+{
+	_StatFullUpdates		= 0;
+	_StatDeltaUpdates		= 0;
+	_StatRawBits			= 0;
+	_StatSentBits			= 0;
+	_StatAcksReceived		= 0;
+	_StatUndecodable		= 0;
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Start_Recording
+//
+//	Must not be called while the update jobs are running.
+//
+////////////////////////////////////////////////////////////////
+bool
+NetworkObjectDeltaClass::Start_Recording (const char *filename, int client_id)
+{
+	WWASSERT (filename != nullptr);
+	Stop_Recording ();
+
+	if (client_id < 0 || client_id >= NetworkObjectClass::MAX_CLIENT_COUNT) {
+		return false;
+	}
+
+	_RecordFile = ::fopen (filename, "wb");
+	if (_RecordFile == nullptr) {
+		WWDEBUG_SAY (("NetworkObjectDeltaClass::Start_Recording - unable to open %s\n", filename));
+		return false;
+	}
+
+	if (Write_Recording_Header (_RecordFile) == false) {
+		Stop_Recording ();
+		return false;
+	}
+
+	_RecordClientID = client_id;
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Stop_Recording
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectDeltaClass::Stop_Recording (void)
+{
+	if (_RecordFile != nullptr) {
+		::fclose (_RecordFile);
+		_RecordFile = nullptr;
+	}
+
+	_RecordClientID = -1;
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Is_Recording
+//
+////////////////////////////////////////////////////////////////
+bool
+NetworkObjectDeltaClass::Is_Recording (void)
+{
+	return (_RecordFile != nullptr);
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Write_Recording_Header
+//
+////////////////////////////////////////////////////////////////
+bool
+NetworkObjectDeltaClass::Write_Recording_Header (FILE *file)
+{
+	return (Write_Int (file, RECORDING_MAGIC, 4) && Write_Int (file, RECORDING_VERSION, 4));
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Read_Recording_Header
+//
+////////////////////////////////////////////////////////////////
+bool
+NetworkObjectDeltaClass::Read_Recording_Header (FILE *file)
+{
+	uint32 magic	= 0;
+	uint32 version	= 0;
+	return (	Read_Int (file, magic, 4) && Read_Int (file, version, 4) &&
+				magic == RECORDING_MAGIC && version == RECORDING_VERSION);
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Write_Recorded_Update
+//
+////////////////////////////////////////////////////////////////
+bool
+NetworkObjectDeltaClass::Write_Recorded_Update (FILE *file, const RecordedUpdateStruct &update)
+{
+	unsigned int byte_count = (update.NumBits + 7) >> 3;
+	WWASSERT (byte_count <= MAX_BUFFER_SIZE);
+
+	return (	Write_Int (file, update.Time, 4) &&
+				Write_Int (file, (uint32)update.ObjectID, 4) &&
+				Write_Int (file, update.NumBits, 2) &&
+				::fwrite (update.Data, 1, byte_count, file) == byte_count);
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Read_Recorded_Update
+//
+////////////////////////////////////////////////////////////////
+bool
+NetworkObjectDeltaClass::Read_Recorded_Update (FILE *file, RecordedUpdateStruct &update)
+{
+	uint32 time			= 0;
+	uint32 object_id	= 0;
+	uint32 num_bits	= 0;
+	if (	Read_Int (file, time, 4) == false ||
+			Read_Int (file, object_id, 4) == false ||
+			Read_Int (file, num_bits, 2) == false ||
+			num_bits > MAX_BUFFER_SIZE * 8)
+	{
+		return false;
+	}
+
+	update.Time			= time;
+	update.ObjectID	= (int)object_id;
+	update.NumBits		= (uint16)num_bits;
+
+	unsigned int byte_count = (num_bits + 7) >> 3;
+	return (::fread (update.Data, 1, byte_count, file) == byte_count);
+}
@@ -0,0 +1,183 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef	__NETWORKOBJECTDELTA_H
+#define	__NETWORKOBJECTDELTA_H
+
+#include "always.h"
+#include "bittype.h"
+#include "BitPacker.h"
+
+#include <cstdio>
+
+
+////////////////////////////////////////////////////////////////
+//	Forward declarations
+////////////////////////////////////////////////////////////////
+class BitStreamClass;
+class NetworkObjectClass;
+
+
+////////////////////////////////////////////////////////////////
+//
+//	NetworkObjectDeltaClass
+//
+//	Delta coding of the frequent tier against the last state the
+// client acknowledged. The server numbers every frequent tier it
+// sends to a client and keeps the last few in a history. Once the
+// client has acked one of them, later updates only carry the
+// 32 bit words, and within those the bytes, that differ from it.
+// If the acked state has fallen out of the history, or nothing
+// has been acked yet (e.g. after loss), the full tier is sent.
+//
+//	Server side state is kept per client so the per-client update
+// jobs can code their packets concurrently.
+//
+//	Wire format of a coded frequent tier:
+//
+//		8 bits		sequence
+//		1 bit			has baseline
+//		full:			the tier as exported
+//		delta:		4 bits age of the baseline, then for each word
+//						of the tier a changed bit, for changed words a
+//						changed bit per byte, then the changed bytes
+//
+////////////////////////////////////////////////////////////////
+class NetworkObjectDeltaClass
+{
+public:
+
+	////////////////////////////////////////////////////////////////
+	//	Public constants
+	////////////////////////////////////////////////////////////////
+	enum
+	{
+		//
+		//	Set in the dirty bits sent with an update whose frequent
+		// tier is delta coded. Never set in an object's own dirty bits.
+		//
+		DELTA_CODED_BIT		= 0x10,
+
+		SEQUENCE_BITS			= 8,
+		AGE_BITS					= 4,
+		HISTORY_SIZE			= 1 << AGE_BITS,
+		MAX_ACKS_PER_PACKET	= 32
+	};
+
+	struct StatsStruct
+	{
+		uint32	FullUpdates;		// Frequent tiers sent whole
+		uint32	DeltaUpdates;		// Frequent tiers sent as a delta
+		uint32	RawBits;				// What the tiers would have cost uncoded
+		uint32	SentBits;			// What they cost, headers included
+		uint32	AcksReceived;
+		uint32	Undecodable;		// Deltas the client had no baseline for
+	};
+
+	//
+	//	One frequent tier as stored in a recorded session file. The
+	// file starts with RECORDING_MAGIC and RECORDING_VERSION as 32 bit
+	// words, followed by the updates sent to one client:
+	//
+	//		uint32 time (ms), int32 object id, uint16 bits, data
+	//
+	// All little endian, data is MSB first like the packet payload.
+	//
+	enum
+	{
+		RECORDING_MAGIC		= 0x52443357,	// "W3DR"
+		RECORDING_VERSION		= 1
+	};
+
+	struct RecordedUpdateStruct
+	{
+		uint32	Time;
+		int		ObjectID;
+		uint16	NumBits;
+		uint8		Data[MAX_BUFFER_SIZE];
+	};
+
+	////////////////////////////////////////////////////////////////
+	//	Public methods
+	////////////////////////////////////////////////////////////////
+
+	//
+	//	Mode switch, read by the server when it builds updates
+	//
+	static void		Enable (bool onoff)					{ IsEnabled = onoff; }
+	static bool		Is_Enabled (void)						{ return IsEnabled; }
+
+	//
+	//	Server side. Write_Frequent codes num_bits bits of the exported
+	// frequent tier, starting at start_bit of source, for the client.
+	// Safe to call from several threads as long as each thread works
+	// on its own client.
+	//
+	static void		Write_Frequent (BitStreamClass &packet, int client_id, int object_id, const uint8 *source, unsigned int start_bit, unsigned int num_bits);
+	static void		Reset_Object (int client_id, int object_id);
+	static void		Reset_Client (int client_id);
+	static void		Import_Acks (BitStreamClass &packet, int client_id);
+
+	//
+	//	Client side. Read_Frequent decodes a coded frequent tier and
+	// hands it to the object's Import_Frequent.
+	//
+	static void		Read_Frequent (BitStreamClass &packet, NetworkObjectClass *object);
+	static void		Reset_Received (int object_id);
+	static bool		Has_Pending_Acks (void);
+	static void		Export_Acks (BitStreamClass &packet);
+
+	//
+	//	Drops all state kept for the object, called when it is
+	// unregistered.
+	//
+	static void		Remove_Object (int object_id);
+	static void		Reset (void);
+
+	//
+	//	Statistics
+	//
+	static void		Get_Stats (StatsStruct &stats);
+	static void		Reset_Stats (void);
+
+	//
+	//	Session recording of the frequent tiers sent to one client
+	//
+	static bool		Start_Recording (const char *filename, int client_id);
+	static void		Stop_Recording (void);
+	static bool		Is_Recording (void);
+
+	static bool		Write_Recording_Header (FILE *file);
+	static bool		Read_Recording_Header (FILE *file);
+	static bool		Write_Recorded_Update (FILE *file, const RecordedUpdateStruct &update);
+	static bool		Read_Recorded_Update (FILE *file, RecordedUpdateStruct &update);
+
+private:
+
+	////////////////////////////////////////////////////////////////
+	//	Private member data
+	////////////////////////////////////////////////////////////////
+	static bool		IsEnabled;
+};
+
+
+#endif	// __NETWORKOBJECTDELTA_H
@@ -36,16 +36,62 @@
 
 #include "networkobjectmgr.h"
 #include "networkobject.h"
+#include "networkobjectdelta.h"
+
+#include <algorithm>
+#include <math.h>
 
 
 ////////////////////////////////////////////////////////////////
 //	Static member initialization
 ////////////////////////////////////////////////////////////////
 NetworkObjectMgrClass::OBJECT_LIST	NetworkObjectMgrClass::_ObjectList;
+int											NetworkObjectMgrClass::_ObjectListHoles = 0;
+int											NetworkObjectMgrClass::_ObjectListMaxID = 0;
+bool											NetworkObjectMgrClass::_IsObjectListDirty = false;
+bool											NetworkObjectMgrClass::_IsObjectListSorted = true;
 NetworkObjectMgrClass::OBJECT_LIST	NetworkObjectMgrClass::_DeletePendingList;
 int											NetworkObjectMgrClass::_NewDynamicID = NETID_DYNAMIC_OBJECT_MIN;
 int											NetworkObjectMgrClass::_NewClientID = 0;
 bool											NetworkObjectMgrClass::_IsLevelLoading = false;
+NetworkObjectMgrClass::IDSlotStruct *	NetworkObjectMgrClass::_IDTable = nullptr;
+int											NetworkObjectMgrClass::_IDTableSize = 0;
+DynamicVectorClass<NetworkObjectMgrClass::SpatialEntryStruct>	NetworkObjectMgrClass::_SpatialEntries;
+DynamicVectorClass<int>					NetworkObjectMgrClass::_UnpositionedObjects;
+int											NetworkObjectMgrClass::_SpatialBucketStart[SPATIAL_BUCKET_COUNT + 1] = { 0 };
+int											NetworkObjectMgrClass::_RelevanceSkippedPairs = 0;
+int											NetworkObjectMgrClass::_LastRelevanceSkippedPairs = 0;
+bool											NetworkObjectMgrClass::_IsSpatialIndexStale = true;
+NetworkObjectMgrClass::OBJECT_LIST	NetworkObjectMgrClass::_DirtyLists[NetworkObjectClass::MAX_CLIENT_COUNT];
+
+//
+//	Size of one spatial index cell in meters (cells are columns along Z)
+//
+static const float SPATIAL_CELL_SIZE = 50.0f;
+
+//
+//	Network IDs are mostly handed out sequentially, multiplying by an odd
+// constant keeps consecutive IDs in distinct slots.
+//
+static inline unsigned ID_Hash (int object_id)
+{
+	return (unsigned)object_id * 2654435761u;
+}
+
+static inline bool Is_Lower_ID (const NetworkObjectClass *a, const NetworkObjectClass *b)
+{
+	return a->Get_Network_ID () < b->Get_Network_ID ();
+}
+
+static inline int Spatial_Cell (float coord)
+{
+	return (int)::floorf (coord / SPATIAL_CELL_SIZE);
+}
+
+static inline int Spatial_Bucket (int cell_x, int cell_y, int bucket_count)
+{
+	return (int)(((unsigned)cell_x * 73856093u ^ (unsigned)cell_y * 19349663u) & (unsigned)(bucket_count - 1));
+}
 
 ////////////////////////////////////////////////////////////////
 //
@@ -61,13 +107,22 @@ NetworkObjectMgrClass::Register_Object (NetworkObjectClass *object)
 		//
 		//	Check to ensure the object isn't already in the list
 		//
-		int index = 0;
-		if (Find_Object (object_id, &index) == false) {
+		if (Find_ID_Slot (object_id) == -1) {
 
 			//
-			//	Insert the object into the list
+			//	Append the object, the list is sorted by ID again the next
+			// time it is enumerated.  IDs are mostly handed out in order so
+			// that rarely has anything to do.
 			//
-			_ObjectList.Insert (index, object);
+			object->ObjectListIndex = _ObjectList.Count ();
+			Add_ID_Slot (object);
+			_ObjectList.Add (object);
+			if (object_id < _ObjectListMaxID) {
+				_IsObjectListSorted	= false;
+			}
+			_ObjectListMaxID			= std::max (_ObjectListMaxID, object_id);
+			_IsObjectListDirty		= true;
+			_IsSpatialIndexStale		= true;
 		}
 	}
 
@@ -89,13 +144,34 @@ NetworkObjectMgrClass::Unregister_Object (NetworkObjectClass *object)
 		//
 		//	Try to find the object in the list
 		//
-		int index = 0;
-		if (Find_Object (object_id, &index)) {
+		int slot = Find_ID_Slot (object_id);
+		if (slot != -1) {
 
 			//
-			//	Remove the object from the list
+			//	Leave a hole in the list rather than shifting everything
+			// behind the object down, the holes are packed out the next
+			// time the list is enumerated.
 			//
-			_ObjectList.Delete (index);
+			NetworkObjectClass *registered = _IDTable[slot].Object;
+			_ObjectList[registered->ObjectListIndex] = nullptr;
+			registered->ObjectListIndex = -1;
+			_ObjectListHoles ++;
+			_IsObjectListDirty		= true;
+			_IsSpatialIndexStale		= true;
+			Remove_ID_Slot (slot);
+
+			if (_ObjectList.Count () == _ObjectListHoles) {
+				delete [] _IDTable;
+				_IDTable				= nullptr;
+				_IDTableSize		= 0;
+				_ObjectListHoles		= 0;
+				_ObjectListMaxID		= 0;
+				_IsObjectListDirty	= false;
+				_IsObjectListSorted	= true;
+				_ObjectList.Reset_Active ();
+			}
+
+			NetworkObjectDeltaClass::Remove_Object (object_id);
 		}
 	}
 
@@ -114,11 +190,11 @@ NetworkObjectMgrClass::Find_Object (int object_id)
 	NetworkObjectClass *object = nullptr;
 
 	//
-	//	Lookup the object in the sorted list
+	//	Lookup the object in the ID table
 	//
-	int index = 0;
-	if (Find_Object (object_id, &index)) {
-		object = _ObjectList[index];
+	int slot = Find_ID_Slot (object_id);
+	if (slot != -1) {
+		object = _IDTable[slot].Object;
 	}
 
 	return object;
@@ -213,60 +289,188 @@ NetworkObjectMgrClass::Get_New_Client_ID (void)
 
 ////////////////////////////////////////////////////////////////
 //
-//	Find_Object
+//	Rebuild_Object_List
+//
+//	Packs out the holes left by unregistered objects and puts
+// the list back in ID order.
 //
 ////////////////////////////////////////////////////////////////
-bool
-NetworkObjectMgrClass::Find_Object (int id_to_find, int *index)
+void
+NetworkObjectMgrClass::Rebuild_Object_List (void)
 {
-	WWASSERT(index != nullptr);
+	int count			= _ObjectList.Count ();
+	int first_moved	= count;
+	int live_count		= 0;
+
+	for (int index = 0; index < count; index ++) {
+		NetworkObjectClass *object = _ObjectList[index];
+		if (object == nullptr) {
+			first_moved = std::min (first_moved, index);
+		} else {
+			_ObjectList[live_count ++] = object;
+		}
+	}
+	_ObjectList.Set_Active (live_count);
+
+	//
+	//	Only objects registered out of ID order need sorting
+	//
+	if (_IsObjectListSorted == false) {
+		NetworkObjectClass **begin	= &_ObjectList[0];
+		NetworkObjectClass **end	= begin + live_count;
+		NetworkObjectClass **moved	= std::is_sorted_until (begin, end, Is_Lower_ID);
+		if (moved != end) {
+			std::sort (moved, end, Is_Lower_ID);
+			NetworkObjectClass **first = std::upper_bound (begin, moved, *moved, Is_Lower_ID);
+			std::inplace_merge (first, moved, end, Is_Lower_ID);
+			first_moved = std::min (first_moved, (int)(first - begin));
+		}
+	}
+
+	for (int index = first_moved; index < live_count; index ++) {
+		_ObjectList[index]->ObjectListIndex = index;
+	}
+
+	_ObjectListHoles		= 0;
+	_IsObjectListDirty	= false;
+	_IsObjectListSorted	= true;
+	return ;
+}
 
-	bool found		= false;
-	(*index)			= 0;
-	int min_index	= 0;
-	int max_index	= _ObjectList.Count () - 1;
+
+////////////////////////////////////////////////////////////////
+//
+//	Find_ID_Slot
+//
+//	Returns the hash table slot holding the given ID, or -1.
+//
+////////////////////////////////////////////////////////////////
+int
+NetworkObjectMgrClass::Find_ID_Slot (int object_id)
+{
+	if (_IDTable == nullptr || object_id == 0) {
+		return -1;
+	}
+
+	unsigned mask = (unsigned)_IDTableSize - 1;
+	unsigned slot = ID_Hash (object_id) & mask;
 
 	//
-	//	Keep looping until we've closed the window of possiblity
+	//	Linear probe until we hit the ID or an empty slot
 	//
-	bool keep_going = (max_index >= min_index);
-	while (keep_going) {
+	while (_IDTable[slot].ObjectID != 0) {
+		if (_IDTable[slot].ObjectID == object_id) {
+			return (int)slot;
+		}
+		slot = (slot + 1) & mask;
+	}
 
-		//
-		//	Calculate what slot we are currently looking at
-		//
-		int curr_index	= min_index + ((max_index - min_index) / 2);
-		int curr_id		= _ObjectList[curr_index]->Get_Network_ID ();
+	return -1;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Add_ID_Slot
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectMgrClass::Add_ID_Slot (NetworkObjectClass *object)
+{
+	int object_id = object->Get_Network_ID ();
+	WWASSERT(object_id != 0);
+
+	//
+	//	Keep the table at most half full
+	//
+	if ((_ObjectList.Count () - _ObjectListHoles + 1) * 2 > _IDTableSize) {
+		Grow_ID_Table ();
+	}
+
+	unsigned mask = (unsigned)_IDTableSize - 1;
+	unsigned slot = ID_Hash (object_id) & mask;
+	while (_IDTable[slot].ObjectID != 0) {
+		slot = (slot + 1) & mask;
+	}
+
+	_IDTable[slot].ObjectID	= object_id;
+	_IDTable[slot].Object	= object;
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Remove_ID_Slot
+//
+//	Shifts the following entries of the probe sequence back
+// into the freed slot, so no tombstones are needed.
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectMgrClass::Remove_ID_Slot (int slot)
+{
+	unsigned mask = (unsigned)_IDTableSize - 1;
+	unsigned hole = (unsigned)slot;
+	unsigned next = (hole + 1) & mask;
+
+	while (_IDTable[next].ObjectID != 0) {
 
 		//
-		//	Did we find the right slot?
+		//	The entry can fill the hole if the hole lies between
+		// its home slot and where it is now.
 		//
-		if (id_to_find == curr_id) {
-			(*index)		= curr_index;
-			keep_going	= false;
-			found			= true;
-		} else {
+		unsigned home = ID_Hash (_IDTable[next].ObjectID) & mask;
+		if (((next - home) & mask) >= ((next - hole) & mask)) {
+			_IDTable[hole]	= _IDTable[next];
+			hole				= next;
+		}
+		next = (next + 1) & mask;
+	}
 
-			//
-			//	Stop if we've narrowed the window to one entry
-			//
-			keep_going = (max_index > min_index);
+	_IDTable[hole].ObjectID	= 0;
+	_IDTable[hole].Object	= nullptr;
+	return ;
+}
 
-			//
-			//	Move the window to the appropriate side
-			// of the test index.
-			//
-			if (id_to_find < curr_id) {
-				max_index	= curr_index - 1;
-				(*index)		= curr_index;
-			} else {
-				min_index	= curr_index + 1;
-				(*index)		= curr_index + 1;
-			}
+
+////////////////////////////////////////////////////////////////
+//
+//	Grow_ID_Table
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectMgrClass::Grow_ID_Table (void)
+{
+	delete [] _IDTable;
+
+	_IDTableSize = (_IDTableSize > 0) ? (_IDTableSize * 2) : (int)MIN_ID_TABLE_SIZE;
+	_IDTable = new IDSlotStruct[_IDTableSize];
+	for (int slot = 0; slot < _IDTableSize; slot ++) {
+		_IDTable[slot].ObjectID	= 0;
+		_IDTable[slot].Object	= nullptr;
+	}
+
+	//
+	//	Rehash everything that is already registered
+	//
+	unsigned mask = (unsigned)_IDTableSize - 1;
+	for (int index = 0; index < _ObjectList.Count (); index ++) {
+		NetworkObjectClass *object = _ObjectList[index];
+		if (object == nullptr) {
+			continue;
 		}
+
+		int object_id = object->Get_Network_ID ();
+		unsigned slot = ID_Hash (object_id) & mask;
+		while (_IDTable[slot].ObjectID != 0) {
+			slot = (slot + 1) & mask;
+		}
+		_IDTable[slot].ObjectID	= object_id;
+		_IDTable[slot].Object	= object;
 	}
 
-	return found;
+	return ;
 }
 
 
@@ -281,9 +485,9 @@ NetworkObjectMgrClass::Think (void)
 	//
 	//	Simply let each object think
 	//
-	for (int index = 0; index < _ObjectList.Count (); index ++) {
-		WWASSERT(_ObjectList[index] != nullptr);
-		_ObjectList[index]->Network_Think ();
+	for (int index = 0; index < Get_Object_Count (); index ++) {
+		WWASSERT(Get_Object (index) != nullptr);
+		Get_Object (index)->Network_Think ();
 	}
 
 	return ;
@@ -305,8 +509,8 @@ NetworkObjectMgrClass::Set_All_Delete_Pending (void)
 	//
 	//	Mark all netobjects as delete pending
 	//
-	for (int index = 0; index < _ObjectList.Count (); index ++) {
-		_ObjectList[index]->Set_Delete_Pending();
+	for (int index = 0; index < Get_Object_Count (); index ++) {
+		Get_Object (index)->Set_Delete_Pending();
 	}
 
 	return ;
@@ -359,11 +563,11 @@ NetworkObjectMgrClass::Delete_Client_Objects (int client_id)
 	//	Delete each object that belongs to the given client
 	//
 
-	for (int index = 0; index < _ObjectList.Count (); index ++) {
-		WWASSERT(_ObjectList[index] != nullptr);
-		if (_ObjectList[index]->Belongs_To_Client (client_id)) {
+	for (int index = 0; index < Get_Object_Count (); index ++) {
+		WWASSERT(Get_Object (index) != nullptr);
+		if (Get_Object (index)->Belongs_To_Client (client_id)) {
 			//TSS092301 _ObjectList[index]->Delete ();
-			_ObjectList[index]->Set_Delete_Pending();
+			Get_Object (index)->Set_Delete_Pending();
 		}
 	}
 
@@ -387,8 +591,8 @@ NetworkObjectMgrClass::Restore_Dirty_Bits (int client_id)
 	// For now I am going to use the topmost client id...
 	//
 
-	for (int index = 0; index < _ObjectList.Count (); index ++) {
-		NetworkObjectClass * p_object = _ObjectList[index];
+	for (int index = 0; index < Get_Object_Count (); index ++) {
+		NetworkObjectClass * p_object = Get_Object (index);
 		WWASSERT(p_object != nullptr);
 		BYTE generic_bits = p_object->Get_Object_Dirty_Bits(NetworkObjectClass::MAX_CLIENT_COUNT - 1);//TSS2001e
 		p_object->Set_Object_Dirty_Bits(client_id, generic_bits);
@@ -422,9 +626,9 @@ NetworkObjectMgrClass::Register_Object_For_Deletion (NetworkObjectClass *object)
 void
 NetworkObjectMgrClass::Reset_Import_State_Counts(void)
 {
-	for (int index = 0; index < _ObjectList.Count (); index ++) {
+	for (int index = 0; index < Get_Object_Count (); index ++) {
 
-		NetworkObjectClass * p_object = _ObjectList[index];
+		NetworkObjectClass * p_object = Get_Object (index);
 		WWASSERT(p_object != nullptr);
 
 		//
@@ -435,3 +639,227 @@ NetworkObjectMgrClass::Reset_Import_State_Counts(void)
 }
 
 
+////////////////////////////////////////////////////////////////
+//
+//	Update_Spatial_Index
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectMgrClass::Update_Spatial_Index (void)
+{
+	_LastRelevanceSkippedPairs	= _RelevanceSkippedPairs;
+	_RelevanceSkippedPairs		= 0;
+	_IsSpatialIndexStale			= false;
+
+	static DynamicVectorClass<SpatialEntryStruct> unsorted_entries;
+	unsorted_entries.Reset_Active ();
+	_UnpositionedObjects.Reset_Active ();
+
+	int bucket_size[SPATIAL_BUCKET_COUNT] = { 0 };
+
+	for (int index = 0; index < Get_Object_Count (); index ++) {
+		NetworkObjectClass *object = Get_Object (index);
+		WWASSERT(object != nullptr);
+
+		SpatialEntryStruct entry;
+		if (object->Get_World_Position (entry.Position) == false) {
+			_UnpositionedObjects.Add (index);
+			continue;
+		}
+
+		entry.ObjectIndex	= index;
+		entry.CellX			= Spatial_Cell (entry.Position.X);
+		entry.CellY			= Spatial_Cell (entry.Position.Y);
+		bucket_size[Spatial_Bucket (entry.CellX, entry.CellY, SPATIAL_BUCKET_COUNT)] ++;
+		unsorted_entries.Add (entry);
+	}
+
+	//
+	//	Counting sort the entries into their buckets
+	//
+	int bucket_fill[SPATIAL_BUCKET_COUNT];
+	_SpatialBucketStart[0] = 0;
+	for (int bucket = 0; bucket < SPATIAL_BUCKET_COUNT; bucket ++) {
+		bucket_fill[bucket]					= _SpatialBucketStart[bucket];
+		_SpatialBucketStart[bucket + 1]	= _SpatialBucketStart[bucket] + bucket_size[bucket];
+	}
+
+	_SpatialEntries.Reset_Active ();
+	for (int index = 0; index < unsorted_entries.Count (); index ++) {
+		_SpatialEntries.Add (unsorted_entries[index]);
+	}
+	for (int index = 0; index < unsorted_entries.Count (); index ++) {
+		const SpatialEntryStruct &entry = unsorted_entries[index];
+		int bucket = Spatial_Bucket (entry.CellX, entry.CellY, SPATIAL_BUCKET_COUNT);
+		_SpatialEntries[bucket_fill[bucket] ++] = entry;
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Collect_Relevant_Objects
+//
+//	Read only, so it is safe to call from several threads at
+// once as long as nobody is updating the index.
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectMgrClass::Collect_Relevant_Objects
+(
+	const Vector3 &		pos,
+	float						radius,
+	RelevantSetClass &	relevant
+)
+{
+	//
+	//	The stored indices are only valid until the object list changes,
+	// in that case every object is considered relevant.
+	//
+	relevant.IsEverything = _IsSpatialIndexStale;
+	if (_IsSpatialIndexStale) {
+		return ;
+	}
+
+	//
+	//	Start a new set by bumping the stamp, only clear the marks when it wraps
+	//
+	if (relevant.Marks.size () < (size_t)_ObjectList.Count ()) {
+		relevant.Marks.resize (_ObjectList.Count (), 0);
+	}
+	if (++relevant.Stamp == 0) {
+		std::fill (relevant.Marks.begin (), relevant.Marks.end (), 0u);
+		relevant.Stamp = 1;
+	}
+
+	float radius2	= radius * radius;
+	int min_x		= Spatial_Cell (pos.X - radius);
+	int max_x		= Spatial_Cell (pos.X + radius);
+	int min_y		= Spatial_Cell (pos.Y - radius);
+	int max_y		= Spatial_Cell (pos.Y + radius);
+
+	if ((max_x - min_x + 1) * (max_y - min_y + 1) > SPATIAL_BUCKET_COUNT) {
+
+		//
+		//	The area covers more cells than we have buckets, just test everything
+		//
+		for (int index = 0; index < _SpatialEntries.Count (); index ++) {
+			const SpatialEntryStruct &entry = _SpatialEntries[index];
+			if ((entry.Position - pos).Length2 () <= radius2) {
+				relevant.Marks[entry.ObjectIndex] = relevant.Stamp;
+			}
+		}
+
+	} else {
+
+		for (int cell_y = min_y; cell_y <= max_y; cell_y ++) {
+			for (int cell_x = min_x; cell_x <= max_x; cell_x ++) {
+
+				int bucket = Spatial_Bucket (cell_x, cell_y, SPATIAL_BUCKET_COUNT);
+				for (int index = _SpatialBucketStart[bucket]; index < _SpatialBucketStart[bucket + 1]; index ++) {
+					const SpatialEntryStruct &entry = _SpatialEntries[index];
+
+					//
+					//	Buckets are shared by several cells
+					//
+					if (entry.CellX == cell_x && entry.CellY == cell_y && (entry.Position - pos).Length2 () <= radius2) {
+						relevant.Marks[entry.ObjectIndex] = relevant.Stamp;
+					}
+				}
+			}
+		}
+	}
+
+	for (int index = 0; index < _UnpositionedObjects.Count (); index ++) {
+		relevant.Marks[_UnpositionedObjects[index]] = relevant.Stamp;
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Add_Dirty_Object
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectMgrClass::Add_Dirty_Object (int client_id, NetworkObjectClass *object)
+{
+	WWASSERT(object != nullptr);
+	WWASSERT(object->DirtyListIndex[client_id] == -1);
+
+	OBJECT_LIST &list = _DirtyLists[client_id];
+	if (list.Length () == 0) {
+		list.Set_Growth_Step (DIRTY_LIST_GROWTH);
+	}
+
+	object->DirtyListIndex[client_id] = list.Count ();
+	list.Add (object);
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Remove_Dirty_Object
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectMgrClass::Remove_Dirty_Object (int client_id, NetworkObjectClass *object)
+{
+	WWASSERT(object != nullptr);
+
+	OBJECT_LIST &list	= _DirtyLists[client_id];
+	int index			= object->DirtyListIndex[client_id];
+	WWASSERT(index >= 0 && index < list.Count () && list[index] == object);
+
+	//
+	//	Move the last entry into the hole so we don't have to shift
+	//
+	int last_index = list.Count () - 1;
+	if (index != last_index) {
+		NetworkObjectClass *moved_object = list[last_index];
+		list[index] = moved_object;
+		moved_object->DirtyListIndex[client_id] = index;
+	}
+
+	list.Delete (last_index);
+	object->DirtyListIndex[client_id] = -1;
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Collect_Dirty_Objects
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectMgrClass::Collect_Dirty_Objects (int client_id, DynamicVectorClass<int> &indices)
+{
+	Pack_Object_List ();
+	indices.Reset_Active ();
+
+	const OBJECT_LIST &list = _DirtyLists[client_id];
+	for (int index = 0; index < list.Count (); index ++) {
+		NetworkObjectClass *object = list[index];
+
+		//
+		//	Objects can be dirty before they are registered or after
+		// they have been unregistered, skip those
+		//
+		int slot = Find_ID_Slot (object->Get_Network_ID ());
+		if (slot != -1 && _IDTable[slot].Object == object) {
+			indices.Add (object->ObjectListIndex);
+		}
+	}
+
+	if (indices.Count () > 1) {
+		std::sort (&indices[0], &indices[0] + indices.Count ());
+	}
+
+	return ;
+}
@@ -42,12 +42,10 @@
 #define	__NETWORKOBJECTMGR_H
 
 #include "vector.h"
+#include "vector3.h"
+#include "networkobject.h"
 
-
-////////////////////////////////////////////////////////////////
-//	Forward declarations
-////////////////////////////////////////////////////////////////
-class NetworkObjectClass;
+#include <vector>
 
 
 ////////////////////////////////////////////////////////////////
@@ -111,10 +109,12 @@ public:
 	static void							Restore_Dirty_Bits (int client_id);
 
 	//
-	//	Object enumeration
+	//	Object enumeration, in network ID order. Registering only
+	// appends and unregistering only leaves a hole, the list is
+	// packed and sorted again the next time it is enumerated.
 	//
-	static int							Get_Object_Count (void)	{ return _ObjectList.Count (); }
-	static NetworkObjectClass *	Get_Object (int index)	{ return _ObjectList[index]; }
+	static int							Get_Object_Count (void)	{ Pack_Object_List (); return _ObjectList.Count (); }
+	static NetworkObjectClass *	Get_Object (int index)	{ Pack_Object_List (); return _ObjectList[index]; }
 	static int							Get_Pending_Object_Count (void)	{ return _DeletePendingList.Count (); }
 
 	//
@@ -134,26 +134,131 @@ public:
 
 	static void							Reset_Import_State_Counts(void);
 
+	//
+	//	Set of relevant objects filled in by Collect_Relevant_Objects,
+	// tested by index into the object list. Each caller (or thread)
+	// keeps its own set and reuses it, filling it again only costs
+	// the objects that are actually relevant.
+	//
+	class RelevantSetClass
+	{
+	public:
+		RelevantSetClass (void) : Stamp (0), IsEverything (true)	{}
+
+		bool		Is_Relevant (int index) const
+		{
+			return IsEverything || (index < (int)Marks.size () && Marks[index] == Stamp);
+		}
+
+	private:
+		friend class NetworkObjectMgrClass;
+		std::vector<unsigned>	Marks;
+		unsigned						Stamp;
+		bool							IsEverything;
+	};
+
+	//
+	//	Spatial index used for relevance filtering. The index is a
+	// snapshot of the object positions taken by Update_Spatial_Index,
+	// queries only look at the grid cells that overlap the radius.
+	// Objects without a world position are always relevant.
+	//
+	static void							Update_Spatial_Index (void);
+	static void							Collect_Relevant_Objects (const Vector3 &pos, float radius, RelevantSetClass &relevant);
+
+	//
+	//	Relevance filtering stats
+	//
+	static void							Add_Relevance_Skipped_Pairs (int count)	{ _RelevanceSkippedPairs += count; }
+	static int							Get_Relevance_Skipped_Pairs (void)			{ return _LastRelevanceSkippedPairs; }
+
+	//
+	//	Dirty worklists. An object is on a client's list for as long as
+	// it has any dirty bits set for that client, so senders only need
+	// to look at those. Collect_Dirty_Objects returns indices into the
+	// object list in ascending order, unregistered objects are skipped.
+	// Safe to call from several threads while no dirty bits change and
+	// no objects are registered or unregistered.
+	//
+	static int							Get_Dirty_Object_Count (int client_id)	{ return _DirtyLists[client_id].Count (); }
+	static void							Collect_Dirty_Objects (int client_id, DynamicVectorClass<int> &indices);
+
 private:
 
 	////////////////////////////////////////////////////////////////
 	//	Private methods
 	////////////////////////////////////////////////////////////////
-	static bool							Find_Object (int id_to_find, int *index);
+	static void							Pack_Object_List (void)	{ if (_IsObjectListDirty) Rebuild_Object_List (); }
+	static void							Rebuild_Object_List (void);
+
+	//
+	//	Network ID hash table
+	//
+	static int							Find_ID_Slot (int object_id);
+	static void							Add_ID_Slot (NetworkObjectClass *object);
+	static void							Remove_ID_Slot (int slot);
+	static void							Grow_ID_Table (void);
+
+	//
+	//	Dirty worklist maintenance, called by NetworkObjectClass
+	//
+	friend class NetworkObjectClass;
+	static void							Add_Dirty_Object (int client_id, NetworkObjectClass *object);
+	static void							Remove_Dirty_Object (int client_id, NetworkObjectClass *object);
 
 	////////////////////////////////////////////////////////////////
 	//	Private tyepdefs
 	////////////////////////////////////////////////////////////////
 	typedef DynamicVectorClass<NetworkObjectClass *>	OBJECT_LIST;
 
+	struct SpatialEntryStruct
+	{
+		int		ObjectIndex;
+		int		CellX;
+		int		CellY;
+		Vector3	Position;
+
+		bool operator== (const SpatialEntryStruct &src)	{ return ObjectIndex == src.ObjectIndex; }
+		bool operator!= (const SpatialEntryStruct &src)	{ return ObjectIndex != src.ObjectIndex; }
+	};
+
+	struct IDSlotStruct
+	{
+		int						ObjectID;	// 0 if the slot is free
+		NetworkObjectClass *	Object;
+	};
+
+	enum
+	{
+		SPATIAL_BUCKET_COUNT	= 1024,
+		MIN_ID_TABLE_SIZE		= 1024,
+		DIRTY_LIST_GROWTH		= 256,
+	};
+
 	////////////////////////////////////////////////////////////////
 	//	Private member data
 	////////////////////////////////////////////////////////////////
 	static OBJECT_LIST	_ObjectList;
+	static int			_ObjectListHoles;
+	static int			_ObjectListMaxID;
+	static bool			_IsObjectListDirty;
+	static bool			_IsObjectListSorted;
 	static OBJECT_LIST	_DeletePendingList;
 	static int			_NewDynamicID;
 	static int			_NewClientID;
 	static bool			_IsLevelLoading;
+
+	static IDSlotStruct *	_IDTable;
+	static int					_IDTableSize;
+
+	static DynamicVectorClass<SpatialEntryStruct>	_SpatialEntries;
+	static DynamicVectorClass<int>					_UnpositionedObjects;
+	static int												_SpatialBucketStart[SPATIAL_BUCKET_COUNT + 1];
+	static int												_RelevanceSkippedPairs;
+	static int												_LastRelevanceSkippedPairs;
+	static bool												_IsSpatialIndexStale;
+
+	static OBJECT_LIST	_DirtyLists[NetworkObjectClass::MAX_CLIENT_COUNT];
 };
 
 
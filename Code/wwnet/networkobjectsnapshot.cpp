@@ -0,0 +1,301 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkobjectsnapshot.h"
+#include "networkobjectmgr.h"
+#include "networkobjectfactorymgr.h"
+#include "networkobjectfactory.h"
+#include "networkobjectdelta.h"
+#include "wwpacket.h"
+#include "connect.h"
+#include "wwprofile.h"
+
+
+////////////////////////////////////////////////////////////////
+//	Local constants
+////////////////////////////////////////////////////////////////
+static const NetworkObjectClass::DIRTY_BIT _TierDirtyBit[PACKET_TIER_COUNT] =
+{
+	NetworkObjectClass::BIT_CREATION,
+	NetworkObjectClass::BIT_RARE,
+	NetworkObjectClass::BIT_OCCASIONAL,
+	NetworkObjectClass::BIT_FREQUENT
+};
+
+
+////////////////////////////////////////////////////////////////
+//
+//	NetworkObjectSnapshotClass
+//
+////////////////////////////////////////////////////////////////
+NetworkObjectSnapshotClass::NetworkObjectSnapshotClass (void)
+{
+	ObjectList.Set_Growth_Step (500);
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	~NetworkObjectSnapshotClass
+//
+////////////////////////////////////////////////////////////////
+NetworkObjectSnapshotClass::~NetworkObjectSnapshotClass (void)
+{
+	Reset ();
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Reset
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectSnapshotClass::Reset (void)
+{
+	for (int index = 0; index < ObjectList.Count (); index ++) {
+		delete ObjectList[index].Payload;
+	}
+	ObjectList.Reset_Active ();
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Is_Tier_Dirty
+//
+////////////////////////////////////////////////////////////////
+bool
+NetworkObjectSnapshotClass::Is_Tier_Dirty (BYTE dirty_bits, PACKET_TIER_ENUM tier)
+{
+	return ((dirty_bits & _TierDirtyBit[tier]) == _TierDirtyBit[tier]);
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Build
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectSnapshotClass::Build (const int *client_ids, int client_count)
+{
+	WWPROFILE ("Snapshot");
+
+	Reset ();
+
+	int count = NetworkObjectMgrClass::Get_Object_Count ();
+	for (int index = 0; index < count; index ++) {
+		NetworkObjectClass *object = NetworkObjectMgrClass::Get_Object (index);
+		if (object == nullptr) {
+			continue;
+		}
+
+		ObjectStruct entry;
+		memset (&entry, 0, sizeof (entry));
+		entry.Object				= object;
+		entry.NetworkID			= object->Get_Network_ID ();
+		entry.AppPacketType		= object->Get_App_Packet_Type ();
+		entry.IsDeletePending	= object->Is_Delete_Pending ();
+		entry.UnreliableOverride = object->Get_Unreliable_Override ();
+		ObjectList.Add (entry);
+	}
+
+	//
+	//	Work out which tiers at least one of the clients is going
+	// to ask for. Only objects on a client's dirty worklist can
+	// need anything.
+	//
+	static DynamicVectorClass<BYTE> needed_masks;
+	static DynamicVectorClass<int> dirty_list;
+	needed_masks.Reset_Active ();
+	for (int index = 0; index < ObjectList.Count (); index ++) {
+		needed_masks.Add (0);
+	}
+
+	for (int client_index = 0; client_index < client_count; client_index ++) {
+		int client_id = client_ids[client_index];
+		NetworkObjectMgrClass::Collect_Dirty_Objects (client_id, dirty_list);
+		for (int dirty_index = 0; dirty_index < dirty_list.Count (); dirty_index ++) {
+			int index			= dirty_list[dirty_index];
+			BYTE dirty_bits	= ObjectList[index].Object->Get_Object_Dirty_Bits (client_id);
+			for (int tier = 0; tier < PACKET_TIER_COUNT; tier ++) {
+				if (Is_Tier_Dirty (dirty_bits, (PACKET_TIER_ENUM)tier)) {
+					needed_masks[index] |= (1 << tier);
+				}
+			}
+		}
+	}
+
+	for (int index = 0; index < ObjectList.Count (); index ++) {
+		if (needed_masks[index] == 0) {
+			continue;
+		}
+
+		bool needed_tiers[PACKET_TIER_COUNT] = { false };
+		for (int tier = 0; tier < PACKET_TIER_COUNT; tier ++) {
+			needed_tiers[tier] = ((needed_masks[index] & (1 << tier)) != 0);
+		}
+
+		Export_Object (ObjectList[index], needed_tiers);
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Export_Object
+//
+////////////////////////////////////////////////////////////////
+void
+NetworkObjectSnapshotClass::Export_Object (ObjectStruct &entry, const bool *needed_tiers)
+{
+	NetworkObjectClass *object = entry.Object;
+	cPacket *packet = new cPacket;
+	entry.Payload = packet;
+
+	for (int tier = 0; tier < PACKET_TIER_COUNT; tier ++) {
+		if (needed_tiers[tier] == false) {
+			continue;
+		}
+
+		int bits_before = packet->Get_Bit_Write_Position ();
+
+		switch (tier) {
+			case PACKET_TIER_CREATION:
+			{
+				//
+				//	Same layout Send_Object_Update uses: class id, factory data
+				// and then the object's own creation data.
+				//
+				uint32 net_classid = object->Get_Network_Class_ID ();
+				packet->Add (net_classid);
+
+				NetworkObjectFactoryClass *factory = NetworkObjectFactoryMgrClass::Find_Factory (net_classid);
+				WWASSERT (factory != nullptr);
+				factory->Prep_Packet (object, *packet);
+
+				object->Export_Creation (*packet);
+				break;
+			}
+
+			case PACKET_TIER_RARE:
+				object->Export_Rare (*packet);
+				break;
+
+			case PACKET_TIER_OCCASIONAL:
+				object->Export_Occasional (*packet);
+				break;
+
+			case PACKET_TIER_FREQUENT:
+				object->Export_Frequent (*packet);
+				break;
+		}
+
+		int bits_after = packet->Get_Bit_Write_Position ();
+
+		entry.HasTier[tier]		= true;
+		entry.TierStart[tier]	= (unsigned short)bits_before;
+		entry.TierBits[tier]		= (unsigned short)(bits_after - bits_before);
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Build_Update_Packet
+//
+////////////////////////////////////////////////////////////////
+bool
+NetworkObjectSnapshotClass::Build_Update_Packet
+(
+	int			index,
+	BYTE			dirty_bits,
+	cPacket &	packet,
+	int &			mode,
+	int			client_id,
+	int *			tier_bits
+) const
+{
+	const ObjectStruct &entry = ObjectList[index];
+
+	//
+	//	Delta code the frequent tier against what this client has acked?
+	//
+	bool is_delta = (	client_id >= 0 && NetworkObjectDeltaClass::Is_Enabled () &&
+							Is_Tier_Dirty (dirty_bits, PACKET_TIER_FREQUENT) &&
+							entry.TierBits[PACKET_TIER_FREQUENT] > 0);
+
+	if (client_id >= 0 && Is_Tier_Dirty (dirty_bits, PACKET_TIER_CREATION)) {
+		NetworkObjectDeltaClass::Reset_Object (client_id, entry.NetworkID);
+	}
+
+	packet.Add (entry.NetworkID);
+	packet.Add ((BYTE)(is_delta ? (dirty_bits | NetworkObjectDeltaClass::DELTA_CODED_BIT) : dirty_bits));
+	packet.Add (entry.IsDeletePending);
+
+	int bits_start = packet.Get_Bit_Write_Position ();
+
+	mode = SEND_UNRELIABLE;
+	if (entry.IsDeletePending) {
+		mode = SEND_RELIABLE;
+	}
+
+	for (int tier = 0; tier < PACKET_TIER_COUNT; tier ++) {
+		if (tier_bits != nullptr) {
+			tier_bits[tier] = 0;
+		}
+		if (Is_Tier_Dirty (dirty_bits, (PACKET_TIER_ENUM)tier) == false) {
+			continue;
+		}
+
+		//
+		//	The snapshot must have been built with this client in the list
+		//
+		WWASSERT (entry.HasTier[tier]);
+		int bits_before = packet.Get_Bit_Write_Position ();
+		if (is_delta && tier == PACKET_TIER_FREQUENT) {
+			NetworkObjectDeltaClass::Write_Frequent (packet, client_id, entry.NetworkID,
+				(const uint8 *)entry.Payload->Peek_Data (), entry.TierStart[tier], entry.TierBits[tier]);
+		} else if (entry.TierBits[tier] > 0) {
+			packet.Add_Bit_Range ((const uint8_t *)entry.Payload->Peek_Data (), entry.TierStart[tier], entry.TierBits[tier]);
+		}
+
+		if (tier_bits != nullptr) {
+			tier_bits[tier] = packet.Get_Bit_Write_Position () - bits_before;
+		}
+
+		if (tier != PACKET_TIER_FREQUENT) {
+			mode = SEND_RELIABLE;
+		}
+	}
+
+	if (mode == SEND_RELIABLE && entry.UnreliableOverride) {
+		mode = SEND_UNRELIABLE;
+	}
+
+	int bits_end = packet.Get_Bit_Write_Position ();
+	return (entry.IsDeletePending || bits_end > bits_start);
+}
@@ -0,0 +1,137 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef	__NETWORKOBJECTSNAPSHOT_H
+#define	__NETWORKOBJECTSNAPSHOT_H
+
+#include "always.h"
+#include "bittype.h"
+#include "vector.h"
+#include "networkobject.h"
+
+
+////////////////////////////////////////////////////////////////
+//	Forward declarations
+////////////////////////////////////////////////////////////////
+class cPacket;
+
+
+////////////////////////////////////////////////////////////////
+//
+//	NetworkObjectSnapshotClass
+//
+//	Frozen copy of the network object list taken once per server
+// tick. Every tier any of the given clients needs is exported
+// exactly once, after which per-client update packets can be
+// assembled from the snapshot on any thread. The assembled
+// packets are bit for bit identical to exporting the object
+// straight into the packet.
+//
+////////////////////////////////////////////////////////////////
+class NetworkObjectSnapshotClass
+{
+public:
+
+	////////////////////////////////////////////////////////////////
+	//	Public data types
+	////////////////////////////////////////////////////////////////
+	struct ObjectStruct
+	{
+		NetworkObjectClass *	Object;
+		int						NetworkID;
+		BYTE						AppPacketType;
+		bool						IsDeletePending;
+		bool						UnreliableOverride;
+
+		//
+		//	Exported tiers, stored back to back in Payload
+		//
+		bool						HasTier[PACKET_TIER_COUNT];
+		unsigned short			TierStart[PACKET_TIER_COUNT];
+		unsigned short			TierBits[PACKET_TIER_COUNT];
+		cPacket *				Payload;
+
+		bool operator== (const ObjectStruct &src)	{ return Object == src.Object; }
+		bool operator!= (const ObjectStruct &src)	{ return Object != src.Object; }
+	};
+
+	////////////////////////////////////////////////////////////////
+	//	Public constructors/destructors
+	////////////////////////////////////////////////////////////////
+	NetworkObjectSnapshotClass (void);
+	~NetworkObjectSnapshotClass (void);
+
+	////////////////////////////////////////////////////////////////
+	//	Public methods
+	////////////////////////////////////////////////////////////////
+
+	//
+	//	Capture the current state of NetworkObjectMgrClass. Must be
+	// called from the main thread.
+	//
+	void						Build (const int *client_ids, int client_count);
+	void						Reset (void);
+
+	//
+	//	Object access, in NetworkObjectMgrClass order
+	//
+	int						Get_Object_Count (void) const			{ return ObjectList.Count (); }
+	const ObjectStruct &	Get_Object (int index) const			{ return ObjectList[index]; }
+
+	//
+	//	Assemble the update packet for the object as seen by a client
+	// with the given dirty bits. Returns false if there was nothing
+	// to send. Safe to call from several threads at once, as long as
+	// no two threads pass the same client. Pass the client's id to
+	// delta code the frequent tier when NetworkObjectDeltaClass is
+	// enabled, or -1 to send the tiers as exported. If tier_bits is
+	// given it receives the bits each tier actually took up in the
+	// packet, which differs from Get_Tier_Bits for a delta coded
+	// frequent tier.
+	//
+	bool						Build_Update_Packet (int index, BYTE dirty_bits, cPacket &packet, int &mode, int client_id = -1, int *tier_bits = nullptr) const;
+
+	//
+	//	Size in bits the tier adds to an update packet
+	//
+	int						Get_Tier_Bits (int index, PACKET_TIER_ENUM tier) const	{ return ObjectList[index].TierBits[tier]; }
+
+	//
+	//	Maps a packet tier onto its (cumulative) dirty bit mask
+	//
+	static bool				Is_Tier_Dirty (BYTE dirty_bits, PACKET_TIER_ENUM tier);
+
+private:
+
+	////////////////////////////////////////////////////////////////
+	//	Private methods
+	////////////////////////////////////////////////////////////////
+	void						Export_Object (ObjectStruct &entry, const bool *needed_tiers);
+
+	////////////////////////////////////////////////////////////////
+	//	Private member data
+	////////////////////////////////////////////////////////////////
+	DynamicVectorClass<ObjectStruct>	ObjectList;
+};
+
+
+#endif	// __NETWORKOBJECTSNAPSHOT_H
@@ -0,0 +1,261 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "packetcapture.h"
+#include "systimer.h"
+#include "wwdebug.h"
+
+#include <cstring>
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Write_Int / Read_Int - little endian file fields
+//
+////////////////////////////////////////////////////////////////
+static bool
+Write_Int (FILE *file, uint32 value, int byte_count)
+{
+	uint8 bytes[4];
+	for (int index = 0; index < byte_count; index ++) {
+		bytes[index] = (uint8)(value >> (index * 8));
+	}
+	return (::fwrite (bytes, 1, byte_count, file) == (size_t)byte_count);
+}
+
+static bool
+Read_Int (FILE *file, uint32 &value, int byte_count)
+{
+	uint8 bytes[4];
+	if (::fread (bytes, 1, byte_count, file) != (size_t)byte_count) {
+		return false;
+	}
+
+	value = 0;
+	for (int index = 0; index < byte_count; index ++) {
+		value |= (uint32)bytes[index] << (index * 8);
+	}
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	PacketCaptureClass
+//
+////////////////////////////////////////////////////////////////
+PacketCaptureClass::PacketCaptureClass (void)	:
+	File (nullptr),
+	IsWriting (false),
+	StartTime (0),
+	DatagramCount (0),
+	ByteCount (0)
+{
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	~PacketCaptureClass
+//
+////////////////////////////////////////////////////////////////
+PacketCaptureClass::~PacketCaptureClass (void)
+{
+	Close ();
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Open_For_Write
+//
+////////////////////////////////////////////////////////////////
+bool
+PacketCaptureClass::Open_For_Write (const char *filename)
+{
+	WWASSERT (filename != nullptr);
+	Close ();
+
+	File = ::fopen (filename, "wb");
+	if (File == nullptr) {
+		WWDEBUG_SAY (("PacketCaptureClass::Open_For_Write - unable to open %s\n", filename));
+		return false;
+	}
+
+	IsWriting	= true;
+	StartTime	= TIMEGETTIME ();
+
+	if ((Write_Int (File, CAPTURE_MAGIC, 4) && Write_Int (File, CAPTURE_VERSION, 4)) == false) {
+		Close ();
+		return false;
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Open_For_Read
+//
+////////////////////////////////////////////////////////////////
+bool
+PacketCaptureClass::Open_For_Read (const char *filename)
+{
+	WWASSERT (filename != nullptr);
+	Close ();
+
+	File = ::fopen (filename, "rb");
+	if (File == nullptr) {
+		WWDEBUG_SAY (("PacketCaptureClass::Open_For_Read - unable to open %s\n", filename));
+		return false;
+	}
+
+	IsWriting = false;
+
+	uint32 magic	= 0;
+	uint32 version	= 0;
+	if (	Read_Int (File, magic, 4) == false || Read_Int (File, version, 4) == false ||
+			magic != CAPTURE_MAGIC || version != CAPTURE_VERSION)
+	{
+		WWDEBUG_SAY (("PacketCaptureClass::Open_For_Read - %s is not a packet capture\n", filename));
+		Close ();
+		return false;
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Close
+//
+////////////////////////////////////////////////////////////////
+void
+PacketCaptureClass::Close (void)
+{
+	if (File != nullptr) {
+		::fclose (File);
+		File = nullptr;
+	}
+
+	IsWriting		= false;
+	DatagramCount	= 0;
+	ByteCount		= 0;
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Write_Datagram
+//
+////////////////////////////////////////////////////////////////
+bool
+PacketCaptureClass::Write_Datagram
+(
+	DIRECTION		direction,
+	uint32			ip_address,
+	uint16			port,
+	const void *	data,
+	int				length
+)
+{
+	WWASSERT (length >= 0 && length <= MAX_DATAGRAM_SIZE);
+
+	DatagramStruct datagram;
+	datagram.Time			= TIMEGETTIME () - StartTime;
+	datagram.Direction	= direction;
+	datagram.IPAddress	= ip_address;
+	datagram.Port			= port;
+	datagram.Length		= (uint16)length;
+	::memcpy (datagram.Data, data, length);
+	return Write_Datagram (datagram);
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Write_Datagram
+//
+////////////////////////////////////////////////////////////////
+bool
+PacketCaptureClass::Write_Datagram (const DatagramStruct &datagram)
+{
+	WWASSERT (Is_Writing ());
+	WWASSERT (datagram.Length <= MAX_DATAGRAM_SIZE);
+
+	//
+	//	Address and port are written byte for byte so they stay in
+	// network order whatever the host is.
+	//
+	bool retval = (	Write_Int (File, datagram.Time, 4) &&
+							Write_Int (File, datagram.Direction, 1) &&
+							::fwrite (&datagram.IPAddress, 1, 4, File) == 4 &&
+							::fwrite (&datagram.Port, 1, 2, File) == 2 &&
+							Write_Int (File, datagram.Length, 2) &&
+							::fwrite (datagram.Data, 1, datagram.Length, File) == datagram.Length);
+
+	if (retval) {
+		DatagramCount ++;
+		ByteCount += datagram.Length;
+	}
+
+	return retval;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//	Read_Datagram
+//
+////////////////////////////////////////////////////////////////
+bool
+PacketCaptureClass::Read_Datagram (DatagramStruct &datagram)
+{
+	WWASSERT (Is_Reading ());
+
+	uint32 time			= 0;
+	uint32 direction	= 0;
+	uint32 length		= 0;
+	if (	Read_Int (File, time, 4) == false ||
+			Read_Int (File, direction, 1) == false ||
+			::fread (&datagram.IPAddress, 1, 4, File) != 4 ||
+			::fread (&datagram.Port, 1, 2, File) != 2 ||
+			Read_Int (File, length, 2) == false ||
+			direction > DIRECTION_OUT ||
+			length > MAX_DATAGRAM_SIZE)
+	{
+		return false;
+	}
+
+	datagram.Time			= time;
+	datagram.Direction	= (DIRECTION)direction;
+	datagram.Length		= (uint16)length;
+
+	if (::fread (datagram.Data, 1, length, File) != length) {
+		return false;
+	}
+
+	DatagramCount ++;
+	ByteCount += length;
+	return true;
+}
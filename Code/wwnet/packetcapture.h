@@ -0,0 +1,131 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef	__PACKETCAPTURE_H
+#define	__PACKETCAPTURE_H
+
+#include "always.h"
+#include "bittype.h"
+
+#include <cstdio>
+
+
+////////////////////////////////////////////////////////////////
+//
+//	PacketCaptureClass
+//
+//	Capture file of the raw datagrams a PacketManagerClass sent
+// and received, so a session can be played back through the
+// receive path offline. The file starts with CAPTURE_MAGIC and
+// CAPTURE_VERSION as 32 bit words, followed by one record per
+// datagram:
+//
+//		uint32 time (ms since the capture started)
+//		uint8  direction
+//		uint32 IP address, uint16 port of the other end
+//		uint16 length, data
+//
+// Fields are little endian. The address and port are stored as
+// they appear in a sockaddr_in, i.e. in network byte order.
+//
+////////////////////////////////////////////////////////////////
+class PacketCaptureClass
+{
+public:
+
+	////////////////////////////////////////////////////////////////
+	//	Public constants
+	////////////////////////////////////////////////////////////////
+	enum
+	{
+		CAPTURE_MAGIC			= 0x43443357,	// "W3DC"
+		CAPTURE_VERSION		= 1,
+		MAX_DATAGRAM_SIZE		= 600
+	};
+
+	typedef enum
+	{
+		DIRECTION_IN			= 0,
+		DIRECTION_OUT
+	} DIRECTION;
+
+	struct DatagramStruct
+	{
+		uint32		Time;
+		DIRECTION	Direction;
+		uint32		IPAddress;
+		uint16		Port;
+		uint16		Length;
+		uint8			Data[MAX_DATAGRAM_SIZE];
+	};
+
+	////////////////////////////////////////////////////////////////
+	//	Public constructors/destructors
+	////////////////////////////////////////////////////////////////
+	PacketCaptureClass (void);
+	~PacketCaptureClass (void);
+
+	////////////////////////////////////////////////////////////////
+	//	Public methods
+	////////////////////////////////////////////////////////////////
+
+	//
+	//	File control
+	//
+	bool			Open_For_Write (const char *filename);
+	bool			Open_For_Read (const char *filename);
+	void			Close (void);
+	bool			Is_Open (void) const							{ return (File != nullptr); }
+	bool			Is_Writing (void) const						{ return (File != nullptr && IsWriting); }
+	bool			Is_Reading (void) const						{ return (File != nullptr && !IsWriting); }
+
+	//
+	//	Records. The first Write_Datagram takes its time from the
+	// clock, the second writes the record as is.
+	//
+	bool			Write_Datagram (DIRECTION direction, uint32 ip_address, uint16 port, const void *data, int length);
+	bool			Write_Datagram (const DatagramStruct &datagram);
+	bool			Read_Datagram (DatagramStruct &datagram);
+
+	//
+	//	Totals since the file was opened
+	//
+	int			Get_Datagram_Count (void) const			{ return DatagramCount; }
+	uint32		Get_Byte_Count (void) const				{ return ByteCount; }
+
+private:
+
+	PacketCaptureClass (const PacketCaptureClass &);
+	PacketCaptureClass &operator= (const PacketCaptureClass &);
+
+	////////////////////////////////////////////////////////////////
+	//	Private member data
+	////////////////////////////////////////////////////////////////
+	FILE *		File;
+	bool			IsWriting;
+	uint32		StartTime;
+	int			DatagramCount;
+	uint32		ByteCount;
+};
+
+
+#endif	// __PACKETCAPTURE_H
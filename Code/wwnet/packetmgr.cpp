@@ -178,6 +178,22 @@ PacketManagerClass::PacketManagerClass(void)
 	SendBuffers = new SendBufferClass[NumSendBuffers];
 	NumReceiveBuffers = PACKET_MANAGER_RECEIVE_BUFFERS;
 	ReceiveBuffers = new ReceiveBufferClass[NumReceiveBuffers];
+
+	BatchIO = false;
+	BatchSendBuffers = new unsigned char[PACKET_MANAGER_BATCH_SIZE * PACKET_MANAGER_BATCH_BUFFER_SIZE];
+	NumBatchSends = 0;
+	BatchSendSocket = INVALID_SOCKET;
+	BatchReceiveBuffers = new unsigned char[PACKET_MANAGER_BATCH_SIZE * PACKET_MANAGER_BATCH_BUFFER_SIZE];
+	NumBatchReceives = 0;
+	CurrentBatchReceive = 0;
+	BatchReceiveSocket = INVALID_SOCKET;
+	ReplayHasDatagram = false;
+	ReplayDone = false;
+	ReplayInBurst = false;
+	ReplayBurstMs = 0;
+	ReplayBurstEnd = 0;
+	ReplayedDatagrams = 0;
+	ReplayedBytes = 0;
 }
 
 
@@ -205,6 +221,14 @@ PacketManagerClass::~PacketManagerClass(void)
 		delete [] ReceiveBuffers;
 		ReceiveBuffers = nullptr;
 	}
+	if (BatchSendBuffers) {
+		delete [] BatchSendBuffers;
+		BatchSendBuffers = nullptr;
+	}
+	if (BatchReceiveBuffers) {
+		delete [] BatchReceiveBuffers;
+		BatchReceiveBuffers = nullptr;
+	}
 }
 
 
@@ -245,6 +269,8 @@ void PacketManagerClass::Set_Is_Server(bool is_server)
 		NumPackets = 0;
 		NumReceivePackets = 0;
 		CurrentPacket = 0;
+		NumBatchReceives = 0;
+		CurrentBatchReceive = 0;
 
 		if (SendBuffers) {
 			delete [] SendBuffers;
@@ -889,8 +915,11 @@ WWPROFILE("PMgr Flush");
 
 
 	/*
-	** Send any packets marked as ready.
+	** Send any packets marked as ready. There is nobody to send to while replaying a capture so the datagrams are built
+	** and then dropped.
 	*/
+	bool replaying = Replay.Is_Reading();
+	bool batch_io = BatchIO && !replaying;
 	for (i=0 ; i<NumSendBuffers ; i++) {
 		if (SendBuffers[i].PacketReady) {
 			sockaddr_in addr;
@@ -917,19 +946,34 @@ WWPROFILE("PMgr Flush");
 			*/
 			crc = _byteswap_ulong(crc);
 #endif //(0)
-			char *crc_and_buffer = (char*)_alloca(SendBuffers[i].PacketSendLength + sizeof(crc));
+			int send_length = SendBuffers[i].PacketSendLength + sizeof(crc);
+			char *crc_and_buffer = batch_io ? Queue_Batched_Send(socket, addr, send_length) : (char*)_alloca(send_length);
 			*((unsigned int*) crc_and_buffer) = crc;
 			memcpy(crc_and_buffer + sizeof(crc), (const char*)SendBuffers[i].PacketBuffer, SendBuffers[i].PacketSendLength);
 
 			Register_Packet_Out(&SendBuffers[i].IPAddress[0], SendBuffers[i].Port, SendBuffers[i].PacketSendLength + UDP_HEADER_SIZE + sizeof(crc), 0);
 			socklen_t addr_len = sizeof(struct sockaddr_in);
-			int result = wwnet::SocketSendTo(socket, crc_and_buffer, SendBuffers[i].PacketSendLength + sizeof(crc), 0, (const sockaddr*)&addr, &addr_len);
+			int result = 0;
+			if (!batch_io && !replaying) {
+				result = wwnet::SocketSendTo(socket, crc_and_buffer, send_length, 0, (const sockaddr*)&addr, &addr_len);
+				if (result != SOCKET_ERROR) {
+					Capture_Datagram(PacketCaptureClass::DIRECTION_OUT, addr, crc_and_buffer, send_length);
+				}
+			}
 
 #else //WRAPPER_CRC
 
 			Register_Packet_Out(&SendBuffers[i].IPAddress[0], SendBuffers[i].Port, SendBuffers[i].PacketSendLength + UDP_HEADER_SIZE, 0);
 			socklen_t addr_len = sizeof(struct sockaddr_in);
-			int result = wwnet::SocketSendTo(socket, (const char*)SendBuffers[i].PacketBuffer, SendBuffers[i].PacketSendLength, 0, (const sockaddr*)&addr, &addr_len);
+			int result = 0;
+			if (batch_io) {
+				memcpy(Queue_Batched_Send(socket, addr, SendBuffers[i].PacketSendLength), SendBuffers[i].PacketBuffer, SendBuffers[i].PacketSendLength);
+			} else if (!replaying) {
+				result = wwnet::SocketSendTo(socket, (const char*)SendBuffers[i].PacketBuffer, SendBuffers[i].PacketSendLength, 0, (const sockaddr*)&addr, &addr_len);
+				if (result != SOCKET_ERROR) {
+					Capture_Datagram(PacketCaptureClass::DIRECTION_OUT, addr, SendBuffers[i].PacketBuffer, SendBuffers[i].PacketSendLength);
+				}
+			}
 #endif //WRAPPER_CRC
 
 
@@ -960,6 +1004,14 @@ WWPROFILE("PMgr Flush");
 
 		}
 	}
+
+	/*
+	** Send whatever is left in the batch.
+	*/
+	if (NumBatchSends) {
+		Send_Batched();
+	}
+
 	Update_Stats();
 }
 }
@@ -1133,6 +1185,387 @@ void PacketManagerClass::Clear_Socket_Error(SOCKET socket)
 
 
 
+/***********************************************************************************************
+ * PacketManagerClass::Set_Batch_IO -- Enable or disable batched socket I/O                    *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    True to send and receive whole bursts of datagrams per syscall                    *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: Stays disabled on platforms without batched socket calls                          *
+ *                                                                                             *
+ *=============================================================================================*/
+void PacketManagerClass::Set_Batch_IO(bool enable)
+{
+	CriticalSectionClass::LockClass lock(CriticalSection);
+	BatchIO = enable && wwnet::SocketHasBatchIO();
+	WWDEBUG_SAY(("PacketManagerClass - batched socket I/O %s\n", BatchIO ? "enabled" : "disabled"));
+}
+
+
+
+/***********************************************************************************************
+ * PacketManagerClass::Queue_Batched_Send -- Reserve space for a datagram in the send batch    *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Socket to send on                                                                 *
+ *           Destination address                                                               *
+ *           Length of datagram                                                                *
+ *                                                                                             *
+ * OUTPUT:   Ptr to buffer to copy the datagram into                                           *
+ *                                                                                             *
+ * WARNINGS: Sends the batch so far if it is full or was for a different socket                *
+ *                                                                                             *
+ *=============================================================================================*/
+char *PacketManagerClass::Queue_Batched_Send(SOCKET socket, const sockaddr_in &addr, int length)
+{
+	pm_assert(length > 0 && length <= PACKET_MANAGER_BATCH_BUFFER_SIZE);
+
+	if (NumBatchSends == PACKET_MANAGER_BATCH_SIZE || (NumBatchSends && socket != BatchSendSocket)) {
+		Send_Batched();
+
+		/*
+		** If the socket buffers are still full there's no room to keep the old datagrams as well, so they are lost.
+		*/
+		if (NumBatchSends == PACKET_MANAGER_BATCH_SIZE || (NumBatchSends && socket != BatchSendSocket)) {
+			WWDEBUG_SAY(("PacketManagerClass - dropping %d batched datagrams that couldn't be sent\n", NumBatchSends));
+			NumBatchSends = 0;
+		}
+	}
+
+	BatchSendSocket = socket;
+	wwnet::SocketDatagram &datagram = BatchSends[NumBatchSends];
+	datagram.Buffer = (char*) &BatchSendBuffers[NumBatchSends * PACKET_MANAGER_BATCH_BUFFER_SIZE];
+	datagram.Length = length;
+	datagram.Address = addr;
+	NumBatchSends++;
+
+	return(datagram.Buffer);
+}
+
+
+
+/***********************************************************************************************
+ * PacketManagerClass::Send_Batched -- Send all datagrams in the send batch                    *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: Datagrams that didn't fit in the socket buffers stay queued for the next call     *
+ *                                                                                             *
+ *=============================================================================================*/
+void PacketManagerClass::Send_Batched(void)
+{
+	int sent = 0;
+	while (sent < NumBatchSends) {
+		int result = wwnet::SocketSendBatch(BatchSendSocket, &BatchSends[sent], NumBatchSends - sent);
+
+		if (result > 0) {
+			for (int i=sent ; i<sent + result ; i++) {
+				Capture_Datagram(PacketCaptureClass::DIRECTION_OUT, BatchSends[i].Address, BatchSends[i].Buffer, BatchSends[i].Length);
+			}
+			sent += result;
+			continue;
+		}
+
+		int error_code = wwnet::SocketGetLastError();
+		if (result == SOCKET_ERROR && error_code != WSAEWOULDBLOCK) {
+
+			/*
+			** Skip the datagram that failed and carry on with the rest, same as the one-at-a-time path.
+			*/
+			WWDEBUG_SAY(("PacketManagerClass - sendmmsg returned error code %d - %s\n", error_code, cNetUtil::Winsock_Error_Text(error_code)));
+			Clear_Socket_Error(BatchSendSocket);
+			sent++;
+		} else {
+
+			/*
+			** No more room for outgoing packets. Keep the rest and try them again next time.
+			*/
+			WWDEBUG_SAY(("PacketManagerClass - sendmmsg returned WSAEWOULDBLOCK\n"));
+			std::this_thread::yield();
+			ErrorState = STATE_WS_BUFFERS_FULL;
+			break;
+		}
+	}
+
+	/*
+	** Move whatever is left to the front of the batch, buffers and all, so new datagrams queue up behind it.
+	*/
+	int remaining = NumBatchSends - sent;
+	for (int i=0 ; i<remaining ; i++) {
+		wwnet::SocketDatagram &datagram = BatchSends[i];
+		datagram = BatchSends[sent + i];
+		char *buffer = (char*) &BatchSendBuffers[i * PACKET_MANAGER_BATCH_BUFFER_SIZE];
+		memmove(buffer, datagram.Buffer, datagram.Length);
+		datagram.Buffer = buffer;
+	}
+	NumBatchSends = remaining;
+}
+
+
+
+/***********************************************************************************************
+ * PacketManagerClass::Receive_Batched -- Get the next datagram from the receive batch         *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Socket to use                                                                     *
+ *           Ptr to packet buffer                                                              *
+ *           Size of packet buffer                                                             *
+ *           (out) Address the datagram came from                                              *
+ *                                                                                             *
+ * OUTPUT:   Size of datagram (0 = nothing waiting, -1 = use the one-at-a-time path)           *
+ *                                                                                             *
+ * WARNINGS: Refills the batch from the socket with a single call once it is empty             *
+ *                                                                                             *
+ *=============================================================================================*/
+int PacketManagerClass::Receive_Batched(SOCKET socket, unsigned char *packet_buffer, int packet_buffer_size, sockaddr_in &addr)
+{
+	if (CurrentBatchReceive >= NumBatchReceives) {
+		NumBatchReceives = 0;
+		CurrentBatchReceive = 0;
+
+		if (!BatchIO) {
+			return(-1);
+		}
+
+		for (int i=0 ; i<PACKET_MANAGER_BATCH_SIZE ; i++) {
+			BatchReceives[i].Buffer = (char*) &BatchReceiveBuffers[i * PACKET_MANAGER_BATCH_BUFFER_SIZE];
+			BatchReceives[i].Length = PACKET_MANAGER_BATCH_BUFFER_SIZE;
+		}
+
+		int result = wwnet::SocketRecvBatch(socket, BatchReceives, PACKET_MANAGER_BATCH_SIZE);
+		if (result == SOCKET_ERROR) {
+			int error_code = wwnet::SocketGetLastError();
+			if (error_code != WSAEWOULDBLOCK) {
+				WWDEBUG_SAY(("PacketManagerClass - recvmmsg failed with error %d - %s\n", error_code, cNetUtil::Winsock_Error_Text(error_code)));
+				Clear_Socket_Error(socket);
+			}
+			return(0);
+		}
+
+		NumBatchReceives = result;
+		BatchReceiveSocket = socket;
+
+	} else if (socket != BatchReceiveSocket) {
+
+		/*
+		** The batch belongs to another socket. Leave it for that one.
+		*/
+		return(-1);
+	}
+
+	while (CurrentBatchReceive < NumBatchReceives) {
+		wwnet::SocketDatagram &datagram = BatchReceives[CurrentBatchReceive++];
+		if (datagram.Length > 0) {
+			int bytes = std::min((int)datagram.Length, packet_buffer_size);
+			memcpy(packet_buffer, datagram.Buffer, bytes);
+			addr = datagram.Address;
+			return(bytes);
+		}
+	}
+
+	return(0);
+}
+
+
+
+/***********************************************************************************************
+ * PacketManagerClass::Start_Capture -- Start recording datagrams to a capture file            *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Capture file name                                                                 *
+ *                                                                                             *
+ * OUTPUT:   True if the file was opened                                                       *
+ *                                                                                             *
+ * WARNINGS: Replaces any capture already running                                              *
+ *                                                                                             *
+ *=============================================================================================*/
+bool PacketManagerClass::Start_Capture(const char *filename)
+{
+	CriticalSectionClass::LockClass lock(CriticalSection);
+	bool opened = Capture.Open_For_Write(filename);
+	WWDEBUG_SAY(("PacketManagerClass - %s datagram capture to %s\n", opened ? "started" : "failed to start", filename));
+	return(opened);
+}
+
+
+
+/***********************************************************************************************
+ * PacketManagerClass::Stop_Capture -- Stop recording datagrams                                *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: None                                                                              *
+ *                                                                                             *
+ *=============================================================================================*/
+void PacketManagerClass::Stop_Capture(void)
+{
+	CriticalSectionClass::LockClass lock(CriticalSection);
+	if (Capture.Is_Writing()) {
+		WWDEBUG_SAY(("PacketManagerClass - captured %d datagrams, %u bytes\n", Capture.Get_Datagram_Count(), Capture.Get_Byte_Count()));
+	}
+	Capture.Close();
+}
+
+
+
+/***********************************************************************************************
+ * PacketManagerClass::Start_Replay -- Feed received datagrams from a capture file             *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Capture file name                                                                 *
+ *           Capture time per burst in ms (0 = no bursts)                                      *
+ *                                                                                             *
+ * OUTPUT:   True if the file was opened                                                       *
+ *                                                                                             *
+ * WARNINGS: Anything already received but not yet handed out is dropped                       *
+ *                                                                                             *
+ *=============================================================================================*/
+bool PacketManagerClass::Start_Replay(const char *filename, unsigned int burst_ms)
+{
+	CriticalSectionClass::LockClass lock(CriticalSection);
+
+	NumReceivePackets = 0;
+	CurrentPacket = 0;
+	NumBatchReceives = 0;
+	CurrentBatchReceive = 0;
+	ReplayHasDatagram = false;
+	ReplayDone = false;
+	ReplayInBurst = false;
+	ReplayBurstMs = burst_ms;
+	ReplayedDatagrams = 0;
+	ReplayedBytes = 0;
+
+	bool opened = Replay.Open_For_Read(filename);
+	WWDEBUG_SAY(("PacketManagerClass - %s replay of %s\n", opened ? "started" : "failed to start", filename));
+	return(opened);
+}
+
+
+
+/***********************************************************************************************
+ * PacketManagerClass::Stop_Replay -- Go back to reading the socket                            *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: None                                                                              *
+ *                                                                                             *
+ *=============================================================================================*/
+void PacketManagerClass::Stop_Replay(void)
+{
+	CriticalSectionClass::LockClass lock(CriticalSection);
+	Replay.Close();
+	ReplayHasDatagram = false;
+	ReplayInBurst = false;
+}
+
+
+
+/***********************************************************************************************
+ * PacketManagerClass::Capture_Datagram -- Add a datagram to the capture if one is running     *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Direction                                                                         *
+ *           Address of the other end                                                          *
+ *           Ptr to datagram                                                                   *
+ *           Length of datagram                                                                *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: Call with the critical section held                                               *
+ *                                                                                             *
+ *=============================================================================================*/
+void PacketManagerClass::Capture_Datagram(PacketCaptureClass::DIRECTION direction, const sockaddr_in &addr, const void *data, int length)
+{
+	if (Capture.Is_Writing()) {
+		if (!Capture.Write_Datagram(direction, (unsigned int)addr.sin_addr.s_addr, addr.sin_port, data, length)) {
+			WWDEBUG_SAY(("PacketManagerClass - write to capture file failed, capture stopped\n"));
+			Capture.Close();
+		}
+	}
+}
+
+
+
+/***********************************************************************************************
+ * PacketManagerClass::Receive_Replayed -- Get the next received datagram from the capture     *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Ptr to packet buffer                                                              *
+ *           Size of packet buffer                                                             *
+ *           (out) Address the datagram came from                                              *
+ *                                                                                             *
+ * OUTPUT:   Size of datagram (0 = end of burst or capture)                                    *
+ *                                                                                             *
+ * WARNINGS: Datagrams we sent are skipped                                                     *
+ *                                                                                             *
+ *=============================================================================================*/
+int PacketManagerClass::Receive_Replayed(unsigned char *packet_buffer, int packet_buffer_size, sockaddr_in &addr)
+{
+	if (!ReplayHasDatagram) {
+		while (Replay.Read_Datagram(ReplayDatagram)) {
+			if (ReplayDatagram.Direction == PacketCaptureClass::DIRECTION_IN) {
+				ReplayHasDatagram = true;
+				break;
+			}
+		}
+
+		if (!ReplayHasDatagram) {
+			if (!ReplayDone) {
+				WWDEBUG_SAY(("PacketManagerClass - replay finished after %d datagrams\n", ReplayedDatagrams));
+			}
+			ReplayDone = true;
+			return(0);
+		}
+	}
+
+	/*
+	** Stop at the end of each burst. The next call starts the next one.
+	*/
+	if (ReplayBurstMs) {
+		if (!ReplayInBurst) {
+			ReplayInBurst = true;
+			ReplayBurstEnd = ReplayDatagram.Time + ReplayBurstMs;
+		} else if ((int)(ReplayDatagram.Time - ReplayBurstEnd) >= 0) {
+			ReplayInBurst = false;
+			return(0);
+		}
+	}
+
+	ReplayHasDatagram = false;
+	ReplayedDatagrams++;
+	ReplayedBytes += ReplayDatagram.Length;
+
+	int bytes = std::min((int)ReplayDatagram.Length, packet_buffer_size);
+	memcpy(packet_buffer, ReplayDatagram.Data, bytes);
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = ReplayDatagram.IPAddress;
+	addr.sin_port = ReplayDatagram.Port;
+	return(bytes);
+}
+
+
+
 /***********************************************************************************************
  * PacketManagerClass::Get_Packet -- Return the next incoming packet to the app                *
  *                                                                                             *
@@ -1162,12 +1595,32 @@ WWPROFILE("Pmgr Get");
 		sockaddr_in addr;
 		memset(&addr, 0, sizeof(addr));
 		pm_assert(packet_buffer_size >= PACKET_MANAGER_MTU);
-		wwnet::SocketIoctlParam bytes_available;
-		int result = wwnet::SocketIoctl(socket, FIONREAD, &bytes_available);
-		if (result == 0 && bytes_available != 0) {
 
-			int bytes = wwnet::SocketRecvFrom(socket, (char*)packet_buffer, packet_buffer_size, 0, (sockaddr*)&addr, &address_size);
+		/*
+		** Take the next datagram out of the capture if we are replaying one, or out of the batch if we are using batched
+		** I/O. Otherwise fall back to one recvfrom per datagram.
+		*/
+		int batch_bytes = -1;
+		if (Replay.Is_Reading()) {
+			batch_bytes = Receive_Replayed(packet_buffer, packet_buffer_size, addr);
+		} else if (BatchIO || CurrentBatchReceive < NumBatchReceives) {
+			batch_bytes = Receive_Batched(socket, packet_buffer, packet_buffer_size, addr);
+		}
+
+		wwnet::SocketIoctlParam bytes_available = 0;
+		int result = SOCKET_ERROR;
+		if (batch_bytes < 0) {
+			result = wwnet::SocketIoctl(socket, FIONREAD, &bytes_available);
+		}
+		if (batch_bytes > 0 || (result == 0 && bytes_available != 0)) {
+
+			int bytes = batch_bytes;
+			if (batch_bytes < 0) {
+				bytes = wwnet::SocketRecvFrom(socket, (char*)packet_buffer, packet_buffer_size, 0, (sockaddr*)&addr, &address_size);
+			}
 			if (bytes > 0) {
+				Capture_Datagram(PacketCaptureClass::DIRECTION_IN, addr, packet_buffer, bytes);
+
 #ifndef WRAPPER_CRC
 				Register_Packet_In((unsigned char*) &addr.sin_addr.s_addr, addr.sin_port, bytes + UDP_HEADER_SIZE, 0);
 #endif //WRAPPER_CRC
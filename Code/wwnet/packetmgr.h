@@ -43,6 +43,8 @@
 #include "wwdebug.h"
 #include "vector.h"
 #include "network-typedefs.h"
+#include "socket_wrapper.h"
+#include "packetcapture.h"
 
 #ifdef WWASSERT
 #ifndef pm_assert
@@ -111,6 +113,8 @@ struct PacketDeltaHeaderStruct {
 #define PACKET_MANAGER_RECEIVE_BUFFERS 128
 #define PACKET_MANAGER_RECEIVE_BUFFERS_AS_SERVER (64 * 32)
 #define PACKET_MANAGER_MAX_PACKETS 31
+#define PACKET_MANAGER_BATCH_SIZE wwnet::SOCKET_BATCH_MAX
+#define PACKET_MANAGER_BATCH_BUFFER_SIZE 600
 #define UDP_HEADER_SIZE 28
 
 
@@ -184,6 +188,33 @@ class PacketManagerClass
 		bool Get_Allow_Combos(void)					{return AllowCombos;}
 		void Disable_Optimizations(void);
 
+		/*
+		** Batched socket I/O. Moves whole bursts of datagrams per syscall where the platform supports it (recvmmsg/sendmmsg
+		** on Linux). Has no effect elsewhere.
+		*/
+		void Set_Batch_IO(bool enable);
+		bool Get_Batch_IO(void) {return(BatchIO);};
+		bool Toggle_Batch_IO(void) {
+			Set_Batch_IO(BatchIO ? false : true);
+			return(BatchIO);
+		};
+
+		/*
+		** Datagram capture and replay. A capture records every datagram sent and received along with its address. While
+		** replaying, Get_Packet hands out the received datagrams from a capture instead of reading the socket and nothing is
+		** sent. With a burst length set, Get_Packet returns 0 after each burst_ms worth of capture time so the caller sees
+		** roughly the same groups of datagrams per frame as the captured server did.
+		*/
+		bool Start_Capture(const char *filename);
+		void Stop_Capture(void);
+		bool Is_Capturing(void) {return(Capture.Is_Writing());};
+		bool Start_Replay(const char *filename, unsigned int burst_ms = 0);
+		void Stop_Replay(void);
+		bool Is_Replaying(void) {return(Replay.Is_Reading());};
+		bool Is_Replay_Done(void) {return(ReplayDone);};
+		int Get_Replayed_Datagrams(void) {return(ReplayedDatagrams);};
+		unsigned int Get_Replayed_Bytes(void) {return(ReplayedBytes);};
+
 		enum ErrorStateEnum {
 			STATE_OK,
 			STATE_WS_BUFFERS_FULL,
@@ -216,6 +247,19 @@ class PacketManagerClass
 		*/
 		void Clear_Socket_Error(SOCKET socket);
 
+		/*
+		** Batched socket I/O.
+		*/
+		char *Queue_Batched_Send(SOCKET socket, const sockaddr_in &addr, int length);
+		void Send_Batched(void);
+		int Receive_Batched(SOCKET socket, unsigned char *packet_buffer, int packet_buffer_size, sockaddr_in &addr);
+
+		/*
+		** Capture and replay.
+		*/
+		void Capture_Datagram(PacketCaptureClass::DIRECTION direction, const sockaddr_in &addr, const void *data, int length);
+		int Receive_Replayed(unsigned char *packet_buffer, int packet_buffer_size, sockaddr_in &addr);
+
 		/*
 		** Stats management.
 		*/
@@ -337,6 +381,35 @@ class PacketManagerClass
 		bool AllowDeltas;
 		bool AllowCombos;
 
+		/*
+		** Batched socket I/O. Received datagrams are queued until Get_Packet asks for them, outgoing ones until the end of
+		** the flush.
+		*/
+		bool BatchIO;
+		unsigned char *BatchSendBuffers;					//[PACKET_MANAGER_BATCH_SIZE][PACKET_MANAGER_BATCH_BUFFER_SIZE]
+		wwnet::SocketDatagram BatchSends[PACKET_MANAGER_BATCH_SIZE];
+		int NumBatchSends;
+		SOCKET BatchSendSocket;
+		unsigned char *BatchReceiveBuffers;				//[PACKET_MANAGER_BATCH_SIZE][PACKET_MANAGER_BATCH_BUFFER_SIZE]
+		wwnet::SocketDatagram BatchReceives[PACKET_MANAGER_BATCH_SIZE];
+		int NumBatchReceives;
+		int CurrentBatchReceive;
+		SOCKET BatchReceiveSocket;
+
+		/*
+		** Capture and replay.
+		*/
+		PacketCaptureClass Capture;
+		PacketCaptureClass Replay;
+		PacketCaptureClass::DatagramStruct ReplayDatagram;
+		bool ReplayHasDatagram;
+		bool ReplayDone;
+		bool ReplayInBurst;
+		unsigned int ReplayBurstMs;
+		unsigned int ReplayBurstEnd;
+		int ReplayedDatagrams;
+		unsigned int ReplayedBytes;
+
 		/*
 		** Winsock error handling.
 		*/
@@ -29,6 +29,16 @@ namespace wwnet {
 #endif
 
 namespace wwnet {
+	// One datagram for the batched send/receive calls. For receives Length is
+	// the buffer size on the way in and the datagram size on the way out.
+	struct SocketDatagram {
+		char* Buffer;
+		size_t Length;
+		struct sockaddr_in Address;
+	};
+
+	constexpr int SOCKET_BATCH_MAX = 64;
+
 	int SocketStartup();
 	void SocketCleanup();
 	SocketHandle SocketCreate(int domain, int type, int protocol);
@@ -41,6 +51,14 @@ namespace wwnet {
 	int SocketSetSockOpt(SocketHandle s, int level, int optname, const char* optval, socklen_t optlen);
 	int SocketSendTo(SocketHandle s, const char* buf, size_t len, int flags, const struct sockaddr* to, socklen_t* tolen);
 	int SocketRecvFrom(SocketHandle s, char* buf, size_t len, int flags, struct sockaddr* from, socklen_t* fromlen);
+
+	// Send/receive up to SOCKET_BATCH_MAX datagrams. Return the number of
+	// datagrams handled, or SOCKET_ERROR_VALUE if the first one failed. The
+	// receive never blocks. Only a single syscall is made when
+	// SocketHasBatchIO() is true, otherwise these loop over sendto/recvfrom.
+	bool SocketHasBatchIO();
+	int SocketSendBatch(SocketHandle s, SocketDatagram* datagrams, int count);
+	int SocketRecvBatch(SocketHandle s, SocketDatagram* datagrams, int count);
 	int SocketGetHostName(char* name, int namelen);
 	struct hostent* SocketGetHostByName(const char* name);
 }
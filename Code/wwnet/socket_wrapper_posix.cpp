@@ -1,5 +1,8 @@
 #include "socket_wrapper.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace wwnet {
 
     int SocketStartup() {
@@ -50,6 +53,85 @@ namespace wwnet {
         return ::recvfrom(s, buf, len, flags, from, fromlen);
     }
 
+#ifdef __linux__
+
+    bool SocketHasBatchIO() {
+        return true;
+    }
+
+    int SocketSendBatch(SocketHandle s, SocketDatagram* datagrams, int count) {
+        struct mmsghdr msgs[SOCKET_BATCH_MAX];
+        struct iovec iovs[SOCKET_BATCH_MAX];
+        count = std::min(count, SOCKET_BATCH_MAX);
+
+        memset(msgs, 0, sizeof(msgs[0]) * count);
+        for (int i = 0; i < count; ++i) {
+            iovs[i].iov_base = datagrams[i].Buffer;
+            iovs[i].iov_len = datagrams[i].Length;
+            msgs[i].msg_hdr.msg_name = &datagrams[i].Address;
+            msgs[i].msg_hdr.msg_namelen = sizeof(datagrams[i].Address);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        return ::sendmmsg(s, msgs, count, 0);
+    }
+
+    int SocketRecvBatch(SocketHandle s, SocketDatagram* datagrams, int count) {
+        struct mmsghdr msgs[SOCKET_BATCH_MAX];
+        struct iovec iovs[SOCKET_BATCH_MAX];
+        count = std::min(count, SOCKET_BATCH_MAX);
+
+        memset(msgs, 0, sizeof(msgs[0]) * count);
+        for (int i = 0; i < count; ++i) {
+            iovs[i].iov_base = datagrams[i].Buffer;
+            iovs[i].iov_len = datagrams[i].Length;
+            msgs[i].msg_hdr.msg_name = &datagrams[i].Address;
+            msgs[i].msg_hdr.msg_namelen = sizeof(datagrams[i].Address);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int received = ::recvmmsg(s, msgs, count, MSG_DONTWAIT, nullptr);
+        for (int i = 0; i < received; ++i) {
+            datagrams[i].Length = msgs[i].msg_len;
+        }
+        return received;
+    }
+
+#else
+
+    bool SocketHasBatchIO() {
+        return false;
+    }
+
+    int SocketSendBatch(SocketHandle s, SocketDatagram* datagrams, int count) {
+        count = std::min(count, SOCKET_BATCH_MAX);
+        for (int i = 0; i < count; ++i) {
+            int rc = ::sendto(s, datagrams[i].Buffer, datagrams[i].Length, 0,
+                (const struct sockaddr*)&datagrams[i].Address, sizeof(datagrams[i].Address));
+            if (rc < 0) {
+                return (i == 0) ? SOCKET_ERROR_VALUE : i;
+            }
+        }
+        return count;
+    }
+
+    int SocketRecvBatch(SocketHandle s, SocketDatagram* datagrams, int count) {
+        count = std::min(count, SOCKET_BATCH_MAX);
+        for (int i = 0; i < count; ++i) {
+            socklen_t address_size = sizeof(datagrams[i].Address);
+            ssize_t rc = ::recvfrom(s, datagrams[i].Buffer, datagrams[i].Length, MSG_DONTWAIT,
+                (struct sockaddr*)&datagrams[i].Address, &address_size);
+            if (rc < 0) {
+                return (i == 0) ? SOCKET_ERROR_VALUE : i;
+            }
+            datagrams[i].Length = static_cast<size_t>(rc);
+        }
+        return count;
+    }
+
+#endif
+
     int SocketGetHostName(char* name, int namelen) {
         return ::gethostname(name, namelen);
     }
@@ -70,6 +70,50 @@ namespace wwnet {
         return rc;
     }
 
+    bool SocketHasBatchIO() {
+        return false;
+    }
+
+    int SocketSendBatch(SocketHandle s, SocketDatagram* datagrams, int count) {
+        count = (count < SOCKET_BATCH_MAX) ? count : SOCKET_BATCH_MAX;
+        for (int i = 0; i < count; ++i) {
+            int rc = ::sendto(s, datagrams[i].Buffer, static_cast<int>(datagrams[i].Length), 0,
+                (const struct sockaddr*)&datagrams[i].Address, static_cast<int>(sizeof(datagrams[i].Address)));
+            if (rc == SOCKET_ERROR) {
+                return (i == 0) ? SOCKET_ERROR_VALUE : i;
+            }
+        }
+        return count;
+    }
+
+    int SocketRecvBatch(SocketHandle s, SocketDatagram* datagrams, int count) {
+        count = (count < SOCKET_BATCH_MAX) ? count : SOCKET_BATCH_MAX;
+        for (int i = 0; i < count; ++i) {
+            // recvfrom waits for data on a blocking socket, only call it
+            // when a datagram is already queued.
+            u_long pending = 0;
+            if (::ioctlsocket(s, FIONREAD, &pending) == SOCKET_ERROR) {
+                return (i == 0) ? SOCKET_ERROR_VALUE : i;
+            }
+            if (pending == 0) {
+                if (i == 0) {
+                    ::WSASetLastError(WSAEWOULDBLOCK);
+                    return SOCKET_ERROR_VALUE;
+                }
+                return i;
+            }
+
+            int address_size = static_cast<int>(sizeof(datagrams[i].Address));
+            int rc = ::recvfrom(s, datagrams[i].Buffer, static_cast<int>(datagrams[i].Length), 0,
+                (struct sockaddr*)&datagrams[i].Address, &address_size);
+            if (rc == SOCKET_ERROR) {
+                return (i == 0) ? SOCKET_ERROR_VALUE : i;
+            }
+            datagrams[i].Length = static_cast<size_t>(rc);
+        }
+        return count;
+    }
+
     int SocketGetHostName(char* name, int namelen) {
         return ::gethostname(name, namelen);
     }
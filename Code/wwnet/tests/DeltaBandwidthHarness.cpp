@@ -0,0 +1,299 @@
+#include "networkobject.h"
+#include "networkobjectdelta.h"
+#include "wwpacket.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using RecordedUpdate = NetworkObjectDeltaClass::RecordedUpdateStruct;
+
+constexpr int ClientId = 1;
+constexpr uint32_t AckIntervalMs = 100;
+constexpr uint32_t RoundTripMs = 120;
+
+// Synthetic session: a 32 player match sampled at 15 Hz for a minute.
+constexpr int SyntheticObjectCount = 32;
+constexpr int SyntheticFrameCount = 15 * 60;
+constexpr uint32_t SyntheticFrameMs = 1000 / 15;
+
+//
+// Stands in for the client's copy of an object. Import_Frequent reads back
+// the number of bits the server exported so the result can be compared.
+//
+class ReplayObject : public NetworkObjectClass
+{
+public:
+    uint32 Get_Network_Class_ID() const override { return 0x7e59; }
+    void Delete() override { delete this; }
+
+    void Import_Frequent(BitStreamClass &packet) override
+    {
+        Received.assign((ExpectedBits + 7) / 8, 0);
+        for (uint32_t bit = 0; bit < ExpectedBits; bit += 8) {
+            uint32_t count = (ExpectedBits - bit < 8) ? ExpectedBits - bit : 8;
+            uint32_t value = 0;
+            packet.Get_Bits(value, count);
+            Received[bit / 8] = static_cast<uint8_t>(value << (8 - count));
+        }
+    }
+
+    uint32_t ExpectedBits = 0;
+    std::vector<uint8_t> Received;
+};
+
+uint32_t Next_Random(uint32_t &state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+//
+// Soldiers and vehicles: quantized position, facing, velocity and a few
+// state bits. Some stand still, some run, some turn, like a real match.
+//
+void Generate_Session(std::vector<RecordedUpdate> &session)
+{
+    struct Player
+    {
+        int32_t X, Y, Z;
+        int32_t VelX, VelY;
+        uint32_t Facing;
+        uint32_t State;
+    };
+
+    uint32_t seed = 4242;
+    std::vector<Player> players(SyntheticObjectCount);
+    for (Player &player : players) {
+        player = Player{static_cast<int32_t>(Next_Random(seed) % 200000), static_cast<int32_t>(Next_Random(seed) % 200000),
+            static_cast<int32_t>(Next_Random(seed) % 4000), 0, 0, Next_Random(seed) & 0xff, 0};
+    }
+
+    for (int frame = 0; frame < SyntheticFrameCount; ++frame) {
+        for (int index = 0; index < SyntheticObjectCount; ++index) {
+            Player &player = players[index];
+
+            uint32_t roll = Next_Random(seed) % 100;
+            if (roll < 3) {
+                player.VelX = static_cast<int32_t>(Next_Random(seed) % 61) - 30;
+                player.VelY = static_cast<int32_t>(Next_Random(seed) % 61) - 30;
+            } else if (roll < 6) {
+                player.VelX = player.VelY = 0;
+            }
+            if (roll % 4 == 0) {
+                player.Facing = (player.Facing + (Next_Random(seed) % 9) - 4) & 0xff;
+            }
+            if (roll == 99) {
+                player.State ^= 1u << (Next_Random(seed) % 6);
+            }
+            player.X += player.VelX;
+            player.Y += player.VelY;
+
+            cPacket tier;
+            tier.Add_Bits(static_cast<uint32_t>(player.X) & 0x3ffff, 18);
+            tier.Add_Bits(static_cast<uint32_t>(player.Y) & 0x3ffff, 18);
+            tier.Add_Bits(static_cast<uint32_t>(player.Z) & 0xfff, 12);
+            tier.Add_Bits(player.Facing, 8);
+            tier.Add_Bits(static_cast<uint32_t>(player.VelX) & 0xff, 8);
+            tier.Add_Bits(static_cast<uint32_t>(player.VelY) & 0xff, 8);
+            tier.Add_Bits(0, 8);
+            tier.Add_Bits(player.State, 6);
+            if (index % 4 == 0) {
+                // Vehicles also send turret and barrel angles
+                tier.Add_Bits((frame / 8 + index) & 0xff, 8);
+                tier.Add_Bits(0x40, 8);
+            }
+
+            RecordedUpdate update;
+            update.Time = static_cast<uint32_t>(frame) * SyntheticFrameMs;
+            update.ObjectID = 1500 + index;
+            update.NumBits = static_cast<uint16_t>(tier.Get_Bit_Write_Position());
+            memcpy(update.Data, tier.Peek_Data(), (update.NumBits + 7) / 8);
+            session.push_back(update);
+        }
+    }
+}
+
+bool Load_Session(FILE *file, std::vector<RecordedUpdate> &session)
+{
+    if (!NetworkObjectDeltaClass::Read_Recording_Header(file)) {
+        return false;
+    }
+
+    RecordedUpdate update;
+    while (NetworkObjectDeltaClass::Read_Recorded_Update(file, update)) {
+        session.push_back(update);
+    }
+    return !session.empty();
+}
+
+//
+// Writes the synthetic session out and reads it back, so the recording
+// format is covered even when no recorded session is passed in.
+//
+bool Round_Trip_Session(std::vector<RecordedUpdate> &session)
+{
+    FILE *file = tmpfile();
+    if (file == nullptr) {
+        return true;
+    }
+
+    bool ok = NetworkObjectDeltaClass::Write_Recording_Header(file);
+    for (const RecordedUpdate &update : session) {
+        ok = ok && NetworkObjectDeltaClass::Write_Recorded_Update(file, update);
+    }
+    rewind(file);
+
+    std::vector<RecordedUpdate> loaded;
+    ok = ok && Load_Session(file, loaded) && loaded.size() == session.size();
+    for (size_t index = 0; ok && index < loaded.size(); ++index) {
+        ok = loaded[index].Time == session[index].Time && loaded[index].ObjectID == session[index].ObjectID
+            && loaded[index].NumBits == session[index].NumBits
+            && memcmp(loaded[index].Data, session[index].Data, (loaded[index].NumBits + 7) / 8) == 0;
+    }
+    fclose(file);
+
+    if (!ok) {
+        std::cerr << "Recorded session does not round trip.\n";
+    }
+    return ok;
+}
+
+struct ReplayResult
+{
+    uint64_t FullBits = 0;
+    uint64_t SentBits = 0;
+    NetworkObjectDeltaClass::StatsStruct Stats{};
+};
+
+struct AckPacket
+{
+    uint32_t DeliverTime;
+    std::unique_ptr<cPacket> Packet;
+};
+
+//
+// Plays the session through the server coder and the client decoder. Update
+// packets and ack packets are dropped at the given rate, acks are batched
+// and arrive a round trip later.
+//
+bool Replay(const std::vector<RecordedUpdate> &session, int loss_percent, ReplayResult &result)
+{
+    NetworkObjectDeltaClass::Reset();
+    NetworkObjectDeltaClass::Reset_Stats();
+
+    std::map<int, std::unique_ptr<ReplayObject>> objects;
+    std::deque<AckPacket> acks;
+    uint32_t seed = 777 + loss_percent;
+    uint32_t last_ack_time = session.front().Time;
+
+    for (const RecordedUpdate &update : session) {
+        uint32_t now = update.Time;
+
+        while (!acks.empty() && acks.front().DeliverTime <= now) {
+            NetworkObjectDeltaClass::Import_Acks(*acks.front().Packet, ClientId);
+            acks.pop_front();
+        }
+
+        std::unique_ptr<ReplayObject> &object = objects[update.ObjectID];
+        if (object == nullptr) {
+            object = std::make_unique<ReplayObject>();
+            object->Set_Network_ID(update.ObjectID);
+        }
+
+        cPacket packet;
+        NetworkObjectDeltaClass::Write_Frequent(packet, ClientId, update.ObjectID, update.Data, 0, update.NumBits);
+        result.FullBits += update.NumBits;
+        result.SentBits += packet.Get_Bit_Write_Position();
+
+        if (static_cast<int>(Next_Random(seed) % 100) >= loss_percent) {
+            object->ExpectedBits = update.NumBits;
+            object->Received.clear();
+            NetworkObjectDeltaClass::Read_Frequent(packet, object.get());
+
+            if (!packet.Is_Flushed() || object->Received.size() != (update.NumBits + 7u) / 8u
+                || memcmp(object->Received.data(), update.Data, object->Received.size()) != 0) {
+                std::cerr << "Object " << update.ObjectID << " decoded wrong at " << now << " ms with " << loss_percent
+                          << "% loss.\n";
+                return false;
+            }
+        }
+
+        if (now - last_ack_time >= AckIntervalMs) {
+            last_ack_time = now;
+            while (NetworkObjectDeltaClass::Has_Pending_Acks()) {
+                AckPacket ack{now + RoundTripMs, std::make_unique<cPacket>()};
+                NetworkObjectDeltaClass::Export_Acks(*ack.Packet);
+                if (static_cast<int>(Next_Random(seed) % 100) >= loss_percent) {
+                    acks.push_back(std::move(ack));
+                }
+            }
+        }
+    }
+
+    NetworkObjectDeltaClass::Get_Stats(result.Stats);
+    if (result.Stats.Undecodable != 0) {
+        std::cerr << result.Stats.Undecodable << " deltas had no baseline on the client with " << loss_percent
+                  << "% loss.\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::vector<RecordedUpdate> session;
+    bool is_synthetic = (argc < 2);
+
+    if (is_synthetic) {
+        Generate_Session(session);
+        if (!Round_Trip_Session(session)) {
+            return 1;
+        }
+    } else {
+        FILE *file = fopen(argv[1], "rb");
+        if (file == nullptr || !Load_Session(file, session)) {
+            std::cerr << "Could not read a recorded session from " << argv[1] << ".\n";
+            return 1;
+        }
+        fclose(file);
+    }
+
+    double seconds = (session.back().Time - session.front().Time) / 1000.0;
+    if (seconds <= 0.0) {
+        seconds = 1.0;
+    }
+
+    std::cout << (is_synthetic ? "Synthetic session" : argv[1]) << ": " << session.size() << " frequent updates over "
+              << seconds << " s\n";
+
+    const int loss_rates[] = {0, 5, 20};
+    for (int loss_percent : loss_rates) {
+        ReplayResult result;
+        if (!Replay(session, loss_percent, result)) {
+            return 1;
+        }
+
+        double full_rate = result.FullBits / 8.0 / seconds;
+        double delta_rate = result.SentBits / 8.0 / seconds;
+        std::cout << loss_percent << "% loss: full " << full_rate << " B/s/player, delta " << delta_rate
+                  << " B/s/player (" << 100.0 * (1.0 - delta_rate / full_rate) << "% saved), "
+                  << result.Stats.DeltaUpdates << " delta / " << result.Stats.FullUpdates << " full\n";
+
+        if (is_synthetic && loss_percent == 0 && result.SentBits >= result.FullBits) {
+            std::cerr << "Delta coding did not save anything on the synthetic session.\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
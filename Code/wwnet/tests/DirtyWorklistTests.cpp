@@ -0,0 +1,188 @@
+#include "networkobject.h"
+#include "networkobjectmgr.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr int ObjectCount = 5000;
+constexpr int MovingObjectCount = 100;
+constexpr int ClientCount = 32;
+constexpr int FrameCount = 500;
+constexpr int ChangesPerFrame = 150;
+constexpr int ChurnPerFrame = 10;
+
+class TestNetworkObject : public NetworkObjectClass
+{
+public:
+    uint32 Get_Network_Class_ID() const override { return 0x7e5a; }
+    void Delete() override { delete this; }
+};
+
+// Small deterministic generator so runs are comparable.
+uint32_t Next_Random(uint32_t &state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// What the senders used to do: ask every object.
+void Scan_Dirty_Objects(int client_id, std::vector<int> &indices)
+{
+    indices.clear();
+    for (int index = 0; index < NetworkObjectMgrClass::Get_Object_Count(); ++index) {
+        if (NetworkObjectMgrClass::Get_Object(index)->Get_Object_Dirty_Bits(client_id) != 0) {
+            indices.push_back(index);
+        }
+    }
+}
+
+bool Same_Lists(const DynamicVectorClass<int> &worklist, const std::vector<int> &scan)
+{
+    if (worklist.Count() != static_cast<int>(scan.size())) {
+        return false;
+    }
+    for (int index = 0; index < worklist.Count(); ++index) {
+        if (worklist[index] != scan[index]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//
+// A mix of everything that touches dirty bits: single bits for one or all
+// clients, whole masks, sends that clear them and full clears.
+//
+void Change_Dirty_Bits(NetworkObjectClass *object, uint32_t &seed)
+{
+    static const NetworkObjectClass::DIRTY_BIT bits[] = {NetworkObjectClass::BIT_FREQUENT,
+        NetworkObjectClass::BIT_OCCASIONAL, NetworkObjectClass::BIT_RARE, NetworkObjectClass::BIT_CREATION};
+
+    int client_id = static_cast<int>(Next_Random(seed) % ClientCount);
+    NetworkObjectClass::DIRTY_BIT bit = bits[Next_Random(seed) % 4];
+
+    switch (Next_Random(seed) % 6) {
+        case 0:
+            object->Set_Object_Dirty_Bit(client_id, bit, true);
+            break;
+        case 1:
+            object->Set_Object_Dirty_Bit(client_id, bit, false);
+            break;
+        case 2:
+            object->Set_Object_Dirty_Bit(bit, (Next_Random(seed) & 1) != 0);
+            break;
+        case 3:
+            object->Set_Object_Dirty_Bits(client_id, static_cast<BYTE>(Next_Random(seed) & 0x0f));
+            break;
+        case 4:
+            object->Set_Object_Dirty_Bits(client_id, 0);
+            break;
+        default:
+            object->Clear_Object_Dirty_Bits();
+            break;
+    }
+}
+
+} // namespace
+
+int main()
+{
+    using Clock = std::chrono::steady_clock;
+
+    NetworkObjectClass::Set_Is_Server(true);
+
+    std::vector<NetworkObjectClass *> live;
+    live.reserve(ObjectCount);
+    for (int index = 0; index < ObjectCount; ++index) {
+        live.push_back(new TestNetworkObject);
+    }
+
+    //
+    // Like players and vehicles, these always have a frequent update for
+    // everyone. The rest is static and only dirty now and then.
+    //
+    for (int index = 0; index < MovingObjectCount; ++index) {
+        live[index]->Set_Object_Dirty_Bit(NetworkObjectClass::BIT_FREQUENT, true);
+    }
+
+    uint32_t seed = 1234;
+    DynamicVectorClass<int> worklist;
+    std::vector<int> scan;
+    Clock::duration worklist_time{};
+    Clock::duration scan_time{};
+    int64_t dirty_total = 0;
+
+    for (int frame = 0; frame < FrameCount; ++frame) {
+        for (int change = 0; change < ChangesPerFrame; ++change) {
+            Change_Dirty_Bits(live[MovingObjectCount + Next_Random(seed) % (live.size() - MovingObjectCount)], seed);
+        }
+
+        //
+        // Dirty objects come and go too, the lists must not keep dead ones.
+        //
+        for (int churn = 0; churn < ChurnPerFrame; ++churn) {
+            size_t slot = MovingObjectCount + Next_Random(seed) % (live.size() - MovingObjectCount);
+            delete live[slot];
+            live[slot] = new TestNetworkObject;
+            live[slot]->Set_Object_Dirty_Bit(NetworkObjectClass::BIT_CREATION, true);
+        }
+
+        for (int client_id = 0; client_id < ClientCount; ++client_id) {
+            Clock::time_point start = Clock::now();
+            NetworkObjectMgrClass::Collect_Dirty_Objects(client_id, worklist);
+            worklist_time += Clock::now() - start;
+
+            start = Clock::now();
+            Scan_Dirty_Objects(client_id, scan);
+            scan_time += Clock::now() - start;
+
+            if (!Same_Lists(worklist, scan)) {
+                std::cerr << "Worklist of client " << client_id << " has " << worklist.Count()
+                          << " objects, a full scan finds " << scan.size() << " in frame " << frame << ".\n";
+                return 1;
+            }
+            dirty_total += worklist.Count();
+
+            //
+            // Sending clears the bits, the moving objects keep their
+            // frequent bit. They were registered first and never go
+            // away, so they keep the lowest indices.
+            //
+            for (int index = 0; index < worklist.Count(); ++index) {
+                bool is_moving = (worklist[index] < MovingObjectCount);
+                NetworkObjectMgrClass::Get_Object(worklist[index])
+                    ->Set_Object_Dirty_Bits(client_id, is_moving ? NetworkObjectClass::BIT_FREQUENT : 0);
+            }
+        }
+    }
+
+    //
+    // Clearing everything has to leave the lists empty.
+    //
+    for (NetworkObjectClass *object : live) {
+        object->Clear_Object_Dirty_Bits();
+    }
+    for (int client_id = 0; client_id < ClientCount; ++client_id) {
+        if (NetworkObjectMgrClass::Get_Dirty_Object_Count(client_id) != 0) {
+            std::cerr << "Client " << client_id << " still has " << NetworkObjectMgrClass::Get_Dirty_Object_Count(client_id)
+                      << " dirty objects after clearing.\n";
+            return 1;
+        }
+    }
+
+    double passes = static_cast<double>(FrameCount) * ClientCount;
+    std::cout << ObjectCount << " objects, " << dirty_total / passes << " dirty per client on average\n"
+              << "Full scan: " << std::chrono::duration<double, std::micro>(scan_time).count() / passes
+              << " us/client, worklist: " << std::chrono::duration<double, std::micro>(worklist_time).count() / passes
+              << " us/client\n";
+
+    for (NetworkObjectClass *object : live) {
+        delete object;
+    }
+
+    return 0;
+}
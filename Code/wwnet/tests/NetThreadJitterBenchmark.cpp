@@ -0,0 +1,271 @@
+#include "netthread.h"
+#include "socket_wrapper.h"
+#include "spscqueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int QueueItemCount = 1000000;
+constexpr int TickCount = 120;
+constexpr int TickMs = 16;
+constexpr int SpikeEvery = 10;
+constexpr int SpikeMs = 80;
+constexpr int SendIntervalMs = 2;
+
+struct Endpoint
+{
+    wwnet::SocketHandle Socket = wwnet::INVALID_SOCKET_VALUE;
+    sockaddr_in Address{};
+};
+
+bool Open_Endpoint(Endpoint &endpoint)
+{
+    endpoint.Socket = wwnet::SocketCreate(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (endpoint.Socket == wwnet::INVALID_SOCKET_VALUE) {
+        return false;
+    }
+
+    wwnet::SocketIoctlParam non_blocking = 1;
+    wwnet::SocketIoctl(endpoint.Socket, FIONBIO, &non_blocking);
+
+    endpoint.Address.sin_family = AF_INET;
+    endpoint.Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    endpoint.Address.sin_port = 0;
+    if (bind(endpoint.Socket, reinterpret_cast<sockaddr *>(&endpoint.Address), sizeof(endpoint.Address)) != 0) {
+        return false;
+    }
+
+    socklen_t length = sizeof(endpoint.Address);
+    return getsockname(endpoint.Socket, reinterpret_cast<sockaddr *>(&endpoint.Address), &length) == 0;
+}
+
+// Throws away whatever an earlier run left in the socket.
+void Drain(wwnet::SocketHandle socket)
+{
+    char buffer[64];
+    while (recv(socket, buffer, sizeof(buffer), 0) > 0) {
+    }
+}
+
+// Producer and consumer on separate threads must see every item, in order.
+bool Check_Queue_Order()
+{
+    static SpscQueueClass<uint32_t, 256> queue;
+
+    std::thread producer([] {
+        for (uint32_t value = 0; value < QueueItemCount; ++value) {
+            while (!queue.Push(value)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    bool ok = true;
+    while (expected < QueueItemCount) {
+        uint32_t value;
+        if (!queue.Pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (value != expected) {
+            ok = false;
+            break;
+        }
+        ++expected;
+    }
+
+    producer.join();
+    if (!ok) {
+        std::cerr << "Queue handed out item " << expected << " out of order.\n";
+    }
+    return ok && queue.Is_Empty();
+}
+
+//
+// Stands in for a cConnection: acks every datagram the moment it is read
+// and hands it to the game thread through the queue.
+//
+class EchoService : public NetworkThreadServiceClass
+{
+public:
+    explicit EchoService(wwnet::SocketHandle socket) : Socket(socket) {}
+
+    void Service_Network_Thread() override { Service(); }
+
+    void Service()
+    {
+        while (!Received.Is_Full()) {
+            uint32_t sequence;
+            sockaddr_in from{};
+            socklen_t from_length = sizeof(from);
+            int bytes = static_cast<int>(recvfrom(Socket, reinterpret_cast<char *>(&sequence), sizeof(sequence), 0,
+                reinterpret_cast<sockaddr *>(&from), &from_length));
+            if (bytes != sizeof(sequence)) {
+                break;
+            }
+            sendto(Socket, reinterpret_cast<const char *>(&sequence), sizeof(sequence), 0,
+                reinterpret_cast<sockaddr *>(&from), from_length);
+            Received.Push(sequence);
+        }
+    }
+
+    wwnet::SocketHandle Socket;
+    SpscQueueClass<uint32_t, 1024> Received;
+};
+
+struct RunResult
+{
+    int Sent = 0;
+    int Acked = 0;
+    double MeanAckMs = 0;
+    double MaxAckMs = 0;
+    NetworkThreadClass::ServiceStatsStruct Stats{};
+};
+
+//
+// A client sends a datagram every couple of ms and times the acks while the
+// game loop ticks, with a long frame every now and then.
+//
+bool Run(Endpoint &server, Endpoint &client, bool use_thread, RunResult &result)
+{
+    Drain(server.Socket);
+    Drain(client.Socket);
+
+    EchoService service(server.Socket);
+    NetworkThreadClass::Reset_Service_Stats();
+    NetworkThreadClass::Register_Service(&service);
+    if (use_thread) {
+        NetworkThreadClass::Start();
+    }
+
+    std::atomic<bool> done{false};
+    std::vector<Clock::time_point> send_times;
+    send_times.reserve(TickCount * (TickMs + SpikeMs) / SendIntervalMs);
+    double ack_sum_ms = 0;
+
+    std::thread sender([&] {
+        uint32_t next = 0;
+        uint32_t acked = 0;
+        while (!done.load()) {
+            send_times.push_back(Clock::now());
+            sendto(client.Socket, reinterpret_cast<const char *>(&next), sizeof(next), 0,
+                reinterpret_cast<sockaddr *>(&server.Address), sizeof(server.Address));
+            ++next;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(SendIntervalMs));
+
+            uint32_t sequence;
+            while (recv(client.Socket, reinterpret_cast<char *>(&sequence), sizeof(sequence), 0) == sizeof(sequence)
+                && sequence < send_times.size()) {
+                double ack_ms = std::chrono::duration<double, std::milli>(Clock::now() - send_times[sequence]).count();
+                ack_sum_ms += ack_ms;
+                result.MaxAckMs = std::max(result.MaxAckMs, ack_ms);
+                ++acked;
+            }
+        }
+        result.Sent = static_cast<int>(next);
+        result.Acked = static_cast<int>(acked);
+    });
+
+    uint32_t expected = 0;
+    bool ok = true;
+    for (int tick = 0; tick < TickCount; ++tick) {
+        {
+            NetworkThreadLockClass lock;
+            NetworkThreadClass::Note_Service();
+            if (!use_thread) {
+                service.Service();
+            }
+
+            uint32_t sequence;
+            while (service.Received.Pop(sequence)) {
+                ok = ok && (sequence == expected);
+                ++expected;
+            }
+        }
+
+        int frame_ms = (tick % SpikeEvery == SpikeEvery - 1) ? SpikeMs : TickMs;
+        std::this_thread::sleep_for(std::chrono::milliseconds(frame_ms));
+    }
+
+    done.store(true);
+    sender.join();
+
+    NetworkThreadClass::Stop();
+    NetworkThreadClass::Get_Service_Stats(use_thread ? NetworkThreadClass::MODE_NETWORK_THREAD
+                                                     : NetworkThreadClass::MODE_GAME_THREAD,
+        result.Stats);
+    NetworkThreadClass::Unregister_Service(&service);
+
+    if (result.Acked > 0) {
+        result.MeanAckMs = ack_sum_ms / result.Acked;
+    }
+
+    if (!ok) {
+        std::cerr << "Game thread got datagrams out of order" << (use_thread ? " from the network thread" : "") << ".\n";
+        return false;
+    }
+    if (result.Stats.Samples == 0 || result.Acked == 0) {
+        std::cerr << "Nothing was serviced" << (use_thread ? " by the network thread" : "") << ".\n";
+        return false;
+    }
+    return true;
+}
+
+void Print(const char *name, const RunResult &result)
+{
+    std::cout << name << ": " << result.Stats.Samples << " services, mean " << result.Stats.MeanMs << " ms, jitter "
+              << result.Stats.JitterMs << " ms, max " << result.Stats.MaxMs << " ms; acks " << result.Acked << "/"
+              << result.Sent << ", mean " << result.MeanAckMs << " ms, max " << result.MaxAckMs << " ms\n";
+}
+
+} // namespace
+
+int main()
+{
+    if (!Check_Queue_Order()) {
+        return 1;
+    }
+
+    wwnet::SocketStartup();
+
+    Endpoint server;
+    Endpoint client;
+    if (!Open_Endpoint(server) || !Open_Endpoint(client)) {
+        std::cerr << "Could not open the loopback sockets.\n";
+        return 1;
+    }
+
+    RunResult game_thread;
+    RunResult network_thread;
+    if (!Run(server, client, false, game_thread) || !Run(server, client, true, network_thread)) {
+        return 1;
+    }
+
+    Print("Game thread", game_thread);
+    Print("Network thread", network_thread);
+
+    //
+    // The whole point: a long frame must not hold the acks back any more.
+    //
+    if (network_thread.Stats.MaxMs >= game_thread.Stats.MaxMs) {
+        std::cerr << "The network thread did not service the sockets between frames.\n";
+        return 1;
+    }
+
+    wwnet::SocketClose(server.Socket);
+    wwnet::SocketClose(client.Socket);
+    wwnet::SocketCleanup();
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include "networkobject.h"
+#include "networkobjectmgr.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr int LiveObjectCount = 5000;
+constexpr int ChurnFrames = 2000;
+constexpr int ChurnPerFrame = 200;
+constexpr int LookupsPerFrame = 2000;
+
+class TestNetworkObject : public NetworkObjectClass
+{
+public:
+    uint32 Get_Network_Class_ID() const override { return 0x7e58; }
+    void Delete() override { delete this; }
+};
+
+// Small deterministic generator so runs are comparable.
+uint32_t Next_Random(uint32_t &state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+bool Verify(const std::unordered_map<int, NetworkObjectClass *> &expected)
+{
+    if (NetworkObjectMgrClass::Get_Object_Count() != static_cast<int>(expected.size())) {
+        std::cerr << "Object count is " << NetworkObjectMgrClass::Get_Object_Count() << ", expected "
+                  << expected.size() << ".\n";
+        return false;
+    }
+
+    for (int index = 0; index < NetworkObjectMgrClass::Get_Object_Count(); ++index) {
+        NetworkObjectClass *object = NetworkObjectMgrClass::Get_Object(index);
+        auto it = expected.find(object->Get_Network_ID());
+        if (it == expected.end() || it->second != object) {
+            std::cerr << "Enumerated object " << object->Get_Network_ID() << " is not registered.\n";
+            return false;
+        }
+        if (index > 0 && NetworkObjectMgrClass::Get_Object(index - 1)->Get_Network_ID() >= object->Get_Network_ID()) {
+            std::cerr << "Objects are not enumerated in network ID order at index " << index << ".\n";
+            return false;
+        }
+    }
+
+    for (const auto &pair : expected) {
+        if (NetworkObjectMgrClass::Find_Object(pair.first) != pair.second) {
+            std::cerr << "Lookup of object " << pair.first << " failed.\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    using Clock = std::chrono::steady_clock;
+
+    NetworkObjectClass::Set_Is_Server(true);
+
+    std::vector<NetworkObjectClass *> live;
+    std::unordered_map<int, NetworkObjectClass *> expected;
+    live.reserve(LiveObjectCount);
+
+    for (int index = 0; index < LiveObjectCount; ++index) {
+        NetworkObjectClass *object = new TestNetworkObject;
+        live.push_back(object);
+        expected[object->Get_Network_ID()] = object;
+    }
+
+    if (!Verify(expected)) {
+        return 1;
+    }
+
+    //
+    // Each frame destroys and creates a batch of objects at random positions
+    // in the live set, the way projectiles come and go during a firefight,
+    // walks the object list once the way the update pass does, then looks
+    // up a mix of live and dead IDs.
+    //
+    uint32_t seed = 12345;
+    int first_id = live.front()->Get_Network_ID();
+    int64_t found_count = 0;
+    int64_t id_sum = 0;
+    Clock::duration churn_time{};
+    Clock::duration enumerate_time{};
+    Clock::duration lookup_time{};
+
+    for (int frame = 0; frame < ChurnFrames; ++frame) {
+        Clock::time_point start = Clock::now();
+        for (int churn = 0; churn < ChurnPerFrame; ++churn) {
+            size_t victim = Next_Random(seed) % live.size();
+            delete live[victim];
+            live[victim] = new TestNetworkObject;
+        }
+        churn_time += Clock::now() - start;
+
+        start = Clock::now();
+        for (int index = 0; index < NetworkObjectMgrClass::Get_Object_Count(); ++index) {
+            id_sum += NetworkObjectMgrClass::Get_Object(index)->Get_Network_ID();
+        }
+        enumerate_time += Clock::now() - start;
+
+        int last_id = NetworkObjectMgrClass::Get_Current_Dynamic_ID();
+        start = Clock::now();
+        for (int lookup = 0; lookup < LookupsPerFrame; ++lookup) {
+            int id = first_id + static_cast<int>(Next_Random(seed) % static_cast<uint32_t>(last_id - first_id));
+            if (NetworkObjectMgrClass::Find_Object(id) != nullptr) {
+                ++found_count;
+            }
+        }
+        lookup_time += Clock::now() - start;
+
+        if ((frame % 250) == 0) {
+            expected.clear();
+            for (NetworkObjectClass *object : live) {
+                expected[object->Get_Network_ID()] = object;
+            }
+            if (!Verify(expected)) {
+                std::cerr << "Failed after frame " << frame << ".\n";
+                return 1;
+            }
+        }
+    }
+
+    expected.clear();
+    for (NetworkObjectClass *object : live) {
+        expected[object->Get_Network_ID()] = object;
+    }
+    if (!Verify(expected)) {
+        return 1;
+    }
+
+    const double churn_ops = 2.0 * ChurnFrames * ChurnPerFrame;
+    const double lookup_ops = static_cast<double>(ChurnFrames) * LookupsPerFrame;
+    std::cout << "Live objects:       " << LiveObjectCount << "\n"
+              << "Register/unregister: "
+              << std::chrono::duration<double, std::nano>(churn_time).count() / churn_ops << " ns/op (incl. new/delete)\n"
+              << "Enumerate:          "
+              << std::chrono::duration<double, std::micro>(enumerate_time).count() / ChurnFrames << " us/frame (checksum "
+              << id_sum << ")\n"
+              << "Find_Object:        "
+              << std::chrono::duration<double, std::nano>(lookup_time).count() / lookup_ops << " ns/op ("
+              << found_count << " hits)\n";
+
+    for (NetworkObjectClass *object : live) {
+        delete object;
+    }
+
+    if (NetworkObjectMgrClass::Get_Object_Count() != 0) {
+        std::cerr << "Objects left registered after cleanup.\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include "packetmgr.h"
+#include "socket_wrapper.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr int ClientCount = 64;
+constexpr int RoundCount = 1000;
+constexpr int PacketsPerClient = 3;
+constexpr int SocketBufferSize = 4 * 1024 * 1024;
+
+struct Endpoint
+{
+    SOCKET Socket = INVALID_SOCKET;
+    sockaddr_in Address{};
+};
+
+struct PathResult
+{
+    double SendSeconds = 0.0;
+    double ReceiveSeconds = 0.0;
+    double CpuSeconds = 0.0;
+    int64_t PacketsSent = 0;
+    int64_t PacketsReceived = 0;
+};
+
+double Thread_Cpu_Seconds()
+{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+bool Open_Endpoint(Endpoint &endpoint)
+{
+    endpoint.Socket = wwnet::SocketCreate(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (endpoint.Socket == INVALID_SOCKET) {
+        return false;
+    }
+
+    wwnet::SocketIoctlParam non_blocking = 1;
+    wwnet::SocketIoctl(endpoint.Socket, FIONBIO, &non_blocking);
+
+    int size = SocketBufferSize;
+    wwnet::SocketSetSockOpt(endpoint.Socket, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char *>(&size), sizeof(size));
+    wwnet::SocketSetSockOpt(endpoint.Socket, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char *>(&size), sizeof(size));
+
+    endpoint.Address.sin_family = AF_INET;
+    endpoint.Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    endpoint.Address.sin_port = 0;
+    if (bind(endpoint.Socket, reinterpret_cast<sockaddr *>(&endpoint.Address), sizeof(endpoint.Address)) != 0) {
+        return false;
+    }
+
+    socklen_t length = sizeof(endpoint.Address);
+    return getsockname(endpoint.Socket, reinterpret_cast<sockaddr *>(&endpoint.Address), &length) == 0;
+}
+
+// Payloads differ in size per client so the packet manager has to combine
+// runs of different lengths, the same as real object updates.
+int Build_Payload(unsigned char *buffer, int round, int client, int index)
+{
+    int length = 40 + (client * 7 + index * 13) % 120;
+    uint32_t tag = static_cast<uint32_t>((round << 16) | (client << 4) | index);
+    memcpy(buffer, &tag, sizeof(tag));
+    for (int i = sizeof(tag); i < length; ++i) {
+        buffer[i] = static_cast<unsigned char>(tag * 31 + i);
+    }
+    return length;
+}
+
+bool Check_Payload(const unsigned char *buffer, int length)
+{
+    uint32_t tag;
+    if (length < static_cast<int>(sizeof(tag))) {
+        return false;
+    }
+    memcpy(&tag, buffer, sizeof(tag));
+
+    unsigned char expected[PACKET_MANAGER_MTU];
+    int expected_length = Build_Payload(expected, tag >> 16, (tag >> 4) & 0xfff, tag & 0xf);
+    return length == expected_length && memcmp(buffer, expected, length) == 0;
+}
+
+//
+// Runs the server side of a 64 client game over loopback: every round the
+// server sends a few packets to each client and then drains a few packets
+// from each client. Only the server's own work is timed.
+//
+bool Run_Path(bool batch_io, Endpoint &server, std::vector<Endpoint> &clients, PathResult &result)
+{
+    PacketManagerClass server_manager;
+    PacketManagerClass client_manager;
+    server_manager.Set_Is_Server(true);
+    client_manager.Set_Is_Server(true);
+    server_manager.Set_Flush_Frequency(0);
+    client_manager.Set_Flush_Frequency(0);
+    server_manager.Set_Batch_IO(batch_io);
+
+    if (server_manager.Get_Batch_IO() != batch_io) {
+        std::cerr << "Could not switch batched I/O " << (batch_io ? "on" : "off") << ".\n";
+        return false;
+    }
+
+    unsigned char payload[PACKET_MANAGER_MTU];
+    unsigned char receive_buffer[PACKET_MANAGER_MTU * 2];
+    unsigned char ip_address[4];
+    unsigned short port;
+
+    for (int round = 0; round < RoundCount; ++round) {
+
+        //
+        // Server -> clients
+        //
+        auto wall_start = std::chrono::steady_clock::now();
+        double cpu_start = Thread_Cpu_Seconds();
+        for (int client = 0; client < ClientCount; ++client) {
+            for (int index = 0; index < PacketsPerClient; ++index) {
+                int length = Build_Payload(payload, round, client, index);
+                server_manager.Take_Packet(payload, length, reinterpret_cast<unsigned char *>(&clients[client].Address.sin_addr.s_addr),
+                    clients[client].Address.sin_port, server.Socket);
+                ++result.PacketsSent;
+            }
+        }
+        server_manager.Flush(true);
+        result.CpuSeconds += Thread_Cpu_Seconds() - cpu_start;
+        result.SendSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+        for (int client = 0; client < ClientCount; ++client) {
+            int received = 0;
+            int bytes;
+            while ((bytes = client_manager.Get_Packet(clients[client].Socket, receive_buffer, sizeof(receive_buffer), ip_address, port)) > 0) {
+                if (!Check_Payload(receive_buffer, bytes)) {
+                    std::cerr << "Client " << client << " received a corrupt packet in round " << round << ".\n";
+                    return false;
+                }
+                ++received;
+            }
+            if (received != PacketsPerClient) {
+                std::cerr << "Client " << client << " received " << received << " packets in round " << round << ".\n";
+                return false;
+            }
+        }
+
+        //
+        // Clients -> server
+        //
+        for (int client = 0; client < ClientCount; ++client) {
+            for (int index = 0; index < PacketsPerClient; ++index) {
+                int length = Build_Payload(payload, round, client, index);
+                client_manager.Take_Packet(payload, length, reinterpret_cast<unsigned char *>(&server.Address.sin_addr.s_addr),
+                    server.Address.sin_port, clients[client].Socket);
+            }
+        }
+        client_manager.Flush(true);
+
+        wall_start = std::chrono::steady_clock::now();
+        cpu_start = Thread_Cpu_Seconds();
+        int bytes;
+        while ((bytes = server_manager.Get_Packet(server.Socket, receive_buffer, sizeof(receive_buffer), ip_address, port)) > 0) {
+            if (!Check_Payload(receive_buffer, bytes)) {
+                std::cerr << "Server received a corrupt packet in round " << round << ".\n";
+                return false;
+            }
+            ++result.PacketsReceived;
+        }
+        result.CpuSeconds += Thread_Cpu_Seconds() - cpu_start;
+        result.ReceiveSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    }
+
+    if (result.PacketsReceived != result.PacketsSent) {
+        std::cerr << "Server received " << result.PacketsReceived << " of " << result.PacketsSent << " packets.\n";
+        return false;
+    }
+
+    return true;
+}
+
+void Print_Result(const char *name, const PathResult &result)
+{
+    std::cout << name << ": send " << result.PacketsSent / result.SendSeconds << " packets/s, receive "
+              << result.PacketsReceived / result.ReceiveSeconds << " packets/s, server CPU " << result.CpuSeconds * 1000.0
+              << " ms\n";
+}
+
+} // namespace
+
+int main()
+{
+    wwnet::SocketStartup();
+
+    Endpoint server;
+    std::vector<Endpoint> clients(ClientCount);
+    if (!Open_Endpoint(server)) {
+        std::cerr << "Could not open the server socket.\n";
+        return 1;
+    }
+    for (Endpoint &client : clients) {
+        if (!Open_Endpoint(client)) {
+            std::cerr << "Could not open a client socket.\n";
+            return 1;
+        }
+    }
+
+    PathResult single;
+    if (!Run_Path(false, server, clients, single)) {
+        return 1;
+    }
+    Print_Result("sendto/recvfrom ", single);
+
+    if (wwnet::SocketHasBatchIO()) {
+        PathResult batched;
+        if (!Run_Path(true, server, clients, batched)) {
+            return 1;
+        }
+        Print_Result("sendmmsg/recvmmsg", batched);
+    } else {
+        std::cout << "Batched socket I/O is not available on this platform.\n";
+    }
+
+    wwnet::SocketClose(server.Socket);
+    for (Endpoint &client : clients) {
+        wwnet::SocketClose(client.Socket);
+    }
+    wwnet::SocketCleanup();
+    return 0;
+}
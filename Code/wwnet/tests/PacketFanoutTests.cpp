@@ -0,0 +1,110 @@
+#include "packettype.h"
+#include "wwpacket.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr int ClientCount = 64;
+constexpr int FrameCount = 2000;
+
+// Fills a packet the size of a typical world update.
+void Build_Update(cPacket &packet, int frame)
+{
+    packet.Set_Type(PACKETTYPE_UNRELIABLE);
+    packet.Set_Id(frame);
+    uint32_t value = static_cast<uint32_t>(frame) * 2654435761u;
+    for (int index = 0; index < 60; ++index) {
+        value = value * 1103515245u + 12345u;
+        packet.Add(static_cast<int>(value));
+        packet.Add_Bits(value >> 7, 1 + (value % 13));
+    }
+}
+
+bool Same_Payload(cPacket &a, cPacket &b)
+{
+    return a.Get_Bit_Length() == b.Get_Bit_Length()
+        && memcmp(a.Peek_Data(), b.Peek_Data(), a.Get_Compressed_Size_Bytes()) == 0;
+}
+
+} // namespace
+
+int main()
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<cPacket *> queues(ClientCount, nullptr);
+    cPacket::Reset_Buffer_Stats();
+
+    //
+    // Each frame one update is fanned out to every client's send queue the
+    // way cRemoteHost::Add_Packet does, then wrapped for the wire.
+    //
+    Clock::duration fanout_time{};
+    for (int frame = 0; frame < FrameCount; ++frame) {
+        cPacket update;
+        Build_Update(update, frame);
+
+        Clock::time_point start = Clock::now();
+        for (int client = 0; client < ClientCount; ++client) {
+            delete queues[client];
+            queues[client] = new cPacket;
+            *queues[client] = update;
+        }
+        fanout_time += Clock::now() - start;
+
+        for (int client = 0; client < ClientCount; ++client) {
+            if (!Same_Payload(*queues[client], update)) {
+                std::cerr << "Queued copy for client " << client << " differs in frame " << frame << ".\n";
+                return 1;
+            }
+        }
+
+        cPacket full_packet;
+        cPacket::Construct_Full_Packet(full_packet, *queues[frame % ClientCount]);
+        cPacket received;
+        cPacket::Construct_App_Packet(received, full_packet);
+        if (!Same_Payload(received, update)) {
+            std::cerr << "Wrapped packet does not round trip in frame " << frame << ".\n";
+            return 1;
+        }
+    }
+
+    BitPackerBufferStatsStruct stats;
+    cPacket::Get_Buffer_Stats(stats);
+    if (stats.Copies != 0) {
+        std::cerr << "Fanning out read only packets made " << stats.Copies << " payload copies.\n";
+        return 1;
+    }
+
+    //
+    // Writing to one shared copy must leave the others alone.
+    //
+    cPacket original;
+    original = *queues[0];
+    int before = original.Get_Bit_Length();
+    queues[0]->Add(0x7fffffff);
+
+    cPacket::Get_Buffer_Stats(stats);
+    if (stats.Copies != 1 || !Same_Payload(original, *queues[1]) || (int)original.Get_Bit_Length() != before) {
+        std::cerr << "Copy on write did not separate the shared payload.\n";
+        return 1;
+    }
+
+    std::cout << "Fan out to " << ClientCount << " clients: "
+              << std::chrono::duration<double, std::nano>(fanout_time).count() / (static_cast<double>(FrameCount) * ClientCount)
+              << " ns/packet\n"
+              << "Buffers: " << stats.Allocations << " allocated, " << stats.Reuses << " reused, " << stats.Shares
+              << " shared, " << stats.Copies << " copied, " << stats.Grows << " grown, " << stats.BytesCopied
+              << " bytes copied\n";
+
+    for (cPacket *packet : queues) {
+        delete packet;
+    }
+
+    return 0;
+}
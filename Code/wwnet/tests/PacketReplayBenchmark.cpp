@@ -0,0 +1,235 @@
+#include "packetmgr.h"
+#include "socket_wrapper.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr int ClientCount = 32;
+constexpr int RoundCount = 300;
+constexpr int PacketsPerClient = 4;
+constexpr int SocketBufferSize = 4 * 1024 * 1024;
+constexpr unsigned int BurstMs = 10;
+const char *CaptureFileName = "wwnet_packet_replay_benchmark.cap";
+
+struct Endpoint
+{
+    SOCKET Socket = INVALID_SOCKET;
+    sockaddr_in Address{};
+};
+
+bool Open_Endpoint(Endpoint &endpoint)
+{
+    endpoint.Socket = wwnet::SocketCreate(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (endpoint.Socket == INVALID_SOCKET) {
+        return false;
+    }
+
+    wwnet::SocketIoctlParam non_blocking = 1;
+    wwnet::SocketIoctl(endpoint.Socket, FIONBIO, &non_blocking);
+
+    int size = SocketBufferSize;
+    wwnet::SocketSetSockOpt(endpoint.Socket, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char *>(&size), sizeof(size));
+
+    endpoint.Address.sin_family = AF_INET;
+    endpoint.Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    endpoint.Address.sin_port = 0;
+    if (bind(endpoint.Socket, reinterpret_cast<sockaddr *>(&endpoint.Address), sizeof(endpoint.Address)) != 0) {
+        return false;
+    }
+
+    socklen_t length = sizeof(endpoint.Address);
+    return getsockname(endpoint.Socket, reinterpret_cast<sockaddr *>(&endpoint.Address), &length) == 0;
+}
+
+// Sizes vary per client and round so the packet manager both deltas and
+// combines, like real object updates.
+int Build_Payload(unsigned char *buffer, int round, int client, int index)
+{
+    int length = 24 + (client * 11 + index * 17 + (round & 3) * 5) % 140;
+    uint32_t tag = static_cast<uint32_t>((round << 16) | (client << 4) | index);
+    memcpy(buffer, &tag, sizeof(tag));
+    for (int i = sizeof(tag); i < length; ++i) {
+        buffer[i] = static_cast<unsigned char>(tag * 31 + (i / 8));
+    }
+    return length;
+}
+
+struct ReceivedPacket
+{
+    uint32_t Tag;
+    int Length;
+    unsigned short Port;
+};
+
+//
+// Drains everything the manager has for the socket. Returns false if a
+// packet came out corrupt.
+//
+bool Drain(PacketManagerClass &manager, SOCKET socket, std::vector<ReceivedPacket> &received)
+{
+    unsigned char buffer[PACKET_MANAGER_MTU * 2];
+    unsigned char expected[PACKET_MANAGER_MTU];
+    unsigned char ip_address[4];
+    unsigned short port = 0;
+    int bytes;
+
+    while ((bytes = manager.Get_Packet(socket, buffer, sizeof(buffer), ip_address, port)) > 0) {
+        uint32_t tag = 0;
+        memcpy(&tag, buffer, sizeof(tag));
+        int expected_length = Build_Payload(expected, tag >> 16, (tag >> 4) & 0xfff, tag & 0xf);
+        if (bytes != expected_length || memcmp(buffer, expected, bytes) != 0) {
+            return false;
+        }
+        received.push_back(ReceivedPacket{tag, bytes, port});
+    }
+    return true;
+}
+
+bool Same_Packets(const std::vector<ReceivedPacket> &a, const std::vector<ReceivedPacket> &b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t index = 0; index < a.size(); ++index) {
+        if (a[index].Tag != b[index].Tag || a[index].Length != b[index].Length || a[index].Port != b[index].Port) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    using Clock = std::chrono::steady_clock;
+
+    wwnet::SocketStartup();
+
+    Endpoint server;
+    std::vector<Endpoint> clients(ClientCount);
+    if (!Open_Endpoint(server)) {
+        std::cerr << "Could not open the server socket.\n";
+        return 1;
+    }
+    for (Endpoint &client : clients) {
+        if (!Open_Endpoint(client)) {
+            std::cerr << "Could not open a client socket.\n";
+            return 1;
+        }
+    }
+
+    //
+    // Live session over loopback with the server capturing.
+    //
+    std::vector<ReceivedPacket> live;
+    Clock::duration live_time{};
+    {
+        PacketManagerClass server_manager;
+        PacketManagerClass client_manager;
+        server_manager.Set_Is_Server(true);
+        client_manager.Set_Is_Server(true);
+        client_manager.Set_Flush_Frequency(0);
+
+        if (!server_manager.Start_Capture(CaptureFileName)) {
+            std::cerr << "Could not create " << CaptureFileName << ".\n";
+            return 1;
+        }
+
+        unsigned char payload[PACKET_MANAGER_MTU];
+        for (int round = 0; round < RoundCount; ++round) {
+            for (int client = 0; client < ClientCount; ++client) {
+                for (int index = 0; index < PacketsPerClient; ++index) {
+                    int length = Build_Payload(payload, round, client, index);
+                    client_manager.Take_Packet(payload, length, reinterpret_cast<unsigned char *>(&server.Address.sin_addr.s_addr),
+                        server.Address.sin_port, clients[client].Socket);
+                }
+            }
+            client_manager.Flush(true);
+
+            Clock::time_point start = Clock::now();
+            if (!Drain(server_manager, server.Socket, live)) {
+                std::cerr << "Server received a corrupt packet in round " << round << ".\n";
+                return 1;
+            }
+            live_time += Clock::now() - start;
+        }
+
+        server_manager.Stop_Capture();
+    }
+
+    if (live.size() != static_cast<size_t>(RoundCount) * ClientCount * PacketsPerClient) {
+        std::cerr << "Live session delivered " << live.size() << " packets.\n";
+        return 1;
+    }
+
+    //
+    // Replay the capture at full speed, once in one go and once in bursts.
+    // Either way the server must see exactly what it saw live.
+    //
+    std::vector<ReceivedPacket> replayed;
+    Clock::duration replay_time{};
+    int replay_datagrams = 0;
+    {
+        PacketManagerClass replay_manager;
+        replay_manager.Set_Is_Server(true);
+        if (!replay_manager.Start_Replay(CaptureFileName)) {
+            std::cerr << "Could not open " << CaptureFileName << " for replay.\n";
+            return 1;
+        }
+
+        Clock::time_point start = Clock::now();
+        bool ok = Drain(replay_manager, server.Socket, replayed);
+        replay_time = Clock::now() - start;
+        replay_datagrams = replay_manager.Get_Replayed_Datagrams();
+
+        if (!ok || !replay_manager.Is_Replay_Done() || !Same_Packets(live, replayed)) {
+            std::cerr << "Replay delivered " << replayed.size() << " packets, the live session " << live.size() << ".\n";
+            return 1;
+        }
+    }
+
+    std::vector<ReceivedPacket> bursts;
+    int burst_count = 0;
+    {
+        PacketManagerClass replay_manager;
+        replay_manager.Set_Is_Server(true);
+        replay_manager.Start_Replay(CaptureFileName, BurstMs);
+
+        while (!replay_manager.Is_Replay_Done()) {
+            if (!Drain(replay_manager, server.Socket, bursts)) {
+                std::cerr << "Burst replay delivered a corrupt packet.\n";
+                return 1;
+            }
+            ++burst_count;
+        }
+
+        if (!Same_Packets(live, bursts)) {
+            std::cerr << "Burst replay delivered " << bursts.size() << " packets, the live session " << live.size() << ".\n";
+            return 1;
+        }
+    }
+
+    remove(CaptureFileName);
+
+    double live_seconds = std::chrono::duration<double>(live_time).count();
+    double replay_seconds = std::chrono::duration<double>(replay_time).count();
+    std::cout << "Captured " << replay_datagrams << " datagrams carrying " << live.size() << " packets\n"
+              << "Live receive: " << live.size() / live_seconds << " packets/s\n"
+              << "Replay: " << replayed.size() / replay_seconds << " packets/s, " << replay_datagrams / replay_seconds
+              << " datagrams/s\n"
+              << "Burst replay (" << BurstMs << " ms): " << burst_count << " bursts\n";
+
+    wwnet::SocketClose(server.Socket);
+    for (Endpoint &client : clients) {
+        wwnet::SocketClose(client.Socket);
+    }
+    wwnet::SocketCleanup();
+    return 0;
+}
@@ -0,0 +1,463 @@
+#include "jobpool.h"
+#include "networkobject.h"
+#include "networkobjectdelta.h"
+#include "networkobjectfactory.h"
+#include "networkobjectfactorymgr.h"
+#include "networkobjectmgr.h"
+#include "networkobjectsnapshot.h"
+#include "connect.h"
+#include "wwpacket.h"
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr int TestClassId = 0x7e57;
+constexpr int ObjectCount = 600;
+constexpr int ClientCount = 24;
+constexpr int WireRounds = 8;
+
+//
+// Exports a deterministic mix of field widths so tiers end up at every
+// possible bit alignment inside the packet.
+//
+class TestNetworkObject : public NetworkObjectClass
+{
+public:
+    TestNetworkObject() : Seed(0) {}
+
+    uint32 Get_Network_Class_ID() const override { return TestClassId; }
+    void Delete() override { delete this; }
+
+    void Export_Creation(BitStreamClass &packet) override { Export_Fields(packet, 1, 5); }
+    void Export_Rare(BitStreamClass &packet) override { Export_Fields(packet, 2, 3); }
+    void Export_Occasional(BitStreamClass &packet) override { Export_Fields(packet, 3, 2); }
+    void Export_Frequent(BitStreamClass &packet) override { Export_Fields(packet, 4, Seed % 7); }
+
+    uint32_t Seed;
+
+private:
+    void Export_Fields(BitStreamClass &packet, uint32_t salt, uint32_t count)
+    {
+        uint32_t value = Seed * 2654435761u + salt;
+        for (uint32_t index = 0; index < count; ++index) {
+            value = value * 1103515245u + 12345u;
+            packet.Add((value & 1) != 0);
+            packet.Add(static_cast<uint8_t>(value >> 8));
+            packet.Add_Bits(value >> 3, 1 + (value % 32));
+            packet.Add(static_cast<int>(value));
+        }
+    }
+};
+
+//
+// Writes some creation data of its own, like the game's factories do.
+//
+class TestNetworkObjectFactory : public NetworkObjectFactoryClass
+{
+public:
+    NetworkObjectClass *Create(cPacket &) const override { return new TestNetworkObject; }
+    uint32 Get_Class_ID() const override { return TestClassId; }
+
+    void Prep_Packet(NetworkObjectClass *object, cPacket &packet) const override
+    {
+        packet.Add(static_cast<TestNetworkObject *>(object)->Seed ^ 0x5a5a5a5au);
+        packet.Add_Bits(static_cast<uint32_t>(object->Get_Network_ID()), 13);
+    }
+};
+
+TestNetworkObjectFactory TestFactory;
+
+struct UpdateResult
+{
+    bool HasData = false;
+    int Mode = 0;
+    uint32_t Bits = 0;
+    std::vector<unsigned char> Bytes;
+    int TierBits[PACKET_TIER_COUNT] = {};
+};
+
+void Capture(const cPacket &packet, bool has_data, int mode, UpdateResult &result)
+{
+    result.HasData = has_data;
+    result.Mode = mode;
+    result.Bits = packet.Get_Bit_Write_Position();
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(packet.Peek_Data());
+    result.Bytes.assign(data, data + (result.Bits + 7) / 8);
+}
+
+//
+// Reference path: export straight into the packet the way
+// cNetwork::Send_Object_Update does, delta coding the frequent
+// tier when NetworkObjectDeltaClass is enabled and a client is given.
+//
+void Build_Direct(NetworkObjectClass *object, int client_id, UpdateResult &result)
+{
+    cPacket frequent;
+    bool is_frequent_exported = false;
+    bool is_delta = false;
+    if (client_id > 0) {
+        if (object->Get_Object_Dirty_Bit(client_id, NetworkObjectClass::BIT_CREATION)) {
+            NetworkObjectDeltaClass::Reset_Object(client_id, object->Get_Network_ID());
+        }
+        if (NetworkObjectDeltaClass::Is_Enabled() && object->Get_Object_Dirty_Bit(client_id, NetworkObjectClass::BIT_FREQUENT)) {
+            object->Export_Frequent(frequent);
+            is_frequent_exported = true;
+            is_delta = (frequent.Get_Bit_Write_Position() > 0);
+        }
+    }
+
+    BYTE dirty_bits = object->Get_Object_Dirty_Bits(client_id);
+    if (is_delta) {
+        dirty_bits |= NetworkObjectDeltaClass::DELTA_CODED_BIT;
+    }
+
+    cPacket packet;
+    packet.Add(object->Get_Network_ID());
+    packet.Add(dirty_bits);
+    packet.Add(object->Is_Delete_Pending());
+
+    int bits_start = packet.Get_Bit_Write_Position();
+    int mode = object->Is_Delete_Pending() ? SEND_RELIABLE : SEND_UNRELIABLE;
+    int bits_before = 0;
+
+    if (object->Get_Object_Dirty_Bit(client_id, NetworkObjectClass::BIT_CREATION)) {
+        bits_before = packet.Get_Bit_Write_Position();
+        uint32 net_classid = object->Get_Network_Class_ID();
+        packet.Add(net_classid);
+        NetworkObjectFactoryMgrClass::Find_Factory(net_classid)->Prep_Packet(object, packet);
+        object->Export_Creation(packet);
+        result.TierBits[PACKET_TIER_CREATION] = packet.Get_Bit_Write_Position() - bits_before;
+        mode = SEND_RELIABLE;
+    }
+    if (object->Get_Object_Dirty_Bit(client_id, NetworkObjectClass::BIT_RARE)) {
+        bits_before = packet.Get_Bit_Write_Position();
+        object->Export_Rare(packet);
+        result.TierBits[PACKET_TIER_RARE] = packet.Get_Bit_Write_Position() - bits_before;
+        mode = SEND_RELIABLE;
+    }
+    if (object->Get_Object_Dirty_Bit(client_id, NetworkObjectClass::BIT_OCCASIONAL)) {
+        bits_before = packet.Get_Bit_Write_Position();
+        object->Export_Occasional(packet);
+        result.TierBits[PACKET_TIER_OCCASIONAL] = packet.Get_Bit_Write_Position() - bits_before;
+        mode = SEND_RELIABLE;
+    }
+    if (object->Get_Object_Dirty_Bit(client_id, NetworkObjectClass::BIT_FREQUENT)) {
+        bits_before = packet.Get_Bit_Write_Position();
+        if (is_delta) {
+            NetworkObjectDeltaClass::Write_Frequent(packet, client_id, object->Get_Network_ID(),
+                reinterpret_cast<const uint8 *>(frequent.Peek_Data()), 0, frequent.Get_Bit_Write_Position());
+        } else if (!is_frequent_exported) {
+            object->Export_Frequent(packet);
+        }
+        result.TierBits[PACKET_TIER_FREQUENT] = packet.Get_Bit_Write_Position() - bits_before;
+    }
+    if (mode == SEND_RELIABLE && object->Get_Unreliable_Override()) {
+        mode = SEND_UNRELIABLE;
+    }
+
+    bool has_data = object->Is_Delete_Pending() || (int)packet.Get_Bit_Write_Position() > bits_start;
+    Capture(packet, has_data, mode, result);
+}
+
+bool Same(const UpdateResult &a, const UpdateResult &b)
+{
+    return a.HasData == b.HasData && a.Mode == b.Mode && a.Bits == b.Bits && a.Bytes == b.Bytes;
+}
+
+//
+// What a client receives, and the per tier stats the server records, over a
+// number of TCADO ticks.
+//
+struct WireStruct
+{
+    std::vector<unsigned char> Bytes;
+    long long TierBits[PACKET_TIER_COUNT] = {};
+};
+
+void Append_Sent(const UpdateResult &update, WireStruct &wire)
+{
+    for (int tier = 0; tier < PACKET_TIER_COUNT; ++tier) {
+        wire.TierBits[tier] += update.TierBits[tier];
+    }
+    if (update.HasData) {
+        wire.Bytes.push_back(static_cast<unsigned char>(update.Mode));
+        for (int shift = 0; shift < 32; shift += 8) {
+            wire.Bytes.push_back(static_cast<unsigned char>(update.Bits >> shift));
+        }
+        wire.Bytes.insert(wire.Bytes.end(), update.Bytes.begin(), update.Bytes.end());
+    }
+}
+
+//
+// Changes the frequent data of every other object between ticks without
+// changing its size, so delta coding has unchanged and changed tiers to work on.
+//
+void Set_Round_State(const std::vector<TestNetworkObject *> &objects, const BYTE *patterns, int pattern_count, int round)
+{
+    for (int index = 0; index < ObjectCount; ++index) {
+        TestNetworkObject *object = objects[index];
+        object->Seed = static_cast<uint32_t>(index * 7919 + 13) + 7u * static_cast<uint32_t>(round * (index & 1));
+        for (int client = 1; client <= ClientCount; ++client) {
+            object->Set_Object_Dirty_Bits(client, patterns[(index * 31 + client * 7 + round * 3) % pattern_count]);
+        }
+    }
+}
+
+//
+// The client acks every delta coded frequent tier it got, on every other tick.
+// Both runs get the same acks as long as they sent the same tiers.
+//
+void Send_Acks(const std::vector<TestNetworkObject *> &objects, std::vector<std::vector<int>> &sent_counts, int round)
+{
+    if (!NetworkObjectDeltaClass::Is_Enabled()) {
+        return;
+    }
+
+    for (int client = 0; client < ClientCount; ++client) {
+        std::vector<std::pair<int, int>> acks;
+        for (int index = 0; index < ObjectCount; ++index) {
+            TestNetworkObject *object = objects[index];
+            if (!object->Get_Object_Dirty_Bit(client + 1, NetworkObjectClass::BIT_FREQUENT) || (object->Seed % 7) == 0) {
+                continue;
+            }
+            int sequence = sent_counts[client][index]++;
+            if ((round & 1) == 0) {
+                acks.push_back(std::make_pair(object->Get_Network_ID(), sequence));
+            }
+        }
+
+        for (size_t first = 0; first < acks.size(); first += NetworkObjectDeltaClass::MAX_ACKS_PER_PACKET) {
+            size_t count = std::min(acks.size() - first, static_cast<size_t>(NetworkObjectDeltaClass::MAX_ACKS_PER_PACKET));
+            cPacket packet;
+            packet.Add(static_cast<BYTE>(count));
+            for (size_t ack = first; ack < first + count; ++ack) {
+                packet.Add(acks[ack].first);
+                packet.Add_Bits(static_cast<uint32_t>(acks[ack].second), NetworkObjectDeltaClass::SEQUENCE_BITS);
+            }
+            NetworkObjectDeltaClass::Import_Acks(packet, client + 1);
+        }
+    }
+}
+
+//
+// Serial TCADO: each client in turn, its dirty objects in order, exported
+// straight into the packets.
+//
+std::vector<WireStruct> Run_Serial_Wire(const std::vector<TestNetworkObject *> &objects, const BYTE *patterns, int pattern_count)
+{
+    NetworkObjectDeltaClass::Reset();
+    std::vector<WireStruct> wires(ClientCount);
+    std::vector<std::vector<int>> sent_counts(ClientCount, std::vector<int>(ObjectCount, 0));
+
+    for (int round = 0; round < WireRounds; ++round) {
+        Set_Round_State(objects, patterns, pattern_count, round);
+        for (int client = 0; client < ClientCount; ++client) {
+            for (int index = 0; index < ObjectCount; ++index) {
+                NetworkObjectClass *object = NetworkObjectMgrClass::Get_Object(index);
+                if (object->Get_Object_Dirty_Bits(client + 1) == 0) {
+                    continue;
+                }
+                UpdateResult update;
+                Build_Direct(object, client + 1, update);
+                Append_Sent(update, wires[client]);
+            }
+        }
+        Send_Acks(objects, sent_counts, round);
+    }
+
+    return wires;
+}
+
+//
+// Parallel TCADO: one snapshot per tick, every client's packets built on
+// the job pool, then sent in client order.
+//
+std::vector<WireStruct> Run_Parallel_Wire(const std::vector<TestNetworkObject *> &objects, const BYTE *patterns, int pattern_count, const int *client_ids)
+{
+    NetworkObjectDeltaClass::Reset();
+    std::vector<WireStruct> wires(ClientCount);
+    std::vector<std::vector<int>> sent_counts(ClientCount, std::vector<int>(ObjectCount, 0));
+    std::vector<std::vector<UpdateResult>> queued(ClientCount);
+    NetworkObjectSnapshotClass snapshot;
+
+    for (int round = 0; round < WireRounds; ++round) {
+        Set_Round_State(objects, patterns, pattern_count, round);
+        snapshot.Build(client_ids, ClientCount);
+
+        JobPoolClass::Run(ClientCount, [&](int client) {
+            queued[client].clear();
+            for (int index = 0; index < snapshot.Get_Object_Count(); ++index) {
+                BYTE dirty_bits = snapshot.Get_Object(index).Object->Get_Object_Dirty_Bits(client_ids[client]);
+                if (dirty_bits == 0) {
+                    continue;
+                }
+                UpdateResult update;
+                cPacket packet;
+                int mode = 0;
+                bool has_data = snapshot.Build_Update_Packet(index, dirty_bits, packet, mode, client_ids[client], update.TierBits);
+                Capture(packet, has_data, mode, update);
+                queued[client].push_back(update);
+            }
+        });
+
+        for (int client = 0; client < ClientCount; ++client) {
+            for (const UpdateResult &update : queued[client]) {
+                Append_Sent(update, wires[client]);
+            }
+        }
+        Send_Acks(objects, sent_counts, round);
+    }
+
+    snapshot.Reset();
+    return wires;
+}
+
+bool Compare_Wires(const std::vector<WireStruct> &serial, const std::vector<WireStruct> &parallel, const char *label)
+{
+    for (int client = 0; client < ClientCount; ++client) {
+        if (serial[client].Bytes != parallel[client].Bytes) {
+            std::cerr << label << ": parallel TCADO wire output differs from serial for client " << client + 1 << ".\n";
+            return false;
+        }
+        for (int tier = 0; tier < PACKET_TIER_COUNT; ++tier) {
+            if (serial[client].TierBits[tier] != parallel[client].TierBits[tier]) {
+                std::cerr << label << ": tier " << tier << " bits sent to client " << client + 1
+                          << " are " << parallel[client].TierBits[tier] << ", serial sent " << serial[client].TierBits[tier] << ".\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    static const BYTE dirty_patterns[] = {
+        0,
+        NetworkObjectClass::BIT_FREQUENT,
+        NetworkObjectClass::BIT_OCCASIONAL,
+        NetworkObjectClass::BIT_RARE,
+        NetworkObjectClass::BIT_CREATION,
+        0x04, // Partial bits never select a tier on their own
+    };
+    const int pattern_count = sizeof(dirty_patterns) / sizeof(dirty_patterns[0]);
+
+    NetworkObjectClass::Set_Is_Server(true);
+
+    std::vector<TestNetworkObject *> objects;
+    for (int index = 0; index < ObjectCount; ++index) {
+        TestNetworkObject *object = new TestNetworkObject;
+        object->Seed = static_cast<uint32_t>(index * 7919 + 13);
+        object->Set_Unreliable_Override((index % 11) == 0);
+        if ((index % 17) == 0) {
+            object->Set_Delete_Pending();
+        }
+        for (int client = 1; client <= ClientCount; ++client) {
+            object->Set_Object_Dirty_Bits(client, dirty_patterns[(index * 31 + client * 7) % pattern_count]);
+        }
+        objects.push_back(object);
+    }
+
+    if (NetworkObjectMgrClass::Get_Object_Count() != ObjectCount) {
+        std::cerr << "Test objects were not registered with the network object manager.\n";
+        return 1;
+    }
+
+    int client_ids[ClientCount];
+    for (int index = 0; index < ClientCount; ++index) {
+        client_ids[index] = index + 1;
+    }
+
+    //
+    // Serial reference output, per client, in object order.
+    //
+    std::vector<std::vector<UpdateResult>> expected(ClientCount, std::vector<UpdateResult>(ObjectCount));
+    for (int client = 0; client < ClientCount; ++client) {
+        for (int index = 0; index < ObjectCount; ++index) {
+            Build_Direct(NetworkObjectMgrClass::Get_Object(index), client_ids[client], expected[client][index]);
+        }
+    }
+
+    JobPoolClass::Init(4);
+
+    NetworkObjectSnapshotClass snapshot;
+    std::vector<std::vector<UpdateResult>> actual(ClientCount, std::vector<UpdateResult>(ObjectCount));
+
+    for (int round = 0; round < 3; ++round) {
+        snapshot.Build(client_ids, ClientCount);
+        if (snapshot.Get_Object_Count() != ObjectCount) {
+            std::cerr << "Snapshot object count does not match the manager.\n";
+            return 1;
+        }
+
+        JobPoolClass::Run(ClientCount, [&](int client) {
+            for (int index = 0; index < ObjectCount; ++index) {
+                const NetworkObjectSnapshotClass::ObjectStruct &entry = snapshot.Get_Object(index);
+                BYTE dirty_bits = entry.Object->Get_Object_Dirty_Bits(client_ids[client]);
+                cPacket packet;
+                int mode = 0;
+                bool has_data = snapshot.Build_Update_Packet(index, dirty_bits, packet, mode);
+                Capture(packet, has_data, mode, actual[client][index]);
+            }
+        });
+
+        for (int client = 0; client < ClientCount; ++client) {
+            for (int index = 0; index < ObjectCount; ++index) {
+                if (!Same(expected[client][index], actual[client][index])) {
+                    std::cerr << "Snapshot update differs from direct export for client " << client_ids[client]
+                              << ", object " << index << " (round " << round << ").\n";
+                    return 1;
+                }
+            }
+        }
+    }
+
+    snapshot.Reset();
+
+    //
+    // Serial and parallel TCADO over several ticks must put the same bytes on
+    // the wire and count the same bits, with and without delta coding.
+    //
+    {
+        std::vector<WireStruct> serial = Run_Serial_Wire(objects, dirty_patterns, pattern_count);
+        std::vector<WireStruct> parallel = Run_Parallel_Wire(objects, dirty_patterns, pattern_count, client_ids);
+        if (!Compare_Wires(serial, parallel, "Full")) {
+            return 1;
+        }
+    }
+
+    NetworkObjectDeltaClass::Enable(true);
+    NetworkObjectDeltaClass::Reset_Stats();
+    {
+        std::vector<WireStruct> serial = Run_Serial_Wire(objects, dirty_patterns, pattern_count);
+        std::vector<WireStruct> parallel = Run_Parallel_Wire(objects, dirty_patterns, pattern_count, client_ids);
+        if (!Compare_Wires(serial, parallel, "Delta")) {
+            return 1;
+        }
+    }
+
+    NetworkObjectDeltaClass::StatsStruct stats;
+    NetworkObjectDeltaClass::Get_Stats(stats);
+    if (stats.DeltaUpdates == 0) {
+        std::cerr << "No frequent tier was delta coded.\n";
+        return 1;
+    }
+    NetworkObjectDeltaClass::Enable(false);
+    NetworkObjectDeltaClass::Reset();
+
+    JobPoolClass::Shutdown();
+
+    for (TestNetworkObject *object : objects) {
+        delete object;
+    }
+
+    return 0;
+}
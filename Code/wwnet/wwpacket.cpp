@@ -217,6 +217,11 @@ void cPacket::Construct_Full_Packet(cPacket & full_packet, cPacket & src_packet)
 		src_packet.Get_Type() <= PACKETTYPE_LAST);
    WWASSERT(src_packet.Get_Id() != UNDEFINED_ID);
 
+	//
+	// Size the payload for header and data up front so it is not grown twice
+	//
+	full_packet.Get_Data(PACKET_HEADER_SIZE + src_packet.Get_Compressed_Size_Bytes());
+
 #ifndef WRAPPER_CRC
 	full_packet.Add(CRC_PLACEHOLDER);
 #endif //WRAPPER_CRC
@@ -229,8 +234,8 @@ void cPacket::Construct_Full_Packet(cPacket & full_packet, cPacket & src_packet)
 	WWASSERT(header_bit_length == PACKET_HEADER_SIZE * 8);
 
 	memcpy(
-		full_packet.Get_Data() + PACKET_HEADER_SIZE,
-		src_packet.Get_Data(),
+		full_packet.Get_Data(PACKET_HEADER_SIZE + src_packet.Get_Compressed_Size_Bytes()) + PACKET_HEADER_SIZE,
+		src_packet.Peek_Data(),
 		src_packet.Get_Compressed_Size_Bytes());
 	unsigned int whole_bit_length = header_bit_length + src_packet.Get_Bit_Length();
 	full_packet.Set_Bit_Length(whole_bit_length);
@@ -244,7 +249,7 @@ void cPacket::Construct_Full_Packet(cPacket & full_packet, cPacket & src_packet)
 
 	// Only CRC the meaningful data in the buffer - not the other 1300ish bytes as well. ST - 9/19/2001 11:18PM
 #ifndef WRAPPER_CRC
-	ULONG crc = CRC::Memory((BYTE *) (full_packet.Get_Data() + sizeof(CRC_PLACEHOLDER)), (whole_bit_length / 8) - sizeof(CRC_PLACEHOLDER));
+	ULONG crc = CRC::Memory((BYTE *) (full_packet.Peek_Data() + sizeof(CRC_PLACEHOLDER)), (whole_bit_length / 8) - sizeof(CRC_PLACEHOLDER));
 
 	//
 	// Overwrite the crc placeholder with the computed crc.
@@ -253,8 +258,8 @@ void cPacket::Construct_Full_Packet(cPacket & full_packet, cPacket & src_packet)
 	temp_packet.Add(crc);
 
 	memcpy(
-		full_packet.Get_Data(),
-		temp_packet.Get_Data(),
+		full_packet.Get_Data(temp_packet.Get_Compressed_Size_Bytes()),
+		temp_packet.Peek_Data(),
 		temp_packet.Get_Compressed_Size_Bytes());
 #endif //WRAPPER_CRC
 }
@@ -284,7 +289,7 @@ void cPacket::Construct_App_Packet(cPacket & packet, cPacket & full_packet)
 	packet.Set_Sender_Id(sender_id);
 	packet.Set_Bit_Length(bit_size);
 	packet.PFromAddressWrapper = full_packet.PFromAddressWrapper;
-	memcpy(packet.Get_Data(), full_packet.Get_Data() + PACKET_HEADER_SIZE, packet.Get_Compressed_Size_Bytes());
+	memcpy(packet.Get_Data(packet.Get_Compressed_Size_Bytes()), full_packet.Peek_Data() + PACKET_HEADER_SIZE, packet.Get_Compressed_Size_Bytes());
 
 #else //WRAPPER_CRC
 
@@ -293,7 +298,7 @@ void cPacket::Construct_App_Packet(cPacket & packet, cPacket & full_packet)
 		//
 		// Only CRC the meaningful data in the buffer - not the other 1300ish bytes as well. ST - 9/19/2001 11:29PM
 		//
-		int local_crc = CRC::Memory((BYTE *) (full_packet.Get_Data() + sizeof(CRC_PLACEHOLDER)), ((bit_size / 8) + PACKET_HEADER_SIZE) - sizeof(CRC_PLACEHOLDER));
+		int local_crc = CRC::Memory((BYTE *) (full_packet.Peek_Data() + sizeof(CRC_PLACEHOLDER)), ((bit_size / 8) + PACKET_HEADER_SIZE) - sizeof(CRC_PLACEHOLDER));
 
 		if (local_crc == remote_crc) {
 			packet.Set_Is_Crc_Correct(true);
@@ -303,7 +308,7 @@ void cPacket::Construct_App_Packet(cPacket & packet, cPacket & full_packet)
 			packet.Set_Bit_Length(bit_size);
 			packet.PFromAddressWrapper = full_packet.PFromAddressWrapper;
 
-			memcpy(packet.Get_Data(), full_packet.Get_Data() + PACKET_HEADER_SIZE, packet.Get_Compressed_Size_Bytes());
+			memcpy(packet.Get_Data(packet.Get_Compressed_Size_Bytes()), full_packet.Peek_Data() + PACKET_HEADER_SIZE, packet.Get_Compressed_Size_Bytes());
 		} else {
 			packet.Set_Is_Crc_Correct(false);
 		}
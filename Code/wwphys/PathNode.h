@@ -42,9 +42,9 @@
 #define __PATHNODE_H
 
 #include "matrix3d.h"
-#include "refcount.h"
-#include "binheap.h"
-#include "mempool.h"
+#include "simplevec.h"
+#include "vector.h"
+#include <algorithm>
 #include "PathfindPortal.h"
 
 
@@ -59,7 +59,7 @@ class PathfindSectorClass;
 //	PathNodeClass
 //
 /////////////////////////////////////////////////////////////////////////
-class PathNodeClass : public RefCountClass, public HeapNodeClass<float>, public AutoPoolClass<PathNodeClass, 512>
+class PathNodeClass
 {
 	public:
 
@@ -79,6 +79,12 @@ class PathNodeClass : public RefCountClass, public HeapNodeClass<float>, public
 				m_HeapLocation (0),
 				m_InClosedList (false)	{ }
 
+		//
+		//	Puts the node back the way the constructor left it (nodes are recycled
+		// by PathNodeArenaClass)
+		//
+		void							Reset (void);
+
 		~PathNodeClass (void)			{ }
 
 		/////////////////////////////////////////////////////////////////////////
@@ -110,15 +116,12 @@ class PathNodeClass : public RefCountClass, public HeapNodeClass<float>, public
 		bool							Is_On_Final_Path (void) const;
 		void							On_Final_Path (bool on_path);
 
-		// For distributed (multi-frame) solve...
+		// Set once the node has been taken off the open list
 		bool							Is_In_Closed_List (void) const;
-		void							Reconnect_To_Portal (void);
-		void							Disconnect_From_Portal (void);
 
-		// From HeapNodeClass
-		uint32						Get_Heap_Location (void) const override;
-		void							Set_Heap_Location (uint32 location) override;
-		float							Heap_Key (void) const override;
+		// Open list (PathOpenListClass) support
+		uint32						Get_Heap_Location (void) const;
+		void							Set_Heap_Location (uint32 location);
 
 	protected:
 
@@ -146,6 +149,94 @@ class PathNodeClass : public RefCountClass, public HeapNodeClass<float>, public
 };
 
 
+/////////////////////////////////////////////////////////////////////////
+//
+//	PathNodeArenaClass
+//
+//	Hands out the nodes for one path solve.  The nodes are allocated in
+// blocks which are kept when the arena is reset, so once a solver has
+// seen a search of a given size it doesn't allocate any more.  Nodes
+// never move, so pointers to them stay good until the next Reset.
+//
+/////////////////////////////////////////////////////////////////////////
+class PathNodeArenaClass
+{
+	public:
+
+		/////////////////////////////////////////////////////////////////////////
+		// Public constructors/destructors
+		/////////////////////////////////////////////////////////////////////////
+		PathNodeArenaClass (void)
+			:	m_UsedCount (0)	{ }
+		~PathNodeArenaClass (void);
+
+		/////////////////////////////////////////////////////////////////////////
+		// Public methods
+		/////////////////////////////////////////////////////////////////////////
+		PathNodeClass *			Allocate (void);
+		void							Reset (void)					{ m_UsedCount = 0; }
+		int							Get_Count (void) const		{ return m_UsedCount; }
+		int							Get_Capacity (void) const	{ return m_Blocks.Count () * BLOCK_SIZE; }
+
+	private:
+
+		/////////////////////////////////////////////////////////////////////////
+		// Private constants
+		/////////////////////////////////////////////////////////////////////////
+		enum
+		{
+			BLOCK_SIZE	= 256
+		};
+
+		/////////////////////////////////////////////////////////////////////////
+		// Private member data
+		/////////////////////////////////////////////////////////////////////////
+		DynamicVectorClass<PathNodeClass *>	m_Blocks;
+		int											m_UsedCount;
+};
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	PathOpenListClass
+//
+//	Indexed binary min-heap of path nodes keyed on their total cost.  Each
+// node remembers its index in the heap so its cost can be lowered in place
+// (Percolate_Up).  Element [0] is never used.  The array only grows, so a
+// reset doesn't touch the memory.
+//
+/////////////////////////////////////////////////////////////////////////
+class PathOpenListClass
+{
+	public:
+
+		/////////////////////////////////////////////////////////////////////////
+		// Public constructors/destructors
+		/////////////////////////////////////////////////////////////////////////
+		PathOpenListClass (void)
+			:	m_Count (0)	{ }
+
+		/////////////////////////////////////////////////////////////////////////
+		// Public methods
+		/////////////////////////////////////////////////////////////////////////
+		void							Reset (void)					{ m_Count = 0; }
+		int							Get_Count (void) const		{ return m_Count; }
+
+		PathNodeClass *			Peek_Node (uint32 location)	{ return m_Nodes[location]; }
+		void							Insert (PathNodeClass *node);
+		void							Percolate_Up (uint32 location);
+		PathNodeClass *			Remove_Min (void);
+
+	private:
+
+		/////////////////////////////////////////////////////////////////////////
+		// Private member data
+		/////////////////////////////////////////////////////////////////////////
+		SimpleVecClass<PathNodeClass *>	m_Nodes;
+		int										m_Count;
+};
+
+
 /////////////////////////////////////////////////////////////////////////
 //
 //	Inlines
@@ -220,10 +311,6 @@ PathNodeClass::Set_Heap_Location (uint32 location)
 {
 	m_HeapLocation = location;
 
-	if (m_Portal != nullptr) {
-		m_Portal->Set_Heap_Location (location);
-	}
-
 	if (location == 0) {
 		m_InClosedList = true;
 	} else {
@@ -233,12 +320,6 @@ PathNodeClass::Set_Heap_Location (uint32 location)
 	return ;
 }
 
-inline float
-PathNodeClass::Heap_Key (void) const
-{
-	return m_TotalCost;
-}
-
 inline bool
 PathNodeClass::Is_In_Closed_List (void) const
 {
@@ -246,29 +327,120 @@ PathNodeClass::Is_In_Closed_List (void) const
 }
 
 inline void
-PathNodeClass::Disconnect_From_Portal (void)
+PathNodeClass::Reset (void)
 {
-	WWASSERT (m_Portal != nullptr);
+	m_Sector				= nullptr;
+	m_ParentNode		= nullptr;
+	m_Portal				= nullptr;
+	m_TotalCost			= 0;
+	m_HeuristicCost	= 0;
+	m_TraversalCost	= 0;
+	m_OnFinalPath		= false;
+	m_EnterTransform.Make_Identity ();
+	m_Transform.Make_Identity ();
+	m_HeapLocation		= 0;
+	m_InClosedList		= false;
+	return ;
+}
 
-	m_Portal->m_ClosedListPtr = nullptr;
-	m_Portal->Set_Heap_Location (0);
+inline PathNodeClass *
+PathNodeArenaClass::Allocate (void)
+{
+	int block = m_UsedCount / BLOCK_SIZE;
+	if (block == m_Blocks.Count ()) {
+		m_Blocks.Add (new PathNodeClass[BLOCK_SIZE]);
+	}
+
+	PathNodeClass *node = &(m_Blocks[block][m_UsedCount % BLOCK_SIZE]);
+	m_UsedCount ++;
+
+	node->Reset ();
+	return node;
+}
+
+inline void
+PathOpenListClass::Insert (PathNodeClass *node)
+{
+	//
+	//	Grow the array if necessary
+	//
+	if (m_Count + 1 >= m_Nodes.Length ()) {
+		m_Nodes.Resize (std::max (m_Nodes.Length () * 2, 256));
+	}
+
+	m_Nodes[++ m_Count] = node;
+	Percolate_Up (m_Count);
 	return ;
 }
 
 inline void
-PathNodeClass::Reconnect_To_Portal (void)
+PathOpenListClass::Percolate_Up (uint32 location)
 {
-	if (m_Portal != nullptr) {
-		if (m_InClosedList) {
-			m_Portal->m_ClosedListPtr = this;
-		} else {
-			m_Portal->Set_Heap_Location (m_HeapLocation);
-		}
+	PathNodeClass *node	= m_Nodes[location];
+	float cost				= node->Get_Total_Cost ();
+
+	//
+	//	Find the node's place in the tree.  Remember: the smallest node is the root.
+	//
+	uint32 index = location;
+	while (index > 1 && m_Nodes[index / 2]->Get_Total_Cost () > cost) {
+		m_Nodes[index] = m_Nodes[index / 2];
+		m_Nodes[index]->Set_Heap_Location (index);
+		index /= 2;
 	}
 
+	m_Nodes[index] = node;
+	node->Set_Heap_Location (index);
 	return ;
 }
 
+inline PathNodeClass *
+PathOpenListClass::Remove_Min (void)
+{
+	if (m_Count == 0) {
+		return nullptr;
+	}
+
+	//
+	//	The smallest node is always at the top
+	//
+	PathNodeClass *min_node = m_Nodes[1];
+	min_node->Set_Heap_Location (0);
+
+	PathNodeClass *last_node	= m_Nodes[m_Count --];
+	float last_cost				= last_node->Get_Total_Cost ();
+
+	//
+	//	Percolate the last node down from the top
+	//
+	int index = 1;
+	if (m_Count > 0) {
+		while (index * 2 <= m_Count) {
+
+			//
+			//	Find the smaller child
+			//
+			int child = index * 2;
+			if (child != m_Count && m_Nodes[child + 1]->Get_Total_Cost () < m_Nodes[child]->Get_Total_Cost ()) {
+				child ++;
+			}
+
+			if (last_cost > m_Nodes[child]->Get_Total_Cost ()) {
+				m_Nodes[index] = m_Nodes[child];
+				m_Nodes[index]->Set_Heap_Location (index);
+				index = child;
+			} else {
+				break;
+			}
+		}
+
+		m_Nodes[index] = last_node;
+		last_node->Set_Heap_Location (index);
+	}
+
+	return min_node;
+}
+
 
 #endif //__PATHNODE_H
 
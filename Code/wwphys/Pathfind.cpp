@@ -91,7 +91,9 @@ enum
 	CHUNKID_HEIGHTDB,
 	CHUNKID_ACTION_PORTAL,
 	CHUNKID_WAYPATH_PORTAL,
-	CHUNKID_PATHFIND_SECTOR_OBJECT
+	CHUNKID_PATHFIND_SECTOR_OBJECT,
+	CHUNKID_FLAT_SECTOR_TREE,
+	CHUNKID_FLAT_DATA
 };
 
 
@@ -305,6 +307,7 @@ PathfindClass::Add_Temporary_Portal
 			//
 			m_TemporaryPortalList.Add (new_portal);
 			sector_from->Add_Portal (new_portal->Get_ID ());
+			m_ClusterGraph.Add_Link (sector_from, sector_to);
 
 			//
 			//	Add the size of this portal to the pool.
@@ -358,11 +361,18 @@ PathfindClass::Save (ChunkSaveClass &csave)
 	csave.Begin_Chunk (CHUNKID_DATABASE);
 
 		//
-		//	Save the sectors and portals
+		//	Save the sector culling tree, then the sectors and portals
+		// in one flat block
 		//
-		bool retval =	Save_Culling_System (csave);
-		retval &=		Save_Portals (csave);
-		retval &=		Save_Waypaths (csave);
+		csave.Begin_Chunk (CHUNKID_FLAT_SECTOR_TREE);
+			m_SectorTree.Save (csave);
+		csave.End_Chunk ();
+
+		csave.Begin_Chunk (CHUNKID_FLAT_DATA);
+			bool retval = Save_Flat_Data (csave);
+		csave.End_Chunk ();
+
+		retval &= Save_Waypaths (csave);
 
 		//
 		//	Save the height database for flying vehicles
@@ -377,56 +387,6 @@ PathfindClass::Save (ChunkSaveClass &csave)
 }
 
 
-///////////////////////////////////////////////////////////////////////////
-//
-//	Save_Portals
-//
-///////////////////////////////////////////////////////////////////////////
-bool
-PathfindClass::Save_Portals (ChunkSaveClass &csave)
-{
-	bool retval = true;
-
-	int count = m_PortalList.Count ();
-	int index;
-	for (index = 0; index < count && retval; index ++) {
-		PathfindPortalClass *portal = m_PortalList[index];
-
-		//
-		//	Determine what type of chunk to save this portal in
-		//
-		if (portal->As_PathfindActionPortalClass () != nullptr) {
-			csave.Begin_Chunk (CHUNKID_ACTION_PORTAL);
-		} else {
-			csave.Begin_Chunk (CHUNKID_PORTAL);
-		}
-
-		//
-		//	Write this portal out ot its own chunk
-		//
-			retval &= portal->Save (csave);
-		csave.End_Chunk ();
-	}
-
-	//
-	//	Now save the waypath portals
-	//
-	count = m_WaypathPortalList.Count ();
-	for (index = 0; index < count && retval; index ++) {
-		PathfindPortalClass *portal = m_WaypathPortalList[index];
-
-		//
-		//	Write this portal out ot its own chunk
-		//
-		csave.Begin_Chunk (CHUNKID_WAYPATH_PORTAL);
-			retval &= portal->Save (csave);
-		csave.End_Chunk ();
-	}
-
-	return retval;
-}
-
-
 ///////////////////////////////////////////////////////////////////////////
 //
 //	Load
@@ -462,6 +422,14 @@ PathfindClass::Load (ChunkLoadClass &cload)
 				retval &= HeightDBClass::Load (cload);
 				break;
 
+			case CHUNKID_FLAT_SECTOR_TREE:
+				m_SectorTree.Load (cload);
+				break;
+
+			case CHUNKID_FLAT_DATA:
+				retval &= Load_Flat_Data (cload);
+				break;
+
 			case CHUNKID_SECTOR_CULLING_SYSTEM:
 				retval &= Load_Culling_System (cload);
 				break;
@@ -522,52 +490,29 @@ PathfindClass::Load (ChunkLoadClass &cload)
 	}
 
 	cload.Close_Chunk ();
+
+	//
+	//	Precompute the cluster graph for the hierarchical search
+	//
+	Build_Clusters ();
 	return retval;
 }
 
 
 ///////////////////////////////////////////////////////////////////////////
 //
-//	Save_Sector
+//	Build_Clusters
 //
 ///////////////////////////////////////////////////////////////////////////
-bool
-PathfindClass::Save_Sector
-(
-	ChunkSaveClass &			csave,
-	PathfindSectorClass *	sector
-)
+void
+PathfindClass::Build_Clusters (void)
 {
-	bool retval = true;
-
-	csave.Begin_Chunk (CHUNKID_SECTOR);
-
-		//
-		//	Write this sector out to its own chunk
-		//
-		bool save_linkage = true;
-		if (sector->As_PathfindWaypathSectorClass () != nullptr) {
-			csave.Begin_Chunk (CHUNKID_PATHFIND_SECTOR_OBJECT);
-			save_linkage = false;
-		} else {
-			csave.Begin_Chunk (CHUNKID_SECTOR_OBJECT);
-		}
-
-			retval &= sector->Save (csave);
-		csave.End_Chunk ();
+	m_ClusterGraph.Build (m_SectorList);
+	m_CorridorCache.Reset ();
 
-		//
-		//	Now write the sector's AABTreeCullSystem linkage to a chunk
-		//
-		if (save_linkage) {
-			csave.Begin_Chunk (CHUNKID_SECTOR_LINKAGE);
-				m_SectorTree.Save_Object_Linkage (csave, sector);
-			csave.End_Chunk ();
-		}
-
-	csave.End_Chunk ();
-
-	return retval;
+	WWDEBUG_SAY (("Pathfind: %d sectors in %d clusters, %d cluster links.\r\n",
+		m_SectorList.Count (), m_ClusterGraph.Get_Cluster_Count (), m_ClusterGraph.Get_Link_Count ()));
+	return ;
 }
 
 
@@ -854,6 +799,8 @@ PathfindClass::Reset_Sectors (void)
 	}
 
 	m_SectorList.Delete_All ();
+	m_ClusterGraph.Reset ();
+	m_CorridorCache.Reset ();
 
 	_MemoryFootprint = 0;
 	return ;
@@ -1190,41 +1137,6 @@ PathfindClass::Save_Waypaths (ChunkSaveClass &csave)
 }
 
 
-//////////////////////////////////////////////////////////////////////////////////
-//
-//	Save_Culling_System
-//
-//////////////////////////////////////////////////////////////////////////////////
-bool
-PathfindClass::Save_Culling_System (ChunkSaveClass &csave)
-{
-	bool retval = true;
-
-	csave.Begin_Chunk (CHUNKID_SECTOR_CULLING_SYSTEM);
-
-		//
-		//	Write the AABTreeCullSystem we use for sector lookups
-		// to the chunk
-		//
-		csave.Begin_Chunk (CHUNKID_SECTOR_CULL_TREE);
-			m_SectorTree.Save (csave);
-		csave.End_Chunk ();
-
-		//
-		//	Now write the contents of the tree (the sector list)
-		// to the chunk
-		//
-		int count = m_SectorList.Count ();
-		for (int index = 0; index < count && retval; index ++) {
-			Save_Sector (csave, m_SectorList[index]);
-		}
-
-	csave.End_Chunk ();
-
-	return retval;
-}
-
-
 //////////////////////////////////////////////////////////////////////////////////
 //
 //	Load_Culling_System
@@ -1492,6 +1404,11 @@ PathfindClass::Free_Waypath_Sectors_And_Portals (void)
 	//	Reset the portal list
 	//
 	m_WaypathPortalList.Delete_All ();
+
+	//
+	//	The freed sectors had clusters of their own
+	//
+	Build_Clusters ();
 	return ;
 }
 
@@ -1523,6 +1440,7 @@ PathfindClass::Generate_Waypath_Sectors_And_Portals (void)
 		}
 	}
 
+	Build_Clusters ();
 	return ;
 }
 
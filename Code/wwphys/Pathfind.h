@@ -44,6 +44,7 @@
 #include "aabtreecull.h"
 #include "PathfindSector.h"
 #include "widgetuser.h"
+#include "pathcluster.h"
 
 
 /////////////////////////////////////////////////////////////////////////
@@ -106,6 +107,14 @@ class PathfindClass
 
 		int							Add_Temporary_Portal (PathfindSectorClass *sector_from, PathfindSectorClass *sector_to, const Vector3 &start_pos, const Vector3 &dest_pos);
 
+		//
+		//	Hierarchical search support (see pathcluster.h).  The clusters are
+		// built when the pathfind data is loaded or the waypath sectors change.
+		//
+		void							Build_Clusters (void);
+		PathClusterGraphClass &	Get_Cluster_Graph (void)	{ return m_ClusterGraph; }
+		PathCorridorCacheClass &Get_Corridor_Cache (void)	{ return m_CorridorCache; }
+
 		//
 		//	Statistics
 		//
@@ -171,13 +180,19 @@ class PathfindClass
 		/////////////////////////////////////////////////////////////////////////
 		// Protected methods
 		/////////////////////////////////////////////////////////////////////////
-		bool							Save_Portals (ChunkSaveClass &csave);
 		bool							Save_Waypaths (ChunkSaveClass &csave);
-		bool							Save_Sector (ChunkSaveClass &csave, PathfindSectorClass *sector);
+
+		//
+		//	Flat sector and portal data (see pathfindflat.cpp)
+		//
+		bool							Save_Flat_Data (ChunkSaveClass &csave);
+		bool							Load_Flat_Data (ChunkLoadClass &cload);
+
+		//
+		//	Older levels store each sector and portal in its own chunk
+		//
 		bool							Load_Sector (ChunkLoadClass &cload);
 		bool							Load_Portal (ChunkLoadClass &cload, PathfindPortalClass *portal);
-
-		bool							Save_Culling_System (ChunkSaveClass &csave);
 		bool							Load_Culling_System (ChunkLoadClass &cload);
 
 		void							Generate_Waypath_Sector_And_Portals (WaypathClass *waypath);
@@ -217,6 +232,9 @@ class PathfindClass
 
 		WidgetUserClass		m_SectorDisplayWidgets;
 		WidgetUserClass		m_PortalDisplayWidgets;
+
+		PathClusterGraphClass	m_ClusterGraph;
+		PathCorridorCacheClass	m_CorridorCache;
 };
 
 
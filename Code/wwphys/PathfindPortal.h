@@ -54,7 +54,6 @@
 // Forward declarations
 //////////////////////////////////////////////////////////////////////////
 class PathfindSectorClass;
-class PathNodeClass;
 class ChunkSaveClass;
 class ChunkLoadClass;
 class PathfindActionPortalClass;
@@ -76,8 +75,6 @@ public:
 	PathfindPortalClass (void)
 		:	m_DestSector1 ((uint16)-1),
 			m_DestSector2 ((uint16)-1),
-			m_HeapLocation (0),
-			m_ClosedListPtr (nullptr),
 			m_ID (0)									{}
 
 	virtual ~PathfindPortalClass (void)		{}
@@ -97,6 +94,7 @@ public:
 	PathfindSectorClass *Peek_Dest_Sector (PathfindSectorClass *current_sector);
 	void						Add_Dest_Sector (int sector_index);
 	void						Add_Dest_Sector (PathfindSectorClass *sector);
+	void						Set_Dest_Sectors (uint16 sector1, uint16 sector2)	{ m_DestSector1 = sector1; m_DestSector2 = sector2; }
 	uint16					Get_Dest_Sector1 (void);
 	uint16					Get_Dest_Sector2 (void);
 
@@ -108,12 +106,6 @@ public:
 	uint32					Get_ID (void) const	{ return m_ID; }
 	void						Set_ID (uint32 id)	{ m_ID = id; }
 
-	//////////////////////////////////////////////////////////////////////
-	//	A-Star list methods
-	//////////////////////////////////////////////////////////////////////
-	uint32					Get_Heap_Location (void) const;
-	void						Set_Heap_Location (uint32 location);
-
 	//////////////////////////////////////////////////////////////////////
 	//	Serialization methods
 	//////////////////////////////////////////////////////////////////////
@@ -121,8 +113,6 @@ public:
 	virtual bool			Load (ChunkLoadClass &chunk_load);
 	void						Resolve_IDs (void);
 
-	PathNodeClass *		m_ClosedListPtr;
-
 protected:
 
 	//////////////////////////////////////////////////////////////////////
@@ -139,7 +129,6 @@ private:
 	uint16 		m_DestSector2;
 	AABoxClass	m_BoundingBox;
 	uint32		m_ID;
-	uint32		m_HeapLocation;
 };
 
 
@@ -236,25 +225,6 @@ PathfindPortalClass::Is_Two_Way_Portal (void) const
 	return (m_DestSector1 != ((uint16)-1)) && (m_DestSector2 != ((uint16)-1));
 }
 
-//////////////////////////////////////////////////////////////////////////
-//	Get_Heap_Location
-//////////////////////////////////////////////////////////////////////////
-inline uint32
-PathfindPortalClass::Get_Heap_Location (void) const
-{
-	return m_HeapLocation;
-}
-
-//////////////////////////////////////////////////////////////////////////
-//	Set_Heap_Location
-//////////////////////////////////////////////////////////////////////////
-inline void
-PathfindPortalClass::Set_Heap_Location (uint32 location)
-{
-	m_HeapLocation = location;
-	return ;
-}
-
 
 //////////////////////////////////////////////////////////////////////////
 //
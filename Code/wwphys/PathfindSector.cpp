@@ -92,6 +92,28 @@ PathfindSectorClass::Reset_Portal_List (void)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////
+//
+//	Set_Portal_List
+//
+////////////////////////////////////////////////////////////////////////////////////
+void
+PathfindSectorClass::Set_Portal_List (const uint32 *portal_ids, int count)
+{
+	//
+	//	Size the list once, then fill it
+	//
+	m_PortalList.Delete_All ();
+	m_PortalList.Resize (count);
+
+	for (int index = 0; index < count; index ++) {
+		m_PortalList.Add (portal_ids[index]);
+	}
+
+	return ;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////
 //
 //	Save
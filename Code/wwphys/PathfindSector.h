@@ -70,10 +70,12 @@ public:
 	//	Public constructors/destructors
 	////////////////////////////////////////////////////////////////////
 	PathfindSectorClass (void)
-		:	m_IsValid (true)		{}
+		:	m_IsValid (true),
+			m_ClusterID (-1)	{}
 
 	PathfindSectorClass (const AABoxClass &/* box */)
-		:	m_IsValid (true)		{}
+		:	m_IsValid (true),
+			m_ClusterID (-1)	{}
 
 	virtual ~PathfindSectorClass (void);
 
@@ -99,6 +101,7 @@ public:
 	void						Add_Portal (uint32 portal_id);
 	void						Remove_Portal (uint32 portal_id);
 	void						Reset_Portal_List (void);
+	void						Set_Portal_List (const uint32 *portal_ids, int count);
 
 	//
 	//	Portal access
@@ -112,6 +115,12 @@ public:
 	bool						Is_Valid (void)				{ return m_IsValid; }
 	void						Set_Valid (bool is_valid)	{ m_IsValid = is_valid; }
 
+	//
+	//	Cluster this sector belongs to (see pathcluster.h), -1 if none
+	//
+	int						Get_Cluster_ID (void) const		{ return m_ClusterID; }
+	void						Set_Cluster_ID (int cluster_id)	{ m_ClusterID = cluster_id; }
+
 	//
 	//	Portal testing methods
 	//
@@ -130,6 +139,7 @@ protected:
 	////////////////////////////////////////////////////////////////////
 	DynamicVectorClass<uint32>		m_PortalList;
 	bool									m_IsValid;
+	int									m_ClusterID;
 
 private:
 
@@ -138,6 +138,29 @@ void MotorVehicleClass::Timestep(float dt)
 	VehiclePhysClass::Timestep(dt);
 }
 
+bool MotorVehicleClass::Is_At_Rest(void)
+{
+	if (!VehiclePhysClass::Is_At_Rest()) {
+		return false;
+	}
+
+	/*
+	** The engine and the gearbox keep going in Timestep even while we're asleep.  We're only
+	** at rest once Timestep would leave them alone.
+	*/
+	if ((ShiftTimer > 0.0f) || (AcceleratorFraction != 0.0f) || IsBraking) {
+		return false;
+	}
+
+	if (Drive_Wheels_In_Contact()) {
+		const MotorVehicleDefClass * def = Get_MotorVehicleDef();
+		bool shift_up = (EngineAngularVelocity > def->ShiftUpAvel) && (CurrentGear < def->GearCount);
+		bool shift_down = (EngineAngularVelocity < def->ShiftDownAvel) && (CurrentGear > 0);
+		return !shift_up && !shift_down;
+	}
+	return (Compute_Engine_Angular_Acceleration() == 0.0f);
+}
+
 
 /***********************************************************************************************
 **
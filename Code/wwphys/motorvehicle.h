@@ -96,6 +96,7 @@ public:
 	void					Init(const MotorVehicleDefClass & def);
 
 	virtual void		Timestep(float dt) override;
+	virtual bool		Is_At_Rest(void) override;
 
 	// Accessors for the current state
 	float					Get_Engine_Angular_Velocity(void)							{ return EngineAngularVelocity; }
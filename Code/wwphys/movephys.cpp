@@ -240,6 +240,9 @@ void MoveablePhysClass::Link_To_Carrier(PhysClass * carrier,RenderObjClass * car
 	// If this is the same carrier we already have, just return
 	if ((Carrier == carrier) && (CarrierSubObject == carrier_sub_obj)) return;
 
+	// Carriers are shared between islands
+	PhysIslandSerialLockClass lock;
+
 	// If we had a different carrier, unlink from it
 	if (Carrier != nullptr) {
 		Carrier->Internal_Unlink_Rider(this);
@@ -0,0 +1,494 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : wwphys                                                       *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/pathcluster.cpp                       $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+
+#include "pathcluster.h"
+#include "PathfindSector.h"
+#include "PathfindPortal.h"
+#include "PathObject.h"
+#include "wwmath.h"
+#include <string.h>
+#include <algorithm>
+
+
+///////////////////////////////////////////////////////////////////////////
+//	Constants
+///////////////////////////////////////////////////////////////////////////
+const float PathClusterGraphClass::CELL_SIZE	= 32.0F;
+
+
+///////////////////////////////////////////////////////////////////////////
+//	Local inlines
+///////////////////////////////////////////////////////////////////////////
+static inline int
+Get_Cell_Coord (float value, float cell_size)
+{
+	return (int)WWMath::Floor (value / cell_size);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Build
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathClusterGraphClass::Build (const DynamicVectorClass<PathfindSectorClass *> &sector_list)
+{
+	Reset ();
+
+	int index;
+	for (index = 0; index < sector_list.Count (); index ++) {
+		sector_list[index]->Set_Cluster_ID (-1);
+	}
+
+	//
+	//	Give every sector a cluster.  Waypath sectors are strung out along the
+	// waypath so they don't get merged with anything.
+	//
+	DynamicVectorClass<PathfindSectorClass *> work_list;
+	for (index = 0; index < sector_list.Count (); index ++) {
+		PathfindSectorClass *sector = sector_list[index];
+		if (sector->Get_Cluster_ID () == -1) {
+
+			int cluster_id = m_GroupParent.Count ();
+			m_GroupParent.Add (cluster_id);
+
+			if (sector->As_PathfindWaypathSectorClass () != nullptr) {
+				sector->Set_Cluster_ID (cluster_id);
+			} else {
+				Flood_Cluster (sector, cluster_id, work_list);
+			}
+		}
+	}
+
+	//
+	//	Now join the clusters that are linked by a portal
+	//
+	for (index = 0; index < sector_list.Count (); index ++) {
+		PathfindSectorClass *sector = sector_list[index];
+
+		for (int portal_index = 0; portal_index < sector->Get_Portal_Count (); portal_index ++) {
+			PathfindPortalClass *portal = sector->Peek_Portal (portal_index);
+			if (portal != nullptr) {
+				Add_Link (sector, portal->Peek_Dest_Sector (sector));
+			}
+		}
+	}
+
+	//
+	//	Point every cluster straight at its group
+	//
+	for (index = 0; index < m_GroupParent.Count (); index ++) {
+		m_GroupParent[index] = Find_Group (index);
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Reset
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathClusterGraphClass::Reset (void)
+{
+	m_GroupParent.Delete_All ();
+	m_LinkCount = 0;
+	m_SerialNumber ++;
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Flood_Cluster
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathClusterGraphClass::Flood_Cluster
+(
+	PathfindSectorClass *							seed,
+	int													cluster_id,
+	DynamicVectorClass<PathfindSectorClass *> &	work_list
+)
+{
+	const Vector3 &seed_center = seed->Get_Bounding_Box ().Center;
+	int cell_x = ::Get_Cell_Coord (seed_center.X, CELL_SIZE);
+	int cell_y = ::Get_Cell_Coord (seed_center.Y, CELL_SIZE);
+
+	seed->Set_Cluster_ID (cluster_id);
+	int sector_count = 1;
+
+	work_list.Reset_Active ();
+	work_list.Add (seed);
+
+	//
+	//	Spread through the portals to the neighbouring sectors that are
+	// centered in the seed's cell
+	//
+	while (work_list.Count () > 0 && sector_count < MAX_CLUSTER_SECTORS) {
+		PathfindSectorClass *sector = work_list[work_list.Count () - 1];
+		work_list.Delete (work_list.Count () - 1);
+
+		for (int index = 0; index < sector->Get_Portal_Count (); index ++) {
+			PathfindPortalClass *portal = sector->Peek_Portal (index);
+			if (portal == nullptr) {
+				continue;
+			}
+
+			PathfindSectorClass *dest_sector = portal->Peek_Dest_Sector (sector);
+			if (	dest_sector == nullptr ||
+					dest_sector->Get_Cluster_ID () != -1 ||
+					dest_sector->As_PathfindWaypathSectorClass () != nullptr)
+			{
+				continue;
+			}
+
+			const Vector3 &center = dest_sector->Get_Bounding_Box ().Center;
+			if (	::Get_Cell_Coord (center.X, CELL_SIZE) == cell_x &&
+					::Get_Cell_Coord (center.Y, CELL_SIZE) == cell_y &&
+					sector_count < MAX_CLUSTER_SECTORS)
+			{
+				dest_sector->Set_Cluster_ID (cluster_id);
+				work_list.Add (dest_sector);
+				sector_count ++;
+			}
+		}
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Add_Link
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathClusterGraphClass::Add_Link
+(
+	PathfindSectorClass *sector_from,
+	PathfindSectorClass *sector_to
+)
+{
+	if (sector_from == nullptr || sector_to == nullptr) {
+		return ;
+	}
+
+	int cluster1 = sector_from->Get_Cluster_ID ();
+	int cluster2 = sector_to->Get_Cluster_ID ();
+	if (	cluster1 >= 0 && cluster1 < m_GroupParent.Count () &&
+			cluster2 >= 0 && cluster2 < m_GroupParent.Count () &&
+			cluster1 != cluster2)
+	{
+		Join_Groups (cluster1, cluster2);
+		m_LinkCount ++;
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Can_Clusters_Connect
+//
+///////////////////////////////////////////////////////////////////////////
+bool
+PathClusterGraphClass::Can_Clusters_Connect (int cluster1, int cluster2) const
+{
+	if (	cluster1 < 0 || cluster1 >= m_GroupParent.Count () ||
+			cluster2 < 0 || cluster2 >= m_GroupParent.Count ())
+	{
+		return true;
+	}
+
+	return (Find_Group (cluster1) == Find_Group (cluster2));
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Find_Group
+//
+///////////////////////////////////////////////////////////////////////////
+int
+PathClusterGraphClass::Find_Group (int cluster_id) const
+{
+	while (m_GroupParent[cluster_id] != cluster_id) {
+		cluster_id = m_GroupParent[cluster_id];
+	}
+
+	return cluster_id;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Join_Groups
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathClusterGraphClass::Join_Groups (int cluster1, int cluster2)
+{
+	int group1 = Find_Group (cluster1);
+	int group2 = Find_Group (cluster2);
+
+	//
+	//	Keep the lower ID as the root and shorten the chains we walked
+	//
+	int root = std::min (group1, group2);
+	m_GroupParent[group1]	= root;
+	m_GroupParent[group2]	= root;
+	m_GroupParent[cluster1]	= root;
+	m_GroupParent[cluster2]	= root;
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	PathCorridorCacheClass
+//
+///////////////////////////////////////////////////////////////////////////
+PathCorridorCacheClass::PathCorridorCacheClass (void)
+	:	m_Entries (MAX_ENTRIES),
+		m_EntryCount (0),
+		m_UseCounter (0),
+		m_IsEnabled (true)
+{
+	Reset_Stats ();
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Build_Key
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathCorridorCacheClass::Build_Key
+(
+	int							start_cluster,
+	int							dest_cluster,
+	const PathObjectClass &	path_object,
+	KeyStruct *					key
+)
+{
+	key->StartCluster	= start_cluster;
+	key->DestCluster	= dest_cluster;
+	key->Flags			= path_object.Get_Flags ();
+	key->KeyRing		= path_object.Get_Key_Ring ();
+
+	//
+	//	Objects within a quarter meter of each other fit through the same
+	// portals often enough to share corridors.
+	//
+	key->WidthClass	= (int)WWMath::Ceil (path_object.Get_Width () * 4.0F);
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Lookup
+//
+///////////////////////////////////////////////////////////////////////////
+bool
+PathCorridorCacheClass::Lookup
+(
+	const KeyStruct &				key,
+	DynamicVectorClass<int> &	cluster_list
+)
+{
+	if (m_IsEnabled == false) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock (m_Mutex);
+	m_Stats.Lookups ++;
+
+	int index = Find_Entry (key);
+	if (index == -1) {
+		return false;
+	}
+
+	EntryStruct &entry	= m_Entries[index];
+	entry.LastUsed			= ++ m_UseCounter;
+	m_Stats.Hits ++;
+
+	cluster_list.Reset_Active ();
+	for (int cluster_index = 0; cluster_index < entry.ClusterCount; cluster_index ++) {
+		cluster_list.Add (entry.Clusters[cluster_index]);
+	}
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Store
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathCorridorCacheClass::Store
+(
+	const KeyStruct &	key,
+	const int *			cluster_list,
+	int					count
+)
+{
+	if (m_IsEnabled == false || count <= 0 || count > MAX_CORRIDOR_CLUSTERS) {
+		return ;
+	}
+
+	std::lock_guard<std::mutex> lock (m_Mutex);
+
+	//
+	//	Replace the corridor we already have for this key, fill an empty
+	// slot or throw out the one that's gone unused the longest.
+	//
+	int index = Find_Entry (key);
+	if (index == -1) {
+		if (m_EntryCount < MAX_ENTRIES) {
+			index = m_EntryCount ++;
+		} else {
+			index = 0;
+			for (int entry_index = 1; entry_index < m_EntryCount; entry_index ++) {
+				if (m_Entries[entry_index].LastUsed < m_Entries[index].LastUsed) {
+					index = entry_index;
+				}
+			}
+			m_Stats.Evictions ++;
+		}
+	}
+
+	EntryStruct &entry	= m_Entries[index];
+	entry.Key				= key;
+	entry.LastUsed			= ++ m_UseCounter;
+	entry.ClusterCount	= count;
+	::memcpy (entry.Clusters, cluster_list, count * sizeof (int));
+
+	m_Stats.Stores ++;
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Reset
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathCorridorCacheClass::Reset (void)
+{
+	std::lock_guard<std::mutex> lock (m_Mutex);
+	m_EntryCount = 0;
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Record_Fallback
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathCorridorCacheClass::Record_Fallback (void)
+{
+	std::lock_guard<std::mutex> lock (m_Mutex);
+	m_Stats.Fallbacks ++;
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Record_Unreachable
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathCorridorCacheClass::Record_Unreachable (void)
+{
+	std::lock_guard<std::mutex> lock (m_Mutex);
+	m_Stats.Unreachable ++;
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Get_Stats
+//
+///////////////////////////////////////////////////////////////////////////
+PathCorridorCacheClass::StatsStruct
+PathCorridorCacheClass::Get_Stats (void)
+{
+	std::lock_guard<std::mutex> lock (m_Mutex);
+	return m_Stats;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Reset_Stats
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathCorridorCacheClass::Reset_Stats (void)
+{
+	std::lock_guard<std::mutex> lock (m_Mutex);
+	m_Stats = StatsStruct ();
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Find_Entry
+//
+///////////////////////////////////////////////////////////////////////////
+int
+PathCorridorCacheClass::Find_Entry (const KeyStruct &key) const
+{
+	for (int index = 0; index < m_EntryCount; index ++) {
+		if (m_Entries[index].Key == key) {
+			return index;
+		}
+	}
+
+	return -1;
+}
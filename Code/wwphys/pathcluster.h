@@ -0,0 +1,263 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : wwphys                                                       *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/pathcluster.h                         $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef __PATHCLUSTER_H
+#define __PATHCLUSTER_H
+
+
+#include "vector.h"
+#include "simplevec.h"
+#include "bittype.h"
+#include <mutex>
+
+
+/////////////////////////////////////////////////////////////////////////
+// Forward declarations
+/////////////////////////////////////////////////////////////////////////
+class PathfindSectorClass;
+class PathObjectClass;
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	PathClusterGraphClass
+//
+//	Abstract graph over the pathfind sectors.  Neighbouring sectors whose
+// centers fall in the same CELL_SIZE grid cell are flooded (through their
+// portals) into one cluster; waypath sectors get a cluster each.  Clusters
+// which are linked by any portal, in either direction, belong to the same
+// group, so two clusters in different groups can never be joined by a path.
+//
+/////////////////////////////////////////////////////////////////////////
+class PathClusterGraphClass
+{
+	public:
+
+		/////////////////////////////////////////////////////////////////////////
+		// Public constructors/destructors
+		/////////////////////////////////////////////////////////////////////////
+		PathClusterGraphClass (void)
+			:	m_LinkCount (0),
+				m_SerialNumber (0)	{ }
+
+		/////////////////////////////////////////////////////////////////////////
+		// Public methods
+		/////////////////////////////////////////////////////////////////////////
+		void				Build (const DynamicVectorClass<PathfindSectorClass *> &sector_list);
+		void				Reset (void);
+
+		//
+		//	Records a portal added after the graph was built
+		//
+		void				Add_Link (PathfindSectorClass *sector_from, PathfindSectorClass *sector_to);
+
+		//
+		//	Queries
+		//
+		int				Get_Cluster_Count (void) const	{ return m_GroupParent.Count (); }
+		int				Get_Link_Count (void) const		{ return m_LinkCount; }
+		bool				Can_Clusters_Connect (int cluster1, int cluster2) const;
+
+		//
+		//	Changes every time the clusters are rebuilt
+		//
+		uint32			Get_Serial_Number (void) const	{ return m_SerialNumber; }
+
+	private:
+
+		/////////////////////////////////////////////////////////////////////////
+		// Private constants
+		/////////////////////////////////////////////////////////////////////////
+		static const float	CELL_SIZE;
+
+		enum
+		{
+			MAX_CLUSTER_SECTORS	= 64
+		};
+
+		/////////////////////////////////////////////////////////////////////////
+		// Private methods
+		/////////////////////////////////////////////////////////////////////////
+		void				Flood_Cluster (PathfindSectorClass *seed, int cluster_id, DynamicVectorClass<PathfindSectorClass *> &work_list);
+		int				Find_Group (int cluster_id) const;
+		void				Join_Groups (int cluster1, int cluster2);
+
+		/////////////////////////////////////////////////////////////////////////
+		// Private member data
+		/////////////////////////////////////////////////////////////////////////
+
+		//
+		//	Union-find parent of each cluster; the roots name the groups
+		//
+		DynamicVectorClass<int>		m_GroupParent;
+		int								m_LinkCount;
+		uint32							m_SerialNumber;
+};
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+//	PathCorridorCacheClass
+//
+//	Least-recently-used cache of solved corridors: the clusters a path went
+// through, keyed by the start and destination clusters and everything about
+// the traversing object that changes which portals it may use.  A solve that
+// hits the cache only searches the sectors of those clusters, and falls back
+// to the whole graph if that doesn't find a path.
+//
+//	Solves look up and store corridors from the job pool, so every access
+// takes the cache's lock.
+//
+/////////////////////////////////////////////////////////////////////////
+class PathCorridorCacheClass
+{
+	public:
+
+		/////////////////////////////////////////////////////////////////////////
+		// Public data types
+		/////////////////////////////////////////////////////////////////////////
+		enum
+		{
+			MAX_ENTRIES				= 256,
+			MAX_CORRIDOR_CLUSTERS	= 64
+		};
+
+		struct KeyStruct
+		{
+			int		StartCluster;
+			int		DestCluster;
+			int		Flags;
+			int		KeyRing;
+			int		WidthClass;
+
+			bool operator== (const KeyStruct &src) const;
+		};
+
+		struct StatsStruct
+		{
+			int		Lookups;
+			int		Hits;
+			int		Fallbacks;
+			int		Stores;
+			int		Evictions;
+			int		Unreachable;
+		};
+
+		/////////////////////////////////////////////////////////////////////////
+		// Public constructors/destructors
+		/////////////////////////////////////////////////////////////////////////
+		PathCorridorCacheClass (void);
+
+		/////////////////////////////////////////////////////////////////////////
+		// Public methods
+		/////////////////////////////////////////////////////////////////////////
+		static void		Build_Key (int start_cluster, int dest_cluster, const PathObjectClass &path_object, KeyStruct *key);
+
+		//
+		//	Copies the corridor's clusters into the list, returns false on a miss
+		//
+		bool				Lookup (const KeyStruct &key, DynamicVectorClass<int> &cluster_list);
+		void				Store (const KeyStruct &key, const int *cluster_list, int count);
+		void				Reset (void);
+
+		//
+		//	A corridor hit that didn't lead to a path / a request the graph
+		// knew couldn't be solved
+		//
+		void				Record_Fallback (void);
+		void				Record_Unreachable (void);
+
+		//
+		//	Control
+		//
+		void				Enable (bool onoff)			{ m_IsEnabled = onoff; }
+		bool				Is_Enabled (void) const		{ return m_IsEnabled; }
+		int				Get_Entry_Count (void) const	{ return m_EntryCount; }
+
+		//
+		//	Statistics
+		//
+		StatsStruct		Get_Stats (void);
+		void				Reset_Stats (void);
+
+	private:
+
+		/////////////////////////////////////////////////////////////////////////
+		// Private data types
+		/////////////////////////////////////////////////////////////////////////
+		struct EntryStruct
+		{
+			KeyStruct	Key;
+			uint32		LastUsed;
+			int			ClusterCount;
+			int			Clusters[MAX_CORRIDOR_CLUSTERS];
+		};
+
+		/////////////////////////////////////////////////////////////////////////
+		// Private methods
+		/////////////////////////////////////////////////////////////////////////
+		int				Find_Entry (const KeyStruct &key) const;
+
+		/////////////////////////////////////////////////////////////////////////
+		// Private member data
+		/////////////////////////////////////////////////////////////////////////
+
+		//
+		//	The cache is small enough that scanning it is cheaper than
+		// keeping a hash table and a use-ordered list in step.
+		//
+		SimpleVecClass<EntryStruct>	m_Entries;
+		int									m_EntryCount;
+		uint32								m_UseCounter;
+		bool									m_IsEnabled;
+		StatsStruct							m_Stats;
+		std::mutex							m_Mutex;
+};
+
+
+/////////////////////////////////////////////////////////////////////////
+//	Inlines
+/////////////////////////////////////////////////////////////////////////
+inline bool
+PathCorridorCacheClass::KeyStruct::operator== (const KeyStruct &src) const
+{
+	return (	StartCluster == src.StartCluster &&
+				DestCluster == src.DestCluster &&
+				Flags == src.Flags &&
+				KeyRing == src.KeyRing &&
+				WidthClass == src.WidthClass);
+}
+
+
+#endif //__PATHCLUSTER_H
@@ -0,0 +1,468 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/***********************************************************************************************
+ ***              C O N F I D E N T I A L  ---  W E S T W O O D  S T U D I O S               ***
+ ***********************************************************************************************
+ *                                                                                             *
+ *                 Project Name : wwphys                                                       *
+ *                                                                                             *
+ *                     $Archive:: /Commando/Code/wwphys/pathfindflat.cpp                      $*
+ *                                                                                             *
+ *---------------------------------------------------------------------------------------------*
+ * Functions:                                                                                  *
+ * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+//
+//	Flat save format for the pathfind sectors and portals.
+//
+//	The sectors, the portal IDs each sector uses, the portals and the waypath
+// portals are written as four arrays of fixed size records in one chunk.  The
+// arrays are located by offsets from the start of the block and refer to each
+// other by index or portal ID, so the block can be read with a single Read and
+// walked in place without the per-object chunk parsing and pointer remapping
+// of the older format.
+//
+
+#include "Pathfind.h"
+#include "PathfindSector.h"
+#include "PathfindPortal.h"
+#include "chunkio.h"
+#include "simplevec.h"
+#include "wwdebug.h"
+#include "wwmemlog.h"
+#include <string.h>
+
+
+///////////////////////////////////////////////////////////////////////////
+//	Flat format
+///////////////////////////////////////////////////////////////////////////
+enum
+{
+	FLAT_VERSION				= 1,
+
+	FLAT_SECTOR_WAYPATH		= 0x00000001,
+
+	FLAT_PORTAL_NORMAL		= 0,
+	FLAT_PORTAL_ACTION,
+	FLAT_PORTAL_WAYPATH
+};
+
+struct FlatHeaderStruct
+{
+	uint32	Version;
+	uint32	SectorCount;
+	uint32	SectorOffset;
+	uint32	PortalRefCount;
+	uint32	PortalRefOffset;
+	uint32	PortalCount;
+	uint32	PortalOffset;
+	uint32	WaypathPortalCount;
+	uint32	WaypathPortalOffset;
+	uint32	TotalSize;
+};
+
+struct FlatSectorStruct
+{
+	float		Center[3];
+	float		Extent[3];
+	uint32	FirstPortalRef;
+	uint32	PortalRefCount;
+	uint32	Flags;
+	sint32	WaypathID;
+	sint32	CullNodeIndex;
+};
+
+struct FlatPortalStruct
+{
+	float		Center[3];
+	float		Extent[3];
+	uint32	ID;
+	uint16	DestSector1;
+	uint16	DestSector2;
+	uint32	Type;
+
+	//
+	//	Action portals
+	//
+	float		Destination[3];
+	uint32	MechanismID;
+	sint32	ActionID;
+	sint32	ExitPortalID;
+	sint32	EnterPortalID;
+
+	//
+	//	Waypath portals
+	//
+	sint32	WaypathID;
+	sint32	WaypointIndex;
+	float		WaypathPercent;
+};
+
+static_assert ((sizeof (FlatHeaderStruct) & 3) == 0, "flat pathfind records must stay 4 byte aligned");
+static_assert ((sizeof (FlatSectorStruct) & 3) == 0, "flat pathfind records must stay 4 byte aligned");
+static_assert ((sizeof (FlatPortalStruct) & 3) == 0, "flat pathfind records must stay 4 byte aligned");
+
+
+///////////////////////////////////////////////////////////////////////////
+//	Local inlines
+///////////////////////////////////////////////////////////////////////////
+static inline void
+Store_Box (const AABoxClass &box, float *center, float *extent)
+{
+	center[0] = box.Center.X;
+	center[1] = box.Center.Y;
+	center[2] = box.Center.Z;
+	extent[0] = box.Extent.X;
+	extent[1] = box.Extent.Y;
+	extent[2] = box.Extent.Z;
+	return ;
+}
+
+static inline AABoxClass
+Read_Box (const float *center, const float *extent)
+{
+	return AABoxClass (Vector3 (center[0], center[1], center[2]), Vector3 (extent[0], extent[1], extent[2]));
+}
+
+static inline bool
+Is_Array_Inside (uint32 offset, uint32 count, uint32 record_size, uint32 total_size)
+{
+	return (offset <= total_size) && (count <= (total_size - offset) / record_size);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Store_Portal
+//
+///////////////////////////////////////////////////////////////////////////
+static void
+Store_Portal (PathfindPortalClass *portal, FlatPortalStruct *dest)
+{
+	::memset (dest, 0, sizeof (FlatPortalStruct));
+
+	AABoxClass box;
+	portal->Get_Bounding_Box (box);
+	::Store_Box (box, dest->Center, dest->Extent);
+
+	dest->ID					= portal->Get_ID ();
+	dest->DestSector1		= portal->Get_Dest_Sector1 ();
+	dest->DestSector2		= portal->Get_Dest_Sector2 ();
+	dest->Type				= FLAT_PORTAL_NORMAL;
+	dest->ExitPortalID	= -1;
+	dest->EnterPortalID	= -1;
+
+	PathfindActionPortalClass *action_portal = portal->As_PathfindActionPortalClass ();
+	if (action_portal != nullptr) {
+		const Vector3 &destination = action_portal->Get_Destination ();
+
+		dest->Type				= FLAT_PORTAL_ACTION;
+		dest->Destination[0]	= destination.X;
+		dest->Destination[1]	= destination.Y;
+		dest->Destination[2]	= destination.Z;
+		dest->MechanismID		= action_portal->Get_Mechanism_ID ();
+		dest->ActionID			= action_portal->Get_Action_Type ();
+
+		if (action_portal->Get_Exit_Portal () != nullptr) {
+			dest->ExitPortalID = action_portal->Get_Exit_Portal ()->Get_ID ();
+		}
+
+		if (action_portal->Get_Enter_Portal () != nullptr) {
+			dest->EnterPortalID = action_portal->Get_Enter_Portal ()->Get_ID ();
+		}
+	}
+
+	PathfindWaypathPortalClass *waypath_portal = portal->As_PathfindWaypathPortalClass ();
+	if (waypath_portal != nullptr) {
+		const WaypathPositionClass &pos = waypath_portal->Get_Waypath_Pos ();
+
+		dest->Type				= FLAT_PORTAL_WAYPATH;
+		dest->WaypathID		= pos.Get_Waypath_ID ();
+		dest->WaypointIndex	= pos.Get_Waypoint_Index ();
+		dest->WaypathPercent	= pos.Get_Percent ();
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Create_Portal
+//
+///////////////////////////////////////////////////////////////////////////
+static PathfindPortalClass *
+Create_Portal (const FlatPortalStruct &src)
+{
+	PathfindPortalClass *portal = nullptr;
+
+	if (src.Type == FLAT_PORTAL_ACTION) {
+
+		PathfindActionPortalClass *action_portal = new PathfindActionPortalClass;
+		action_portal->Set_Destination (Vector3 (src.Destination[0], src.Destination[1], src.Destination[2]));
+		action_portal->Set_Mechanism_ID (src.MechanismID);
+		action_portal->Set_Action_Type ((PathClass::ACTION_ID)src.ActionID);
+		portal = action_portal;
+
+	} else if (src.Type == FLAT_PORTAL_WAYPATH) {
+
+		WaypathPositionClass pos;
+		pos.Set_Waypath_ID (src.WaypathID);
+		pos.Set_Waypoint_Index (src.WaypointIndex);
+		pos.Set_Percent (src.WaypathPercent);
+
+		PathfindWaypathPortalClass *waypath_portal = new PathfindWaypathPortalClass;
+		waypath_portal->Set_Waypath_Pos (pos);
+		portal = waypath_portal;
+
+	} else {
+		portal = new PathfindPortalClass;
+	}
+
+	portal->Set_Bounding_Box (::Read_Box (src.Center, src.Extent));
+	portal->Set_Dest_Sectors (src.DestSector1, src.DestSector2);
+	portal->Set_ID (src.ID);
+	return portal;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Save_Flat_Data
+//
+///////////////////////////////////////////////////////////////////////////
+bool
+PathfindClass::Save_Flat_Data (ChunkSaveClass &csave)
+{
+	//
+	//	Count the portal references (temporary portals aren't saved)
+	//
+	int sector_count	= m_SectorList.Count ();
+	int ref_count		= 0;
+	int index;
+	for (index = 0; index < sector_count; index ++) {
+		PathfindSectorClass *sector = m_SectorList[index];
+		for (int portal_index = 0; portal_index < sector->Get_Portal_Count (); portal_index ++) {
+			PathfindPortalClass *portal = sector->Peek_Portal (portal_index);
+			if (portal != nullptr && portal->Get_ID () < TEMP_PORTAL_ID_START) {
+				ref_count ++;
+			}
+		}
+	}
+
+	//
+	//	Lay out the block
+	//
+	FlatHeaderStruct header;
+	header.Version					= FLAT_VERSION;
+	header.SectorCount			= sector_count;
+	header.SectorOffset			= sizeof (FlatHeaderStruct);
+	header.PortalRefCount		= ref_count;
+	header.PortalRefOffset		= header.SectorOffset + sector_count * sizeof (FlatSectorStruct);
+	header.PortalCount			= m_PortalList.Count ();
+	header.PortalOffset			= header.PortalRefOffset + ref_count * sizeof (uint32);
+	header.WaypathPortalCount	= m_WaypathPortalList.Count ();
+	header.WaypathPortalOffset	= header.PortalOffset + header.PortalCount * sizeof (FlatPortalStruct);
+	header.TotalSize				= header.WaypathPortalOffset + header.WaypathPortalCount * sizeof (FlatPortalStruct);
+
+	SimpleVecClass<uint8> buffer (header.TotalSize);
+	buffer.Zero_Memory ();
+	uint8 *block = &buffer[0];
+	::memcpy (block, &header, sizeof (header));
+
+	FlatSectorStruct *sectors	= (FlatSectorStruct *)(block + header.SectorOffset);
+	uint32 *portal_refs			= (uint32 *)(block + header.PortalRefOffset);
+	FlatPortalStruct *portals	= (FlatPortalStruct *)(block + header.PortalOffset);
+	FlatPortalStruct *wp_portals	= (FlatPortalStruct *)(block + header.WaypathPortalOffset);
+
+	//
+	//	Sectors and the portals they reference
+	//
+	int ref_index = 0;
+	for (index = 0; index < sector_count; index ++) {
+		PathfindSectorClass *sector	= m_SectorList[index];
+		FlatSectorStruct &dest			= sectors[index];
+
+		::Store_Box (sector->Get_Bounding_Box (), dest.Center, dest.Extent);
+		dest.FirstPortalRef	= ref_index;
+		dest.WaypathID			= -1;
+		dest.CullNodeIndex	= -1;
+
+		for (int portal_index = 0; portal_index < sector->Get_Portal_Count (); portal_index ++) {
+			PathfindPortalClass *portal = sector->Peek_Portal (portal_index);
+			if (portal != nullptr && portal->Get_ID () < TEMP_PORTAL_ID_START) {
+				portal_refs[ref_index ++] = portal->Get_ID ();
+			}
+		}
+		dest.PortalRefCount = ref_index - dest.FirstPortalRef;
+
+		PathfindWaypathSectorClass *waypath_sector = sector->As_PathfindWaypathSectorClass ();
+		if (waypath_sector != nullptr) {
+			dest.Flags		= FLAT_SECTOR_WAYPATH;
+			dest.WaypathID	= waypath_sector->Get_Waypath_ID ();
+		} else if (sector->Get_Culling_System () == &m_SectorTree) {
+			dest.CullNodeIndex = m_SectorTree.Get_Object_Node_Index (sector);
+		}
+	}
+
+	//
+	//	Portals
+	//
+	for (index = 0; index < m_PortalList.Count (); index ++) {
+		::Store_Portal (m_PortalList[index], &portals[index]);
+	}
+
+	for (index = 0; index < m_WaypathPortalList.Count (); index ++) {
+		::Store_Portal (m_WaypathPortalList[index], &wp_portals[index]);
+	}
+
+	return (csave.Write (block, header.TotalSize) == header.TotalSize);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Load_Flat_Data
+//
+///////////////////////////////////////////////////////////////////////////
+bool
+PathfindClass::Load_Flat_Data (ChunkLoadClass &cload)
+{
+	WWMEMLOG(MEM_PATHFIND);
+
+	//
+	//	Read the whole block in one go
+	//
+	uint32 size = cload.Cur_Chunk_Length ();
+	if (size < sizeof (FlatHeaderStruct)) {
+		return false;
+	}
+
+	SimpleVecClass<uint8> buffer (size);
+	const uint8 *block = &buffer[0];
+	if (cload.Read (&buffer[0], size) != size) {
+		return false;
+	}
+
+	//
+	//	Make sure the arrays are where the header says they are
+	//
+	const FlatHeaderStruct &header = *(const FlatHeaderStruct *)block;
+	if (	header.Version != FLAT_VERSION ||
+			header.TotalSize != size ||
+			!::Is_Array_Inside (header.SectorOffset, header.SectorCount, sizeof (FlatSectorStruct), size) ||
+			!::Is_Array_Inside (header.PortalRefOffset, header.PortalRefCount, sizeof (uint32), size) ||
+			!::Is_Array_Inside (header.PortalOffset, header.PortalCount, sizeof (FlatPortalStruct), size) ||
+			!::Is_Array_Inside (header.WaypathPortalOffset, header.WaypathPortalCount, sizeof (FlatPortalStruct), size))
+	{
+		WWDEBUG_SAY (("Pathfind: bad flat data block\r\n"));
+		return false;
+	}
+
+	const FlatSectorStruct *sectors		= (const FlatSectorStruct *)(block + header.SectorOffset);
+	const uint32 *portal_refs				= (const uint32 *)(block + header.PortalRefOffset);
+	const FlatPortalStruct *portals		= (const FlatPortalStruct *)(block + header.PortalOffset);
+	const FlatPortalStruct *wp_portals	= (const FlatPortalStruct *)(block + header.WaypathPortalOffset);
+
+	//
+	//	Size the lists up front
+	//
+	m_SectorList.Resize (m_SectorList.Count () + header.SectorCount);
+	m_PortalList.Resize (m_PortalList.Count () + header.PortalCount);
+	m_WaypathPortalList.Resize (m_WaypathPortalList.Count () + header.WaypathPortalCount);
+
+	//
+	//	Sectors
+	//
+	uint32 index;
+	for (index = 0; index < header.SectorCount; index ++) {
+		const FlatSectorStruct &src = sectors[index];
+		if (src.FirstPortalRef > header.PortalRefCount || src.PortalRefCount > header.PortalRefCount - src.FirstPortalRef) {
+			return false;
+		}
+
+		PathfindSectorClass *sector = nullptr;
+		if (src.Flags & FLAT_SECTOR_WAYPATH) {
+			PathfindWaypathSectorClass *waypath_sector = new PathfindWaypathSectorClass;
+			waypath_sector->Set_Waypath_ID (src.WaypathID);
+			sector = waypath_sector;
+		} else {
+			sector = new PathfindSectorClass;
+		}
+
+		sector->Set_Bounding_Box (::Read_Box (src.Center, src.Extent));
+		sector->Set_Portal_List (portal_refs + src.FirstPortalRef, src.PortalRefCount);
+
+		//
+		//	Link the sector back into the node of the culling tree it was saved in
+		//
+		if (sector->As_PathfindWaypathSectorClass () == nullptr) {
+			m_SectorTree.Add_Object (sector, src.CullNodeIndex);
+		}
+
+		Add_Sector (sector, false);
+		sector->Release_Ref ();
+	}
+
+	//
+	//	Portals
+	//
+	int first_portal = m_PortalList.Count ();
+	for (index = 0; index < header.PortalCount; index ++) {
+		m_PortalList.Add (::Create_Portal (portals[index]));
+		_MemoryFootprint += sizeof (PathfindPortalClass);
+	}
+
+	for (index = 0; index < header.WaypathPortalCount; index ++) {
+		if (wp_portals[index].Type != FLAT_PORTAL_WAYPATH) {
+			return false;
+		}
+
+		PathfindPortalClass *portal = ::Create_Portal (wp_portals[index]);
+		m_WaypathPortalList.Add (portal->As_PathfindWaypathPortalClass ());
+		_MemoryFootprint += sizeof (PathfindPortalClass);
+	}
+
+	//
+	//	Now that every portal exists, hook up the action portals to the
+	// portals they enter and exit by.  (These links aren't ref-counted,
+	// see PathfindActionPortalClass::Load_Variables.)
+	//
+	for (index = 0; index < header.PortalCount; index ++) {
+		const FlatPortalStruct &src = portals[index];
+		if (src.Type == FLAT_PORTAL_ACTION) {
+			PathfindActionPortalClass *action_portal = m_PortalList[first_portal + index]->As_PathfindActionPortalClass ();
+
+			if (src.ExitPortalID >= 0) {
+				action_portal->Set_Exit_Portal (Peek_Portal (src.ExitPortalID));
+			}
+
+			if (src.EnterPortalID >= 0) {
+				PathfindPortalClass *enter_portal = Peek_Portal (src.EnterPortalID);
+				if (enter_portal != nullptr) {
+					action_portal->Set_Enter_Portal (enter_portal->As_PathfindActionPortalClass ());
+				}
+			}
+		}
+	}
+
+	WWDEBUG_SAY (("Pathfind: loaded %d sectors and %d portals from flat data.\r\n",
+		header.SectorCount, header.PortalCount + header.WaypathPortalCount));
+	return true;
+}
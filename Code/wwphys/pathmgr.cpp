@@ -41,6 +41,9 @@
 #include "win.h"
 #include "wwmemlog.h"
 #include "systimer.h"
+#include "jobpool.h"
+#include <algorithm>
+#include <atomic>
 
 
 ////////////////////////////////////////////////////////////////
@@ -57,8 +60,12 @@ enum
 /////////////////////////////////////////////////////////////////////////
 DynamicVectorClass<PathSolveClass *>	PathMgrClass::AvailablePathList;
 DynamicVectorClass<PathSolveClass *>	PathMgrClass::UsedPathList;
-PathSolveClass *								PathMgrClass::ActivePath = nullptr;
+DynamicVectorClass<PathSolveClass *>	PathMgrClass::ActivePathList;
+int												PathMgrClass::MaxActivePaths = 8;
 int64_t											PathMgrClass::TicksPerMilliSec = 0;
+PathMgrClass::StatsStruct					PathMgrClass::Stats = { };
+bool												PathMgrClass::RecordRequests = false;
+DynamicVectorClass<PathMgrClass::RequestStruct>	PathMgrClass::RecordedRequests;
 
 
 /////////////////////////////////////////////////////////////////////////
@@ -66,6 +73,12 @@ int64_t											PathMgrClass::TicksPerMilliSec = 0;
 /////////////////////////////////////////////////////////////////////////
 static const int DEFAULT_OBJ_COUNT	= 15;
 
+//
+//	How many paths to keep in flight for each thread solving them, so a thread
+// that finishes its path early has another one to move on to.
+//
+static const int PATHS_PER_LANE		= 2;
+
 
 /////////////////////////////////////////////////////////////////////////
 //
@@ -110,10 +123,7 @@ PathMgrClass::Shutdown (void)
 void
 PathMgrClass::Free_Objects (void)
 {
-	if (ActivePath != nullptr) {
-		ActivePath->Unlink_Pathfind_Hooks ();
-		ActivePath = nullptr;
-	}
+	ActivePathList.Delete_All ();
 
 	//
 	//	Free the list of available objects
@@ -231,12 +241,9 @@ PathMgrClass::Return_Path_Object (PathSolveClass *path)
 			if (used_index != -1) {
 
 				//
-				//	Reset our active path pointer (if necessary)
+				//	Stop solving the path (if necessary)
 				//
-				if (path == ActivePath) {
-					ActivePath->Unlink_Pathfind_Hooks ();
-					ActivePath = nullptr;
-				}
+				Remove_Active_Path (path);
 
 				//
 				//	Remove the object from the used list
@@ -326,6 +333,48 @@ Get_Time (void)
 }
 
 
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Get_Path_Priority
+//
+///////////////////////////////////////////////////////////////////////////
+static float
+Get_Path_Priority (PathSolveClass *path, const Vector3 &camera_pos)
+{
+	//
+	//	Get the different priority factors for this path
+	//
+	float dist				= (path->Get_Start_Pos () - camera_pos).Length ();
+	float pos_priority	= 1.0F - WWMath::Clamp (dist / 20.0F, 0.0F, 1.0F);
+	float path_priority	= WWMath::Clamp (path->Get_Priority (), 0.0F, 1.0F);
+	float time_priority	= (TIMEGETTIME () - path->Get_Birth_Time ()) / 5000.0F;
+
+	//
+	//	Calculate a final priority based on these factors
+	//
+	return (path_priority * 0.5F) + (pos_priority * 0.5F) + time_priority;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Solve_Path
+//
+///////////////////////////////////////////////////////////////////////////
+static inline void
+Solve_Path (PathSolveClass *path, int64_t end_time, int64_t ticks_per_ms)
+{
+	//
+	//	Let this path think for (up to) the remainder of our timeslice
+	//
+	int64_t time_left = std::max (end_time - Get_Time (), (int64_t)0);
+	path->Timestep (uint32(time_left / ticks_per_ms));
+	return ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 //
 //	Resolve_Paths
@@ -345,36 +394,113 @@ PathMgrClass::Resolve_Paths (const Vector3 &camera_pos, uint32 milliseconds)
 	do
 	{
 		//
-		//	Find a path that needs to be solved
+		//	Top up the paths being solved from the ones waiting
 		//
-		if (ActivePath == nullptr) {
-			Activate_New_Priority_Path (camera_pos);
-		}
+		Activate_New_Priority_Paths (camera_pos);
 
 		//
 		//	Do we have any paths to solve?
 		//
-		if (ActivePath != nullptr) {
+		if (ActivePathList.Count () == 0) {
+			break;
+		}
 
-			//
-			//	Let this path think for (up to) the remainder of our timeslice
-			//
-			uint32 time_slice = uint32((end_time - Get_Time ()) / TicksPerMilliSec);
-			PathSolveClass::STATE_DESC result = ActivePath->Timestep (time_slice);
+		Solve_Active_Paths (end_time);
+		Retire_Finished_Paths ();
+
+	} while (Get_Time () < end_time);
+
+	//
+	//	Count the paths still waiting for a thread
+	//
+	Stats.QueueLength = 0;
+	for (int index = 0; index < UsedPathList.Count (); index ++) {
+		PathSolveClass *path = UsedPathList[index];
+		if (path->Get_State () == PathSolveClass::THINKING && Is_Path_Active (path) == false) {
+			Stats.QueueLength ++;
+		}
+	}
+	Stats.MaxQueueLength = std::max (Stats.MaxQueueLength, Stats.QueueLength);
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Activate_New_Priority_Paths
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+void
+PathMgrClass::Activate_New_Priority_Paths (const Vector3 &camera_pos)
+{
+	int lanes		= JobPoolClass::Get_Worker_Count () + 1;
+	int max_active	= std::min (MaxActivePaths, lanes * PATHS_PER_LANE);
+
+	while (ActivePathList.Count () < max_active) {
+
+		//
+		//	Find the highest priority path that needs solving
+		//
+		PathSolveClass *best_path	= nullptr;
+		float best_priority			= 0;
+		for (int index = 0; index < UsedPathList.Count (); index ++) {
+			PathSolveClass *path = UsedPathList[index];
 
 			//
-			//	If the path finished solving, then reset the active path
+			//	Don't bother with paths that are already solved or being solved
 			//
-			if (result != PathSolveClass::THINKING) {
-				ActivePath->Unlink_Pathfind_Hooks ();
-				ActivePath = nullptr;
+			if (path->Get_State () == PathSolveClass::THINKING && Is_Path_Active (path) == false) {
+
+				//
+				//	If this is best path so far, then choose it
+				//
+				float priority = Get_Path_Priority (path, camera_pos);
+				if (priority > best_priority) {
+					best_priority	= priority;
+					best_path		= path;
+				}
 			}
+		}
 
-		} else {
+		if (best_path == nullptr) {
 			break;
 		}
 
-	} while (Get_Time () < end_time);
+		//
+		//	Record how long the path waited for a thread
+		//
+		uint32 queue_time = TIMEGETTIME () - best_path->Get_Birth_Time ();
+		Stats.PathsStarted ++;
+		Stats.TotalQueueTime += queue_time;
+		Stats.MaxQueueTime = std::max (Stats.MaxQueueTime, queue_time);
+
+		//
+		//	Kick off the pathfind
+		//
+		best_path->Process_Initial_Sector ();
+		if (best_path->Get_State () == PathSolveClass::THINKING) {
+			ActivePathList.Add (best_path);
+		} else {
+			Record_Finished_Path (best_path);
+		}
+	}
+
+	//
+	//	Hand out the threads in priority order
+	//
+	int count = ActivePathList.Count ();
+	for (int index = 1; index < count; index ++) {
+		PathSolveClass *path	= ActivePathList[index];
+		float priority			= Get_Path_Priority (path, camera_pos);
+
+		int dest = index;
+		while (dest > 0 && Get_Path_Priority (ActivePathList[dest - 1], camera_pos) < priority) {
+			ActivePathList[dest] = ActivePathList[dest - 1];
+			dest --;
+		}
+		ActivePathList[dest] = path;
+	}
 
 	return ;
 }
@@ -382,54 +508,168 @@ PathMgrClass::Resolve_Paths (const Vector3 &camera_pos, uint32 milliseconds)
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 //
-//	Activate_New_Priority_Path
+//	Solve_Active_Paths
 //
 ////////////////////////////////////////////////////////////////////////////////////////////
 void
-PathMgrClass::Activate_New_Priority_Path (const Vector3 &camera_pos)
+PathMgrClass::Solve_Active_Paths (int64_t end_time)
 {
-	ActivePath				= nullptr;
-	float	best_priority	= 0;
+	int count	= ActivePathList.Count ();
+	int lanes	= std::min (count, JobPoolClass::Get_Worker_Count () + 1);
 
-	//
-	//	Find the highest priority path that needs solving
-	//
-	for (int index = 0; index < UsedPathList.Count (); index ++) {
-		PathSolveClass *path = UsedPathList[index];
+	Stats.LanesUsed			= lanes;
+	Stats.MaxPathsInFlight	= std::max (Stats.MaxPathsInFlight, count);
+
+	if (lanes < 2 || JobPoolClass::Is_Worker_Thread ()) {
 
 		//
-		//	Don't bother with paths that are already solved
+		//	Solve the paths one after the other on this thread
 		//
-		if (path->Get_State () == PathSolveClass::THINKING) {
-
-			//
-			//	Get the different priority factors for this path
-			//
-			float dist				= (path->Get_Start_Pos () - camera_pos).Length ();
-			float pos_priority	= 1.0F - WWMath::Clamp (dist / 20.0F, 0.0F, 1.0F);
-			float path_priority	= WWMath::Clamp (path->Get_Priority (), 0.0F, 1.0F);
-			float time_priority	= (TIMEGETTIME () - path->Get_Birth_Time ()) / 5000.0F;
+		for (int index = 0; index < count; index ++) {
+			Solve_Path (ActivePathList[index], end_time, TicksPerMilliSec);
+			if (Get_Time () >= end_time) {
+				break;
+			}
+		}
 
-			//
-			//	Calculate a final priority based on these factors
-			//
-			float priority	= (path_priority * 0.5F) + (pos_priority * 0.5F) + time_priority;
+	} else {
 
-			//
-			//	If this is best path so far, then choose it
-			//
-			if (priority > best_priority) {
-				best_priority	= priority ;
-				ActivePath		= path;
+		//
+		//	Each lane takes the next path that hasn't been started.  The solves only read
+		// the pathfind sectors and portals, all of their search state is their own.
+		//
+		std::atomic<int> next_path (0);
+		PathSolveClass **paths	= &ActivePathList[0];
+		int64_t ticks_per_ms		= TicksPerMilliSec;
+
+		JobPoolClass::Run (lanes,
+			[paths, count, end_time, ticks_per_ms, &next_path] (int) {
+				for (int index = next_path ++; index < count; index = next_path ++) {
+					if (Get_Time () >= end_time) {
+						break;
+					}
+					Solve_Path (paths[index], end_time, ticks_per_ms);
+				}
 			}
+		);
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Retire_Finished_Paths
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+void
+PathMgrClass::Retire_Finished_Paths (void)
+{
+	for (int index = ActivePathList.Count () - 1; index >= 0; index --) {
+		PathSolveClass *path = ActivePathList[index];
+		if (path->Get_State () != PathSolveClass::THINKING) {
+			Record_Finished_Path (path);
+			ActivePathList.Delete (index);
 		}
 	}
 
-	//
-	//	Kick off the pathfind
-	//
-	if (ActivePath != nullptr) {
-		ActivePath->Process_Initial_Sector ();
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Record_Finished_Path
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+void
+PathMgrClass::Record_Finished_Path (PathSolveClass *path)
+{
+	uint32 solve_time = TIMEGETTIME () - path->Get_Birth_Time ();
+	Stats.PathsFinished ++;
+	Stats.TotalSolveTime += solve_time;
+	Stats.MaxSolveTime = std::max (Stats.MaxSolveTime, solve_time);
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Is_Path_Active
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+bool
+PathMgrClass::Is_Path_Active (PathSolveClass *path)
+{
+	return (ActivePathList.ID (path) != -1);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Remove_Active_Path
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+void
+PathMgrClass::Remove_Active_Path (PathSolveClass *path)
+{
+	int index = ActivePathList.ID (path);
+	if (index != -1) {
+		ActivePathList.Delete (index);
+	}
+
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Set_Max_Active_Paths
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+void
+PathMgrClass::Set_Max_Active_Paths (int count)
+{
+	MaxActivePaths = std::max (count, 1);
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Reset_Stats
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+void
+PathMgrClass::Reset_Stats (void)
+{
+	Stats = StatsStruct ();
+	return ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	Record_Request
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+void
+PathMgrClass::Record_Request
+(
+	const Vector3 &			start,
+	const Vector3 &			dest,
+	float							sector_fudge,
+	const PathObjectClass &	path_object
+)
+{
+	if (RecordRequests) {
+		RequestStruct request;
+		request.StartPos		= start;
+		request.DestPos		= dest;
+		request.SectorFudge	= sector_fudge;
+		request.PathObject	= path_object;
+		RecordedRequests.Add (request);
 	}
 
 	return ;
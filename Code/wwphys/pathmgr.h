@@ -45,6 +45,7 @@
 #include "vector.h"
 #include "vector3.h"
 #include "bittype.h"
+#include "PathObject.h"
 #include <cstdint>
 
 
@@ -76,10 +77,57 @@ public:
 	static void						Shutdown (void);
 
 	//
-	//	Path resolution
+	//	Path resolution.  Up to Get_Max_Active_Paths paths are solved at a time, spread
+	// over the job pool.  Each Resolve_Paths call gives every worker (and the calling
+	// thread) the same time slice.
 	//
 	static void						Resolve_Paths (const Vector3 &camera_pos, uint32 milliseconds = 5);
-	static PathSolveClass *		Peek_Active_Path (void)	{ return ActivePath; }
+	static void						Set_Max_Active_Paths (int count);
+	static int						Get_Max_Active_Paths (void)	{ return MaxActivePaths; }
+	static bool						Is_Path_Active (PathSolveClass *path);
+	static void						Remove_Active_Path (PathSolveClass *path);
+
+	//
+	//	Statistics.  Times are in milliseconds; the queue time is from the request
+	// (Reset) until the solve started, the solve time from the request until it finished.
+	//
+	struct StatsStruct
+	{
+		int								PathsStarted;
+		int								PathsFinished;
+		uint32							TotalQueueTime;
+		uint32							MaxQueueTime;
+		uint32							TotalSolveTime;
+		uint32							MaxSolveTime;
+		int								QueueLength;
+		int								MaxQueueLength;
+		int								MaxPathsInFlight;
+		int								LanesUsed;
+	};
+
+	static const StatsStruct &	Get_Stats (void)	{ return Stats; }
+	static void						Reset_Stats (void);
+
+	//
+	//	Request recording.  While enabled, every path reset is remembered so the
+	// same searches can be replayed later (see the path_bench console command).
+	//
+	struct RequestStruct
+	{
+		Vector3							StartPos;
+		Vector3							DestPos;
+		float								SectorFudge;
+		PathObjectClass				PathObject;
+
+		bool operator== (const RequestStruct &/* src*/) { return false; }
+		bool operator!= (const RequestStruct &/* src*/) { return true; }
+	};
+
+	static void						Enable_Request_Recording (bool onoff)	{ RecordRequests = onoff; }
+	static bool						Is_Request_Recording_Enabled (void)		{ return RecordRequests; }
+	static void						Record_Request (const Vector3 &start, const Vector3 &dest, float sector_fudge, const PathObjectClass &path_object);
+	static void						Reset_Recorded_Requests (void)			{ RecordedRequests.Delete_All (); }
+	static const DynamicVectorClass<RequestStruct> &	Get_Recorded_Requests (void)	{ return RecordedRequests; }
 
 	//
 	//	Save/Load
@@ -100,15 +148,22 @@ private:
 	/////////////////////////////////////////////////////////////////////////
 	static void						Allocate_Objects (void);
 	static void						Free_Objects (void);
-	static void						Activate_New_Priority_Path (const Vector3 &camera_pos);
+	static void						Activate_New_Priority_Paths (const Vector3 &camera_pos);
+	static void						Solve_Active_Paths (int64_t end_time);
+	static void						Retire_Finished_Paths (void);
+	static void						Record_Finished_Path (PathSolveClass *path);
 
 	/////////////////////////////////////////////////////////////////////////
 	// Private member data
 	/////////////////////////////////////////////////////////////////////////
 	static DynamicVectorClass<PathSolveClass *>	AvailablePathList;
 	static DynamicVectorClass<PathSolveClass *>	UsedPathList;
-	static PathSolveClass *								ActivePath;
+	static DynamicVectorClass<PathSolveClass *>	ActivePathList;
+	static int												MaxActivePaths;
 	static int64_t											TicksPerMilliSec;
+	static StatsStruct									Stats;
+	static bool												RecordRequests;
+	static DynamicVectorClass<RequestStruct>		RecordedRequests;
 };
 
 
@@ -38,4 +38,17 @@
 #include "PathNode.h"
 
 
-DEFINE_AUTO_POOL(PathNodeClass, 512);
+/////////////////////////////////////////////////////////////////////////
+//
+//	~PathNodeArenaClass
+//
+/////////////////////////////////////////////////////////////////////////
+PathNodeArenaClass::~PathNodeArenaClass (void)
+{
+	for (int index = 0; index < m_Blocks.Count (); index ++) {
+		delete [] m_Blocks[index];
+	}
+
+	m_Blocks.Delete_All ();
+	return ;
+}
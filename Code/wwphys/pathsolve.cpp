@@ -209,9 +209,11 @@ PathSolveClass::PathSolveClass (void)
 		m_DestSector (nullptr),
 		m_CompletedNode (nullptr),
 		m_State (ERROR_INVALID_START_POS),
-		m_BinaryHeap (10000),
 		m_Priority (0.5F),
-		m_BirthTime (0)
+		m_BirthTime (0),
+		m_UseCorridor (false),
+		m_StoreCorridor (false),
+		m_ClusterSerial (0)
 {
 	//
 	//	Determine how many performance-counter ticks
@@ -222,7 +224,6 @@ PathSolveClass::PathSolveClass (void)
 		_TicksPerMilliSec /= 1000;
 	}
 
-	m_NodeList.Set_Growth_Step (500);
 	return ;
 }
 
@@ -239,9 +240,11 @@ PathSolveClass::PathSolveClass (const Vector3 &start, const Vector3 &dest)
 		m_DestSector (nullptr),
 		m_CompletedNode (nullptr),
 		m_State (ERROR_INVALID_START_POS),
-		m_BinaryHeap (10000),
 		m_Priority (0.5F),
-		m_BirthTime (0)
+		m_BirthTime (0),
+		m_UseCorridor (false),
+		m_StoreCorridor (false),
+		m_ClusterSerial (0)
 {
 	//
 	//	Determine how many performance-counter ticks
@@ -253,7 +256,6 @@ PathSolveClass::PathSolveClass (const Vector3 &start, const Vector3 &dest)
 	}
 
 	Reset (start, dest);
-	m_NodeList.Set_Growth_Step (500);
 	return ;
 }
 
@@ -285,6 +287,7 @@ PathSolveClass::Reset
 {
 	WWMEMLOG(MEM_PATHFIND);
 	Reset_Lists ();
+	PathMgrClass::Record_Request (start, dest, sector_fudge, m_PathObject);
 
 	m_StartPos		= start;
 	m_DestPos		= dest;
@@ -293,41 +296,6 @@ PathSolveClass::Reset
 }
 
 
-///////////////////////////////////////////////////////////////////////////
-//
-//	Begin_Distributed_Solve
-//
-///////////////////////////////////////////////////////////////////////////
-/*void
-PathSolveClass::Begin_Distributed_Solve (void)
-{
-	for (int index = 0; index < m_NodeList.Count (); index ++) {
-		PathNodeClass *node = m_NodeList[index];
-		if (node != nullptr) {
-			node->Reconnect_To_Portal ();
-		}
-	}
-
-	return ;
-}*/
-
-
-///////////////////////////////////////////////////////////////////////////
-//
-//	Unlink_Pathfind_Hooks
-//
-///////////////////////////////////////////////////////////////////////////
-void
-PathSolveClass::Unlink_Pathfind_Hooks (void)
-{
-	for (int index = 0; index < m_NodeList.Count (); index ++) {
-		m_NodeList[index]->Disconnect_From_Portal ();
-	}
-
-	return ;
-}
-
-
 ///////////////////////////////////////////////////////////////////////////
 //
 //	Resolve_Path
@@ -342,7 +310,6 @@ PathSolveClass::Resolve_Path (unsigned int milliseconds)
 	int64_t end_time		= start_time + (((int64_t)milliseconds) * _TicksPerMilliSec);
 
 	int iterations = 0;
-	//Begin_Distributed_Solve ();
 
 	do
 	{
@@ -350,13 +317,23 @@ PathSolveClass::Resolve_Path (unsigned int milliseconds)
 		//	Pop the least cost path 'node' from the open list and process
 		// all of its adjacent sectors.
 		//
-		PathNodeClass *node = (PathNodeClass *)m_BinaryHeap.Remove_Min ();
+		PathNodeClass *node = m_OpenList.Remove_Min ();
 
 		//
 		//	Have we found our path?
 		//
 		if (node == nullptr) {
-			m_State = ERROR_NO_PATH;
+
+			//
+			//	If the search was limited to a cached corridor, try again
+			// over the whole graph before giving up.
+			//
+			if (m_UseCorridor) {
+				Drop_Corridor ();
+			} else {
+				m_State = ERROR_NO_PATH;
+			}
+
 		} else  if (node->Peek_Sector () == m_DestSector) {
 			m_State = SOLVED_PATH;
 
@@ -364,7 +341,6 @@ PathSolveClass::Resolve_Path (unsigned int milliseconds)
 			//	Record this path as 'final'
 			//
 			m_CompletedNode = node;
-			m_CompletedNode->Add_Ref ();
 
 			//
 			//	Mark all the nodes that are on the final path
@@ -381,6 +357,13 @@ PathSolveClass::Resolve_Path (unsigned int milliseconds)
 			//
 			Post_Process_Path ();
 
+			//
+			//	Remember which clusters the path went through
+			//
+			if (m_StoreCorridor) {
+				Store_Corridor ();
+			}
+
 		} else {
 			Process_Portals (node);
 		}
@@ -393,8 +376,6 @@ PathSolveClass::Resolve_Path (unsigned int milliseconds)
 	//
 	} while ((m_State == THINKING) && (Get_Time () < end_time));
 
-	//End_Distributed_Solve ();
-
 	//WWDebug_Printf ("Time spent in pathfind: %d 1/100 millis, loops = %d, finished = %d.\r\n", (unsigned int)((Get_Time () - start_time) / (_TicksPerMilliSec/100)), iterations, (int)(m_State == TRAVERSING_PATH));
 	return ;
 }
@@ -474,6 +455,43 @@ PathSolveClass::Process_Initial_Sector (void)
 		return ;
 	}
 
+	//
+	//	See if the cluster graph can rule out or narrow down the search
+	//
+	Lookup_Corridor ();
+	if (m_State == ERROR_NO_PATH) {
+		return ;
+	}
+
+	Submit_Initial_Portals ();
+
+	if (m_StartSector == m_DestSector) {
+
+		//
+		//	If the start and destination are the same
+		// sector, then we can just beeline.
+		//
+		m_State = SOLVED_PATH;
+		m_Path.Reset_Active ();
+		m_Path.Add (PathDataStruct (nullptr, m_StartPos));
+		m_Path.Add (PathDataStruct (nullptr, m_DestPos));
+
+	} else {
+		m_State = THINKING;
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Submit_Initial_Portals
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathSolveClass::Submit_Initial_Portals (void)
+{
 	//
 	//	Create a set of path 'nodes' that represent all the portals of the
 	//	starting sector.
@@ -506,32 +524,20 @@ PathSolveClass::Process_Initial_Sector (void)
 			//
 			//	Sumbit a node for this portal
 			//
-			if (Does_Object_Have_Access_To_Portal (portal)) {
+			PathfindSectorClass *dest_sector = portal->Peek_Dest_Sector (m_StartSector);
+			if (	Does_Object_Have_Access_To_Portal (portal) &&
+					(m_UseCorridor == false || Is_Sector_In_Corridor (dest_sector)))
+			{
 				Submit_Node (	0,
 									nullptr,
 									portal,
-									portal->Peek_Dest_Sector (m_StartSector),
+									dest_sector,
 									Matrix3D (m_StartPos),
 									ending_tm);
 			}
 		}
 	}
 
-	if (m_StartSector == m_DestSector) {
-
-		//
-		//	If the start and destination are the same
-		// sector, then we can just beeline.
-		//
-		m_State = SOLVED_PATH;
-		m_Path.Delete_All ();
-		m_Path.Add (PathDataStruct (nullptr, m_StartPos));
-		m_Path.Add (PathDataStruct (nullptr, m_DestPos));
-
-	} else {
-		m_State = THINKING;
-	}
-
 	return ;
 }
 
@@ -1033,7 +1039,9 @@ PathSolveClass::Process_Portals (PathNodeClass *node)
 			//	Get this portal's destination
 			//
 			PathfindSectorClass *dest_sector = portal->Peek_Dest_Sector (sector);
-			if (dest_sector != nullptr) {
+			if (	dest_sector != nullptr &&
+					(m_UseCorridor == false || Is_Sector_In_Corridor (dest_sector)))
+			{
 
 				//
 				//	Determine if we can pass through this portal, and if so where
@@ -1053,10 +1061,6 @@ PathSolveClass::Process_Portals (PathNodeClass *node)
 		}
 	}
 
-	if (last_portal != nullptr) {
-		last_portal->m_ClosedListPtr = node;
-	}
-
 	return ;
 }
 
@@ -1160,12 +1164,18 @@ PathSolveClass::Submit_Node
 		current_traversal_cost += dest_dist * 2.0F;
 	}
 
+	//
+	//	Has the search already reached this portal?
+	//
+	PathNodeClass *portal_node = nullptr;
+	m_PortalNodes.Get (portal->Get_ID (), portal_node);
+
 	//
 	//	Is this sector already in the open list?
 	//
-	int open_index = portal->Get_Heap_Location ();
-	if (open_index > 0) {
-		PathNodeClass *open_version = (PathNodeClass *)m_BinaryHeap.Peek_Node (open_index);
+	if (portal_node != nullptr && portal_node->Is_In_Closed_List () == false) {
+		int open_index = portal_node->Get_Heap_Location ();
+		PathNodeClass *open_version = m_OpenList.Peek_Node (open_index);
 
 		//
 		//	If the traversal cost is lower from our current 'path', then
@@ -1179,7 +1189,7 @@ PathSolveClass::Submit_Node
 			open_version->Set_Transform (ending_tm);
 			open_version->Set_Heuristic_Cost (heuristic_cost);
 
-			m_BinaryHeap.Percolate_Up (open_index);
+			m_OpenList.Percolate_Up (open_index);
 		}
 
 	} else {
@@ -1187,8 +1197,8 @@ PathSolveClass::Submit_Node
 		//
 		//	Is this sector already in the closed list?
 		//
-		if (portal->m_ClosedListPtr != nullptr) {
-			PathNodeClass *closed_version	= portal->m_ClosedListPtr;
+		if (portal_node != nullptr) {
+			PathNodeClass *closed_version	= portal_node;
 
 			//
 			//	If the traversal cost is lower from our current 'path', then
@@ -1196,14 +1206,13 @@ PathSolveClass::Submit_Node
 			//
 			if (current_traversal_cost < closed_version->Get_Traversal_Cost ()) {
 
-				portal->m_ClosedListPtr = nullptr;
 				closed_version->Set_Sector (dest_sector);
 				closed_version->Set_Parent_Node (current_node);
 				closed_version->Set_Traversal_Cost (current_traversal_cost);
 				closed_version->Set_Transform (ending_tm);
 				closed_version->Set_Heuristic_Cost (heuristic_cost);
 
-				m_BinaryHeap.Insert (closed_version);
+				m_OpenList.Insert (closed_version);
 			}
 
 		} else {
@@ -1212,7 +1221,7 @@ PathSolveClass::Submit_Node
 			//	Create a new path 'node' that represents that path from start
 			// up until this sector.
 			//
-			PathNodeClass *new_node = new PathNodeClass;
+			PathNodeClass *new_node = m_NodeArena.Allocate ();
 			new_node->Set_Sector (dest_sector);
 			new_node->Set_Parent_Node (current_node);
 			new_node->Set_Portal (portal);
@@ -1227,12 +1236,12 @@ PathSolveClass::Submit_Node
 			//
 			//	Insert this node into the open list
 			//
-			m_BinaryHeap.Insert (new_node);
+			m_OpenList.Insert (new_node);
 
 			//
-			//	Keep track of this node's pointer (for cleanup)
+			//	Remember which node reached this portal
 			//
-			m_NodeList.Add (new_node);
+			m_PortalNodes.Insert (portal->Get_ID (), new_node);
 		}
 	}
 
@@ -1249,28 +1258,189 @@ void
 PathSolveClass::Reset_Lists (void)
 {
 	//
-	//	Ensure we unlink our data before we destroy it...
+	//	Make sure the path manager isn't still solving this path
+	//
+	PathMgrClass::Remove_Active_Path (this);
+
+	m_CompletedNode = nullptr;
+
+	//
+	//	Recycle all our nodes (the memory is kept for the next solve)
 	//
-	if (PathMgrClass::Peek_Active_Path () == this) {
-		Unlink_Pathfind_Hooks ();
+	m_NodeArena.Reset ();
+	m_OpenList.Reset ();
+	m_PortalNodes.Remove_All ();
+
+	m_UseCorridor		= false;
+	m_StoreCorridor	= false;
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Lookup_Corridor
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathSolveClass::Lookup_Corridor (void)
+{
+	m_UseCorridor		= false;
+	m_StoreCorridor	= false;
+
+	PathfindClass *pathfind				= PathfindClass::Get_Instance ();
+	PathClusterGraphClass &graph		= pathfind->Get_Cluster_Graph ();
+	PathCorridorCacheClass &cache		= pathfind->Get_Corridor_Cache ();
+	if (cache.Is_Enabled () == false || m_DestSector == nullptr) {
+		return ;
+	}
+
+	//
+	//	Paths inside one cluster are short enough to search directly
+	//
+	int start_cluster	= m_StartSector->Get_Cluster_ID ();
+	int dest_cluster	= m_DestSector->Get_Cluster_ID ();
+	if (start_cluster < 0 || dest_cluster < 0 || start_cluster == dest_cluster) {
+		return ;
+	}
+
+	//
+	//	If no chain of portals joins the two clusters there's nothing to search
+	//
+	if (graph.Can_Clusters_Connect (start_cluster, dest_cluster) == false) {
+		cache.Record_Unreachable ();
+		m_State = ERROR_NO_PATH;
+		return ;
+	}
+
+	PathCorridorCacheClass::Build_Key (start_cluster, dest_cluster, m_PathObject, &m_CorridorKey);
+	m_ClusterSerial = graph.Get_Serial_Number ();
+
+	if (cache.Lookup (m_CorridorKey, m_CorridorClusters)) {
+
+		//
+		//	Build a bit mask of the corridor's clusters for quick tests
+		//
+		int word_count = (graph.Get_Cluster_Count () + 31) / 32;
+		if (m_CorridorMask.Length () < word_count) {
+			m_CorridorMask.Resize (word_count);
+		}
+		m_CorridorMask.Zero_Memory ();
+
+		for (int index = 0; index < m_CorridorClusters.Count (); index ++) {
+			int cluster_id = m_CorridorClusters[index];
+			if (cluster_id >= 0 && (cluster_id >> 5) < m_CorridorMask.Length ()) {
+				m_CorridorMask[cluster_id >> 5] |= (1U << (cluster_id & 31));
+			}
+		}
+
+		m_UseCorridor = true;
+	} else {
+		m_StoreCorridor = true;
+	}
+
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Drop_Corridor
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathSolveClass::Drop_Corridor (void)
+{
+	PathfindClass::Get_Instance ()->Get_Corridor_Cache ().Record_Fallback ();
+
+	//
+	//	Start the search over without the limit, and replace the cached
+	// corridor with whatever this search finds.
+	//
+	m_NodeArena.Reset ();
+	m_OpenList.Reset ();
+	m_PortalNodes.Remove_All ();
+
+	m_UseCorridor		= false;
+	m_StoreCorridor	= true;
+	Submit_Initial_Portals ();
+	return ;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	Store_Corridor
+//
+///////////////////////////////////////////////////////////////////////////
+void
+PathSolveClass::Store_Corridor (void)
+{
+	PathfindClass *pathfind = PathfindClass::Get_Instance ();
+	if (pathfind->Get_Cluster_Graph ().Get_Serial_Number () != m_ClusterSerial) {
+		return ;
 	}
 
-	REF_PTR_RELEASE (m_CompletedNode);
+	int cluster_list[PathCorridorCacheClass::MAX_CORRIDOR_CLUSTERS];
+	int count = 0;
 
 	//
-	//	Free all our nodes
+	//	Collect the (unique) clusters of every sector on the path, starting
+	// with the destination and ending with the start sector.
 	//
-	for (int index = 0; index < m_NodeList.Count (); index ++) {
-		PathNodeClass *node = m_NodeList[index];
-		REF_PTR_RELEASE (node);
+	PathNodeClass *path_node = m_CompletedNode;
+	for (bool done = false; done == false; ) {
+
+		PathfindSectorClass *sector = m_StartSector;
+		if (path_node != nullptr) {
+			sector		= path_node->Peek_Sector ();
+			path_node	= path_node->Peek_Parent_Node ();
+		} else {
+			done = true;
+		}
+
+		int cluster_id = sector->Get_Cluster_ID ();
+		if (cluster_id < 0) {
+			return ;
+		}
+
+		bool found = false;
+		for (int index = count - 1; index >= 0 && found == false; index --) {
+			found = (cluster_list[index] == cluster_id);
+		}
+
+		if (found == false) {
+			if (count == PathCorridorCacheClass::MAX_CORRIDOR_CLUSTERS) {
+				return ;
+			}
+			cluster_list[count ++] = cluster_id;
+		}
 	}
 
-	m_BinaryHeap.Flush_Array ();
-	m_NodeList.Reset_Active ();
+	pathfind->Get_Corridor_Cache ().Store (m_CorridorKey, cluster_list, count);
 	return ;
 }
 
 
+///////////////////////////////////////////////////////////////////////////
+//
+//	Is_Sector_In_Corridor
+//
+///////////////////////////////////////////////////////////////////////////
+bool
+PathSolveClass::Is_Sector_In_Corridor (PathfindSectorClass *sector) const
+{
+	if (sector == nullptr) {
+		return false;
+	}
+
+	int cluster_id = sector->Get_Cluster_ID ();
+	return (	cluster_id >= 0 &&
+				(cluster_id >> 5) < m_CorridorMask.Length () &&
+				(m_CorridorMask[cluster_id >> 5] & (1U << (cluster_id & 31))) != 0);
+}
+
+
 /////////////////////////////////////////////////////////////////////////////////
 //
 //	Does_Line_Go_Through_Portal
@@ -1490,19 +1660,17 @@ Check_Line
 //	Post_Process_Path
 //
 ///////////////////////////////////////////////////////////////////////////
-PathSolveClass::PATHNODE_LIST PathSolveClass::temp_node_list;
-
 void
 PathSolveClass::Post_Process_Path (void)
 {
-	m_Path.Delete_All ();
+	m_Path.Reset_Active ();
 
 	//
 	//	Build a list of the nodes (in order) the path passes through.
 	//
-	temp_node_list.Reset_Active();
+	m_TempNodeList.Reset_Active();
 	for (PathNodeClass *node = m_CompletedNode; node != nullptr; node = node->Peek_Parent_Node ()) {
-		temp_node_list.Add_Head (node);
+		m_TempNodeList.Add_Head (node);
 	}
 
 
@@ -1514,9 +1682,9 @@ PathSolveClass::Post_Process_Path (void)
 	m_Path[m_Path.Count () - 1].m_SectorExtent = m_StartSector->Get_Bounding_Box ().Extent;
 
 	int index;
-	for (index = 0; index < temp_node_list.Count (); index ++) {
+	for (index = 0; index < m_TempNodeList.Count (); index ++) {
 
-		PathNodeClass *node				= temp_node_list[index];
+		PathNodeClass *node				= m_TempNodeList[index];
 		PathfindPortalClass *portal	= node->Peek_Portal ();
 
 		m_Path.Add (PathDataStruct (portal, node->Get_Position ()));
@@ -1538,14 +1706,11 @@ PathSolveClass::Post_Process_Path (void)
 	//	we will average the closest portal points starting from the beginning
 	// and then starting from the end.
 	//
-	typedef struct
-	{
-		Vector3 backward;
-		Vector3 forward;
-	} PATH_POINT;
-
 	int count = m_Path.Count ();
-	PATH_POINT *path_points = new PATH_POINT[count];
+	if (m_PathPoints.Length () < count) {
+		m_PathPoints.Resize (count);
+	}
+	PATH_POINT *path_points = &(m_PathPoints[0]);
 
 	Vector3 next_point = m_DestPos;
 	for (index = m_Path.Count () - 2; index > 0; index --) {
@@ -1631,8 +1796,6 @@ PathSolveClass::Post_Process_Path (void)
 		m_Path[index].m_Point = avg_point;
 	}
 
-	delete [] path_points;
-
 
 	//
 	//	Relax the points
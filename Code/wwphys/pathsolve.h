@@ -46,7 +46,9 @@
 #include "vector3.h"
 #include "hermitespline.h"
 #include "PathObject.h"
-#include "binheap.h"
+#include "PathNode.h"
+#include "pathcluster.h"
+#include "hashtemplate.h"
 #include "refcount.h"
 #include "postloadable.h"
 #include <cstdint>
@@ -57,7 +59,6 @@
 /////////////////////////////////////////////////////////////////////////
 class PathfindPortalClass;
 class PathfindSectorClass;
-class PathNodeClass;
 class	AABoxClass;
 class WayPathClass;
 class ChunkSaveClass;
@@ -134,6 +135,11 @@ public:
 	//
 	uint32				Get_Birth_Time (void) const	{ return m_BirthTime; }
 
+	//
+	//	Number of search nodes the last (or current) solve has used
+	//
+	int					Get_Node_Count (void) const	{ return m_NodeArena.Get_Count (); }
+
 	//
 	// Volume access
 	//
@@ -150,7 +156,6 @@ public:
 	// Distributed (multi-frame solve) methods
 	//
 	void					Process_Initial_Sector (void);
-	void					Unlink_Pathfind_Hooks (void);
 
 
 protected:
@@ -175,6 +180,12 @@ protected:
 		Vector3						m_SectorExtent;
 	};
 
+	typedef struct
+	{
+		Vector3 backward;
+		Vector3 forward;
+	} PATH_POINT;
+
 	typedef DynamicVectorClass<PathNodeClass *>	PATHNODE_LIST;
 	typedef DynamicVectorClass<PathDataStruct>	PATHPOINT_LIST;
 
@@ -195,6 +206,15 @@ protected:
 
 	void		Reset_Lists (void);
 
+	//
+	//	Cluster corridor methods
+	//
+	void		Submit_Initial_Portals (void);
+	void		Lookup_Corridor (void);
+	void		Drop_Corridor (void);
+	void		Store_Corridor (void);
+	bool		Is_Sector_In_Corridor (PathfindSectorClass *sector) const;
+
 	//
 	//	Post process methods
 	//
@@ -209,12 +229,6 @@ protected:
 	bool		Does_Object_Have_Access_To_Portal (PathfindPortalClass *portal);
 	bool		Can_Object_Go_Through_Portal (const Matrix3D &current_tm, PathfindSectorClass *sector, PathfindPortalClass *portal, Matrix3D *ending_tm);
 
-	//
-	// Distributed (multi-frame solve) methods
-	//
-	//void		Begin_Distributed_Solve (void);
-	//void		End_Distributed_Solve (void);
-
 	//
 	//	Save/load methods
 	//
@@ -239,15 +253,35 @@ private:
 	PathfindSectorClass *						m_StartSector;
 	PathfindSectorClass *						m_DestSector;
 
-	DynamicVectorClass<PathNodeClass *>		m_NodeList;
-	BinaryHeapClass<float>						m_BinaryHeap;
+	PathNodeArenaClass							m_NodeArena;
+	PathOpenListClass								m_OpenList;
+
+	//
+	//	The node (open or closed) for each portal the search has reached, by portal ID.
+	// This lives here rather than on the portals so any number of solves can run
+	// against the pathfind data at once.
+	//
+	HashTemplateClass<uint32, PathNodeClass *>	m_PortalNodes;
 
 	PathNodeClass *								m_CompletedNode;
 	PATHPOINT_LIST									m_Path;
 
 	PathObjectClass								m_PathObject;
 
-	static PATHNODE_LIST							temp_node_list;
+	PATHNODE_LIST									m_TempNodeList;
+	SimpleVecClass<PATH_POINT>					m_PathPoints;
+
+	//
+	//	When the corridor cache has a route between the start and destination
+	// clusters the search is limited to the sectors of those clusters.  A
+	// search that wasn't limited stores the clusters its path went through.
+	//
+	bool												m_UseCorridor;
+	bool												m_StoreCorridor;
+	uint32											m_ClusterSerial;
+	PathCorridorCacheClass::KeyStruct		m_CorridorKey;
+	DynamicVectorClass<int>						m_CorridorClusters;
+	SimpleVecClass<uint32>						m_CorridorMask;
 
 	/////////////////////////////////////////////////////////////////////////
 	// Friends
@@ -109,8 +109,12 @@ enum
 
 
 
+thread_local int PhysClass::_CurrentIsland = -1;
+
 PhysClass::PhysClass(void) :
 	Flags(DEFAULT_FLAGS),
+	IslandID(-1),
+	RestFrames(0),
 	Model(nullptr),
 	Observer(nullptr),
 	Definition(nullptr),
@@ -611,6 +615,7 @@ bool PhysClass::Load (ChunkLoadClass &cload)
 void PhysClass::Add_Debug_Point(const Vector3 & p,const Vector3 & color)
 {
 	if (Is_Debug_Display_Enabled()) {
+		PhysIslandSerialLockClass lock;
 		PhysicsSceneClass::Get_Instance()->Add_Debug_Point(p,color);
 	}
 }
@@ -620,6 +625,7 @@ void PhysClass::Add_Debug_Point(const Vector3 & p,const Vector3 & color)
 void PhysClass::Add_Debug_Vector(const Vector3 & p,const Vector3 & v,const Vector3 & color)
 {
 	if (Is_Debug_Display_Enabled() && (v.Length2() > 0.0f)) {
+		PhysIslandSerialLockClass lock;
 		PhysicsSceneClass::Get_Instance()->Add_Debug_Vector(p,v,color);
 	}
 }
@@ -629,6 +635,7 @@ void PhysClass::Add_Debug_Vector(const Vector3 & p,const Vector3 & v,const Vecto
 void PhysClass::Add_Debug_AABox(const AABoxClass & box,const Vector3 & color,float opacity)
 {
 	if (Is_Debug_Display_Enabled()) {
+		PhysIslandSerialLockClass lock;
 		PhysicsSceneClass::Get_Instance()->Add_Debug_AABox(box,color,opacity);
 	}
 }
@@ -638,6 +645,7 @@ void PhysClass::Add_Debug_AABox(const AABoxClass & box,const Vector3 & color,flo
 void PhysClass::Add_Debug_OBBox(const OBBoxClass & box,const Vector3 & color,float opacity)
 {
 	if (Is_Debug_Display_Enabled()) {
+		PhysIslandSerialLockClass lock;
 		PhysicsSceneClass::Get_Instance()->Add_Debug_OBBox(box,color,opacity);
 	}
 }
@@ -647,6 +655,7 @@ void PhysClass::Add_Debug_OBBox(const OBBoxClass & box,const Vector3 & color,flo
 void PhysClass::Add_Debug_Axes(const Matrix3D & transform,const Vector3 & color)
 {
 	if (Is_Debug_Display_Enabled()) {
+		PhysIslandSerialLockClass lock;
 		PhysicsSceneClass::Get_Instance()->Add_Debug_Axes(transform,color);
 	}
 }
@@ -672,6 +681,8 @@ bool PhysClass::Is_Debug_Display_Enabled(void) const
 
 bool PhysClass::Expire(void)
 {
+	PhysIslandSerialLockClass lock;
+
 	ExpirationReactionType result = EXPIRATION_APPROVED;
 	if (Observer != nullptr) {
 		result = Observer->Object_Expired(this);
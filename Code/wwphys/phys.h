@@ -47,6 +47,7 @@
 #include "matrix3d.h"
 #include "physobserver.h"
 #include "cullsys.h"
+#include "physislands.h"
 #include "rendobj.h"
 #include "widgetuser.h"
 #include "persist.h"
@@ -443,7 +444,19 @@ public:
 	*/
 	void								Inc_Ignore_Counter(void);
 	void								Dec_Ignore_Counter(void);
-	bool								Is_Ignore_Me(void) const									{ return ((Flags & IGNORE_MASK) > 0); }
+	bool								Is_Ignore_Me(void) const									{ return Is_In_Other_Island() || ((Flags & IGNORE_MASK) > 0); }
+
+	/*
+	** Islands.  While the scene timesteps islands of objects in parallel, each object being
+	** timestepped has the ID of its island and each thread knows which island it is running.
+	** Objects in other islands are ignored like the IGNOREME objects above, objects which
+	** are not being timestepped (ID -1) are not.  See PhysicsSceneClass::Timestep_Islands.
+	*/
+	void								Set_Island_ID(int id)										{ IslandID = id; }
+	int								Get_Island_ID(void) const									{ return IslandID; }
+	bool								Is_In_Other_Island(void) const							{ return (IslandID >= 0) && (_CurrentIsland >= 0) && (IslandID != _CurrentIsland); }
+	static void						Set_Current_Island(int id)								{ _CurrentIsland = id; }
+	static int						Get_Current_Island(void)									{ return _CurrentIsland; }
 
 
 	/*
@@ -502,6 +515,17 @@ public:
 	bool								Is_Asleep(void) const										{ return ((Flags & ASLEEP) == ASLEEP); }
 	void								Force_Awake(void)												{ Set_Flag(ASLEEP,false); }
 
+	/*
+	** At rest.  An object that is asleep and has nothing pending that its Timestep would act
+	** on (controller input, network corrections, etc) is at rest.  After a while at rest the
+	** scene stops timestepping the object until it isn't anymore, which is usually because
+	** something cleared its ASLEEP flag.  See PhysicsSceneClass::Put_Objects_To_Sleep and
+	** PhysicsSceneClass::Wake_Sleeping_Objects.
+	*/
+	virtual bool					Is_At_Rest(void)												{ return false; }
+	void								Set_Rest_Frames(int count)									{ RestFrames = count; }
+	int								Get_Rest_Frames(void) const								{ return RestFrames; }
+
 	/*
 	** Static-World-Space-Mesh.  This flag indicates that the phys object is a static world
 	** space mesh (identity transform) and enables some optimizations in the rendering loop.
@@ -659,6 +683,16 @@ protected:
 	*/
 	unsigned int					Flags;
 
+	/*
+	** Island this object is timestepped in, -1 outside of Timestep_Islands
+	*/
+	int								IslandID;
+
+	/*
+	** Number of consecutive scene updates this object has been at rest
+	*/
+	int								RestFrames;
+
 	/*
 	** Render model
 	*/
@@ -721,6 +755,11 @@ protected:
 
 private:
 
+	/*
+	** Island the calling thread is timestepping, -1 if none
+	*/
+	static thread_local int		_CurrentIsland;
+
 	// Not Implemented:
 	PhysClass(const PhysClass & src);
 	PhysClass & operator = (const PhysClass & src);
@@ -749,6 +788,10 @@ inline void PhysClass::Dec_Ignore_Counter(void)
 inline CollisionReactionType PhysClass::Collision_Occurred(CollisionEventClass & event)
 {
 	if (Observer) {
+		if (PhysIslandsClass::Is_Parallel_Phase()) {
+			PhysIslandsClass::Defer_Collision(this,event);
+			return COLLISION_REACTION_DEFAULT;
+		}
 		return Observer->Collision_Occurred(event);
 	} else {
 		return COLLISION_REACTION_DEFAULT;
@@ -758,6 +801,7 @@ inline CollisionReactionType PhysClass::Collision_Occurred(CollisionEventClass &
 inline void PhysClass::Update_Cull_Box(void)
 {
 	if (Model) {
+		PhysIslandCullWriteLockClass lock;
 		Set_Cull_Box(Model->Get_Bounding_Box());
 	}
 }
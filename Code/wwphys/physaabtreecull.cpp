@@ -213,6 +213,230 @@ bool PhysAABTreeCullClass::Cast_OBBox_Recursive
 	return res;
 }
 
+/*
+** Four-wide versions of the casts.  These walk the wide copy of the tree built by
+** AABTreeCullSystemClass; the children that were collapsed into a wide node aren't
+** tested themselves but any objects they hold still have to be cast against.
+** Rays visit the lanes nearest-first and skip lanes which start beyond the closest
+** hit found so far.
+*/
+bool PhysAABTreeCullClass::Cast_Ray_Wide(PhysRayCollisionTestClass & raytest)
+{
+	if (raytest.Cull(RootNode->Box)) {
+		return false;
+	}
+
+	WideRayQueryClass query;
+	query.Init(raytest.Ray);
+
+	bool res = Cast_Ray_To_Objects(RootNode,raytest);
+	res = res | Cast_Ray_Wide(0,raytest,query);
+	return res;
+}
+
+bool PhysAABTreeCullClass::Cast_Ray_Wide
+(
+	int									wide_index,
+	PhysRayCollisionTestClass &	raytest,
+	const WideRayQueryClass &		query
+)
+{
+	const WideAABNodeStruct & wide = WideNodes[wide_index];
+	bool res = false;
+
+	for (int i=0; i<2; i++) {
+		if (wide.Middle[i] != -1) {
+			AABTreeNodeClass * middle = IndexedNodes[wide.Middle[i]];
+			if (middle->Object && !raytest.Cull(middle->Box)) {
+				res = res | Cast_Ray_To_Objects(middle,raytest);
+			}
+		}
+	}
+
+	float enter[WideAABNodeStruct::LANE_COUNT];
+	int overlap = query.Overlap_Mask(wide,raytest.Result->Fraction,enter);
+	WideAABNodeOrderClass order(overlap,enter);
+
+	for (int i=0; i<order.Count; i++) {
+		int lane = order.Lane[i];
+
+		// a nearer lane may already have found something closer than this one
+		if (enter[lane] > raytest.Result->Fraction) {
+			NODE_REJECTED();
+			continue;
+		}
+		NODE_ACCEPTED();
+
+		res = res | Cast_Ray_To_Objects(IndexedNodes[wide.Link[lane]],raytest);
+		if (wide.Child[lane] != -1) {
+			res = res | Cast_Ray_Wide(wide.Child[lane],raytest,query);
+		}
+	}
+
+#ifdef WWDEBUG
+	for (int lane=0; lane<WideAABNodeStruct::LANE_COUNT; lane++) {
+		if ((wide.LaneMask & ~overlap) & (1 << lane)) {
+			NODE_REJECTED();
+		}
+	}
+#endif
+
+	return res;
+}
+
+bool PhysAABTreeCullClass::Cast_AABox_Wide(PhysAABoxCollisionTestClass & boxtest)
+{
+	if (boxtest.Cull(RootNode->Box)) {
+		return false;
+	}
+
+	WideSweepQueryClass query;
+	query.Init_AABox_Sweep(boxtest.Box.Center,boxtest.Box.Extent,boxtest.Move,boxtest.SweepMin,boxtest.SweepMax);
+
+	bool res = Cast_AABox_To_Objects(RootNode,boxtest);
+	res = res | Cast_AABox_Wide(0,boxtest,query);
+	return res;
+}
+
+bool PhysAABTreeCullClass::Cast_AABox_Wide
+(
+	int										wide_index,
+	PhysAABoxCollisionTestClass &		boxtest,
+	const WideSweepQueryClass &		query
+)
+{
+	const WideAABNodeStruct & wide = WideNodes[wide_index];
+	bool res = false;
+
+	for (int i=0; i<2; i++) {
+		if (wide.Middle[i] != -1) {
+			AABTreeNodeClass * middle = IndexedNodes[wide.Middle[i]];
+			if (middle->Object && !boxtest.Cull(middle->Box)) {
+				res = res | Cast_AABox_To_Objects(middle,boxtest);
+			}
+		}
+	}
+
+	int overlap = query.Overlap_Mask(wide);
+
+	for (int lane=0; lane<WideAABNodeStruct::LANE_COUNT; lane++) {
+		int bit = 1 << lane;
+		if ((wide.LaneMask & bit) == 0) {
+			continue;
+		}
+		if ((overlap & bit) == 0) {
+			NODE_REJECTED();
+			continue;
+		}
+		NODE_ACCEPTED();
+
+		res = res | Cast_AABox_To_Objects(IndexedNodes[wide.Link[lane]],boxtest);
+		if (wide.Child[lane] != -1) {
+			res = res | Cast_AABox_Wide(wide.Child[lane],boxtest,query);
+		}
+	}
+	return res;
+}
+
+bool PhysAABTreeCullClass::Cast_OBBox_Wide(PhysOBBoxCollisionTestClass & boxtest)
+{
+	if (boxtest.Cull(RootNode->Box)) {
+		return false;
+	}
+
+	WideSweepQueryClass query;
+	query.Init_OBBox_Sweep(boxtest.Box,boxtest.Move,boxtest.SweepMin,boxtest.SweepMax);
+
+	bool res = Cast_OBBox_To_Objects(RootNode,boxtest);
+	res = res | Cast_OBBox_Wide(0,boxtest,query);
+	return res;
+}
+
+bool PhysAABTreeCullClass::Cast_OBBox_Wide
+(
+	int										wide_index,
+	PhysOBBoxCollisionTestClass &		boxtest,
+	const WideSweepQueryClass &		query
+)
+{
+	const WideAABNodeStruct & wide = WideNodes[wide_index];
+	bool res = false;
+
+	for (int i=0; i<2; i++) {
+		if (wide.Middle[i] != -1) {
+			AABTreeNodeClass * middle = IndexedNodes[wide.Middle[i]];
+			if (middle->Object && !boxtest.Cull(middle->Box)) {
+				res = res | Cast_OBBox_To_Objects(middle,boxtest);
+			}
+		}
+	}
+
+	int overlap = query.Overlap_Mask(wide);
+
+	for (int lane=0; lane<WideAABNodeStruct::LANE_COUNT; lane++) {
+		int bit = 1 << lane;
+		if ((wide.LaneMask & bit) == 0) {
+			continue;
+		}
+		if ((overlap & bit) == 0) {
+			NODE_REJECTED();
+			continue;
+		}
+		NODE_ACCEPTED();
+
+		res = res | Cast_OBBox_To_Objects(IndexedNodes[wide.Link[lane]],boxtest);
+		if (wide.Child[lane] != -1) {
+			res = res | Cast_OBBox_Wide(wide.Child[lane],boxtest,query);
+		}
+	}
+	return res;
+}
+
+bool PhysAABTreeCullClass::Cast_Ray_To_Objects(AABTreeNodeClass * node,PhysRayCollisionTestClass & raytest)
+{
+	bool res = false;
+	PhysClass * obj = get_first_object(node);
+	while (obj) {
+		if (	Scene->Do_Groups_Collide(obj->Get_Collision_Group(),raytest.CollisionGroup) &&
+				!obj->Is_Ignore_Me())
+		{
+			res |= obj->Cast_Ray(raytest);
+		}
+		obj = get_next_object(obj);
+	}
+	return res;
+}
+
+bool PhysAABTreeCullClass::Cast_AABox_To_Objects(AABTreeNodeClass * node,PhysAABoxCollisionTestClass & boxtest)
+{
+	bool res = false;
+	PhysClass * obj = get_first_object(node);
+	while (obj) {
+		if (	Scene->Do_Groups_Collide(obj->Get_Collision_Group(),boxtest.CollisionGroup) &&
+				!obj->Is_Ignore_Me()	)
+		{
+			res |= obj->Cast_AABox(boxtest);
+		}
+		obj = get_next_object(obj);
+	}
+	return res;
+}
+
+bool PhysAABTreeCullClass::Cast_OBBox_To_Objects(AABTreeNodeClass * node,PhysOBBoxCollisionTestClass & boxtest)
+{
+	bool res = false;
+	PhysClass * obj = get_first_object(node);
+	while (obj) {
+		if (	Scene->Do_Groups_Collide(obj->Get_Collision_Group(),boxtest.CollisionGroup) &&
+				!obj->Is_Ignore_Me()	)
+		{
+			res |= obj->Cast_OBBox(boxtest);
+		}
+		obj = get_next_object(obj);
+	}
+	return res;
+}
+
 bool PhysAABTreeCullClass::Intersection_Test(PhysAABoxIntersectionTestClass & boxtest)
 {
 	Reset_Collection();
@@ -95,6 +95,16 @@ protected:
 	bool					Cast_AABox_Recursive(AABTreeNodeClass * node,PhysAABoxCollisionTestClass & boxtest);
 	bool					Cast_OBBox_Recursive(AABTreeNodeClass * node,PhysOBBoxCollisionTestClass & boxtest);
 
+	bool					Cast_Ray_Wide(PhysRayCollisionTestClass & raytest);
+	bool					Cast_AABox_Wide(PhysAABoxCollisionTestClass & boxtest);
+	bool					Cast_OBBox_Wide(PhysOBBoxCollisionTestClass & boxtest);
+	bool					Cast_Ray_Wide(int wide_index,PhysRayCollisionTestClass & raytest,const WideRayQueryClass & query);
+	bool					Cast_AABox_Wide(int wide_index,PhysAABoxCollisionTestClass & boxtest,const WideSweepQueryClass & query);
+	bool					Cast_OBBox_Wide(int wide_index,PhysOBBoxCollisionTestClass & boxtest,const WideSweepQueryClass & query);
+	bool					Cast_Ray_To_Objects(AABTreeNodeClass * node,PhysRayCollisionTestClass & raytest);
+	bool					Cast_AABox_To_Objects(AABTreeNodeClass * node,PhysAABoxCollisionTestClass & boxtest);
+	bool					Cast_OBBox_To_Objects(AABTreeNodeClass * node,PhysOBBoxCollisionTestClass & boxtest);
+
 	/*
 	** Members
 	*/
@@ -107,18 +117,27 @@ protected:
 inline bool PhysAABTreeCullClass::Cast_Ray(PhysRayCollisionTestClass & raytest)
 {
 	WWASSERT(RootNode != nullptr);
+	if (Use_Wide_Nodes()) {
+		return Cast_Ray_Wide(raytest);
+	}
 	return Cast_Ray_Recursive(RootNode,raytest);
 }
 
 inline bool PhysAABTreeCullClass::Cast_AABox(PhysAABoxCollisionTestClass & boxtest)
 {
 	WWASSERT(RootNode != nullptr);
+	if (Use_Wide_Nodes()) {
+		return Cast_AABox_Wide(boxtest);
+	}
 	return Cast_AABox_Recursive(RootNode,boxtest);
 }
 
 inline bool PhysAABTreeCullClass::Cast_OBBox(PhysOBBoxCollisionTestClass & boxtest)
 {
 	WWASSERT(RootNode != nullptr);
+	if (Use_Wide_Nodes()) {
+		return Cast_OBBox_Wide(boxtest);
+	}
 	return Cast_OBBox_Recursive(RootNode,boxtest);
 }
 
@@ -0,0 +1,180 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "physislands.h"
+#include "phys.h"
+#include "physobserver.h"
+#include "castres.h"
+#include "rendobj.h"
+#include "multilist.h"
+#include "wwdebug.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <stdlib.h>
+#include <vector>
+
+
+/*
+** Parallel phase state.  The read lock keeps a per thread depth so nested collision
+** checks don't take the shared mutex twice (which could deadlock against a waiting
+** writer).
+*/
+static std::atomic<bool>		_ParallelPhase{false};
+static std::recursive_mutex	_SerialMutex;
+static std::shared_mutex		_CullMutex;
+static thread_local int			_CullReadDepth = 0;
+
+
+/*
+** Collisions with observed objects reported during the parallel phase.  The objects are
+** referenced until the event has been dispatched.
+*/
+struct DeferredCollisionStruct
+{
+	int					Island;
+	PhysClass *			Obj;
+	PhysClass *			OtherObj;
+	RenderObjClass *	CollidedRenderObj;
+	bool					HasResult;
+	CastResultStruct	Result;
+};
+
+static std::mutex								_DeferredMutex;
+static std::vector<DeferredCollisionStruct>	_DeferredCollisions;
+
+
+void PhysIslandsClass::Begin_Parallel_Phase(void)
+{
+	WWASSERT(!_ParallelPhase.load());
+	GenericMultiListClass::Enable_Thread_Safety(true);
+	_ParallelPhase.store(true);
+}
+
+void PhysIslandsClass::End_Parallel_Phase(void)
+{
+	WWASSERT(_ParallelPhase.load());
+	_ParallelPhase.store(false);
+	GenericMultiListClass::Enable_Thread_Safety(false);
+}
+
+bool PhysIslandsClass::Is_Parallel_Phase(void)
+{
+	return _ParallelPhase.load(std::memory_order_relaxed);
+}
+
+void PhysIslandsClass::Serial_Lock(void)
+{
+	_SerialMutex.lock();
+}
+
+void PhysIslandsClass::Serial_Unlock(void)
+{
+	_SerialMutex.unlock();
+}
+
+void PhysIslandsClass::Cull_Read_Lock(void)
+{
+	if (_CullReadDepth++ == 0) {
+		_CullMutex.lock_shared();
+	}
+}
+
+void PhysIslandsClass::Cull_Read_Unlock(void)
+{
+	WWASSERT(_CullReadDepth > 0);
+	if (--_CullReadDepth == 0) {
+		_CullMutex.unlock_shared();
+	}
+}
+
+void PhysIslandsClass::Cull_Write_Lock(void)
+{
+	/*
+	** The shared mutex can't be upgraded, this thread would wait on its own read lock
+	** forever.  Fail loudly in release builds too rather than hang.
+	*/
+	if (_CullReadDepth != 0) {
+		WWRELEASE_ERROR(("PhysIslandsClass: cull write lock taken while holding a cull read lock\n"));
+		abort();
+	}
+	_CullMutex.lock();
+}
+
+void PhysIslandsClass::Cull_Write_Unlock(void)
+{
+	_CullMutex.unlock();
+}
+
+void PhysIslandsClass::Defer_Collision(PhysClass * obj,const CollisionEventClass & event)
+{
+	DeferredCollisionStruct deferred;
+	deferred.Island = PhysClass::Get_Current_Island();
+	deferred.Obj = obj;
+	deferred.OtherObj = event.OtherObj;
+	deferred.CollidedRenderObj = event.CollidedRenderObj;
+	deferred.HasResult = (event.CollisionResult != nullptr);
+	if (deferred.HasResult) {
+		deferred.Result = *event.CollisionResult;
+	}
+
+	deferred.Obj->Add_Ref();
+	if (deferred.OtherObj != nullptr) {
+		deferred.OtherObj->Add_Ref();
+	}
+	if (deferred.CollidedRenderObj != nullptr) {
+		deferred.CollidedRenderObj->Add_Ref();
+	}
+
+	std::lock_guard<std::mutex> lock(_DeferredMutex);
+	_DeferredCollisions.push_back(deferred);
+}
+
+void PhysIslandsClass::Dispatch_Deferred_Collisions(void)
+{
+	WWASSERT(!_ParallelPhase.load());
+
+	/*
+	** Each island is timestepped by one thread, so sorting by island keeps the order of
+	** the events within an island and makes the order between them repeatable.
+	*/
+	std::stable_sort(_DeferredCollisions.begin(),_DeferredCollisions.end(),
+		[](const DeferredCollisionStruct & a,const DeferredCollisionStruct & b) { return a.Island < b.Island; }
+	);
+
+	for (size_t i=0; i<_DeferredCollisions.size(); i++) {
+		DeferredCollisionStruct & deferred = _DeferredCollisions[i];
+
+		CollisionEventClass event;
+		event.OtherObj = deferred.OtherObj;
+		event.CollisionResult = deferred.HasResult ? &deferred.Result : nullptr;
+		event.CollidedRenderObj = deferred.CollidedRenderObj;
+		deferred.Obj->Collision_Occurred(event);
+
+		deferred.Obj->Release_Ref();
+		if (deferred.OtherObj != nullptr) {
+			deferred.OtherObj->Release_Ref();
+		}
+		if (deferred.CollidedRenderObj != nullptr) {
+			deferred.CollidedRenderObj->Release_Ref();
+		}
+	}
+	_DeferredCollisions.clear();
+}
@@ -0,0 +1,118 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#ifndef PHYSISLANDS_H
+#define PHYSISLANDS_H
+
+#include "always.h"
+
+class PhysClass;
+class CollisionEventClass;
+
+
+/*
+** PhysIslandsClass
+** While the physics scene timesteps independent islands of objects on the job pool
+** (see PhysicsSceneClass::Timestep_Islands), the code which touches state shared
+** between islands has to be protected.  The locks below do nothing unless such a
+** parallel phase is running, so the serial timestep only pays for a flag test.
+** The parallel phase also turns on the thread safety of the multi lists since the
+** islands build temporary physics lists out of shared objects.
+**
+** PhysIslandSerialLockClass - code in its scope runs for one island at a time.  Used
+**   around the scene lists that islands modify.  May be nested.
+**
+** Observer callbacks run game code, which expects the main thread and may reach into
+** any island, so they never run during the parallel phase.  Islands with an observed
+** object in them are timestepped serially.  Collisions with observed objects outside
+** of the islands (static objects, mostly) are deferred by Defer_Collision and handed
+** to their observers by Dispatch_Deferred_Collisions once the parallel phase is over,
+** in island order.  The reaction of a deferred observer can't change the move that
+** caused it any more, so the default reaction is used for that move.
+** PhysIslandCullReadLockClass - held while a collision check or a collection walks the
+**   culling systems.  May be nested.
+** PhysIslandCullWriteLockClass - held while an object is moved in, added to or removed
+**   from a culling system.  Taking it while holding a read lock aborts, even in release.
+*/
+class PhysIslandsClass
+{
+public:
+
+	static void			Begin_Parallel_Phase(void);
+	static void			End_Parallel_Phase(void);
+	static bool			Is_Parallel_Phase(void);
+
+	static void			Serial_Lock(void);
+	static void			Serial_Unlock(void);
+	static void			Cull_Read_Lock(void);
+	static void			Cull_Read_Unlock(void);
+	static void			Cull_Write_Lock(void);
+	static void			Cull_Write_Unlock(void);
+
+	static void			Defer_Collision(PhysClass * obj,const CollisionEventClass & event);
+	static void			Dispatch_Deferred_Collisions(void);
+};
+
+
+class PhysIslandSerialLockClass
+{
+public:
+	PhysIslandSerialLockClass(void) : Locked(PhysIslandsClass::Is_Parallel_Phase())	{ if (Locked) PhysIslandsClass::Serial_Lock(); }
+	~PhysIslandSerialLockClass(void)																	{ if (Locked) PhysIslandsClass::Serial_Unlock(); }
+
+private:
+	bool	Locked;
+
+	PhysIslandSerialLockClass(const PhysIslandSerialLockClass &);
+	PhysIslandSerialLockClass & operator = (const PhysIslandSerialLockClass &);
+};
+
+
+class PhysIslandCullReadLockClass
+{
+public:
+	PhysIslandCullReadLockClass(void) : Locked(PhysIslandsClass::Is_Parallel_Phase())	{ if (Locked) PhysIslandsClass::Cull_Read_Lock(); }
+	~PhysIslandCullReadLockClass(void)																	{ if (Locked) PhysIslandsClass::Cull_Read_Unlock(); }
+
+private:
+	bool	Locked;
+
+	PhysIslandCullReadLockClass(const PhysIslandCullReadLockClass &);
+	PhysIslandCullReadLockClass & operator = (const PhysIslandCullReadLockClass &);
+};
+
+
+class PhysIslandCullWriteLockClass
+{
+public:
+	PhysIslandCullWriteLockClass(void) : Locked(PhysIslandsClass::Is_Parallel_Phase())	{ if (Locked) PhysIslandsClass::Cull_Write_Lock(); }
+	~PhysIslandCullWriteLockClass(void)																	{ if (Locked) PhysIslandsClass::Cull_Write_Unlock(); }
+
+private:
+	bool	Locked;
+
+	PhysIslandCullWriteLockClass(const PhysIslandCullWriteLockClass &);
+	PhysIslandCullWriteLockClass & operator = (const PhysIslandCullWriteLockClass &);
+};
+
+
+#endif // PHYSISLANDS_H
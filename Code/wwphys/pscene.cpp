@@ -35,6 +35,7 @@
  *   PhysicsSceneClass::PhysicsSceneClass -- Constructor                                       *
  *   PhysicsSceneClass::~PhysicsSceneClass -- Destructor                                       *
  *   PhysicsSceneClass::Update -- Simulates the entire scene forward one timestep              *
+ *   PhysicsSceneClass::Timestep_Objects -- Timesteps the objects in the TimestepList          *
  *   PhysicsSceneClass::Add_Dynamic_Object -- Adds a dynamic object to the scene               *
  *   PhysicsSceneClass::Internal_Add_Dynamic_Object -- internal function finishes adding a dyn *
  *   PhysicsSceneClass::Add_Static_Object -- Adds a static object to the scene                 *
@@ -116,6 +117,7 @@
 #include "dx8wrapper.h"
 #include "physresourcemgr.h"
 #include "phys3.h"
+#include "jobpool.h"
 
 #include "umbrasupport.h"
 #include <algorithm>
@@ -195,6 +197,7 @@ PhysicsSceneClass::PhysicsSceneClass(void) :
 	BackfaceDebugEnabled(false),
 	VisSamplePointLocked(false),
 	LockedVisSamplePoint(0,0,0),
+	VisPrefetchTime(1.0f),
 	VisCamera(nullptr),
 	CurrentVisTable(nullptr),
 	StaticProjectorsEnabled(false),
@@ -214,7 +217,21 @@ PhysicsSceneClass::PhysicsSceneClass(void) :
 	CameraShakeSystem(nullptr),
 	HighlightMaterialPass(nullptr),
 	UpdateOnlyVisibleObjects(false),
-	CurrentFrameNumber(0)
+	CurrentFrameNumber(0),
+	IslandTimestepEnabled(false),
+	IslandCheckEnabled(false),
+	IslandMargin(1.0f),
+	TimestepChecksum(0),
+	FixedTimestepEnabled(false),
+	FixedTimestep(1.0f / 30.0f),
+	MaxCatchUpSteps(4),
+	FixedTimestepAccumulator(0.0f),
+	InterpolationFraction(1.0f),
+	InterpolationApplied(false),
+	ObjectSleepingEnabled(true),
+	SleepFrames(30),
+	SleepCount(0),
+	WakeCount(0)
 {
 	WWASSERT_PRINT(TheScene == nullptr,"Only one instance of the PhysicsSceneClass is allowed.\r\n");
 	WWMEMLOG(MEM_PHYSICSDATA);
@@ -335,40 +352,52 @@ void PhysicsSceneClass::Update(float dt,int frameid)
 
 	FrameNum = frameid;
 
+	/*
+	** Age the decompressed vis tables
+	*/
+	VisTableManager.Notify_Frame_Ended();
+
 	if (dt == 0.0f) {
 		return;
 	}
 
+	/*
+	** Bring back the sleeping objects that have been woken up
+	*/
+	if (ObjectSleepingEnabled) {
+		Wake_Sleeping_Objects();
+	}
+
 	/*
 	** Timestep all of the physics objects
 	*/
 	{
 		WWPROFILE("Timestep");
-		float remaining = dt;
 
-		while (remaining > 0) {
-
-			float step = std::min(remaining,MAX_TIMESTEP);
+		if (FixedTimestepEnabled) {
 
 			/*
-			** Loop through each object telling each to time-step itself.
+			** Whole steps of the fixed timestep, see pscene_fixedstep.cpp
 			*/
-			RefPhysListIterator it(&TimestepList);
-			for (it.First(); !it.Is_Done(); it.Next()) {
-				PhysClass* phys_obj=it.Peek_Obj();
-				// Little optimization hack - only update vehicles that are visible (for now update all other physics
-				// objects regardless of the visibility to avoid problems, vehicles are the most expensive anyway).
-				// This same thing is done to Post Timestep couple lines lower.
-				if (phys_obj->Is_Object_Simulating()) {
-					if (!UpdateOnlyVisibleObjects	||
-						phys_obj->Get_Last_Visible_Frame()==CurrentFrameNumber ||
-						!phys_obj->As_VehiclePhysClass()) {
-						phys_obj->Timestep(step);
-					}
-				}
+			Fixed_Timestep(dt);
+
+		} else {
+
+			float remaining = dt;
+
+			while (remaining > 0) {
+				float step = std::min(remaining,MAX_TIMESTEP);
+				Timestep_Objects(step);
+				remaining -= step;
 			}
+		}
 
-			remaining -= step;
+		/*
+		** Checksum the results so that a serial and a parallel run of the same input can be compared
+		*/
+		if (IslandCheckEnabled) {
+			TimestepChecksum = Compute_Timestep_Checksum();
+			WWDEBUG_SAY(("Physics frame %d: timestep checksum %08X, %d island escapes so far\n",frameid,TimestepChecksum,IslandStats.EscapeCount));
 		}
 	}
 
@@ -389,6 +418,13 @@ void PhysicsSceneClass::Update(float dt,int frameid)
 		}
 	}
 
+	/*
+	** Stop timestepping the objects that have been at rest for a while
+	*/
+	if (ObjectSleepingEnabled) {
+		Put_Objects_To_Sleep();
+	}
+
 	/*
 	** Timestep the camera shakers
 	*/
@@ -414,6 +450,49 @@ void PhysicsSceneClass::Update(float dt,int frameid)
 }
 
 
+/***********************************************************************************************
+ * PhysicsSceneClass::Timestep_Objects -- Timesteps the objects in the TimestepList once       *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * step - length of the timestep                                                               *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+void PhysicsSceneClass::Timestep_Objects(float step)
+{
+	if (IslandTimestepEnabled && (JobPoolClass::Get_Worker_Count() > 0)) {
+
+		/*
+		** Split the objects into independent islands and timestep those in parallel
+		*/
+		Timestep_Islands(step);
+
+	} else {
+
+		/*
+		** Loop through each object telling each to time-step itself.
+		*/
+		RefPhysListIterator it(&TimestepList);
+		for (it.First(); !it.Is_Done(); it.Next()) {
+			PhysClass* phys_obj=it.Peek_Obj();
+			// Little optimization hack - only update vehicles that are visible (for now update all other physics
+			// objects regardless of the visibility to avoid problems, vehicles are the most expensive anyway).
+			// This same thing is done to Post Timestep in Update.
+			if (phys_obj->Is_Object_Simulating()) {
+				if (!UpdateOnlyVisibleObjects	||
+					phys_obj->Get_Last_Visible_Frame()==CurrentFrameNumber ||
+					!phys_obj->As_VehiclePhysClass()) {
+					phys_obj->Timestep(step);
+				}
+			}
+		}
+	}
+}
+
+
 /***********************************************************************************************
  * PhysicsSceneClass::Add_Dynamic_Object -- Adds a dynamic object to the scene                 *
  *                                                                                             *
@@ -433,7 +512,10 @@ void PhysicsSceneClass::Add_Dynamic_Object(PhysClass * newobj)
 	WWASSERT(newobj->Get_Culling_System() == nullptr);
 
 	// Add the object to the dynamic culling system
-	DynamicCullingSystem->Add_Object(newobj);
+	{
+		PhysIslandCullWriteLockClass lock;
+		DynamicCullingSystem->Add_Object(newobj);
+	}
 
 	// Add the object to the lists in the physics scene
 	Internal_Add_Dynamic_Object(newobj);
@@ -599,6 +681,7 @@ void PhysicsSceneClass::Internal_Add_Static_Light(LightPhysClass * newlight)
  *=============================================================================================*/
 void PhysicsSceneClass::Delayed_Remove_Object(PhysClass * obj)
 {
+	PhysIslandSerialLockClass lock;
 	if (!ReleaseList.Contains(obj)) {
 		ReleaseList.Add(obj);
 	}
@@ -659,6 +742,7 @@ void PhysicsSceneClass::Remove_Object(PhysClass * obj)
 	// Pull the object out of any of the "extra-processing" lists
 	Remove_From_Dirty_Cull_List(obj);
 	TimestepList.Remove(obj);
+	SleepingList.Remove(obj);
 	StaticAnimList.Remove(obj);
 
 	// Pull the physics object out of whatever system it is in
@@ -666,7 +750,10 @@ void PhysicsSceneClass::Remove_Object(PhysClass * obj)
 
 	if (cullsys == DynamicCullingSystem) {
 
-		DynamicCullingSystem->Remove_Object(obj);
+		{
+			PhysIslandCullWriteLockClass lock;
+			DynamicCullingSystem->Remove_Object(obj);
+		}
 		ObjList.Remove(obj);
 
 	} else if (cullsys == StaticCullingSystem) {
@@ -703,6 +790,9 @@ void PhysicsSceneClass::Remove_Object(PhysClass * obj)
  *=============================================================================================*/
 void PhysicsSceneClass::Remove_All(void)
 {
+	Restore_Interpolated_Transforms();
+	Release_Interpolation_Transforms();
+
 	PhysClass * obj = ObjList.Peek_Head();
 	while (obj) {
 		Remove_Object(obj);
@@ -1091,6 +1181,9 @@ void PhysicsSceneClass::Pre_Render_Processing(CameraClass & camera)
 
 	LastCameraPosition = camera.Get_Position();
 
+	// Draw the fixed timestep objects between their last two steps
+	Apply_Interpolated_Transforms();
+
 	DecalSystem->Update_Decal_Fade_Distances(camera);
 
 	// Do the needed 'On_Frame_Update's
@@ -1180,6 +1273,8 @@ void PhysicsSceneClass::Post_Render_Processing(void)
 	VisibleStaticObjectList.Reset_List();
 	VisibleWSMeshList.Reset_List();
 
+	// Put the fixed timestep objects back where the simulation has them
+	Restore_Interpolated_Transforms();
 
 	// Update statistics
 	Per_Frame_Statistics_Update();
@@ -1876,6 +1971,22 @@ void PhysicsSceneClass::Per_Frame_Statistics_Update(void)
 		StaticCullingSystem->Reset_Statistics();
 		StaticLightingSystem->Reset_Statistics();
 
+		/*
+		** Count the awake and sleeping objects
+		*/
+		CurrentStats.ActiveObjectCount = TimestepList.Count();
+		CurrentStats.SleepingObjectCount = SleepingList.Count();
+
+		/*
+		** Collect the vis table cache stats
+		*/
+		const VisTableMgrClass::CacheStatsStruct & vis_stats = VisTableManager.Get_Cache_Stats();
+		CurrentStats.VisTableHits = vis_stats.Hits;
+		CurrentStats.VisTableMisses = vis_stats.Misses;
+		CurrentStats.VisTablePrefetches = vis_stats.Prefetches;
+		CurrentStats.VisDecompressTime = vis_stats.DecompressTime;
+		VisTableManager.Reset_Cache_Stats();
+
 		/*
 		** Copy over LastValidStats, reset
 		*/
@@ -2123,6 +2234,12 @@ void PhysicsSceneClass::StatsStruct::Reset(void)
 	CullNodesAccepted = 0;
 	CullNodesTriviallyAccepted = 0;
 	CullNodesRejected = 0;
+	ActiveObjectCount = 0;
+	SleepingObjectCount = 0;
+	VisTableHits = 0;
+	VisTableMisses = 0;
+	VisTablePrefetches = 0;
+	VisDecompressTime = 0.0f;
 }
 
 
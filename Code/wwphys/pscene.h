@@ -653,6 +653,15 @@ public:
 	bool Cast_AABox(PhysAABoxCollisionTestClass & boxtest,bool use_collision_region = false);
 	bool Cast_OBBox(PhysOBBoxCollisionTestClass & boxtest,bool use_collision_region = false);
 
+	/*
+	** Batched casts, see pscene_batchcast.cpp.  Same results as calling Cast_Ray or Cast_AABox on
+	** each test, but the tests are sorted so that nearby ones heading the same way end up together,
+	** each packet of tests walks the culling systems once and the packets are spread over the job
+	** pool.  Return the number of tests that hit something.
+	*/
+	int Cast_Rays(PhysRayCollisionTestClass ** tests,int count,bool use_job_pool = true);
+	int Cast_AABoxes(PhysAABoxCollisionTestClass ** tests,int count,bool use_job_pool = true);
+
 	bool Intersection_Test(PhysAABoxIntersectionTestClass & boxtest,bool use_collision_region = false);
 	bool Intersection_Test(PhysOBBoxIntersectionTestClass & boxtest,bool use_collision_region = false);
 	bool Intersection_Test(PhysMeshIntersectionTestClass & meshtest,bool use_collision_region = false);
@@ -752,6 +761,26 @@ public:
 	VisTableClass *			Get_Vis_Table(const CameraClass & camera);
 	VisTableClass *			Get_Vis_Table_For_Rendering(const CameraClass & camera);
 
+	/*
+	** Vis table decompression cache, see VisTableMgrClass.
+	** Set_Vis_Cache_Budget - bytes of decompressed tables to keep, zero releases tables a few frames after their last use
+	** Enable_Vis_Full_Decompression - decompress every vis table up front and keep them all
+	** Prefetch_Vis_Tables - decompress the tables of the vis sectors that something at 'point' moving
+	**   at 'velocity' will reach within the prefetch time
+	*/
+	void							Set_Vis_Cache_Budget(int bytes);						// 16MB by default
+	int							Get_Vis_Cache_Budget(void);
+	void							Enable_Vis_Full_Decompression(bool onoff);			// off by default
+	bool							Is_Vis_Full_Decompression_Enabled(void);
+	void							Set_Vis_Prefetch_Time(float seconds);				// one second by default, zero disables
+	float							Get_Vis_Prefetch_Time(void);
+	void							Prefetch_Vis_Tables(const Vector3 & point,const Vector3 & velocity);
+
+	const VisTableMgrClass::CacheStatsStruct &	Get_Vis_Cache_Stats(void);
+	void							Reset_Vis_Cache_Stats(void);
+	int							Get_Vis_Cache_Bytes(void);
+	int							Get_Vis_Cache_Table_Count(void);
+
 	virtual void				On_Vis_Occluders_Rendered(VisRenderContextClass & /* context */,VisSampleClass & /* sample */) {}
 
 	/*
@@ -943,6 +972,88 @@ public:
 	void							Set_Update_Only_Visible_Objects(bool b) { UpdateOnlyVisibleObjects=b; }
 	bool							Get_Update_Only_Visible_Objects() { return UpdateOnlyVisibleObjects; }
 
+	/*
+	** Island timestepping.  When enabled (and the JobPoolClass has workers), the objects
+	** in the TimestepList are split into islands of objects whose swept bounding boxes
+	** (grown by the island margin) overlap and the islands are timestepped in parallel.
+	** Objects in one island are invisible to the collision checks of the others.  Islands
+	** containing anything other than rigid bodies and Phys3 objects are timestepped serially.
+	** The island check counts objects that moved out of their island's bounds during the
+	** step and computes a checksum of the final transforms for comparison against a
+	** serial run of the same input.
+	*/
+	void							Enable_Island_Timestep(bool onoff)				{ IslandTimestepEnabled = onoff; }
+	bool							Is_Island_Timestep_Enabled(void)					{ return IslandTimestepEnabled; }
+	void							Set_Island_Margin(float margin)					{ IslandMargin = margin; }
+	float							Get_Island_Margin(void)								{ return IslandMargin; }
+	void							Enable_Island_Check(bool onoff)					{ IslandCheckEnabled = onoff; }
+	bool							Is_Island_Check_Enabled(void)						{ return IslandCheckEnabled; }
+	uint32						Get_Timestep_Checksum(void)						{ return TimestepChecksum; }
+
+	struct IslandStatsStruct
+	{
+		IslandStatsStruct(void);
+		void	Reset(void);
+
+		int	StepCount;					// number of island timesteps
+		int	IslandCount;				// islands found, summed over the steps
+		int	ParallelIslandCount;		// islands that were timestepped on the job pool
+		int	ObjectCount;				// objects timestepped
+		int	ParallelObjectCount;		// objects timestepped on the job pool
+		int	LargestIsland;				// largest island seen
+		int	EscapeCount;				// objects that left their island's bounds (island check only)
+	};
+
+	const IslandStatsStruct &	Get_Island_Stats(void)							{ return IslandStats; }
+	void							Reset_Island_Stats(void)							{ IslandStats.Reset(); }
+
+	/*
+	** Fixed timestepping.  When enabled, Update adds the frame time to an accumulator and
+	** timesteps the objects in whole fixed-length steps, so the results don't depend on the
+	** frame rate.  At most the catch-up limit of steps are taken per Update; any time beyond
+	** that is dropped.  While rendering, each timestepped object is drawn between where it
+	** was before and after the last step, by the fraction of a step left in the accumulator.
+	*/
+	void							Enable_Fixed_Timestep(bool onoff);													// off by default
+	bool							Is_Fixed_Timestep_Enabled(void)					{ return FixedTimestepEnabled; }
+	void							Set_Fixed_Timestep(float step)					{ FixedTimestep = step; }			// 1/30 s by default
+	float							Get_Fixed_Timestep(void)							{ return FixedTimestep; }
+	void							Set_Max_Catch_Up_Steps(int count)				{ MaxCatchUpSteps = count; }	// 4 by default
+	int							Get_Max_Catch_Up_Steps(void)						{ return MaxCatchUpSteps; }
+	float							Get_Interpolation_Fraction(void)				{ return InterpolationFraction; }
+
+	struct FixedStepStatsStruct
+	{
+		FixedStepStatsStruct(void);
+		void	Reset(void);
+
+		int	UpdateCount;				// number of Updates in fixed timestep mode
+		int	StepCount;					// fixed steps taken
+		int	MaxSteps;					// most steps taken in one Update
+		int	IdleCount;					// Updates that didn't take a step
+		int	ClampCount;					// Updates that hit the catch-up limit
+		float	DroppedTime;				// seconds dropped by the catch-up limit
+	};
+
+	const FixedStepStatsStruct &	Get_Fixed_Step_Stats(void)				{ return FixedStepStats; }
+	void							Reset_Fixed_Step_Stats(void)						{ FixedStepStats.Reset(); }
+
+	/*
+	** Sleeping objects.  An object that has been at rest (see PhysClass::Is_At_Rest) for the
+	** given number of updates is moved out of the TimestepList into the sleeping list.  At the
+	** start of each update, the sleeping objects that aren't at rest anymore (because a contact,
+	** an impulse, Force_Dynamic_Objects_Awake, etc. woke them up) are moved back.
+	*/
+	void							Enable_Object_Sleeping(bool onoff);												// on by default
+	bool							Is_Object_Sleeping_Enabled(void)					{ return ObjectSleepingEnabled; }
+	void							Set_Sleep_Frames(int count)						{ SleepFrames = count; }			// 30 by default
+	int							Get_Sleep_Frames(void)								{ return SleepFrames; }
+	int							Get_Active_Object_Count(void)						{ return TimestepList.Count(); }
+	int							Get_Sleeping_Object_Count(void)					{ return SleepingList.Count(); }
+	int							Get_Sleep_Count(void)								{ return SleepCount; }		// objects put to sleep
+	int							Get_Wake_Count(void)									{ return WakeCount; }		// objects woken up
+	void							Reset_Sleep_Counts(void)							{ SleepCount = WakeCount = 0; }
+
 	/*
 	** Scene Class methods.  These should *only* be used when absolutely necessary since
 	** it is more efficient to operate through the physics interface (I can keep track
@@ -994,6 +1105,13 @@ public:
 		int	CullNodesTriviallyAccepted;
 		int	CullNodesRejected;
 
+		int	ActiveObjectCount;			// objects in the TimestepList at the end of the sample
+		int	SleepingObjectCount;			// objects asleep outside of it
+
+		int	VisTableHits;
+		int	VisTableMisses;
+		int	VisTablePrefetches;
+		float	VisDecompressTime;			// milliseconds
 	};
 
 	void							Per_Frame_Statistics_Update(void);
@@ -1024,6 +1142,57 @@ protected:
 	void							Merge_Vis_Sector_IDs(uint32 id0,uint32 id1);
 	void							Merge_Vis_Object_IDs(uint32 id0,uint32 id1);
 
+	/*
+	** Batched casts, see pscene_batchcast.cpp
+	*/
+	template<class TEST> int	Batch_Cast(TEST ** tests,int count,bool use_job_pool);
+	template<class TEST> void	Batch_Cast_Packet(TEST ** tests,const int * order,int count);
+
+	/*
+	** Island timestepping, see pscene_islands.cpp
+	*/
+	struct IslandStruct
+	{
+		int	FirstMember;				// index of the first member in IslandMembers
+		int	MemberCount;
+		bool	Parallel;					// all members may be timestepped on the job pool
+
+		bool	operator == (const IslandStruct & that) const	{ return (FirstMember == that.FirstMember) && (MemberCount == that.MemberCount) && (Parallel == that.Parallel); }
+		bool	operator != (const IslandStruct & that) const	{ return !(*this == that); }
+	};
+
+	void							Timestep_Islands(float step);
+	int							Find_Island_Root(int index);
+	void							Merge_Islands(int index0,int index1);
+	uint32						Compute_Timestep_Checksum(void);
+
+	/*
+	** Fixed timestepping, see pscene_fixedstep.cpp
+	*/
+	struct InterpolationStruct
+	{
+		PhysClass *	Object;
+		Matrix3D		PrevTransform;				// transform before the last step
+		Matrix3D		CurTransform;				// transform after it, saved while rendering
+		bool			Applied;						// model holds the interpolated transform
+
+		bool	operator == (const InterpolationStruct & that) const	{ return Object == that.Object; }
+		bool	operator != (const InterpolationStruct & that) const	{ return !(*this == that); }
+	};
+
+	void							Timestep_Objects(float step);
+	void							Fixed_Timestep(float dt);
+	void							Record_Interpolation_Transforms(void);
+	void							Release_Interpolation_Transforms(void);
+	void							Apply_Interpolated_Transforms(void);
+	void							Restore_Interpolated_Transforms(void);
+
+	/*
+	** Sleeping objects, see pscene_sleep.cpp
+	*/
+	void							Wake_Sleeping_Objects(bool wake_all = false);
+	void							Put_Objects_To_Sleep(void);
+
 	/*
 	** Internal texture-projection functions
 	*/
@@ -1122,6 +1291,7 @@ protected:
 	bool							BackfaceDebugEnabled;	// is backface debugging enabled.
 	bool							VisSamplePointLocked;	// is the sample point for vis being over-ridden?
 	Vector3						LockedVisSamplePoint;	// position to sample vis from when locked/overridden.
+	float							VisPrefetchTime;			// how far ahead (in seconds) to prefetch vis tables
 
 	CameraClass *				VisCamera;					// camera set up for vis-rendering
 	VisTableClass *			CurrentVisTable;			// current active vis table
@@ -1248,11 +1418,52 @@ protected:
 	RefPhysListClass			DirtyCullList;		// objects that have 'dirty culling' must be re-inserted each frame...
 	RefPhysListClass			TimestepList;		// objects which need to be time-stepped go in here
 	RefPhysListClass			StaticAnimList;	// list of the StaticAnim objects, these can cast shadows, change states, etc
-	NonRefPhysListClass		CollisionRegionList;	// cached list of objects in the current collision region
+
+	/*
+	** Cached list of objects in the current collision region, one per collection slot
+	** so that islands being timestepped in parallel each have their own.
+	*/
+	DynamicVectorClass<PhysClass *>	CollisionRegionList[CullableClass::MAX_COLLECTION_SLOTS];
 
 	bool							UpdateOnlyVisibleObjects;
 	unsigned						CurrentFrameNumber;
 
+	/*
+	** Island timestepping state.  The vectors are scratch space kept between frames.
+	*/
+	bool							IslandTimestepEnabled;
+	bool							IslandCheckEnabled;
+	float							IslandMargin;
+	uint32						TimestepChecksum;
+	IslandStatsStruct			IslandStats;
+	DynamicVectorClass<PhysClass *>	IslandObjects;		// objects being timestepped, in TimestepList order
+	DynamicVectorClass<AABoxClass>	IslandBounds;		// swept bounds of each object
+	DynamicVectorClass<int>				IslandParents;		// union-find forest over IslandObjects
+	DynamicVectorClass<int>				IslandOrder;		// sweep order, then the order the parallel islands are run in
+	DynamicVectorClass<int>				IslandMembers;		// object indices grouped by island
+	DynamicVectorClass<IslandStruct>	IslandList;
+
+	/*
+	** Fixed timestepping state
+	*/
+	bool							FixedTimestepEnabled;
+	float							FixedTimestep;
+	int							MaxCatchUpSteps;
+	float							FixedTimestepAccumulator;
+	float							InterpolationFraction;
+	bool							InterpolationApplied;
+	FixedStepStatsStruct		FixedStepStats;
+	DynamicVectorClass<InterpolationStruct>	InterpolationList;	// referenced objects with their transform before the last step
+
+	/*
+	** Sleeping object state
+	*/
+	bool							ObjectSleepingEnabled;
+	int							SleepFrames;
+	int							SleepCount;
+	int							WakeCount;
+	RefPhysListClass			SleepingList;		// objects taken out of the TimestepList while they are at rest
+
 private:
 
 	/*
@@ -0,0 +1,309 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+** Batched casts for the PhysicsSceneClass.
+**
+** A single Cast_Ray walks the static AAB-tree and the dynamic grid from the top.  When a lot of
+** casts are done at once (weapons, AI sight checks, visibility probes) the tests are sorted by
+** the direction octant they are heading in and the Morton code of their start point, cut into
+** packets of neighbouring tests and each packet collects the objects touching its bounds from
+** each culling system once.  Every test in the packet is then cast against the collected objects
+** whose cull box it touches.  The packets are independent so they are spread over the job pool,
+** each lane collecting into its own collection slot.
+*/
+
+#include "pscene.h"
+#include "physcoltest.h"
+#include "staticaabtreecull.h"
+#include "physgridcull.h"
+#include "jobpool.h"
+#include "wwprofile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+
+/*
+** Number of tests which share a walk of the culling systems
+*/
+static const int	BATCH_PACKET_SIZE = 16;
+
+/*
+** Below this many packets the job pool isn't worth waking up
+*/
+static const int	BATCH_MIN_PARALLEL_PACKETS = 4;
+
+
+/*
+** The bits of what the batch code needs to know about each kind of test
+*/
+static inline const Vector3 & Get_Test_Start(const PhysRayCollisionTestClass & test)		{ return test.Ray.Get_P0(); }
+static inline const Vector3 & Get_Test_Start(const PhysAABoxCollisionTestClass & test)	{ return test.Box.Center; }
+static inline const Vector3 & Get_Test_Move(const PhysRayCollisionTestClass & test)		{ return test.Ray.Get_Dir(); }
+static inline const Vector3 & Get_Test_Move(const PhysAABoxCollisionTestClass & test)		{ return test.Move; }
+
+static inline void Add_Test_Bounds(const PhysRayCollisionTestClass & test,MinMaxAABoxClass & bounds)
+{
+	bounds.Add_Point(test.Ray.Get_P0());
+	bounds.Add_Point(test.Ray.Get_P1());
+}
+
+static inline void Add_Test_Bounds(const PhysAABoxCollisionTestClass & test,MinMaxAABoxClass & bounds)
+{
+	bounds.Add_Box(test.SweepMin,test.SweepMax);
+}
+
+static inline void Cast_Test(PhysClass * obj,PhysRayCollisionTestClass & test)		{ obj->Cast_Ray(test); }
+static inline void Cast_Test(PhysClass * obj,PhysAABoxCollisionTestClass & test)		{ obj->Cast_AABox(test); }
+
+
+/*
+** Spreads the low 10 bits of the value out so there are two zero bits between each of them
+*/
+static inline uint32 Spread_Bits(uint32 value)
+{
+	value &= 0x000003FF;
+	value = (value | (value << 16)) & 0x030000FF;
+	value = (value | (value <<  8)) & 0x0300F00F;
+	value = (value | (value <<  4)) & 0x030C30C3;
+	value = (value | (value <<  2)) & 0x09249249;
+	return value;
+}
+
+
+struct BatchSortStruct
+{
+	uint64_t	Key;		// octant above the 30 bit Morton code
+	int		Index;
+
+	bool operator < (const BatchSortStruct & that) const	{ return (Key < that.Key) || ((Key == that.Key) && (Index < that.Index)); }
+};
+
+
+/*
+** Collects the objects in the packet's bounds from one culling system and casts each test
+** in the packet against those its own bounds touch.
+*/
+template<class CULLSYS,class TEST>
+static void Cast_Packet_Against_Culling_System
+(
+	PhysicsSceneClass *	scene,
+	CULLSYS *				cullsys,
+	const AABoxClass &	packet_box,
+	bool						is_static,
+	TEST **					tests,
+	const int *				order,
+	int						count
+)
+{
+	cullsys->Reset_Collection();
+	cullsys->Collect_Objects(packet_box);
+
+	for (	PhysClass * obj = cullsys->Get_First_Collected_Object();
+			obj != nullptr;
+			obj = cullsys->Get_Next_Collected_Object(obj) )
+	{
+		if (obj->Is_Ignore_Me()) {
+			continue;
+		}
+
+		const AABoxClass & obj_box = obj->Get_Cull_Box();
+		int obj_group = obj->Get_Collision_Group();
+
+		for (int i=0; i<count; i++) {
+			TEST & test = *tests[order[i]];
+			if (	(is_static ? test.CheckStaticObjs : test.CheckDynamicObjs) &&
+					!test.Result->StartBad &&
+					scene->Do_Groups_Collide(obj_group,test.CollisionGroup) &&
+					!test.Cull(obj_box)	)
+			{
+				Cast_Test(obj,test);
+			}
+		}
+	}
+}
+
+
+int PhysicsSceneClass::Cast_Rays(PhysRayCollisionTestClass ** tests,int count,bool use_job_pool)
+{
+	WWPROFILE("Cast_Rays");
+	return Batch_Cast(tests,count,use_job_pool);
+}
+
+
+int PhysicsSceneClass::Cast_AABoxes(PhysAABoxCollisionTestClass ** tests,int count,bool use_job_pool)
+{
+	WWPROFILE("Cast_AABoxes");
+	return Batch_Cast(tests,count,use_job_pool);
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Batch_Cast -- sorts the tests into packets and casts them                *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * tests - the tests, each one initialized the same way as for a single cast                   *
+ * count - number of tests                                                                     *
+ * use_job_pool - spread the packets over the job pool                                         *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ * number of tests that hit something                                                          *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * When several objects are hit at exactly the same fraction, the one reported in              *
+ * CollidedPhysObj may differ from a single cast since the objects are visited in a different  *
+ * order.                                                                                      *
+ *=============================================================================================*/
+template<class TEST>
+int PhysicsSceneClass::Batch_Cast(TEST ** tests,int count,bool use_job_pool)
+{
+	if (count <= 0) {
+		return 0;
+	}
+
+	/*
+	** Quantize the start points to a 1024^3 grid over their bounds and sort by the
+	** direction octant, then the Morton code of the cell.
+	*/
+	MinMaxAABoxClass start_bounds;
+	start_bounds.Init_Empty();
+	for (int i=0; i<count; i++) {
+		WWASSERT(tests[i]->Result->Fraction == 1.0f);
+		WWASSERT(tests[i]->Result->StartBad == false);
+		tests[i]->CollidedPhysObj = nullptr;
+		start_bounds.Add_Point(Get_Test_Start(*tests[i]));
+	}
+
+	Vector3 size = start_bounds.MaxCorner - start_bounds.MinCorner;
+	Vector3 scale;
+	scale.X = (size.X > 0.0f) ? (1023.0f / size.X) : 0.0f;
+	scale.Y = (size.Y > 0.0f) ? (1023.0f / size.Y) : 0.0f;
+	scale.Z = (size.Z > 0.0f) ? (1023.0f / size.Z) : 0.0f;
+
+	SimpleVecClass<BatchSortStruct> sorted(count);
+	for (int i=0; i<count; i++) {
+		const Vector3 & start = Get_Test_Start(*tests[i]);
+		const Vector3 & move = Get_Test_Move(*tests[i]);
+
+		uint32 octant = ((move.X < 0.0f) ? 1 : 0) | ((move.Y < 0.0f) ? 2 : 0) | ((move.Z < 0.0f) ? 4 : 0);
+		uint32 x = (uint32)((start.X - start_bounds.MinCorner.X) * scale.X);
+		uint32 y = (uint32)((start.Y - start_bounds.MinCorner.Y) * scale.Y);
+		uint32 z = (uint32)((start.Z - start_bounds.MinCorner.Z) * scale.Z);
+
+		sorted[i].Key = ((uint64_t)octant << 30) | Spread_Bits(x) | (Spread_Bits(y) << 1) | (Spread_Bits(z) << 2);
+		sorted[i].Index = i;
+	}
+	std::sort(&(sorted[0]),&(sorted[0]) + count);
+
+	SimpleVecClass<int> order(count);
+	for (int i=0; i<count; i++) {
+		order[i] = sorted[i].Index;
+	}
+
+	/*
+	** Cast the packets.  Not from inside a job or an island timestep though, those
+	** already have the pool busy.
+	*/
+	int packet_count = (count + BATCH_PACKET_SIZE - 1) / BATCH_PACKET_SIZE;
+	int lanes = std::min(JobPoolClass::Get_Worker_Count() + 1,(int)CullableClass::MAX_COLLECTION_SLOTS);
+	lanes = std::min(lanes,packet_count);
+
+	if (	!use_job_pool ||
+			(lanes < 2) ||
+			(packet_count < BATCH_MIN_PARALLEL_PACKETS) ||
+			JobPoolClass::Is_Worker_Thread() ||
+			PhysIslandsClass::Is_Parallel_Phase())
+	{
+		for (int packet=0; packet<packet_count; packet++) {
+			int first = packet * BATCH_PACKET_SIZE;
+			Batch_Cast_Packet(tests,&(order[first]),std::min(BATCH_PACKET_SIZE,count - first));
+		}
+
+	} else {
+
+		std::atomic<int> next_packet(0);
+		const int * order_ptr = &(order[0]);
+		int old_slot = CullSystemClass::Get_Collection_Slot();
+
+		JobPoolClass::Run(lanes,
+			[this,tests,order_ptr,count,packet_count,&next_packet](int lane) {
+				CullSystemClass::Set_Collection_Slot(lane);
+				for (int packet = next_packet++; packet < packet_count; packet = next_packet++) {
+					int first = packet * BATCH_PACKET_SIZE;
+					Batch_Cast_Packet(tests,order_ptr + first,std::min(BATCH_PACKET_SIZE,count - first));
+				}
+				CullSystemClass::Set_Collection_Slot(0);
+			}
+		);
+
+		CullSystemClass::Set_Collection_Slot(old_slot);
+	}
+
+	int hit_count = 0;
+	for (int i=0; i<count; i++) {
+		if (tests[i]->Result->StartBad || (tests[i]->Result->Fraction < 1.0f)) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Batch_Cast_Packet -- casts one packet of tests                           *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * tests - all of the tests                                                                    *
+ * order - indices of the tests in this packet                                                 *
+ * count - number of tests in this packet                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Like the single casts, the static objects are checked before the dynamic ones and a test    *
+ * which starts embedded in something isn't checked any further.                               *
+ *=============================================================================================*/
+template<class TEST>
+void PhysicsSceneClass::Batch_Cast_Packet(TEST ** tests,const int * order,int count)
+{
+	MinMaxAABoxClass packet_bounds;
+	packet_bounds.Init_Empty();
+	bool check_static = false;
+	bool check_dynamic = false;
+
+	for (int i=0; i<count; i++) {
+		const TEST & test = *tests[order[i]];
+		Add_Test_Bounds(test,packet_bounds);
+		check_static |= test.CheckStaticObjs;
+		check_dynamic |= test.CheckDynamicObjs;
+	}
+
+	AABoxClass box;
+	box.Init_Min_Max(packet_bounds.MinCorner,packet_bounds.MaxCorner);
+
+	PhysIslandCullReadLockClass lock;
+
+	if (check_static) {
+		Cast_Packet_Against_Culling_System(this,StaticCullingSystem,box,true,tests,order,count);
+	}
+	if (check_dynamic) {
+		Cast_Packet_Against_Culling_System(this,DynamicCullingSystem,box,false,tests,order,count);
+	}
+}
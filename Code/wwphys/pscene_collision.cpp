@@ -122,12 +122,42 @@ void PhysicsSceneClass::Disable_All_Collision_Detections(int group)
 
 void PhysicsSceneClass::Set_Collision_Region(const AABoxClass & bounds,int colgroup)
 {
-	Collect_Collideable_Objects(bounds,colgroup,true,true,&CollisionRegionList);
+	/*
+	** Each collection slot has its own region so islands timestepping on the job pool
+	** don't trample each other's.
+	*/
+	DynamicVectorClass<PhysClass *> & region = CollisionRegionList[CullSystemClass::Get_Collection_Slot()];
+	region.Reset_Active();
+
+	PhysIslandCullReadLockClass lock;
+
+	StaticCullingSystem->Reset_Collection();
+	StaticCullingSystem->Collect_Objects(bounds);
+	DynamicCullingSystem->Reset_Collection();
+	DynamicCullingSystem->Collect_Objects(bounds);
+
+	for (PhysClass * obj = (PhysClass *)StaticCullingSystem->Get_First_Collected_Object();
+		obj != nullptr;
+		obj = (PhysClass *)StaticCullingSystem->Get_Next_Collected_Object(obj) )
+	{
+		if (Do_Groups_Collide(obj->Get_Collision_Group(),colgroup) && !obj->Is_Ignore_Me()) {
+			region.Add(obj);
+		}
+	}
+
+	for (PhysClass * obj = (PhysClass *)DynamicCullingSystem->Get_First_Collected_Object();
+		obj != nullptr;
+		obj = (PhysClass *)DynamicCullingSystem->Get_Next_Collected_Object(obj) )
+	{
+		if (Do_Groups_Collide(obj->Get_Collision_Group(),colgroup) && !obj->Is_Ignore_Me()) {
+			region.Add(obj);
+		}
+	}
 }
 
 void PhysicsSceneClass::Release_Collision_Region(void)
 {
-	CollisionRegionList.Reset_List();
+	CollisionRegionList[CullSystemClass::Get_Collection_Slot()].Reset_Active();
 }
 
 bool PhysicsSceneClass::Cast_Ray(PhysRayCollisionTestClass & raytest,bool use_collision_region)
@@ -153,9 +183,9 @@ bool PhysicsSceneClass::Cast_Ray(PhysRayCollisionTestClass & raytest,bool use_co
 		/*
 		** Use the cached collision region list
 		*/
-		NonRefPhysListIterator it(&CollisionRegionList);
-		for ( ; !it.Is_Done(); it.Next()) {
-			PhysClass * obj = it.Peek_Obj();
+		DynamicVectorClass<PhysClass *> & region = CollisionRegionList[CullSystemClass::Get_Collection_Slot()];
+		for (int i=0; i<region.Count(); i++) {
+			PhysClass * obj = region[i];
 			if (	Do_Groups_Collide(obj->Get_Collision_Group(),raytest.CollisionGroup) &&
 					!obj->Is_Ignore_Me()	)
 			{
@@ -168,6 +198,8 @@ bool PhysicsSceneClass::Cast_Ray(PhysRayCollisionTestClass & raytest,bool use_co
 		/*
 		** Cull the collision check using the culling systems
 		*/
+		PhysIslandCullReadLockClass lock;
+
 		if (raytest.CheckStaticObjs) {
 			res |= StaticCullingSystem->Cast_Ray(raytest);
 			if (raytest.Result->StartBad) return true;
@@ -206,9 +238,9 @@ bool PhysicsSceneClass::Cast_AABox(PhysAABoxCollisionTestClass & boxtest,bool us
 		/*
 		** Use the cached collision region list
 		*/
-		NonRefPhysListIterator it(&CollisionRegionList);
-		for ( ; !it.Is_Done(); it.Next()) {
-			PhysClass * obj = it.Peek_Obj();
+		DynamicVectorClass<PhysClass *> & region = CollisionRegionList[CullSystemClass::Get_Collection_Slot()];
+		for (int i=0; i<region.Count(); i++) {
+			PhysClass * obj = region[i];
 			if (	Do_Groups_Collide(obj->Get_Collision_Group(),boxtest.CollisionGroup) &&
 					!obj->Is_Ignore_Me()	)
 			{
@@ -221,6 +253,8 @@ bool PhysicsSceneClass::Cast_AABox(PhysAABoxCollisionTestClass & boxtest,bool us
 		/*
 		** Cull the collision check using the culling systems
 		*/
+		PhysIslandCullReadLockClass lock;
+
 		if (boxtest.CheckStaticObjs) {
 			res |= StaticCullingSystem->Cast_AABox(boxtest);
 			if (boxtest.Result->StartBad) return true;
@@ -258,9 +292,9 @@ bool PhysicsSceneClass::Cast_OBBox(PhysOBBoxCollisionTestClass & boxtest,bool us
 		/*
 		** Use the cached collision region list
 		*/
-		NonRefPhysListIterator it(&CollisionRegionList);
-		for ( ; !it.Is_Done(); it.Next()) {
-			PhysClass * obj = it.Peek_Obj();
+		DynamicVectorClass<PhysClass *> & region = CollisionRegionList[CullSystemClass::Get_Collection_Slot()];
+		for (int i=0; i<region.Count(); i++) {
+			PhysClass * obj = region[i];
 			if (	Do_Groups_Collide(obj->Get_Collision_Group(),boxtest.CollisionGroup) &&
 					!obj->Is_Ignore_Me()	)
 			{
@@ -273,6 +307,8 @@ bool PhysicsSceneClass::Cast_OBBox(PhysOBBoxCollisionTestClass & boxtest,bool us
 		/*
 		** Cull the collision check using the culling systems
 		*/
+		PhysIslandCullReadLockClass lock;
+
 		if (boxtest.CheckStaticObjs) {
 			res |= StaticCullingSystem->Cast_OBBox(boxtest);
 			if (boxtest.Result->StartBad) return true;
@@ -294,9 +330,9 @@ bool PhysicsSceneClass::Intersection_Test(PhysAABoxIntersectionTestClass & boxte
 		/*
 		** Test for intersection with objects in the cached collision region
 		*/
-		NonRefPhysListIterator it(&CollisionRegionList);
-		for ( ; !it.Is_Done(); it.Next()) {
-			PhysClass * obj = it.Peek_Obj();
+		DynamicVectorClass<PhysClass *> & region = CollisionRegionList[CullSystemClass::Get_Collection_Slot()];
+		for (int i=0; i<region.Count(); i++) {
+			PhysClass * obj = region[i];
 			if (	Do_Groups_Collide(obj->Get_Collision_Group(),boxtest.CollisionGroup) &&
 					!obj->Is_Ignore_Me()	)
 			{
@@ -311,6 +347,8 @@ bool PhysicsSceneClass::Intersection_Test(PhysAABoxIntersectionTestClass & boxte
 		/*
 		** Test for intersection with objects in the static and dynamic culling systems
 		*/
+		PhysIslandCullReadLockClass lock;
+
 		if (boxtest.CheckStaticObjs) {
 			if (StaticCullingSystem->Intersection_Test(boxtest)) {
 				return true;
@@ -334,9 +372,9 @@ bool PhysicsSceneClass::Intersection_Test(PhysOBBoxIntersectionTestClass & boxte
 		/*
 		** Test for intersection with objects in the cached collision region
 		*/
-		NonRefPhysListIterator it(&CollisionRegionList);
-		for ( ; !it.Is_Done(); it.Next()) {
-			PhysClass * obj = it.Peek_Obj();
+		DynamicVectorClass<PhysClass *> & region = CollisionRegionList[CullSystemClass::Get_Collection_Slot()];
+		for (int i=0; i<region.Count(); i++) {
+			PhysClass * obj = region[i];
 			if (	Do_Groups_Collide(obj->Get_Collision_Group(),boxtest.CollisionGroup) &&
 					!obj->Is_Ignore_Me()	)
 			{
@@ -351,6 +389,8 @@ bool PhysicsSceneClass::Intersection_Test(PhysOBBoxIntersectionTestClass & boxte
 		/*
 		** Test for intersection with objects in the static and dynamic culling systems
 		*/
+		PhysIslandCullReadLockClass lock;
+
 		if (boxtest.CheckStaticObjs) {
 			if (StaticCullingSystem->Intersection_Test(boxtest)) {
 				return true;
@@ -372,9 +412,9 @@ bool PhysicsSceneClass::Intersection_Test(PhysMeshIntersectionTestClass & meshte
 		/*
 		** Test for intersection with objects in the cached collision region
 		*/
-		NonRefPhysListIterator it(&CollisionRegionList);
-		for ( ; !it.Is_Done(); it.Next()) {
-			PhysClass * obj = it.Peek_Obj();
+		DynamicVectorClass<PhysClass *> & region = CollisionRegionList[CullSystemClass::Get_Collection_Slot()];
+		for (int i=0; i<region.Count(); i++) {
+			PhysClass * obj = region[i];
 			if (	Do_Groups_Collide(obj->Get_Collision_Group(),meshtest.CollisionGroup) &&
 					!obj->Is_Ignore_Me()	)
 			{
@@ -386,6 +426,8 @@ bool PhysicsSceneClass::Intersection_Test(PhysMeshIntersectionTestClass & meshte
 
 	} else {
 
+		PhysIslandCullReadLockClass lock;
+
 		if (meshtest.CheckStaticObjs) {
 			if (StaticCullingSystem->Intersection_Test(meshtest)) {
 				return true;
@@ -440,7 +482,10 @@ void PhysicsSceneClass::Add_Collected_Objects_To_List
 				obj != nullptr;
 				obj = (PhysClass *)DynamicCullingSystem->Get_Next_Collected_Object(obj) )
 		{
-			list->Add(obj);
+			// objects being timestepped by another island are off limits
+			if (!obj->Is_In_Other_Island()) {
+				list->Add(obj);
+			}
 		}
 	}
 }
@@ -494,6 +539,7 @@ void PhysicsSceneClass::Collect_Objects
 )
 {
 	WWASSERT(list != nullptr);
+	PhysIslandCullReadLockClass lock;
 
 	if (static_objs) {
 		StaticCullingSystem->Reset_Collection();
@@ -517,6 +563,7 @@ void PhysicsSceneClass::Collect_Objects
 )
 {
 	WWASSERT(list != nullptr);
+	PhysIslandCullReadLockClass lock;
 
 	if (static_objs) {
 		StaticCullingSystem->Reset_Collection();
@@ -540,6 +587,8 @@ void PhysicsSceneClass::Collect_Objects
 )
 {
 	WWASSERT(list != nullptr);
+	PhysIslandCullReadLockClass lock;
+
 	if (static_objs) {
 		StaticCullingSystem->Reset_Collection();
 		StaticCullingSystem->Collect_Objects(box);
@@ -562,6 +611,8 @@ void PhysicsSceneClass::Collect_Objects
 )
 {
 	WWASSERT(list != nullptr);
+	PhysIslandCullReadLockClass lock;
+
 	if (static_objs) {
 		StaticCullingSystem->Reset_Collection();
 		StaticCullingSystem->Collect_Objects(frustum);
@@ -585,6 +636,8 @@ void PhysicsSceneClass::Collect_Collideable_Objects
 )
 {
 	WWASSERT(list != nullptr);
+	PhysIslandCullReadLockClass lock;
+
 	if (static_objs) {
 		StaticCullingSystem->Reset_Collection();
 		StaticCullingSystem->Collect_Objects(box);
@@ -608,6 +661,8 @@ void PhysicsSceneClass::Collect_Collideable_Objects
 )
 {
 	WWASSERT(list != nullptr);
+	PhysIslandCullReadLockClass lock;
+
 	if (static_objs) {
 		StaticCullingSystem->Reset_Collection();
 		StaticCullingSystem->Collect_Objects(box);
@@ -652,6 +707,7 @@ void PhysicsSceneClass::Collect_Lights
 )
 {
 	WWASSERT(list != nullptr);
+	PhysIslandCullReadLockClass lock;
 
 	if (static_lights) {
 		StaticLightingSystem->Reset_Collection();
@@ -673,6 +729,7 @@ void PhysicsSceneClass::Collect_Lights
 )
 {
 	WWASSERT(list != nullptr);
+	PhysIslandCullReadLockClass lock;
 
 	if (static_lights) {
 		StaticLightingSystem->Reset_Collection();
@@ -0,0 +1,284 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+** Fixed timestepping for the PhysicsSceneClass.
+**
+** Update normally timesteps the objects by the frame time, split into steps no longer than
+** MAX_TIMESTEP, so the number and length of the steps follow the frame rate.  In fixed
+** timestep mode the frame time goes into an accumulator instead and the objects are
+** timestepped in whole steps of FixedTimestep; whatever is left over waits for the next
+** Update.  A server and a client running the same input then take the same steps.
+**
+** To keep motion smooth when the frame rate and the step rate don't match, each timestepped
+** object's transform from before the last step is recorded.  Pre_Render_Processing moves the
+** object's model between that and its current transform, by the fraction of a step left in
+** the accumulator, and Post_Render_Processing puts it back.  The simulation never sees the
+** interpolated transforms.
+*/
+
+#include "pscene.h"
+#include "phys.h"
+#include "rendobj.h"
+#include "matrix3d.h"
+#include "wwdebug.h"
+#include "wwprofile.h"
+
+#include <algorithm>
+
+
+/*
+** Objects that moved further than this during the last step are assumed to have been
+** teleported and aren't interpolated.
+*/
+const float MAX_INTERPOLATION_DISTANCE = 10.0f;
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Enable_Fixed_Timestep -- Turns fixed timestep mode on or off             *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+void PhysicsSceneClass::Enable_Fixed_Timestep(bool onoff)
+{
+	if (onoff == FixedTimestepEnabled) {
+		return;
+	}
+
+	Restore_Interpolated_Transforms();
+	Release_Interpolation_Transforms();
+
+	FixedTimestepEnabled = onoff;
+	FixedTimestepAccumulator = 0.0f;
+	InterpolationFraction = 1.0f;
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Fixed_Timestep -- Timesteps the objects in whole fixed steps             *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * dt - frame time to add to the accumulator                                                   *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+void PhysicsSceneClass::Fixed_Timestep(float dt)
+{
+	WWASSERT(FixedTimestep > 0.0f);
+	WWPROFILE("Fixed Timestep");
+
+	/*
+	** The simulation has to start from the real transforms
+	*/
+	Restore_Interpolated_Transforms();
+
+	FixedTimestepAccumulator += dt;
+	int steps = (int)(FixedTimestepAccumulator / FixedTimestep);
+
+	/*
+	** Don't try to catch up on more than a few steps at once, a slow frame would only
+	** make the next one slower.  The time we can't catch up on is dropped.
+	*/
+	if ((MaxCatchUpSteps > 0) && (steps > MaxCatchUpSteps)) {
+		float dropped = (steps - MaxCatchUpSteps) * FixedTimestep;
+		FixedTimestepAccumulator -= dropped;
+		FixedStepStats.DroppedTime += dropped;
+		FixedStepStats.ClampCount++;
+		steps = MaxCatchUpSteps;
+	}
+
+	for (int i=0; i<steps; i++) {
+
+		/*
+		** Rendering interpolates across the last step of the frame
+		*/
+		if (i == steps - 1) {
+			Record_Interpolation_Transforms();
+		}
+
+		Timestep_Objects(FixedTimestep);
+		FixedTimestepAccumulator -= FixedTimestep;
+	}
+
+	FixedTimestepAccumulator = std::max(FixedTimestepAccumulator,0.0f);
+	InterpolationFraction = std::min(FixedTimestepAccumulator / FixedTimestep,1.0f);
+
+	FixedStepStats.UpdateCount++;
+	FixedStepStats.StepCount += steps;
+	FixedStepStats.MaxSteps = std::max(FixedStepStats.MaxSteps,steps);
+	if (steps == 0) {
+		FixedStepStats.IdleCount++;
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Record_Interpolation_Transforms -- Records transforms before a step      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * The objects are referenced until the next record so an object removed from the scene in    *
+ * the meantime is still safe to look at.                                                      *
+ *=============================================================================================*/
+void PhysicsSceneClass::Record_Interpolation_Transforms(void)
+{
+	Release_Interpolation_Transforms();
+
+	RefPhysListIterator it(&TimestepList);
+	for (it.First(); !it.Is_Done(); it.Next()) {
+		PhysClass * obj = it.Peek_Obj();
+		if (obj->Is_Object_Simulating() && (obj->Peek_Model() != nullptr)) {
+
+			InterpolationStruct entry;
+			entry.Object = obj;
+			entry.PrevTransform = obj->Get_Transform();
+			entry.CurTransform = entry.PrevTransform;
+			entry.Applied = false;
+
+			obj->Add_Ref();
+			InterpolationList.Add(entry);
+		}
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Release_Interpolation_Transforms -- Forgets the recorded transforms      *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+void PhysicsSceneClass::Release_Interpolation_Transforms(void)
+{
+	WWASSERT(!InterpolationApplied);
+
+	for (int i=0; i<InterpolationList.Count(); i++) {
+		InterpolationList[i].Object->Release_Ref();
+	}
+	InterpolationList.Reset_Active();
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Apply_Interpolated_Transforms -- Moves the models for rendering          *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Only the render models are moved; the culling systems keep the simulated bounds.            *
+ *=============================================================================================*/
+void PhysicsSceneClass::Apply_Interpolated_Transforms(void)
+{
+	if (!FixedTimestepEnabled || InterpolationApplied) {
+		return;
+	}
+
+	WWPROFILE("Interpolate");
+	InterpolationApplied = true;
+
+	for (int i=0; i<InterpolationList.Count(); i++) {
+		InterpolationStruct & entry = InterpolationList[i];
+		entry.Applied = false;
+
+		/*
+		** Skip objects that have left the scene or swapped models since the step
+		*/
+		PhysClass * obj = entry.Object;
+		if ((obj->Get_Culling_System() == nullptr) || (obj->Peek_Model() == nullptr)) {
+			continue;
+		}
+
+		entry.CurTransform = obj->Get_Transform();
+
+		Vector3 move = entry.CurTransform.Get_Translation() - entry.PrevTransform.Get_Translation();
+		if (move.Length2() > MAX_INTERPOLATION_DISTANCE * MAX_INTERPOLATION_DISTANCE) {
+			continue;
+		}
+
+		obj->Peek_Model()->Set_Transform(Lerp(entry.PrevTransform,entry.CurTransform,InterpolationFraction));
+		entry.Applied = true;
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Restore_Interpolated_Transforms -- Puts the models back after rendering  *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+void PhysicsSceneClass::Restore_Interpolated_Transforms(void)
+{
+	if (!InterpolationApplied) {
+		return;
+	}
+
+	for (int i=0; i<InterpolationList.Count(); i++) {
+		InterpolationStruct & entry = InterpolationList[i];
+		if (entry.Applied && (entry.Object->Peek_Model() != nullptr)) {
+			entry.Object->Peek_Model()->Set_Transform(entry.CurTransform);
+		}
+		entry.Applied = false;
+	}
+
+	InterpolationApplied = false;
+}
+
+
+/******************************************************************************************
+**
+**
+** PhysicsSceneClass::FixedStepStatsStruct Implementation
+**
+**
+******************************************************************************************/
+PhysicsSceneClass::FixedStepStatsStruct::FixedStepStatsStruct(void)
+{
+	Reset();
+}
+
+void PhysicsSceneClass::FixedStepStatsStruct::Reset(void)
+{
+	UpdateCount = 0;
+	StepCount = 0;
+	MaxSteps = 0;
+	IdleCount = 0;
+	ClampCount = 0;
+	DroppedTime = 0.0f;
+}
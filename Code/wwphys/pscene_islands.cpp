@@ -0,0 +1,403 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+** Island timestepping for the PhysicsSceneClass.
+**
+** Each step, the objects that would be timestepped are grouped into islands: two objects
+** share an island if their cull boxes, grown by the island margin and by the distance they
+** can travel in the step, overlap, or if one of them is riding on or standing on the other.
+** Islands can't touch each other during the step so they are timestepped independently.
+** Rigid bodies and Phys3 objects which aren't timestepped this step (asleep, not simulating,
+** or invisible vehicles) can still be pushed and woken up by those that are, so they join
+** the islands that can reach them without being timestepped themselves.
+** Islands made only of rigid bodies and Phys3 objects, none of them observed, are spread
+** over the job pool, the rest are timestepped on the calling thread first.  Observer
+** callbacks run game code, see physislands.h for how they are kept off the job pool.  Within an island objects are
+** timestepped in TimestepList order; islands can't affect each other so the order between
+** them doesn't change the results.  While an island is being timestepped,
+** the objects of every other island are ignored by its collision checks (see
+** PhysClass::Is_In_Other_Island) and the shared state it does touch is protected by the
+** locks in physislands.h.
+*/
+
+#include "pscene.h"
+#include "phys3.h"
+#include "jobpool.h"
+#include "crc.h"
+#include "wwdebug.h"
+#include "wwprofile.h"
+
+#include <algorithm>
+#include <atomic>
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Timestep_Islands -- Timesteps the TimestepList as independent islands    *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * step - length of the timestep                                                               *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ * Skips the same objects as the serial loop in Update.                                        *
+ *                                                                                             *
+ *=============================================================================================*/
+void PhysicsSceneClass::Timestep_Islands(float step)
+{
+	WWPROFILE("Islands");
+
+	/*
+	** Grab the objects that are going to be timestepped.  They are referenced for the
+	** duration in case an observer tries to get rid of one.  The island id temporarily
+	** holds the object's index so carriers and ground objects can be looked up.
+	*/
+	IslandObjects.Reset_Active();
+	IslandBounds.Reset_Active();
+	IslandParents.Reset_Active();
+
+	RefPhysListIterator it(&TimestepList);
+	for (it.First(); !it.Is_Done(); it.Next()) {
+		PhysClass * obj = it.Peek_Obj();
+		if (obj->Is_Object_Simulating()) {
+			if (	!UpdateOnlyVisibleObjects ||
+					obj->Get_Last_Visible_Frame() == CurrentFrameNumber ||
+					!obj->As_VehiclePhysClass()) {
+
+				obj->Add_Ref();
+				obj->Set_Island_ID(IslandObjects.Count());
+				IslandParents.Add(IslandObjects.Count());
+				IslandObjects.Add(obj);
+
+				AABoxClass bounds = obj->Get_Cull_Box();
+				Vector3 vel(0,0,0);
+				if (obj->As_MoveablePhysClass() != nullptr) {
+					obj->As_MoveablePhysClass()->Get_Velocity(&vel);
+				}
+				bounds.Extent.X += IslandMargin + WWMath::Fabs(vel.X) * step;
+				bounds.Extent.Y += IslandMargin + WWMath::Fabs(vel.Y) * step;
+				bounds.Extent.Z += IslandMargin + WWMath::Fabs(vel.Z) * step;
+				IslandBounds.Add(bounds);
+			}
+		}
+	}
+
+	int active_count = IslandObjects.Count();
+	if (active_count == 0) {
+		return;
+	}
+
+	/*
+	** Add the rigid bodies and Phys3 objects that aren't being timestepped.  They go after
+	** the timestepped objects so an island with any timestepped object in it has one of
+	** those as its root.
+	*/
+	RefPhysListIterator obj_it(&ObjList);
+	for (obj_it.First(); !obj_it.Is_Done(); obj_it.Next()) {
+		PhysClass * obj = obj_it.Peek_Obj();
+		if (	(obj->Get_Island_ID() < 0) &&
+				((obj->As_RigidBodyClass() != nullptr) || (obj->As_Phys3Class() != nullptr)))
+		{
+			obj->Add_Ref();
+			obj->Set_Island_ID(IslandObjects.Count());
+			IslandParents.Add(IslandObjects.Count());
+			IslandObjects.Add(obj);
+
+			AABoxClass bounds = obj->Get_Cull_Box();
+			bounds.Extent.X += IslandMargin;
+			bounds.Extent.Y += IslandMargin;
+			bounds.Extent.Z += IslandMargin;
+			IslandBounds.Add(bounds);
+		}
+	}
+
+	int count = IslandObjects.Count();
+
+	/*
+	** Merge objects whose bounds overlap.  Sort by the minimum x and sweep, only the
+	** objects which start before the current one ends can overlap it.
+	*/
+	IslandOrder.Reset_Active();
+	for (int i=0; i<count; i++) {
+		IslandOrder.Add(i);
+	}
+
+	const AABoxClass * bounds = &(IslandBounds[0]);
+	std::sort(&(IslandOrder[0]),&(IslandOrder[0]) + count,
+		[bounds](int a,int b) {
+			float amin = bounds[a].Center.X - bounds[a].Extent.X;
+			float bmin = bounds[b].Center.X - bounds[b].Extent.X;
+			return (amin < bmin) || ((amin == bmin) && (a < b));
+		}
+	);
+
+	for (int i=0; i<count; i++) {
+		const AABoxClass & box0 = bounds[IslandOrder[i]];
+		float max_x = box0.Center.X + box0.Extent.X;
+		bool passive0 = (IslandOrder[i] >= active_count);
+
+		for (int j=i+1; j<count; j++) {
+			const AABoxClass & box1 = bounds[IslandOrder[j]];
+			if (box1.Center.X - box1.Extent.X > max_x) {
+				break;
+			}
+			if (passive0 && (IslandOrder[j] >= active_count)) {
+				continue;
+			}
+			if (	(WWMath::Fabs(box0.Center.Y - box1.Center.Y) <= box0.Extent.Y + box1.Extent.Y) &&
+					(WWMath::Fabs(box0.Center.Z - box1.Center.Z) <= box0.Extent.Z + box1.Extent.Z)	)
+			{
+				Merge_Islands(IslandOrder[i],IslandOrder[j]);
+			}
+		}
+	}
+
+	/*
+	** Riders move with their carrier and walkers react to what they stand on
+	*/
+	for (int i=0; i<count; i++) {
+		PhysClass * obj = IslandObjects[i];
+		PhysClass * other[2] = { nullptr, nullptr };
+
+		if (obj->As_MoveablePhysClass() != nullptr) {
+			other[0] = obj->As_MoveablePhysClass()->Peek_Carrier_Object();
+		}
+		if (obj->As_Phys3Class() != nullptr) {
+			other[1] = obj->As_Phys3Class()->Peek_Ground_Object();
+		}
+
+		for (int k=0; k<2; k++) {
+			if (other[k] != nullptr) {
+				int index = other[k]->Get_Island_ID();
+				if ((index >= 0) && (index < count) && (IslandObjects[index] == other[k])) {
+					Merge_Islands(i,index);
+				}
+			}
+		}
+	}
+
+	/*
+	** Number the islands in the order of their first object and gather their members,
+	** keeping the TimestepList order within each island.  A root is always the lowest
+	** index in its island so it is reached before any other member.  Objects that aren't
+	** timestepped aren't members; the ones no island can reach stay out of the islands.
+	*/
+	IslandList.Reset_Active();
+	IslandMembers.Reset_Active();
+	for (int i=0; i<count; i++) {
+		int root = Find_Island_Root(i);
+		IslandParents[i] = root;
+		if (root >= active_count) {
+			continue;
+		}
+		if (root == i) {
+			IslandStruct island;
+			island.FirstMember = 0;
+			island.MemberCount = 0;
+			island.Parallel = true;
+			IslandOrder[i] = IslandList.Count();
+			IslandList.Add(island);
+		}
+
+		/*
+		** Anything observed in the island, timestepped or not, keeps it off the job pool
+		*/
+		IslandStruct & island = IslandList[IslandOrder[root]];
+		island.Parallel &= (IslandObjects[i]->Get_Observer() == nullptr);
+		if (i < active_count) {
+			island.MemberCount++;
+			island.Parallel &= ((IslandObjects[i]->As_RigidBodyClass() != nullptr) || (IslandObjects[i]->As_Phys3Class() != nullptr));
+		}
+	}
+
+	int first = 0;
+	for (int i=0; i<IslandList.Count(); i++) {
+		IslandList[i].FirstMember = first;
+		first += IslandList[i].MemberCount;
+		IslandList[i].MemberCount = 0;
+	}
+
+	for (int i=0; i<active_count; i++) {
+		IslandMembers.Add(0);
+	}
+	for (int i=0; i<count; i++) {
+		if (IslandParents[i] >= active_count) {
+			IslandObjects[i]->Set_Island_ID(-1);
+			continue;
+		}
+		int island_id = IslandOrder[IslandParents[i]];
+		if (i < active_count) {
+			IslandStruct & island = IslandList[island_id];
+			IslandMembers[island.FirstMember + island.MemberCount++] = i;
+		}
+		IslandObjects[i]->Set_Island_ID(island_id);
+	}
+
+	/*
+	** Islands that can't go on the job pool are timestepped here, as the serial loop would.
+	** They run before all of the parallel islands rather than in TimestepList order, which
+	** is only safe because islands are independent.
+	*/
+	int parallel_objects = 0;
+	IslandOrder.Reset_Active();
+	for (int i=0; i<IslandList.Count(); i++) {
+		const IslandStruct & island = IslandList[i];
+		if (island.Parallel) {
+			IslandOrder.Add(i);
+			parallel_objects += island.MemberCount;
+		} else {
+			for (int m=0; m<island.MemberCount; m++) {
+				IslandObjects[IslandMembers[island.FirstMember + m]]->Timestep(step);
+			}
+		}
+		IslandStats.LargestIsland = std::max(IslandStats.LargestIsland,island.MemberCount);
+	}
+
+	/*
+	** Hand the rest to the job pool, largest first so a big island doesn't end up last.
+	** Each lane gets its own collection slot in the culling systems.
+	*/
+	int parallel_count = IslandOrder.Count();
+	if (parallel_count > 0) {
+		const IslandStruct * islands = &(IslandList[0]);
+		std::stable_sort(&(IslandOrder[0]),&(IslandOrder[0]) + parallel_count,
+			[islands](int a,int b) { return islands[a].MemberCount > islands[b].MemberCount; }
+		);
+
+		int lanes = std::min(JobPoolClass::Get_Worker_Count() + 1,(int)CullableClass::MAX_COLLECTION_SLOTS);
+		lanes = std::min(lanes,parallel_count);
+
+		std::atomic<int> next_island(0);
+		const int * order = &(IslandOrder[0]);
+		const int * members = &(IslandMembers[0]);
+		PhysClass * const * objects = &(IslandObjects[0]);
+
+		PhysIslandsClass::Begin_Parallel_Phase();
+		JobPoolClass::Run(lanes,
+			[&next_island,parallel_count,order,islands,members,objects,step](int lane) {
+				CullSystemClass::Set_Collection_Slot(lane);
+				for (int n = next_island++; n < parallel_count; n = next_island++) {
+					const IslandStruct & island = islands[order[n]];
+					PhysClass::Set_Current_Island(order[n]);
+					for (int m=0; m<island.MemberCount; m++) {
+						objects[members[island.FirstMember + m]]->Timestep(step);
+					}
+				}
+				PhysClass::Set_Current_Island(-1);
+				CullSystemClass::Set_Collection_Slot(0);
+			}
+		);
+		PhysIslandsClass::End_Parallel_Phase();
+		PhysIslandsClass::Dispatch_Deferred_Collisions();
+	}
+
+	/*
+	** An object which left the bounds it was grouped by may have run into another island
+	*/
+	if (IslandCheckEnabled) {
+		for (int i=0; i<count; i++) {
+			const AABoxClass & box0 = IslandBounds[i];
+			const AABoxClass & box1 = IslandObjects[i]->Get_Cull_Box();
+			if (	(WWMath::Fabs(box1.Center.X - box0.Center.X) + box1.Extent.X > box0.Extent.X) ||
+					(WWMath::Fabs(box1.Center.Y - box0.Center.Y) + box1.Extent.Y > box0.Extent.Y) ||
+					(WWMath::Fabs(box1.Center.Z - box0.Center.Z) + box1.Extent.Z > box0.Extent.Z)	)
+			{
+				IslandStats.EscapeCount++;
+			}
+		}
+	}
+
+	IslandStats.StepCount++;
+	IslandStats.IslandCount += IslandList.Count();
+	IslandStats.ParallelIslandCount += parallel_count;
+	IslandStats.ObjectCount += active_count;
+	IslandStats.ParallelObjectCount += parallel_objects;
+
+	for (int i=0; i<count; i++) {
+		IslandObjects[i]->Set_Island_ID(-1);
+		IslandObjects[i]->Release_Ref();
+	}
+	IslandObjects.Reset_Active();
+}
+
+
+int PhysicsSceneClass::Find_Island_Root(int index)
+{
+	while (IslandParents[index] != index) {
+		IslandParents[index] = IslandParents[IslandParents[index]];
+		index = IslandParents[index];
+	}
+	return index;
+}
+
+
+void PhysicsSceneClass::Merge_Islands(int index0,int index1)
+{
+	int root0 = Find_Island_Root(index0);
+	int root1 = Find_Island_Root(index1);
+
+	// the lower index becomes the root so the grouping doesn't depend on the merge order
+	if (root0 < root1) {
+		IslandParents[root1] = root0;
+	} else if (root1 < root0) {
+		IslandParents[root0] = root1;
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Compute_Timestep_Checksum -- CRC of the transforms in the TimestepList   *
+ *                                                                                             *
+ * Used by the island check, the same input must give the same checksum whether the            *
+ * islands were timestepped in parallel or not.                                                *
+ *=============================================================================================*/
+uint32 PhysicsSceneClass::Compute_Timestep_Checksum(void)
+{
+	uint32 crc = 0;
+	RefPhysListIterator it(&TimestepList);
+	for (it.First(); !it.Is_Done(); it.Next()) {
+		Matrix3D tm = it.Peek_Obj()->Get_Transform();
+		crc = CRC::Memory((unsigned char *)&tm,sizeof(tm),crc);
+	}
+	return crc;
+}
+
+
+/******************************************************************************************
+**
+**
+** PhysicsSceneClass::IslandStatsStruct Implementation
+**
+**
+******************************************************************************************/
+PhysicsSceneClass::IslandStatsStruct::IslandStatsStruct(void)
+{
+	Reset();
+}
+
+void PhysicsSceneClass::IslandStatsStruct::Reset(void)
+{
+	StepCount = 0;
+	IslandCount = 0;
+	ParallelIslandCount = 0;
+	ObjectCount = 0;
+	ParallelObjectCount = 0;
+	LargestIsland = 0;
+	EscapeCount = 0;
+}
@@ -0,0 +1,125 @@
+/*
+**	Command & Conquer Renegade(tm)
+**	Copyright 2025 Electronic Arts Inc.
+**
+**	This program is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 3 of the License, or
+**	(at your option) any later version.
+**
+**	This program is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+** Sleeping objects for the PhysicsSceneClass.
+**
+** Physics objects that settle set their ASLEEP flag and skip their own simulation, but they
+** stay in the TimestepList so they still cost a Timestep call, a Post_Timestep_Process call
+** and a place in the island sweep every step.  Late in a game that is hundreds of parked
+** vehicles.  Here, an object that has been at rest (PhysClass::Is_At_Rest) for SleepFrames
+** updates is moved to the SleepingList instead.  Anything that would have woken it up in its
+** own Timestep - a contact or an impulse clearing the ASLEEP flag, its controller becoming
+** active, a network correction - makes it stop being at rest, and the next update moves it
+** back to the TimestepList before anything is timestepped.
+*/
+
+#include "pscene.h"
+#include "phys.h"
+#include "wwprofile.h"
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Enable_Object_Sleeping -- Turns sleeping objects on or off               *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+void PhysicsSceneClass::Enable_Object_Sleeping(bool onoff)
+{
+	if (!onoff) {
+		Wake_Sleeping_Objects(true);
+	}
+	ObjectSleepingEnabled = onoff;
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Wake_Sleeping_Objects -- Moves the woken objects back to the TimestepList *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ * wake_all - move every sleeping object back, at rest or not                                  *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+void PhysicsSceneClass::Wake_Sleeping_Objects(bool wake_all)
+{
+	WWPROFILE("Wake Objects");
+
+	RefPhysListIterator it(&SleepingList);
+	while (!it.Is_Done()) {
+		PhysClass * obj = it.Peek_Obj();
+
+		if (wake_all || !obj->Is_At_Rest()) {
+			obj->Set_Rest_Frames(0);
+			TimestepList.Add(obj);
+			it.Remove_Current_Object();
+			WakeCount++;
+		} else {
+			it.Next();
+		}
+	}
+}
+
+
+/***********************************************************************************************
+ * PhysicsSceneClass::Put_Objects_To_Sleep -- Takes resting objects out of the TimestepList    *
+ *                                                                                             *
+ * INPUT:                                                                                      *
+ *                                                                                             *
+ * OUTPUT:                                                                                     *
+ *                                                                                             *
+ * WARNINGS:                                                                                   *
+ *                                                                                             *
+ *=============================================================================================*/
+void PhysicsSceneClass::Put_Objects_To_Sleep(void)
+{
+	WWPROFILE("Sleep Objects");
+
+	RefPhysListIterator it(&TimestepList);
+	while (!it.Is_Done()) {
+		PhysClass * obj = it.Peek_Obj();
+
+		if (!obj->Is_At_Rest()) {
+			obj->Set_Rest_Frames(0);
+			it.Next();
+			continue;
+		}
+
+		obj->Set_Rest_Frames(obj->Get_Rest_Frames() + 1);
+		if (obj->Get_Rest_Frames() < SleepFrames) {
+			it.Next();
+			continue;
+		}
+
+		/*
+		** Add it to the sleeping list first, removing it from the TimestepList
+		** releases that list's reference.
+		*/
+		SleepingList.Add(obj);
+		it.Remove_Current_Object();
+		SleepCount++;
+	}
+}
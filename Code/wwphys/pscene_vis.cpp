@@ -305,6 +305,81 @@ void PhysicsSceneClass::Debug_Display_Dynamic_Vis_Node(int node_id)
 	}
 }
 
+void PhysicsSceneClass::Set_Vis_Cache_Budget(int bytes)
+{
+	VisTableManager.Set_Cache_Budget(bytes);
+}
+
+int PhysicsSceneClass::Get_Vis_Cache_Budget(void)
+{
+	return VisTableManager.Get_Cache_Budget();
+}
+
+void PhysicsSceneClass::Enable_Vis_Full_Decompression(bool onoff)
+{
+	VisTableManager.Enable_Full_Decompression(onoff);
+}
+
+bool PhysicsSceneClass::Is_Vis_Full_Decompression_Enabled(void)
+{
+	return VisTableManager.Is_Full_Decompression_Enabled();
+}
+
+void PhysicsSceneClass::Set_Vis_Prefetch_Time(float seconds)
+{
+	VisPrefetchTime = seconds;
+}
+
+float PhysicsSceneClass::Get_Vis_Prefetch_Time(void)
+{
+	return VisPrefetchTime;
+}
+
+void PhysicsSceneClass::Prefetch_Vis_Tables(const Vector3 & point,const Vector3 & velocity)
+{
+	const int PREFETCH_SAMPLES = 2;
+
+	if ((VisPrefetchTime <= 0.0f) || VisResetNeeded || !VisEnabled || VisTableManager.Is_Full_Decompression_Enabled()) {
+		return;
+	}
+
+	/*
+	** Sample a couple of points along the path the object is on and prefetch
+	** the table of each new vis sector we find there.
+	*/
+	int last_vis_id = StaticCullingSystem->Get_Vis_Sector_ID(point);
+
+	for (int i=1; i<=PREFETCH_SAMPLES; i++) {
+		Vector3 sample_point = point + velocity * (VisPrefetchTime * (float)i / (float)PREFETCH_SAMPLES);
+		int vis_id = StaticCullingSystem->Get_Vis_Sector_ID(sample_point);
+
+		if ((vis_id != -1) && (vis_id != last_vis_id)) {
+			VisTableManager.Prefetch_Vis_Table(vis_id);
+			last_vis_id = vis_id;
+		}
+	}
+}
+
+const VisTableMgrClass::CacheStatsStruct & PhysicsSceneClass::Get_Vis_Cache_Stats(void)
+{
+	return VisTableManager.Get_Cache_Stats();
+}
+
+void PhysicsSceneClass::Reset_Vis_Cache_Stats(void)
+{
+	VisTableManager.Reset_Cache_Stats();
+}
+
+int PhysicsSceneClass::Get_Vis_Cache_Bytes(void)
+{
+	return VisTableManager.Get_Cache_Bytes();
+}
+
+int PhysicsSceneClass::Get_Vis_Cache_Table_Count(void)
+{
+	return VisTableManager.Get_Cache_Table_Count();
+}
+
 void PhysicsSceneClass::Lock_Vis_Sample_Point(bool onoff)
 {
 	VisSamplePointLocked = onoff;
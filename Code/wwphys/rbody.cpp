@@ -967,6 +967,18 @@ void RigidBodyClass::Network_Latency_Error_Correction(float dt)
 }
 
 
+bool RigidBodyClass::Is_At_Rest(void)
+{
+	/*
+	** Timestep would return right away: we're asleep, our controller has nothing
+	** to wake us up with and there is no network error to correct.
+	*/
+	return	Is_Asleep() &&
+				((Controller == nullptr) || Controller->Is_Inactive()) &&
+				(LatencyError.Position.Length2() <= 0.001f);
+}
+
+
 void RigidBodyClass::Apply_Impulse(const Vector3 & imp)
 {
 	// Impluse applied to center of mass simply adds to the linear momentum
@@ -105,6 +105,7 @@ public:
 	virtual void					Apply_Impulse(const Vector3 & imp);
 	virtual void					Apply_Impulse(const Vector3 & imp, const Vector3 & wpos);
 	virtual void					Timestep(float dt) override;
+	virtual bool					Is_At_Rest(void) override;
 	void								Compute_Point_Velocity(const Vector3 & p,Vector3 * pdot);
 	float								Get_Last_Timestep(void)		{ return LastTimestep; }
 
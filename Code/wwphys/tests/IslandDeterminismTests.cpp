@@ -0,0 +1,103 @@
+#include "pscene.h"
+#include "rbody.h"
+#include "assetmgr.h"
+#include "boxrobj.h"
+#include "jobpool.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr int ClusterCount = 8;
+constexpr int BodiesPerCluster = 4;
+constexpr int FrameCount = 120;
+constexpr float FrameTime = 1.0f / 30.0f;
+
+RigidBodyClass *Create_Body(PhysicsSceneClass &scene, const Vector3 &position, const Vector3 &velocity)
+{
+    RenderObjClass *model = new OBBoxRenderObjClass(OBBoxClass(Vector3(0, 0, 0), Vector3(1, 1, 1)));
+    RigidBodyClass *body = NEW_REF(RigidBodyClass, ());
+    body->Set_Model(model);
+    body->Set_Transform(Matrix3D(position));
+    body->Set_Velocity(velocity);
+    scene.Add_Dynamic_Object(body);
+    model->Release_Ref();
+    return body;
+}
+
+//
+// Clusters of bodies that run into each other, far enough apart to be separate islands.
+// The last group has a body that isn't simulating between two bodies moving at it from
+// either side; they can only reach each other through it, so both must end up in its island.
+//
+void Build_Scene(PhysicsSceneClass &scene, std::vector<RigidBodyClass *> &bodies)
+{
+    for (int cluster = 0; cluster < ClusterCount; ++cluster) {
+        Vector3 center(cluster * 50.0f, 0.0f, 0.0f);
+        for (int index = 0; index < BodiesPerCluster; ++index) {
+            float side = (index & 1) ? 1.0f : -1.0f;
+            Vector3 offset(side * (3.0f + index), 0.25f * index, 0.5f * cluster);
+            Vector3 velocity(-side * (4.0f + cluster), 0.1f * index, 0.0f);
+            bodies.push_back(Create_Body(scene, center + offset, velocity));
+        }
+    }
+
+    Vector3 center(-100.0f, 0.0f, 0.0f);
+    RigidBodyClass *passive = Create_Body(scene, center, Vector3(0, 0, 0));
+    passive->Enable_Objects_Simulation(false);
+    bodies.push_back(passive);
+    bodies.push_back(Create_Body(scene, center + Vector3(-3.0f, 0, 0), Vector3(5.0f, 0, 0)));
+    bodies.push_back(Create_Body(scene, center + Vector3(3.0f, 0, 0), Vector3(-5.0f, 0, 0)));
+}
+
+std::vector<Matrix3D> Run_Scene(PhysicsSceneClass &scene, bool islands)
+{
+    std::vector<RigidBodyClass *> bodies;
+    Build_Scene(scene, bodies);
+
+    scene.Enable_Island_Timestep(islands);
+    scene.Reset_Island_Stats();
+    for (int frame = 0; frame < FrameCount; ++frame) {
+        scene.Update(FrameTime, frame);
+    }
+
+    std::vector<Matrix3D> results;
+    for (RigidBodyClass *body : bodies) {
+        results.push_back(body->Get_Transform());
+        scene.Remove_Object(body);
+        body->Release_Ref();
+    }
+    return results;
+}
+
+} // namespace
+
+int main()
+{
+    JobPoolClass::Init(3);
+    WW3DAssetManager *assets = new WW3DAssetManager;
+    PhysicsSceneClass *scene = new PhysicsSceneClass;
+
+    std::vector<Matrix3D> serial = Run_Scene(*scene, false);
+    std::vector<Matrix3D> parallel = Run_Scene(*scene, true);
+
+    int result = 0;
+    if (scene->Get_Island_Stats().ParallelIslandCount == 0) {
+        std::cerr << "No island was timestepped on the job pool.\n";
+        result = 1;
+    }
+
+    for (size_t index = 0; index < serial.size(); ++index) {
+        if (std::memcmp(&serial[index], &parallel[index], sizeof(Matrix3D)) != 0) {
+            std::cerr << "Body " << index << " ended up somewhere else when timestepped in islands.\n";
+            result = 1;
+        }
+    }
+
+    delete scene;
+    delete assets;
+    JobPoolClass::Shutdown();
+    return result;
+}
@@ -104,6 +104,7 @@ void TimedDecorationPhysClass::Timestep(float dt)
 		*/
 		Lifetime -= dt;
 		if (Lifetime < 0.0f) {
+			PhysIslandSerialLockClass lock;
 			ExpirationReactionType result = EXPIRATION_APPROVED;
 			if (Observer != nullptr) {
 				result = Observer->Object_Expired(this);
@@ -51,6 +51,9 @@
 // Vehicles will sit rolled over for this long before exploding!
 const float		EXPIRE_SECONDS								= 4.0f;
 
+// Vehicles tilted further than this (cosine of the up vector's Z) count as rolled over
+const float		MIN_Z_COSINE								= 0.25f;
+
 // HACK! when the engine is off, decimate the momentum each timestep by this fraction...
 const float		PARKING_BRAKE_DAMPING					= 0.5f;
 
@@ -284,7 +287,6 @@ void VehiclePhysClass::Timestep(float dt)
 	** See if we should be destroyed due to coming to rest upside down
 	*/
 	float up_cos = Get_Transform().Get_Z_Vector().Z;
-	const float MIN_Z_COSINE = 0.25f;
 	if (up_cos < MIN_Z_COSINE) {
 		ExpireTimer -= dt;
 		if (ExpireTimer < 0.0f) {
@@ -296,6 +298,14 @@ void VehiclePhysClass::Timestep(float dt)
 	}
 }
 
+bool VehiclePhysClass::Is_At_Rest(void)
+{
+	/*
+	** Rolled over vehicles keep being timestepped so they can expire
+	*/
+	return RigidBodyClass::Is_At_Rest() && (Get_Transform().Get_Z_Vector().Z >= MIN_Z_COSINE);
+}
+
 SuspensionElementClass * VehiclePhysClass::Peek_Wheel(int wheel_index)
 {
 	return Wheels[wheel_index];
@@ -82,6 +82,7 @@ public:
 	** Simulation
 	*/
 	virtual void						Timestep(float dt) override;
+	virtual bool						Is_At_Rest(void) override;
 
 	/*
 	** Gentlemen Start your Engines!
@@ -41,6 +41,7 @@
 #include "vistable.h"
 #include "chunkio.h"
 #include "wwmemlog.h"
+#include <chrono>
 
 
 const int VIS_LRU_FRAMES = 5;
@@ -55,24 +56,33 @@ const int VIS_LRU_FRAMES = 5;
 class VisDecompressionCacheClass
 {
 public:
-	VisDecompressionCacheClass(void) { }
+	VisDecompressionCacheClass(void) : CurrentTimestamp(0), CacheBytes(0), TableCount(0) { }
 	~VisDecompressionCacheClass(void) { Reset(0); }
 
 	void						Reset(int vis_sector_count = -1);
 
 	VisTableClass *		Get_Table(int vis_sector_id);
+	bool						Has_Table(int vis_sector_id)					{ return Cache[vis_sector_id] != nullptr; }
 	void						Add_Table(VisTableClass * pvs);
-	void						Release_Old_Tables(void);
+	int						Release_Old_Tables(int budget);
 
 	void						Set_Current_Timestamp(int timestamp)		{ CurrentTimestamp = timestamp; }
 	int						Get_Current_Timestamp(void)					{ return CurrentTimestamp; }
 
+	int						Get_Byte_Count(void) const						{ return CacheBytes; }
+	int						Get_Table_Count(void) const					{ return TableCount; }
+
 protected:
 
+	void						Release_Head(void);
+	static int				Table_Bytes(VisTableClass * pvs)				{ return sizeof(VisTableClass) + ((pvs->Get_Bit_Count() + 31) >> 5) * sizeof(uint32); }
+
 	SimpleVecClass<VisTableClass *>			Cache;
 	MultiListClass<VisTableClass>				LRUQueue;
 
 	int												CurrentTimestamp;
+	int												CacheBytes;
+	int												TableCount;
 };
 
 
@@ -81,17 +91,11 @@ void VisDecompressionCacheClass::Reset(int vis_sector_count)
 	/*
 	** Each table that we have should be in our LRU list
 	*/
-	VisTableClass * pvs = LRUQueue.Peek_Head();
-	while (pvs != nullptr) {
-		WWASSERT(Cache[pvs->Get_Vis_Sector_ID()] != nullptr);
-
-		LRUQueue.Remove_Head();
-
-		int vis_id = pvs->Get_Vis_Sector_ID();
-		REF_PTR_RELEASE(Cache[vis_id]);
-
-		pvs = LRUQueue.Peek_Head();
+	while (LRUQueue.Peek_Head() != nullptr) {
+		Release_Head();
 	}
+	WWASSERT(CacheBytes == 0);
+	WWASSERT(TableCount == 0);
 
 	/*
 	** Sanity check, every pointer in the cache array should now be nullptr!
@@ -147,25 +151,58 @@ VisDecompressionCacheClass::Add_Table(VisTableClass * pvs)
 	pvs->Set_Time_Stamp(CurrentTimestamp);
 	REF_PTR_SET(Cache[pvs->Get_Vis_Sector_ID()],pvs);
 	LRUQueue.Add_Tail(pvs);
+
+	CacheBytes += Table_Bytes(pvs);
+	TableCount++;
 }
 
 void
-VisDecompressionCacheClass::Release_Old_Tables(void)
+VisDecompressionCacheClass::Release_Head(void)
 {
-	/*
-	** Release any vis table that hasn't been used in X frames
-	*/
-	int timestamp_cutoff = CurrentTimestamp - VIS_LRU_FRAMES;
+	VisTableClass * tbl = LRUQueue.Peek_Head();
+	WWASSERT(tbl != nullptr);
+	WWASSERT(Cache[tbl->Get_Vis_Sector_ID()] == tbl);
 
+	CacheBytes -= Table_Bytes(tbl);
+	TableCount--;
+
+	LRUQueue.Remove_Head();
+	REF_PTR_RELEASE(Cache[tbl->Get_Vis_Sector_ID()]);
+}
+
+int
+VisDecompressionCacheClass::Release_Old_Tables(int budget)
+{
+	int count = 0;
 	VisTableClass * tbl = LRUQueue.Peek_Head();
-	while (tbl && tbl->Get_Time_Stamp() < timestamp_cutoff) {
 
-		int vis_id = tbl->Get_Vis_Sector_ID();
-		REF_PTR_RELEASE(Cache[vis_id]);
+	if (budget > 0) {
+
+		/*
+		** Release the least recently used tables until we're back under the budget.  Tables
+		** used during the current frame are kept even if that leaves us over budget.
+		*/
+		while (tbl && (CacheBytes > budget) && (tbl->Get_Time_Stamp() < CurrentTimestamp)) {
+			Release_Head();
+			tbl = LRUQueue.Peek_Head();
+			count++;
+		}
+
+	} else {
+
+		/*
+		** Release any vis table that hasn't been used in X frames
+		*/
+		int timestamp_cutoff = CurrentTimestamp - VIS_LRU_FRAMES;
 
-		LRUQueue.Remove_Head();
-		tbl = LRUQueue.Peek_Head();
+		while (tbl && tbl->Get_Time_Stamp() < timestamp_cutoff) {
+			Release_Head();
+			tbl = LRUQueue.Peek_Head();
+			count++;
+		}
 	}
+
+	return count;
 }
 
 
@@ -199,7 +236,10 @@ enum
 VisTableMgrClass::VisTableMgrClass(void) :
 	VisSectorCount(0),
 	VisObjectCount(0),
-	FrameCounter(0)
+	FrameCounter(0),
+	CacheBudget(DEFAULT_CACHE_BUDGET),
+	FullDecompression(false),
+	PrefetchCount(0)
 {
 	WWMEMLOG(MEM_VIS);
 	Cache = new VisDecompressionCacheClass;
@@ -305,6 +345,7 @@ VisTableClass * VisTableMgrClass::Get_Vis_Table(int id,bool allocate/*= false*/)
 		/*
 		** Cache had the table, just return the pointer. (Add-Ref'd by the cache...)
 		*/
+		CacheStats.Hits++;
 		return pvs;
 
 	} else if (VisTables[id] != nullptr) {
@@ -313,9 +354,8 @@ VisTableClass * VisTableMgrClass::Get_Vis_Table(int id,bool allocate/*= false*/)
 		** Cache didn't have it, but we have the compressed version.
 		** Decompress, add to the cache, and return the table.
 		*/
-		pvs = NEW_REF(VisTableClass,(VisTables[id],Get_Vis_Table_Size(),id));
-		Cache->Add_Table(pvs);
-		return pvs;
+		CacheStats.Misses++;
+		return Decompress_Vis_Table(id);
 
 	} else if (allocate) {
 
@@ -369,8 +409,69 @@ bool VisTableMgrClass::Has_Vis_Table(int id)
 void VisTableMgrClass::Notify_Frame_Ended(void)
 {
 	FrameCounter++;
+	PrefetchCount = 0;
 	Cache->Set_Current_Timestamp(FrameCounter);
-	Cache->Release_Old_Tables();
+
+	if (!FullDecompression) {
+		CacheStats.Evictions += Cache->Release_Old_Tables(CacheBudget);
+	}
+}
+
+void VisTableMgrClass::Enable_Full_Decompression(bool onoff)
+{
+	FullDecompression = onoff;
+	if (FullDecompression) {
+		Decompress_All_Vis_Tables();
+	}
+}
+
+int VisTableMgrClass::Get_Cache_Bytes(void) const
+{
+	return Cache->Get_Byte_Count();
+}
+
+int VisTableMgrClass::Get_Cache_Table_Count(void) const
+{
+	return Cache->Get_Table_Count();
+}
+
+void VisTableMgrClass::Prefetch_Vis_Table(int id)
+{
+	if ((id < 0) || (id >= VisTables.Count()) || (VisTables[id] == nullptr) || Cache->Has_Table(id)) {
+		return;
+	}
+
+	if (PrefetchCount >= MAX_PREFETCHES_PER_FRAME) {
+		return;
+	}
+
+	PrefetchCount++;
+	CacheStats.Prefetches++;
+
+	VisTableClass * pvs = Decompress_Vis_Table(id);
+	REF_PTR_RELEASE(pvs);
+}
+
+VisTableClass * VisTableMgrClass::Decompress_Vis_Table(int id)
+{
+	WWMEMLOG(MEM_VIS);
+
+	std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+	VisTableClass * pvs = NEW_REF(VisTableClass,(VisTables[id],Get_Vis_Table_Size(),id));
+	CacheStats.DecompressTime += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+	Cache->Add_Table(pvs);
+	return pvs;
+}
+
+void VisTableMgrClass::Decompress_All_Vis_Tables(void)
+{
+	for (int i=0; i<VisTables.Count(); i++) {
+		if ((VisTables[i] != nullptr) && !Cache->Has_Table(i)) {
+			VisTableClass * pvs = Decompress_Vis_Table(i);
+			REF_PTR_RELEASE(pvs);
+		}
+	}
 }
 
 void VisTableMgrClass::Delete_All_Vis_Tables(void)
@@ -468,7 +569,24 @@ void VisTableMgrClass::Load(ChunkLoadClass & cload)
 		}
 		cload.Close_Chunk();
 	}
-}
 
+	/*
+	** Servers that keep every table decompressed pay for it all at load time
+	*/
+	if (FullDecompression) {
+		Decompress_All_Vis_Tables();
+	}
+}
 
 
+/*
+** VisTableMgrClass::CacheStatsStruct
+*/
+void VisTableMgrClass::CacheStatsStruct::Reset(void)
+{
+	Hits = 0;
+	Misses = 0;
+	Prefetches = 0;
+	Evictions = 0;
+	DecompressTime = 0.0f;
+}
@@ -92,6 +92,44 @@ public:
 	*/
 	void								Notify_Frame_Ended(void);
 
+	/*
+	** Decompression cache control.  With a memory budget (in bytes) decompressed tables stay
+	** cached until the budget is used up, then the least recently used ones are released.  With
+	** a budget of zero, any table that hasn't been used for a few frames is released.  Full
+	** decompression decompresses every table up front and keeps them all, for servers that
+	** have the ram to spare.
+	*/
+	void								Set_Cache_Budget(int bytes)						{ CacheBudget = bytes; }
+	int								Get_Cache_Budget(void) const						{ return CacheBudget; }
+	void								Enable_Full_Decompression(bool onoff);
+	bool								Is_Full_Decompression_Enabled(void) const		{ return FullDecompression; }
+	int								Get_Cache_Bytes(void) const;
+	int								Get_Cache_Table_Count(void) const;
+
+	/*
+	** Decompress a table that is likely to be asked for soon (e.g. the vis sector a player
+	** is moving into).  Only a few tables are prefetched per frame.
+	*/
+	void								Prefetch_Vis_Table(int id);
+
+	/*
+	** Cache statistics, accumulated until reset
+	*/
+	struct CacheStatsStruct
+	{
+		CacheStatsStruct(void)											{ Reset(); }
+		void	Reset(void);
+
+		int	Hits;							// requests for a table that was already decompressed
+		int	Misses;						// requests that had to decompress the table
+		int	Prefetches;					// tables decompressed ahead of a request
+		int	Evictions;					// tables released from the cache
+		float	DecompressTime;			// milliseconds spent decompressing
+	};
+
+	const CacheStatsStruct &	Get_Cache_Stats(void) const						{ return CacheStats; }
+	void								Reset_Cache_Stats(void)								{ CacheStats.Reset(); }
+
 	/*
 	** Save/Load interface
 	*/
@@ -104,10 +142,22 @@ protected:
 	int								VisObjectCount;
 
 	void								Delete_All_Vis_Tables(void);
+	VisTableClass *				Decompress_Vis_Table(int id);
+	void								Decompress_All_Vis_Tables(void);
+
+	enum
+	{
+		DEFAULT_CACHE_BUDGET = 16 * 1024 * 1024,
+		MAX_PREFETCHES_PER_FRAME = 4
+	};
 
 	SimpleDynVecClass<CompressedVisTableClass *>		VisTables;
 	VisDecompressionCacheClass *							Cache;
 	unsigned int												FrameCounter;
+	int															CacheBudget;
+	bool															FullDecompression;
+	int															PrefetchCount;
+	CacheStatsStruct											CacheStats;
 };
 
 
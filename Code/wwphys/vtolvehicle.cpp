@@ -175,6 +175,14 @@ void VTOLVehicleClass::Timestep(float dt)
 	VehiclePhysClass::Timestep(dt);
 }
 
+bool VTOLVehicleClass::Is_At_Rest(void)
+{
+	/*
+	** The rotors spin up, spin and spin down in Timestep even while we're asleep
+	*/
+	return VehiclePhysClass::Is_At_Rest() && !IsEngineOn && (RotorAngularVelocity == 0.0f);
+}
+
 
 void VTOLVehicleClass::Compute_Force_And_Torque(Vector3 * force,Vector3 * torque)
 {
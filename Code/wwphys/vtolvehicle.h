@@ -90,6 +90,7 @@ public:
 	virtual void					Render(RenderInfoClass & rinfo) override;
 	virtual void					Set_Model(RenderObjClass * model) override;
 	virtual void					Timestep(float dt) override;
+	virtual bool					Is_At_Rest(void) override;
 
 	/*
 	** Save-Load System